@@ -11,9 +11,11 @@
 #include "StructureLayout.h"
 #include "concepts/range_concept.h"
 #include "PointerDefs.h"
+#include "BoundingVolume.h"
 #include <vector>
 #include <array>
 #include <ranges>
+#include <algorithm>
 
 namespace lcf {
     class Geometry : public GeometryPointerDefs
@@ -114,11 +116,28 @@ namespace lcf {
         template <std::ranges::contiguous_range Range>
         requires std::integral<std::ranges::range_value_t<Range>>
         Self & setIndices(Range && indices) { m_indices.assign_range(std::forward<Range>(indices)); return *this; }
+        Self & setIndices(IndexList && indices) noexcept { m_indices = std::move(indices); return *this; }
         const IndexList & getIndices() const noexcept { return m_indices; }
+        Self & remapVertices(std::span<const uint32_t> remap) //- remap[old vertex] = new vertex, must be a permutation
+        {
+            for (auto && [i, attributes_bytes] : std::ranges::views::enumerate(m_attributes_map)) {
+                if (attributes_bytes.empty()) { continue; }
+                size_t type_size = enum_decode::get_size_in_bytes(enum_decode::get_vector_type(enum_values_v<VertexAttribute>[i]));
+                ByteList remapped_bytes(attributes_bytes.size());
+                for (size_t vertex = 0; vertex < remap.size(); ++vertex) {
+                    std::copy_n(attributes_bytes.begin() + vertex * type_size, type_size, remapped_bytes.begin() + remap[vertex] * type_size);
+                }
+                attributes_bytes = std::move(remapped_bytes);
+            }
+            for (auto & index : m_indices) { index = remap[index]; }
+            return *this;
+        }
         Self & addFace(Face face) { m_faces.emplace_back(std::move(face)); return *this; }
         const FaceList & getFaces() const noexcept { return m_faces; }
         uint32_t getVertexCount() const noexcept { return m_vertex_count; }
         uint32_t getIndexCount() const noexcept { return static_cast<uint32_t>(m_indices.size()); }
+        Self & setBoundingSphere(const BoundingSphere<float> & bounding_sphere) noexcept { m_bounding_sphere = bounding_sphere; return *this; }
+        const BoundingSphere<float> & getBoundingSphere() const noexcept { return m_bounding_sphere; }
 
         template <typename Mapping = enum_value_type_mapping_traits<VectorType>::type>
         BufferWriteSegments generateInterleavedVertexBufferSegments(VertexAttributeFlags enabled_flags) const noexcept
@@ -150,6 +169,7 @@ namespace lcf {
         AttributesMap m_attributes_map;
         IndexList m_indices;
         FaceList m_faces;
+        BoundingSphere<float> m_bounding_sphere;
     };
 
     template <typename Mapping = enum_value_type_mapping_traits<VectorType>::type, range_of_c<Geometry> GeometryRange>
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "render_assets_fwd_decls.h"
+#include <array>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace lcf {
+    inline constexpr uint32_t c_post_transform_cache_size = 16;
+    inline constexpr uint32_t c_meshlet_max_vertices = 64;
+    inline constexpr uint32_t c_meshlet_max_triangles = 124; //- 124 * 3 index bytes keep a full meshlet 4 byte aligned
+
+    struct Meshlet //- 16 bytes, matches Meshlet in shaders/include/meshlet.glsl
+    {
+        uint32_t m_vertex_offset = 0; //- into MeshletData::m_vertex_indices
+        uint32_t m_triangle_offset = 0; //- byte offset into MeshletData::m_triangle_indices, multiple of 4
+        uint32_t m_vertex_count = 0;
+        uint32_t m_triangle_count = 0;
+    };
+    static_assert(sizeof(Meshlet) == 16);
+
+    //- a meshlet faces away from the camera when dot(normalize(m_cone_apex - camera_position), m_cone_axis) >= m_cone_cutoff.
+    //- Meshlets whose triangles spread too wide get a zero axis and a cutoff of 1 so the test never passes
+    struct MeshletBounds //- 48 bytes, matches MeshletBounds in shaders/include/meshlet.glsl
+    {
+        std::array<float, 3> m_center {};
+        float m_radius = 0.0f;
+        std::array<float, 3> m_cone_apex {};
+        float m_padding = 0.0f;
+        std::array<float, 3> m_cone_axis {};
+        float m_cone_cutoff = 1.0f;
+    };
+    static_assert(sizeof(MeshletBounds) == 48);
+
+    struct MeshletData
+    {
+        std::vector<Meshlet> m_meshlets;
+        std::vector<MeshletBounds> m_bounds; //- one per meshlet
+        std::vector<uint32_t> m_vertex_indices; //- meshlet local vertex to geometry vertex
+        std::vector<uint8_t> m_triangle_indices; //- three meshlet local vertices per triangle
+    };
+
+    //- the passes work on triangle lists, positions are tightly packed xyz floats indexed by the index buffer.
+    //- The reordering passes leave the indices as they are when any of them is at or past vertex_count
+
+    //- Tipsify (Sander et al. 2007): fans triangles around recently used vertices so they hit the post transform cache
+    void optimize_vertex_cache(std::span<uint32_t> indices, uint32_t vertex_count, uint32_t cache_size = c_post_transform_cache_size) noexcept;
+
+    //- splits the cache optimized triangles into clusters whose average cache miss ratio stays within threshold times
+    //- the input one, then sorts the clusters so outward facing ones are drawn first and occlude the rest
+    void optimize_overdraw(std::span<uint32_t> indices, std::span<const float> positions, uint32_t vertex_count, float threshold = 1.05f) noexcept;
+
+    //- remap[old vertex] = new vertex, vertices ordered by first use and unreferenced ones moved to the end,
+    //- out of range indices are ignored
+    std::vector<uint32_t> generate_vertex_fetch_remap(std::span<const uint32_t> indices, uint32_t vertex_count) noexcept;
+
+    //- average transformed vertices per triangle for a fifo cache, 0.5 is the ideal for regular grids and 3 the worst.
+    //- Out of range indices count as misses
+    float compute_acmr(std::span<const uint32_t> indices, uint32_t vertex_count, uint32_t cache_size = c_post_transform_cache_size) noexcept;
+
+    //- runs the three passes above and reorders the vertex attributes, returns false and leaves the geometry as is
+    //- when it is not a triangle list or indexes past its vertices
+    bool optimize_geometry(Geometry & geometry) noexcept;
+
+    //- greedy clustering in index order, so run it on cache optimized indices to get compact meshlets.
+    //- Triangles referencing a vertex without a position are skipped
+    MeshletData build_meshlets(std::span<const uint32_t> indices, std::span<const float> positions,
+        uint32_t max_vertices = c_meshlet_max_vertices, uint32_t max_triangles = c_meshlet_max_triangles) noexcept;
+
+    MeshletData build_meshlets(const Geometry & geometry) noexcept;
+}
@@ -43,6 +43,7 @@ namespace lcf {
         Self & setTextureResource(TextureSemantic semantic, const Texture2DSharedPointer & texture_resource) noexcept;
         const Texture2D & getTexture(TextureSemantic semantic) const noexcept;
         const MaterialParam & getMaterialParam(MaterialProperty property) const noexcept;
+        bool hasParam(MaterialProperty property) const noexcept { return m_params.contains(property); } //- false means getMaterialParam falls back to the default
     private:
         ParamMap m_params;
         TextureReourceMap m_texture_resources;
@@ -74,10 +75,16 @@ namespace lcf {
         return segments;
     }
 
-    inline auto get_textures(const Material & material, ShadingModel shading_model) noexcept
+    inline auto get_texture_semantics(ShadingModel shading_model) noexcept
     {
         return enum_values_v<TextureSemantic> | std::views::filter([shading_model](auto semantic) {
             return contains_flags(enum_decode::get_material_property_flags(shading_model), enum_decode::to_property_flags(semantic));
-        }) | std::views::transform([&material](auto semantic) -> const Texture2D & { return material.getTexture(semantic); });
+        });
+    }
+
+    inline auto get_textures(const Material & material, ShadingModel shading_model) noexcept
+    {
+        return get_texture_semantics(shading_model)
+            | std::views::transform([&material](auto semantic) -> const Texture2D & { return material.getTexture(semantic); });
     }
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Model.h"
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+#include <span>
+#include <memory>
+
+namespace lcf {
+    class ModelCache
+    {
+        using Self = ModelCache;
+    public:
+        struct TextureSlot
+        {
+            uint32_t m_material_index = 0;
+            TextureSemantic m_semantic = TextureSemantic::eBaseColor;
+        };
+        using TextureSlotList = std::vector<TextureSlot>;
+        struct TextureRecord
+        {
+            bool isEmbedded() const noexcept { return not m_embedded_bytes.empty(); }
+            std::filesystem::path m_path;
+            std::span<const std::byte> m_embedded_bytes; //- empty for external files
+            uint32_t m_embedded_width = 0;
+            uint32_t m_embedded_height = 0; //- 0 means m_embedded_bytes is an encoded file image
+            TextureSlotList m_slots;
+        };
+        using TextureRecordList = std::vector<TextureRecord>;
+        using MaterialList = std::vector<Material::SharedPointer>;
+        struct Entry
+        {
+            Model m_model;
+            MaterialList m_materials;
+            TextureRecordList m_textures;
+            std::shared_ptr<const void> m_storage_sp; //- mapped cache file backing every embedded texture span
+        };
+    public:
+        ModelCache() noexcept = default;
+        ~ModelCache() noexcept = default;
+        ModelCache(const Self &) = delete;
+        Self & operator=(const Self &) = delete;
+        ModelCache(Self &&) noexcept = default;
+        Self & operator=(Self &&) noexcept = default;
+    public:
+        std::optional<Entry> tryLoad(const std::filesystem::path & source_path) const noexcept;
+        void store(
+            const std::filesystem::path & source_path,
+            std::span<const std::filesystem::path> dependency_paths,
+            const Model & model,
+            std::span<const Material::SharedPointer> materials,
+            std::span<const TextureRecord> textures) const noexcept;
+    };
+}
@@ -1,23 +1,51 @@
 #pragma once
 
 #include "Model.h"
+#include "Texture2D.h"
 #include <filesystem>
 #include <optional>
+#include <future>
+#include <vector>
 
 namespace lcf {
     class ModelLoader
     {
         using Self = ModelLoader;
+    public:
+        struct PendingTexture
+        {
+            struct Binding
+            {
+                Material::SharedPointer m_material_sp;
+                TextureSemantic m_semantic;
+            };
+            using BindingList = std::vector<Binding>;
+            bool isReady() const noexcept;
+            bool bind() const noexcept; //- blocks until decoded, returns false if decoding failed
+            std::filesystem::path m_path;
+            std::shared_future<Texture2D::SharedPointer> m_texture_future; //- nullptr if decoding failed
+            BindingList m_bindings; //- every material slot referencing this path, textures are decoded once per path
+        };
+        using PendingTextureList = std::vector<PendingTexture>;
+        struct StreamingModel
+        {
+            Model m_model;
+            PendingTextureList m_pending_textures;
+        };
+        static constexpr size_t c_default_decode_budget_in_bytes = 512ull << 20;
     public:
         ModelLoader();
-        ~ModelLoader();
+        ~ModelLoader(); //- blocks until every in-flight texture decode has finished
         ModelLoader(const Self &) = delete;
         Self & operator=(const Self &) = delete;
         ModelLoader(Self &&) = default;
         Self & operator=(Self &&) = default;
+        Self & setDecodeBudget(size_t budget_in_bytes) noexcept; //- caps the estimated decoded bytes in flight, a single oversized texture still proceeds alone
+        Self & setCacheEnabled(bool enabled) noexcept; //- off by default, entries go to ra::Config::getCacheDirectory(), see ModelCache
         std::optional<Model> load(const std::filesystem::path & path) const noexcept;
+        std::optional<StreamingModel> loadStreaming(const std::filesystem::path & path) const noexcept; //- returns once geometries and material params are ready
     private:
         struct Impl;
         std::unique_ptr<Impl> m_impl_up;
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "render_assets_fwd_decls.h"
+#include "BufferWriteSegment.h"
+#include <array>
+#include <span>
+#include <vector>
+#include <cstdint>
+#include <expected>
+#include <system_error>
+
+namespace lcf {
+    struct QuantizedVertex //- 20 bytes, matches QuantizedVertex in shaders/include/vertex_decode.glsl
+    {
+        uint16_t m_position[3] = {}; //- unorm16 over the bounding box, see VertexDecodeInfo
+        uint16_t m_padding = 0;
+        uint32_t m_normal = 0; //- octahedral, two snorm16
+        uint32_t m_tangent = 0; //- octahedral, two snorm16
+        uint32_t m_uv = 0; //- two float16
+    };
+    static_assert(sizeof(QuantizedVertex) == 20);
+
+    struct VertexDecodeInfo //- position = m_position_offset.xyz + m_position_scale.xyz * unorm16, w unused
+    {
+        std::array<float, 4> m_position_offset {};
+        std::array<float, 4> m_position_scale {};
+    };
+    static_assert(sizeof(VertexDecodeInfo) == 32);
+
+    //- the vertex buffer starts with the decode info so shaders reach both through the one buffer address
+    struct QuantizedVertexData
+    {
+        VertexDecodeInfo m_decode_info;
+        std::vector<QuantizedVertex> m_vertices;
+        //- the segments point into this object, it must outlive the upload
+        BufferWriteSegments generateVertexBufferSegments() const noexcept;
+    };
+
+    //- reads position, normal, tangent and texcoord0; missing attributes encode as zero
+    QuantizedVertexData quantize_vertices(const Geometry & geometry) noexcept;
+
+    uint32_t encode_octahedral(float x, float y, float z) noexcept; //- expects a non zero vector
+
+    std::array<float, 3> decode_octahedral(uint32_t encoded) noexcept; //- normalized
+
+    //- compact index stream for storage and transfer, not for the gpu. A vertex seen for the first time in order costs
+    //- one byte, any other index a zigzag varint of its delta to the previous one, so vertex cache and fetch
+    //- optimized meshes shrink to roughly a byte or two per index
+    std::vector<uint8_t> encode_index_buffer(std::span<const uint32_t> indices) noexcept;
+
+    std::expected<std::vector<uint32_t>, std::error_code> decode_index_buffer(std::span<const uint8_t> encoded, size_t index_count) noexcept;
+}
@@ -16,5 +16,9 @@ namespace lcf::ra {
     public:
         Self & registerVirtualPath(std::string virtual_alias, std::filesystem::path real_path) noexcept;
         std::filesystem::path resolvePath(const std::filesystem::path & path) const noexcept;
+        Self & setCacheDirectory(const std::filesystem::path & cache_directory) noexcept;
+        const std::filesystem::path & getCacheDirectory() const noexcept { return m_cache_directory; }
+    private:
+        std::filesystem::path m_cache_directory = ".model_cache";
     };
 }
\ No newline at end of file
@@ -0,0 +1,374 @@
+#include "render_assets/GeometryOptimization.h"
+#include "render_assets/Geometry.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using namespace lcf;
+
+namespace {
+    using Float3 = std::array<float, 3>;
+    constexpr uint32_t k_invalid_vertex = std::numeric_limits<uint32_t>::max();
+    constexpr uint8_t k_invalid_local_index = std::numeric_limits<uint8_t>::max();
+    constexpr float k_min_cone_spread = 0.1f; //- below this the triangles face too many ways for the cone to ever cull
+}
+
+//- auxiliary structs begin
+struct TriangleAdjacency //- triangles around each vertex, m_triangles[m_offsets[v], m_offsets[v + 1])
+{
+    std::vector<uint32_t> m_offsets;
+    std::vector<uint32_t> m_triangles;
+};
+
+struct FifoCache //- stamps every vertex with the time it entered, so a miss is an entry older than the cache size
+{
+    FifoCache(uint32_t vertex_count, uint32_t cache_size) : m_entry_times(vertex_count, 0), m_cache_size(cache_size), m_time(cache_size + 1) {}
+    uint32_t access(uint32_t vertex) noexcept //- returns 1 on a miss, out of range vertices always miss
+    {
+        if (vertex >= m_entry_times.size()) { return 1; }
+        if (m_time - m_entry_times[vertex] <= m_cache_size) { return 0; }
+        m_entry_times[vertex] = m_time++;
+        return 1;
+    }
+    void flush() noexcept { m_time += m_cache_size + 1; }
+    std::vector<uint32_t> m_entry_times;
+    uint32_t m_cache_size;
+    uint32_t m_time;
+};
+//- auxiliary structs end
+
+//- auxiliary function forward declarations begin
+bool are_indices_in_range(std::span<const uint32_t> indices, uint32_t vertex_count) noexcept;
+
+TriangleAdjacency build_triangle_adjacency(std::span<const uint32_t> indices, uint32_t vertex_count) noexcept;
+
+Float3 load_position(std::span<const float> positions, uint32_t vertex) noexcept;
+
+Float3 float3_subtract(const Float3 & lhs, const Float3 & rhs) noexcept;
+
+Float3 float3_cross(const Float3 & lhs, const Float3 & rhs) noexcept;
+
+float float3_dot(const Float3 & lhs, const Float3 & rhs) noexcept;
+
+float float3_length(const Float3 & value) noexcept;
+
+MeshletBounds compute_meshlet_bounds(const MeshletData & data, const Meshlet & meshlet, std::span<const float> positions) noexcept;
+//- auxiliary function forward declarations end
+
+void lcf::optimize_vertex_cache(std::span<uint32_t> indices, uint32_t vertex_count, uint32_t cache_size) noexcept
+{
+    const size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0 or not are_indices_in_range(indices, vertex_count)) { return; }
+    auto adjacency = build_triangle_adjacency(indices, vertex_count);
+    std::vector<uint32_t> live_counts(vertex_count);
+    for (uint32_t v = 0; v < vertex_count; ++v) { live_counts[v] = adjacency.m_offsets[v + 1] - adjacency.m_offsets[v]; }
+    std::vector<uint32_t> entry_times(vertex_count, 0);
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<uint32_t> dead_end_stack, candidates, result;
+    dead_end_stack.reserve(indices.size());
+    result.reserve(triangle_count * 3);
+    uint32_t time = cache_size + 1, scan_cursor = 0;
+    auto next_fanning_vertex = [&]() -> uint32_t {
+        //- prefer the oldest candidate whose remaining fan still fits in the cache
+        uint32_t best = k_invalid_vertex;
+        int64_t best_priority = -1;
+        for (uint32_t v : candidates) {
+            if (live_counts[v] == 0) { continue; }
+            int64_t priority = 0;
+            if (time - entry_times[v] + 2 * live_counts[v] <= cache_size) { priority = time - entry_times[v]; }
+            if (priority > best_priority) {
+                best = v;
+                best_priority = priority;
+            }
+        }
+        if (best != k_invalid_vertex) { return best; }
+        while (not dead_end_stack.empty()) { //- dead end, back up to a recently used vertex
+            uint32_t v = dead_end_stack.back();
+            dead_end_stack.pop_back();
+            if (live_counts[v] > 0) { return v; }
+        }
+        for (; scan_cursor < vertex_count; ++scan_cursor) {
+            if (live_counts[scan_cursor] > 0) { return scan_cursor; }
+        }
+        return k_invalid_vertex;
+    };
+    candidates.push_back(indices[0]);
+    for (uint32_t fanning_vertex = next_fanning_vertex(); fanning_vertex != k_invalid_vertex; fanning_vertex = next_fanning_vertex()) {
+        candidates.clear();
+        for (uint32_t i = adjacency.m_offsets[fanning_vertex]; i < adjacency.m_offsets[fanning_vertex + 1]; ++i) {
+            uint32_t triangle = adjacency.m_triangles[i];
+            if (emitted[triangle]) { continue; }
+            emitted[triangle] = true;
+            for (uint32_t corner = 0; corner < 3; ++corner) {
+                uint32_t v = indices[triangle * 3 + corner];
+                result.push_back(v);
+                dead_end_stack.push_back(v);
+                candidates.push_back(v);
+                --live_counts[v];
+                if (time - entry_times[v] > cache_size) { entry_times[v] = time++; }
+            }
+        }
+    }
+    std::ranges::copy(result, indices.begin());
+}
+
+void lcf::optimize_overdraw(std::span<uint32_t> indices, std::span<const float> positions, uint32_t vertex_count, float threshold) noexcept
+{
+    const size_t triangle_count = indices.size() / 3;
+    if (triangle_count < 2 or positions.size() < size_t(vertex_count) * 3 or not are_indices_in_range(indices, vertex_count)) { return; }
+    auto triangle_misses = [&indices](FifoCache & cache, size_t triangle) {
+        return cache.access(indices[triangle * 3]) + cache.access(indices[triangle * 3 + 1]) + cache.access(indices[triangle * 3 + 2]);
+    };
+    //- a triangle missing all three vertices restarts the cache, reordering at those points costs nothing
+    FifoCache cache(vertex_count, c_post_transform_cache_size);
+    std::vector<uint32_t> hard_starts;
+    for (size_t t = 0; t < triangle_count; ++t) {
+        if (triangle_misses(cache, t) == 3 or t == 0) { hard_starts.push_back(static_cast<uint32_t>(t)); }
+    }
+    hard_starts.push_back(static_cast<uint32_t>(triangle_count));
+    //- finer clusters inside each, closed as soon as their own miss ratio is within the threshold
+    std::vector<uint32_t> cluster_starts;
+    for (size_t h = 0; h + 1 < hard_starts.size(); ++h) {
+        uint32_t begin = hard_starts[h], end = hard_starts[h + 1];
+        cache.flush();
+        uint32_t hard_misses = 0;
+        for (uint32_t t = begin; t < end; ++t) { hard_misses += triangle_misses(cache, t); }
+        float cluster_threshold = threshold * static_cast<float>(hard_misses) / static_cast<float>(end - begin);
+        cache.flush();
+        uint32_t start = begin, misses = 0;
+        for (uint32_t t = begin; t < end; ++t) {
+            misses += triangle_misses(cache, t);
+            if (t + 1 < end and static_cast<float>(misses) <= cluster_threshold * static_cast<float>(t + 1 - start)) {
+                cluster_starts.push_back(start);
+                start = t + 1;
+                misses = 0;
+                cache.flush();
+            }
+        }
+        cluster_starts.push_back(start);
+    }
+    cluster_starts.push_back(static_cast<uint32_t>(triangle_count));
+    const size_t cluster_count = cluster_starts.size() - 1;
+    std::vector<Float3> cluster_centroids(cluster_count), cluster_normals(cluster_count);
+    Float3 mesh_centroid {};
+    float mesh_area = 0.0f;
+    for (size_t c = 0; c < cluster_count; ++c) {
+        Float3 centroid {}, normal {};
+        float area = 0.0f;
+        for (uint32_t t = cluster_starts[c]; t < cluster_starts[c + 1]; ++t) {
+            Float3 p0 = load_position(positions, indices[t * 3]);
+            Float3 p1 = load_position(positions, indices[t * 3 + 1]);
+            Float3 p2 = load_position(positions, indices[t * 3 + 2]);
+            Float3 n = float3_cross(float3_subtract(p1, p0), float3_subtract(p2, p0));
+            float triangle_area = float3_length(n);
+            for (size_t axis = 0; axis < 3; ++axis) {
+                centroid[axis] += (p0[axis] + p1[axis] + p2[axis]) * (triangle_area / 3.0f);
+                normal[axis] += n[axis];
+            }
+            area += triangle_area;
+        }
+        for (size_t axis = 0; axis < 3; ++axis) {
+            mesh_centroid[axis] += centroid[axis];
+            cluster_centroids[c][axis] = area > 0.0f ? centroid[axis] / area : 0.0f;
+        }
+        mesh_area += area;
+        float normal_length = float3_length(normal);
+        for (size_t axis = 0; axis < 3; ++axis) { cluster_normals[c][axis] = normal_length > 0.0f ? normal[axis] / normal_length : 0.0f; }
+    }
+    if (mesh_area > 0.0f) { for (float & value : mesh_centroid) { value /= mesh_area; } }
+    std::vector<float> sort_keys(cluster_count);
+    for (size_t c = 0; c < cluster_count; ++c) { sort_keys[c] = float3_dot(float3_subtract(cluster_centroids[c], mesh_centroid), cluster_normals[c]); }
+    std::vector<uint32_t> cluster_order(cluster_count);
+    std::iota(cluster_order.begin(), cluster_order.end(), 0u);
+    std::ranges::stable_sort(cluster_order, [&sort_keys](uint32_t lhs, uint32_t rhs) { return sort_keys[lhs] > sort_keys[rhs]; });
+    std::vector<uint32_t> result;
+    result.reserve(triangle_count * 3);
+    for (uint32_t c : cluster_order) {
+        result.append_range(indices.subspan(cluster_starts[c] * 3, (cluster_starts[c + 1] - cluster_starts[c]) * 3));
+    }
+    std::ranges::copy(result, indices.begin());
+}
+
+std::vector<uint32_t> lcf::generate_vertex_fetch_remap(std::span<const uint32_t> indices, uint32_t vertex_count) noexcept
+{
+    std::vector<uint32_t> remap(vertex_count, k_invalid_vertex);
+    uint32_t next_vertex = 0;
+    for (uint32_t index : indices) {
+        if (index < vertex_count and remap[index] == k_invalid_vertex) { remap[index] = next_vertex++; }
+    }
+    for (uint32_t & target : remap) {
+        if (target == k_invalid_vertex) { target = next_vertex++; }
+    }
+    return remap;
+}
+
+float lcf::compute_acmr(std::span<const uint32_t> indices, uint32_t vertex_count, uint32_t cache_size) noexcept
+{
+    const size_t triangle_count = indices.size() / 3;
+    if (triangle_count == 0) { return 0.0f; }
+    FifoCache cache(vertex_count, cache_size);
+    size_t misses = 0;
+    for (uint32_t index : indices.first(triangle_count * 3)) { misses += cache.access(index); }
+    return static_cast<float>(misses) / static_cast<float>(triangle_count);
+}
+
+bool lcf::optimize_geometry(Geometry & geometry) noexcept
+{
+    const auto & indices = geometry.getIndices();
+    const uint32_t vertex_count = geometry.getVertexCount();
+    auto positions = geometry.getBasicAttributes<VertexAttribute::ePosition>();
+    if (indices.empty() or indices.size() % 3 != 0 or positions.size() < size_t(vertex_count) * 3) { return false; }
+    if (not are_indices_in_range(indices, vertex_count)) { return false; }
+    if (not std::ranges::all_of(geometry.getFaces(), [](const auto & face) { return face.second == 3; })) { return false; }
+    Geometry::IndexList optimized_indices = indices;
+    optimize_vertex_cache(optimized_indices, vertex_count);
+    optimize_overdraw(optimized_indices, positions, vertex_count);
+    auto remap = generate_vertex_fetch_remap(optimized_indices, vertex_count);
+    //- faces stay (3 * i, 3) since only whole triangles moved
+    geometry.setIndices(std::move(optimized_indices)).remapVertices(remap);
+    return true;
+}
+
+MeshletData lcf::build_meshlets(std::span<const uint32_t> indices, std::span<const float> positions, uint32_t max_vertices, uint32_t max_triangles) noexcept
+{
+    MeshletData data;
+    const size_t vertex_count = positions.size() / 3;
+    max_vertices = std::clamp<uint32_t>(max_vertices, 3, k_invalid_local_index); //- local indices are bytes
+    max_triangles = std::max<uint32_t>(max_triangles, 1);
+    std::vector<uint8_t> local_indices(vertex_count, k_invalid_local_index);
+    Meshlet meshlet;
+    auto finish_meshlet = [&] {
+        if (meshlet.m_triangle_count == 0) { return; }
+        for (uint32_t i = 0; i < meshlet.m_vertex_count; ++i) { local_indices[data.m_vertex_indices[meshlet.m_vertex_offset + i]] = k_invalid_local_index; }
+        data.m_triangle_indices.resize((data.m_triangle_indices.size() + 3) & ~size_t(3), 0);
+        data.m_bounds.push_back(compute_meshlet_bounds(data, meshlet, positions));
+        data.m_meshlets.push_back(meshlet);
+        meshlet = {};
+        meshlet.m_vertex_offset = static_cast<uint32_t>(data.m_vertex_indices.size());
+        meshlet.m_triangle_offset = static_cast<uint32_t>(data.m_triangle_indices.size());
+    };
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        uint32_t a = indices[t], b = indices[t + 1], c = indices[t + 2];
+        if (a >= vertex_count or b >= vertex_count or c >= vertex_count) { continue; } //- no position to bound it with
+        uint32_t new_vertex_count = (local_indices[a] == k_invalid_local_index) +
+            (local_indices[b] == k_invalid_local_index and b != a) +
+            (local_indices[c] == k_invalid_local_index and c != a and c != b);
+        if (meshlet.m_vertex_count + new_vertex_count > max_vertices or meshlet.m_triangle_count >= max_triangles) { finish_meshlet(); }
+        for (uint32_t v : {a, b, c}) {
+            if (local_indices[v] == k_invalid_local_index) {
+                local_indices[v] = static_cast<uint8_t>(meshlet.m_vertex_count++);
+                data.m_vertex_indices.push_back(v);
+            }
+            data.m_triangle_indices.push_back(local_indices[v]);
+        }
+        ++meshlet.m_triangle_count;
+    }
+    finish_meshlet();
+    return data;
+}
+
+MeshletData lcf::build_meshlets(const Geometry & geometry) noexcept
+{
+    return build_meshlets(geometry.getIndices(), geometry.getBasicAttributes<VertexAttribute::ePosition>());
+}
+
+//- auxiliary function implementations begin
+bool are_indices_in_range(std::span<const uint32_t> indices, uint32_t vertex_count) noexcept
+{
+    return std::ranges::all_of(indices, [vertex_count](uint32_t index) { return index < vertex_count; });
+}
+
+TriangleAdjacency build_triangle_adjacency(std::span<const uint32_t> indices, uint32_t vertex_count) noexcept
+{
+    TriangleAdjacency adjacency;
+    const size_t triangle_count = indices.size() / 3;
+    adjacency.m_offsets.assign(vertex_count + 1, 0);
+    for (uint32_t index : indices.first(triangle_count * 3)) { ++adjacency.m_offsets[index + 1]; }
+    std::partial_sum(adjacency.m_offsets.begin(), adjacency.m_offsets.end(), adjacency.m_offsets.begin());
+    adjacency.m_triangles.resize(triangle_count * 3);
+    std::vector<uint32_t> cursors(adjacency.m_offsets.begin(), adjacency.m_offsets.end() - 1);
+    for (size_t i = 0; i < triangle_count * 3; ++i) { adjacency.m_triangles[cursors[indices[i]]++] = static_cast<uint32_t>(i / 3); }
+    return adjacency;
+}
+
+Float3 load_position(std::span<const float> positions, uint32_t vertex) noexcept
+{
+    return {positions[vertex * 3], positions[vertex * 3 + 1], positions[vertex * 3 + 2]};
+}
+
+Float3 float3_subtract(const Float3 & lhs, const Float3 & rhs) noexcept
+{
+    return {lhs[0] - rhs[0], lhs[1] - rhs[1], lhs[2] - rhs[2]};
+}
+
+Float3 float3_cross(const Float3 & lhs, const Float3 & rhs) noexcept
+{
+    return {lhs[1] * rhs[2] - lhs[2] * rhs[1], lhs[2] * rhs[0] - lhs[0] * rhs[2], lhs[0] * rhs[1] - lhs[1] * rhs[0]};
+}
+
+float float3_dot(const Float3 & lhs, const Float3 & rhs) noexcept
+{
+    return lhs[0] * rhs[0] + lhs[1] * rhs[1] + lhs[2] * rhs[2];
+}
+
+float float3_length(const Float3 & value) noexcept
+{
+    return std::sqrt(float3_dot(value, value));
+}
+
+MeshletBounds compute_meshlet_bounds(const MeshletData & data, const Meshlet & meshlet, std::span<const float> positions) noexcept
+{
+    MeshletBounds bounds;
+    auto vertices = std::span(data.m_vertex_indices).subspan(meshlet.m_vertex_offset, meshlet.m_vertex_count);
+    auto triangles = std::span(data.m_triangle_indices).subspan(meshlet.m_triangle_offset, meshlet.m_triangle_count * 3);
+    Float3 min_corner, max_corner;
+    min_corner.fill(std::numeric_limits<float>::max());
+    max_corner.fill(std::numeric_limits<float>::lowest());
+    for (uint32_t v : vertices) {
+        Float3 p = load_position(positions, v);
+        for (size_t axis = 0; axis < 3; ++axis) {
+            min_corner[axis] = std::min(min_corner[axis], p[axis]);
+            max_corner[axis] = std::max(max_corner[axis], p[axis]);
+        }
+    }
+    Float3 center;
+    for (size_t axis = 0; axis < 3; ++axis) { center[axis] = (min_corner[axis] + max_corner[axis]) * 0.5f; }
+    float radius = 0.0f;
+    for (uint32_t v : vertices) { radius = std::max(radius, float3_length(float3_subtract(load_position(positions, v), center))); }
+    bounds.m_center = center;
+    bounds.m_radius = radius;
+    //- the cone axis is the area weighted average normal, its cutoff covers the widest triangle normal
+    std::vector<Float3> normals;
+    std::vector<Float3> corners;
+    normals.reserve(meshlet.m_triangle_count);
+    corners.reserve(meshlet.m_triangle_count);
+    Float3 axis {};
+    for (size_t t = 0; t < meshlet.m_triangle_count; ++t) {
+        Float3 p0 = load_position(positions, vertices[triangles[t * 3]]);
+        Float3 p1 = load_position(positions, vertices[triangles[t * 3 + 1]]);
+        Float3 p2 = load_position(positions, vertices[triangles[t * 3 + 2]]);
+        Float3 n = float3_cross(float3_subtract(p1, p0), float3_subtract(p2, p0));
+        float n_length = float3_length(n);
+        if (n_length == 0.0f) { continue; } //- degenerate triangles face nowhere
+        for (size_t i = 0; i < 3; ++i) { axis[i] += n[i]; }
+        normals.push_back({n[0] / n_length, n[1] / n_length, n[2] / n_length});
+        corners.push_back(p0);
+    }
+    float axis_length = float3_length(axis);
+    if (axis_length == 0.0f) { return bounds; }
+    for (float & value : axis) { value /= axis_length; }
+    float min_dot = 1.0f;
+    for (const auto & n : normals) { min_dot = std::min(min_dot, float3_dot(n, axis)); }
+    if (min_dot <= k_min_cone_spread) { return bounds; }
+    //- move the apex back along the axis until every triangle plane lies in front of it
+    float max_t = 0.0f;
+    for (size_t i = 0; i < normals.size(); ++i) {
+        max_t = std::max(max_t, float3_dot(float3_subtract(center, corners[i]), normals[i]) / float3_dot(axis, normals[i]));
+    }
+    for (size_t i = 0; i < 3; ++i) { bounds.m_cone_apex[i] = center[i] - axis[i] * max_t; }
+    bounds.m_cone_axis = axis;
+    bounds.m_cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+    return bounds;
+}
+//- auxiliary function implementations end
@@ -0,0 +1,509 @@
+#include "render_assets/ModelCache.h"
+#include "render_assets/configs/config.h"
+#include "shader_core/hash.h"
+#include "shader_core/buffer_io.h"
+#include "file_utils.h"
+#include "bytes.h"
+#include "log.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <unordered_map>
+#include <algorithm>
+#include <ranges>
+#include <format>
+#include <limits>
+#include <array>
+#include <tuple>
+
+using namespace lcf;
+namespace stdfs = std::filesystem;
+namespace bip = boost::interprocess;
+
+namespace {
+    constexpr uint32_t k_magic = 0x4C43464D;
+    constexpr uint32_t k_version = 3; //- 2: geometries are vertex cache, overdraw and fetch optimized, 3: records are written field by field
+    constexpr std::string_view k_cache_ext = ".lcfmodel";
+
+    //- records go through write_record and read_record field by field, so no padding or in-memory layout reaches the file
+    struct CacheHeader
+    {
+        static constexpr auto fields(auto & self) noexcept
+        {
+            return std::tie(self.m_magic, self.m_version, self.m_source_hash, self.m_dependency_count, self.m_geometry_count,
+                self.m_material_count, self.m_primitive_count, self.m_node_count, self.m_texture_count);
+        }
+        uint32_t m_magic = 0;
+        uint32_t m_version = 0;
+        uint64_t m_source_hash = 0;
+        uint32_t m_dependency_count = 0;
+        uint32_t m_geometry_count = 0;
+        uint32_t m_material_count = 0;
+        uint32_t m_primitive_count = 0;
+        uint32_t m_node_count = 0;
+        uint32_t m_texture_count = 0;
+    };
+
+    struct DependencyHeader
+    {
+        static constexpr auto fields(auto & self) noexcept { return std::tie(self.m_content_hash, self.m_path_size_in_bytes); }
+        uint64_t m_content_hash = 0;
+        uint32_t m_path_size_in_bytes = 0;
+    };
+
+    struct GeometryHeader
+    {
+        static constexpr auto fields(auto & self) noexcept
+        {
+            return std::tie(self.m_vertex_count, self.m_attribute_mask, self.m_index_count, self.m_face_count, self.m_bounding_sphere);
+        }
+        uint32_t m_vertex_count = 0;
+        uint32_t m_attribute_mask = 0;
+        uint32_t m_index_count = 0;
+        uint32_t m_face_count = 0;
+        std::array<float, 4> m_bounding_sphere {}; //- center xyz, radius
+    };
+
+    struct MaterialParamRecord
+    {
+        static constexpr auto fields(auto & self) noexcept { return std::tie(self.m_property, self.m_value); }
+        uint16_t m_property = 0;
+        std::array<float, 4> m_value {};
+    };
+
+    struct PrimitiveRecord
+    {
+        static constexpr auto fields(auto & self) noexcept { return std::tie(self.m_geometry_index, self.m_material_index); }
+        uint32_t m_geometry_index = 0;
+        uint32_t m_material_index = 0;
+    };
+
+    struct NodeHeader
+    {
+        static constexpr auto fields(auto & self) noexcept { return std::tie(self.m_parent_index, self.m_primitive_index_count, self.m_local_matrix); }
+        uint64_t m_parent_index = 0;
+        uint64_t m_primitive_index_count = 0;
+        std::array<float, 16> m_local_matrix {}; //- column major, as Matrix4x4::getData lays it out
+    };
+
+    struct TextureHeader
+    {
+        static constexpr auto fields(auto & self) noexcept
+        {
+            return std::tie(self.m_path_size_in_bytes, self.m_slot_count, self.m_embedded_width, self.m_embedded_height, self.m_embedded_size_in_bytes);
+        }
+        uint32_t m_path_size_in_bytes = 0;
+        uint32_t m_slot_count = 0;
+        uint32_t m_embedded_width = 0;
+        uint32_t m_embedded_height = 0;
+        uint64_t m_embedded_size_in_bytes = 0;
+    };
+
+    struct TextureSlotRecord
+    {
+        static constexpr auto fields(auto & self) noexcept { return std::tie(self.m_material_index, self.m_semantic); }
+        uint32_t m_material_index = 0;
+        uint32_t m_semantic = 0;
+    };
+
+    struct MappedFile
+    {
+        bip::file_mapping m_mapping;
+        bip::mapped_region m_region;
+        std::span<const std::byte> getBytes() const noexcept
+        {
+            return {static_cast<const std::byte *>(m_region.get_address()), m_region.get_size()};
+        }
+    };
+
+    using MappedFileSharedPointer = std::shared_ptr<const MappedFile>;
+
+    template <typename Record>
+    void write_record(sc::BufferWriter & writer, const Record & record) noexcept;
+
+    template <typename Record>
+    bool read_record(sc::BufferReader & reader, Record & record) noexcept;
+
+    template <typename Record>
+    constexpr size_t get_record_size_in_bytes() noexcept;
+
+    MappedFileSharedPointer map_file(const stdfs::path & path) noexcept;
+
+    std::optional<uint64_t> hash_file(const stdfs::path & path) noexcept;
+
+    std::optional<uint64_t> hash_dependency(const stdfs::path & path, const stdfs::path & source_path, uint64_t source_hash) noexcept;
+
+    uint64_t compute_cache_key(const stdfs::path & source_path, uint64_t source_hash) noexcept;
+
+    stdfs::path make_cache_entry_path(uint64_t key) noexcept;
+
+    std::optional<std::span<const std::byte>> read_view(sc::BufferReader & reader, std::span<const std::byte> data, size_t size_in_bytes) noexcept;
+
+    std::optional<std::string> read_string(sc::BufferReader & reader, size_t size_in_bytes) noexcept;
+
+    bool has_room_for(const sc::BufferReader & reader, uint64_t count, size_t record_size_in_bytes) noexcept;
+
+    bool read_geometry(sc::BufferReader & reader, std::span<const std::byte> data, Geometry & geometry) noexcept;
+
+    void write_geometry(sc::BufferWriter & writer, const Geometry & geometry) noexcept;
+
+    bool read_material(sc::BufferReader & reader, Material & material) noexcept;
+
+    void write_material(sc::BufferWriter & writer, const Material & material) noexcept;
+}
+
+std::optional<ModelCache::Entry> ModelCache::tryLoad(const std::filesystem::path & source_path) const noexcept
+{
+    auto source_hash_opt = hash_file(source_path);
+    if (not source_hash_opt) { return std::nullopt; }
+    const uint64_t key = compute_cache_key(source_path, *source_hash_opt);
+    auto mapped_file_sp = map_file(make_cache_entry_path(key));
+    if (not mapped_file_sp) { return std::nullopt; }
+    auto data = mapped_file_sp->getBytes();
+    sc::BufferReader reader {data};
+    CacheHeader header;
+    if (not read_record(reader, header)) { return std::nullopt; }
+    if (header.m_magic != k_magic or header.m_version != k_version or header.m_source_hash != key) { return std::nullopt; }
+    for (uint32_t i = 0; i < header.m_dependency_count; ++i) {
+        DependencyHeader dependency_header;
+        if (not read_record(reader, dependency_header)) { return std::nullopt; }
+        auto dependency_path_opt = read_string(reader, dependency_header.m_path_size_in_bytes);
+        if (not dependency_path_opt) { return std::nullopt; }
+        auto content_hash_opt = hash_dependency(*dependency_path_opt, source_path, *source_hash_opt);
+        if (not content_hash_opt or *content_hash_opt != dependency_header.m_content_hash) { return std::nullopt; }
+    }
+    //- every count below comes from the file, a truncated or stale one must end in a miss before anything is sized by it
+    if (not has_room_for(reader, header.m_geometry_count, get_record_size_in_bytes<GeometryHeader>()) or
+        not has_room_for(reader, header.m_material_count, sizeof(uint32_t)) or
+        not has_room_for(reader, header.m_primitive_count, get_record_size_in_bytes<PrimitiveRecord>()) or
+        not has_room_for(reader, header.m_node_count, get_record_size_in_bytes<NodeHeader>()) or
+        not has_room_for(reader, header.m_texture_count, get_record_size_in_bytes<TextureHeader>())) { return std::nullopt; }
+
+    Entry entry;
+    std::vector<Geometry::SharedPointer> geometries(header.m_geometry_count);
+    for (auto & geometry_sp : geometries) {
+        geometry_sp = Geometry::makeShared();
+        if (not read_geometry(reader, data, *geometry_sp)) { return std::nullopt; }
+    }
+    entry.m_materials.resize(header.m_material_count);
+    for (auto & material_sp : entry.m_materials) {
+        material_sp = Material::makeShared();
+        if (not read_material(reader, *material_sp)) { return std::nullopt; }
+    }
+    auto & render_primitive_list = entry.m_model.m_render_primitive_list;
+    render_primitive_list.resize(header.m_primitive_count);
+    for (auto & render_primitive : render_primitive_list) {
+        PrimitiveRecord record;
+        if (not read_record(reader, record)) { return std::nullopt; }
+        if (record.m_geometry_index >= geometries.size() or record.m_material_index >= entry.m_materials.size()) { return std::nullopt; }
+        render_primitive.setGeometryResource(geometries[record.m_geometry_index]);
+        render_primitive.setMaterialResource(entry.m_materials[record.m_material_index]);
+    }
+    auto & hierarchy_node_list = entry.m_model.m_hierarchy_node_list;
+    hierarchy_node_list.resize(header.m_node_count);
+    for (auto && [node_index, hierarchy_node] : std::views::enumerate(hierarchy_node_list)) {
+        NodeHeader node_header;
+        if (not read_record(reader, node_header)) { return std::nullopt; }
+        //- nodes are stored breadth first, so a parent always precedes its children
+        bool is_root = node_header.m_parent_index == static_cast<uint64_t>(Model::HierarchyNode {}.m_parent_index) or
+            node_header.m_parent_index == std::numeric_limits<uint64_t>::max();
+        if (not is_root and node_header.m_parent_index >= static_cast<uint64_t>(node_index)) { return std::nullopt; }
+        if (not has_room_for(reader, node_header.m_primitive_index_count, sizeof(uint64_t))) { return std::nullopt; }
+        hierarchy_node.m_parent_index = static_cast<size_t>(node_header.m_parent_index);
+        std::ranges::copy(node_header.m_local_matrix, hierarchy_node.m_local_matrix.getData());
+        hierarchy_node.m_primitive_indices.resize(node_header.m_primitive_index_count);
+        for (auto & primitive_index : hierarchy_node.m_primitive_indices) {
+            uint64_t index = 0;
+            if (not reader.read(index) or index >= render_primitive_list.size()) { return std::nullopt; }
+            primitive_index = static_cast<size_t>(index);
+        }
+    }
+    entry.m_textures.resize(header.m_texture_count);
+    for (auto & texture_record : entry.m_textures) {
+        TextureHeader texture_header;
+        if (not read_record(reader, texture_header)) { return std::nullopt; }
+        auto path_opt = read_string(reader, texture_header.m_path_size_in_bytes);
+        auto embedded_bytes_opt = read_view(reader, data, texture_header.m_embedded_size_in_bytes);
+        if (not path_opt or not embedded_bytes_opt) { return std::nullopt; }
+        texture_record.m_path = std::move(*path_opt);
+        texture_record.m_embedded_bytes = *embedded_bytes_opt;
+        texture_record.m_embedded_width = texture_header.m_embedded_width;
+        texture_record.m_embedded_height = texture_header.m_embedded_height;
+        if (not has_room_for(reader, texture_header.m_slot_count, get_record_size_in_bytes<TextureSlotRecord>())) { return std::nullopt; }
+        texture_record.m_slots.resize(texture_header.m_slot_count);
+        for (auto & slot : texture_record.m_slots) {
+            TextureSlotRecord slot_record;
+            if (not read_record(reader, slot_record)) { return std::nullopt; }
+            auto semantic = static_cast<TextureSemantic>(slot_record.m_semantic);
+            if (slot_record.m_material_index >= entry.m_materials.size() or not std::ranges::contains(enum_values_v<TextureSemantic>, semantic)) { return std::nullopt; }
+            slot.m_material_index = slot_record.m_material_index;
+            slot.m_semantic = semantic;
+        }
+    }
+    entry.m_storage_sp = std::move(mapped_file_sp);
+    return entry;
+}
+
+void ModelCache::store(
+    const std::filesystem::path & source_path,
+    std::span<const std::filesystem::path> dependency_paths,
+    const Model & model,
+    std::span<const Material::SharedPointer> materials,
+    std::span<const TextureRecord> textures) const noexcept
+{
+    auto source_hash_opt = hash_file(source_path);
+    if (not source_hash_opt) { return; }
+    const uint64_t key = compute_cache_key(source_path, *source_hash_opt);
+    std::unordered_map<const Geometry *, uint32_t> geometry_index_map;
+    std::vector<const Geometry *> geometries;
+    for (const auto & render_primitive : model.getRenderPrimitives()) {
+        auto [it, inserted] = geometry_index_map.try_emplace(&render_primitive.getGeometry(), static_cast<uint32_t>(geometries.size()));
+        if (inserted) { geometries.emplace_back(it->first); }
+    }
+    std::unordered_map<const Material *, uint32_t> material_index_map;
+    for (uint32_t i = 0; i < materials.size(); ++i) {
+        material_index_map.emplace(materials[i].get(), i);
+    }
+
+    sc::BufferWriter writer;
+    CacheHeader header;
+    header.m_magic = k_magic;
+    header.m_version = k_version;
+    header.m_source_hash = key;
+    header.m_dependency_count = static_cast<uint32_t>(dependency_paths.size());
+    header.m_geometry_count = static_cast<uint32_t>(geometries.size());
+    header.m_material_count = static_cast<uint32_t>(materials.size());
+    header.m_primitive_count = static_cast<uint32_t>(model.m_render_primitive_list.size());
+    header.m_node_count = static_cast<uint32_t>(model.m_hierarchy_node_list.size());
+    header.m_texture_count = static_cast<uint32_t>(textures.size());
+    write_record(writer, header);
+    for (const auto & dependency_path : dependency_paths) {
+        auto content_hash_opt = hash_dependency(dependency_path, source_path, *source_hash_opt);
+        if (not content_hash_opt) {
+            lcf_log_warn("Failed to hash model cache dependency: {}", dependency_path.string());
+            return;
+        }
+        auto path_str = dependency_path.string();
+        DependencyHeader dependency_header;
+        dependency_header.m_content_hash = *content_hash_opt;
+        dependency_header.m_path_size_in_bytes = static_cast<uint32_t>(path_str.size());
+        write_record(writer, dependency_header);
+        writer.writeBytes(as_bytes(path_str));
+    }
+    for (const auto * geometry_p : geometries) {
+        write_geometry(writer, *geometry_p);
+    }
+    for (const auto & material_sp : materials) {
+        write_material(writer, *material_sp);
+    }
+    for (const auto & render_primitive : model.getRenderPrimitives()) {
+        auto material_it = material_index_map.find(&render_primitive.getMaterial());
+        if (material_it == material_index_map.end()) { return; }
+        PrimitiveRecord record;
+        record.m_geometry_index = geometry_index_map.at(&render_primitive.getGeometry());
+        record.m_material_index = material_it->second;
+        write_record(writer, record);
+    }
+    for (const auto & hierarchy_node : model.m_hierarchy_node_list) {
+        NodeHeader node_header;
+        node_header.m_parent_index = hierarchy_node.m_parent_index;
+        node_header.m_primitive_index_count = hierarchy_node.m_primitive_indices.size();
+        std::ranges::copy_n(hierarchy_node.m_local_matrix.getData(), node_header.m_local_matrix.size(), node_header.m_local_matrix.begin());
+        write_record(writer, node_header);
+        for (size_t primitive_index : hierarchy_node.m_primitive_indices) {
+            writer.write(static_cast<uint64_t>(primitive_index));
+        }
+    }
+    for (const auto & texture_record : textures) {
+        auto path_str = texture_record.m_path.string();
+        TextureHeader texture_header;
+        texture_header.m_path_size_in_bytes = static_cast<uint32_t>(path_str.size());
+        texture_header.m_slot_count = static_cast<uint32_t>(texture_record.m_slots.size());
+        texture_header.m_embedded_width = texture_record.m_embedded_width;
+        texture_header.m_embedded_height = texture_record.m_embedded_height;
+        texture_header.m_embedded_size_in_bytes = texture_record.m_embedded_bytes.size();
+        write_record(writer, texture_header);
+        writer.writeBytes(as_bytes(path_str))
+            .writeBytes(texture_record.m_embedded_bytes);
+        for (const auto & [material_index, semantic] : texture_record.m_slots) {
+            write_record(writer, TextureSlotRecord {material_index, static_cast<uint32_t>(semantic)});
+        }
+    }
+
+    std::error_code ec;
+    stdfs::create_directories(ra::Config::instance().getCacheDirectory(), ec);
+    if (ec) { return; }
+    ec = write_file(make_cache_entry_path(key), as_bytes(writer.getBuffer()));
+    if (ec) { lcf_log_warn("Failed to write model cache for: {}, error: {}", source_path.string(), ec.message()); }
+}
+
+namespace {
+    template <typename Record>
+    void write_record(sc::BufferWriter & writer, const Record & record) noexcept
+    {
+        std::apply([&writer](const auto &... field) { (writer.write(field), ...); }, Record::fields(record));
+    }
+
+    template <typename Record>
+    bool read_record(sc::BufferReader & reader, Record & record) noexcept
+    {
+        return std::apply([&reader](auto &... field) { return (reader.read(field) and ...); }, Record::fields(record));
+    }
+
+    template <typename Record>
+    constexpr size_t get_record_size_in_bytes() noexcept
+    {
+        Record record {};
+        return std::apply([](const auto &... field) { return (sizeof(field) + ... + size_t {0}); }, Record::fields(record));
+    }
+
+    MappedFileSharedPointer map_file(const stdfs::path & path) noexcept
+    {
+        std::error_code ec;
+        if (not stdfs::is_regular_file(path, ec) or stdfs::file_size(path, ec) == 0) { return nullptr; }
+        try {
+            auto mapped_file_sp = std::make_shared<MappedFile>();
+            mapped_file_sp->m_mapping = bip::file_mapping(path.string().c_str(), bip::read_only);
+            mapped_file_sp->m_region = bip::mapped_region(mapped_file_sp->m_mapping, bip::read_only);
+            return mapped_file_sp;
+        } catch (const bip::interprocess_exception &) {
+            return nullptr;
+        }
+    }
+
+    std::optional<uint64_t> hash_file(const stdfs::path & path) noexcept
+    {
+        std::error_code ec;
+        if (not stdfs::is_regular_file(path, ec)) { return std::nullopt; }
+        if (stdfs::file_size(path, ec) == 0 and not ec) { return sc::hash(std::span<const std::byte> {}); } //- empty files cannot be mapped
+        auto mapped_file_sp = map_file(path);
+        if (not mapped_file_sp) { return std::nullopt; }
+        return sc::hash(mapped_file_sp->getBytes());
+    }
+
+    std::optional<uint64_t> hash_dependency(const stdfs::path & path, const stdfs::path & source_path, uint64_t source_hash) noexcept
+    {
+        std::error_code ec;
+        if (stdfs::equivalent(path, source_path, ec)) { return source_hash; } //- the importer always records the source itself
+        return hash_file(path);
+    }
+
+    uint64_t compute_cache_key(const stdfs::path & source_path, uint64_t source_hash) noexcept
+    {
+        auto path_str = stdfs::absolute(source_path).string();
+        const std::span<const std::byte> chunks[] = {
+            as_const_bytes_from_value(source_hash),
+            as_bytes(path_str), //- texture paths are stored resolved, so identical sources in different directories must not collide
+            as_const_bytes_from_value(k_version),
+        };
+        return sc::hash(chunks);
+    }
+
+    stdfs::path make_cache_entry_path(uint64_t key) noexcept
+    {
+        return ra::Config::instance().getCacheDirectory() / std::format("{:016x}{}", key, k_cache_ext);
+    }
+
+    std::optional<std::span<const std::byte>> read_view(sc::BufferReader & reader, std::span<const std::byte> data, size_t size_in_bytes) noexcept
+    {
+        size_t offset = reader.offset();
+        if (size_in_bytes > reader.remaining() or not reader.skip(size_in_bytes)) { return std::nullopt; }
+        return data.subspan(offset, size_in_bytes);
+    }
+
+    std::optional<std::string> read_string(sc::BufferReader & reader, size_t size_in_bytes) noexcept
+    {
+        if (size_in_bytes > reader.remaining()) { return std::nullopt; }
+        std::string str(size_in_bytes, '\0');
+        if (not reader.readBytes(as_bytes(str))) { return std::nullopt; }
+        return str;
+    }
+
+    bool has_room_for(const sc::BufferReader & reader, uint64_t count, size_t record_size_in_bytes) noexcept
+    {
+        return count <= reader.remaining() / record_size_in_bytes;
+    }
+
+    bool read_geometry(sc::BufferReader & reader, std::span<const std::byte> data, Geometry & geometry) noexcept
+    {
+        GeometryHeader geometry_header;
+        if (not read_record(reader, geometry_header)) { return false; }
+        uint32_t known_attribute_mask = 0;
+        for (auto attribute : enum_values_v<VertexAttribute>) { known_attribute_mask |= 1u << enum_decode::get_index(attribute); }
+        if (geometry_header.m_attribute_mask & ~known_attribute_mask) { return false; }
+        geometry.resize(geometry_header.m_vertex_count);
+        for (auto attribute : enum_values_v<VertexAttribute>) {
+            if (not (geometry_header.m_attribute_mask & (1u << enum_decode::get_index(attribute)))) { continue; }
+            size_t size_in_bytes = size_t(geometry_header.m_vertex_count) * enum_decode::get_size_in_bytes(enum_decode::get_vector_type(attribute));
+            auto attribute_bytes_opt = read_view(reader, data, size_in_bytes);
+            if (not attribute_bytes_opt) { return false; }
+            geometry.setRawAttributes(attribute, *attribute_bytes_opt);
+        }
+        if (not has_room_for(reader, geometry_header.m_index_count, sizeof(uint32_t))) { return false; }
+        Geometry::IndexList indices(geometry_header.m_index_count);
+        if (not reader.readBytes(as_bytes(indices))) { return false; }
+        if (std::ranges::any_of(indices, [&geometry_header](uint32_t index) { return index >= geometry_header.m_vertex_count; })) { return false; }
+        geometry.setIndices(std::move(indices));
+        if (not has_room_for(reader, geometry_header.m_face_count, sizeof(uint32_t) * 2)) { return false; }
+        for (uint32_t i = 0; i < geometry_header.m_face_count; ++i) {
+            uint32_t face[2];
+            if (not reader.read(face)) { return false; }
+            if (uint64_t(face[0]) + face[1] > geometry_header.m_index_count) { return false; }
+            geometry.addFace({face[0], face[1]});
+        }
+        const auto & [center_x, center_y, center_z, radius] = geometry_header.m_bounding_sphere;
+        geometry.setBoundingSphere(BoundingSphere<float> {{center_x, center_y, center_z}, radius});
+        return true;
+    }
+
+    void write_geometry(sc::BufferWriter & writer, const Geometry & geometry) noexcept
+    {
+        GeometryHeader geometry_header;
+        geometry_header.m_vertex_count = geometry.getVertexCount();
+        geometry_header.m_index_count = geometry.getIndexCount();
+        geometry_header.m_face_count = static_cast<uint32_t>(geometry.getFaces().size());
+        const auto & bounding_sphere = geometry.getBoundingSphere();
+        const auto & center = bounding_sphere.getCenter();
+        geometry_header.m_bounding_sphere = {center.getX(), center.getY(), center.getZ(), bounding_sphere.getRadius()};
+        for (auto attribute : enum_values_v<VertexAttribute>) {
+            if (geometry.getRawAttributes(attribute).empty()) { continue; }
+            geometry_header.m_attribute_mask |= 1u << enum_decode::get_index(attribute);
+        }
+        write_record(writer, geometry_header);
+        for (auto attribute : enum_values_v<VertexAttribute>) {
+            writer.writeBytes(geometry.getRawAttributes(attribute));
+        }
+        writer.writeBytes(as_const_bytes(geometry.getIndices()));
+        for (const auto & [index_offset, index_count] : geometry.getFaces()) {
+            const uint32_t face[2] = {index_offset, index_count};
+            writer.write(face);
+        }
+    }
+
+    bool read_material(sc::BufferReader & reader, Material & material) noexcept
+    {
+        uint32_t param_count = 0;
+        if (not reader.read(param_count)) { return false; }
+        for (uint32_t i = 0; i < param_count; ++i) {
+            MaterialParamRecord record;
+            if (not read_record(reader, record)) { return false; }
+            auto property = static_cast<MaterialProperty>(record.m_property);
+            if (not std::ranges::contains(enum_values_v<MaterialProperty>, property)) { return false; }
+            material.setParam(property, Vector4D<float> {record.m_value[0], record.m_value[1], record.m_value[2], record.m_value[3]});
+        }
+        return true;
+    }
+
+    void write_material(sc::BufferWriter & writer, const Material & material) noexcept
+    {
+        auto properties = enum_values_v<MaterialProperty> | std::views::filter([&material](auto property) {
+            return material.hasParam(property);
+        });
+        writer.write(static_cast<uint32_t>(std::ranges::distance(properties)));
+        for (auto property : properties) {
+            MaterialParamRecord record;
+            record.m_property = std::to_underlying(property);
+            std::ranges::copy(as_bytes_from_variant(material.getMaterialParam(property)), as_bytes_from_value(record.m_value).begin());
+            write_record(writer, record);
+        }
+    }
+}
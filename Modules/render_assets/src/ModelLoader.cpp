@@ -1,18 +1,25 @@
 #include "render_assets/ModelLoader.h"
+#include "render_assets/ModelCache.h"
 #include "render_assets/Texture2D.h"
+#include "render_assets/GeometryOptimization.h"
 #include "render_assets/configs/config.h"
 #include "enums/enum_cast.h"
 #include "log.h"
 #include "bytes.h"
+#include "file_utils.h"
 #include "string_view_hash.h"
 #include "Transform.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
+#include <assimp/DefaultIOSystem.h>
+#include <taskflow/taskflow.hpp>
 #include <expected>
 #include <system_error>
 #include <unordered_map>
 #include <queue>
+#include <deque>
+#include <mutex>
 #include <algorithm>
 
 using namespace lcf;
@@ -47,9 +54,45 @@ struct enum_mapping_traits<TextureSemantic, aiTextureType>
 
 using AssimpHierarchyNode = std::pair<size_t, const aiNode *>;
 
+class RecordingIOSystem : public Assimp::DefaultIOSystem //- records every file the importer opens so cached models can be invalidated by their dependencies
+{
+public:
+    Assimp::IOStream * Open(const char * file_path, const char * mode = "rb") override
+    {
+        auto stream_p = Assimp::DefaultIOSystem::Open(file_path, mode);
+        if (stream_p and not stdr::contains(m_opened_paths, std::filesystem::path(file_path))) {
+            m_opened_paths.emplace_back(file_path);
+        }
+        return stream_p;
+    }
+    void clearOpenedPaths() noexcept { m_opened_paths.clear(); }
+    std::span<const std::filesystem::path> getOpenedPaths() const noexcept { return m_opened_paths; }
+private:
+    std::vector<std::filesystem::path> m_opened_paths;
+};
+
+struct TextureDecodeJob
+{
+    std::filesystem::path m_path;
+    std::span<const std::byte> m_embedded_bytes; //- empty for external files
+    uint32_t m_embedded_width = 0;
+    uint32_t m_embedded_height = 0;
+    std::shared_ptr<const void> m_storage_sp; //- keeps m_embedded_bytes alive, a cache mapping or the scene orphaned from the importer
+    size_t m_estimated_size_in_bytes = 0; //- external files start at their encoded size and grow once the decode task probes the header
+    std::promise<Texture2D::SharedPointer> m_promise;
+};
+
+using TextureDecodeJobSharedPointer = std::shared_ptr<TextureDecodeJob>;
+
 static Matrix4x4<float> to_matrix4x4(const aiMatrix4x4 & ai_mat) noexcept;
 
-static std::expected<Texture2D, std::error_code> to_texture2d(const aiTexture & ai_texture);
+static std::expected<Texture2D, std::error_code> to_texture2d(std::span<const std::byte> data, uint32_t width, uint32_t height);
+
+static TextureDecodeJobSharedPointer make_texture_decode_job(
+    const ModelCache::TextureRecord & texture_record,
+    const std::shared_ptr<const void> & storage_sp);
+
+static size_t get_decoded_size_in_bytes(const ImageInfo & info) noexcept;
 
 static Model::HierarchyNode to_hierarchy_node(const AssimpHierarchyNode & ai_hierarchy_node);
 
@@ -64,26 +107,47 @@ constexpr std::string_view ai_material_param_key(const char * key, int, int) noe
 
 struct ModelLoader::Impl
 {
-    Impl() = default;
+    Impl() :
+        m_io_system_p(new RecordingIOSystem)
+    {
+        m_importer.SetIOHandler(m_io_system_p); //- the importer takes ownership
+    }
     ~Impl() = default;
     Impl(const Impl &) = delete;
     Impl &operator=(const Impl &) = delete;
     Impl(Impl &&) = delete;
     Impl &operator=(Impl &&) = delete;
 
-    std::optional<Model> load(const std::filesystem::path & path) noexcept;
+    std::optional<StreamingModel> load(const std::filesystem::path & path) noexcept;
     std::expected<Model, std::error_code> analyze(const std::filesystem::path & path) noexcept;
-    void loadTextures() noexcept;
+    ModelCache::TextureRecordList collectTextureRecords() const noexcept;
+    PendingTextureList dispatchTextureDecodes(
+        std::span<const ModelCache::TextureRecord> texture_records,
+        std::span<const Material::SharedPointer> materials,
+        const std::shared_ptr<const void> & storage_sp) noexcept;
+    void pumpTextureDecodes() noexcept;
+    Texture2D::SharedPointer decodeTexture(TextureDecodeJob & job) noexcept;
+    void chargeDecodeBytes(TextureDecodeJob & job, size_t size_in_bytes) noexcept;
     void processGeometries(Model & model) noexcept;
     void processMaterials(Model & model) noexcept;
     void buildModel(Model & model) noexcept;
 
     Assimp::Importer m_importer;
+    RecordingIOSystem * m_io_system_p = nullptr;
     const aiScene * m_ai_scene_p = nullptr;
     std::filesystem::path m_asset_directory_path;
     
     std::vector<Geometry::SharedPointer> m_geometry_resource_list;
     std::vector<Material::SharedPointer> m_material_resource_list;
+
+    ModelCache m_cache;
+    bool m_is_cache_enabled = false; //- opt in, so a load never writes next to the working directory unasked
+
+    std::mutex m_decode_mutex;
+    std::deque<TextureDecodeJobSharedPointer> m_decode_job_queue;
+    size_t m_decode_budget_in_bytes = c_default_decode_budget_in_bytes;
+    size_t m_in_flight_decode_bytes = 0;
+    tf::Executor m_executor; //- must stay the last member: its destructor joins decode tasks that still use the queue and the budget
 };
 
 ModelLoader::ModelLoader() :
@@ -95,24 +159,74 @@ ModelLoader::~ModelLoader()
 {
 }
 
+ModelLoader & ModelLoader::setDecodeBudget(size_t budget_in_bytes) noexcept
+{
+    std::lock_guard lock {m_impl_up->m_decode_mutex};
+    m_impl_up->m_decode_budget_in_bytes = budget_in_bytes;
+    return *this;
+}
+
+ModelLoader & ModelLoader::setCacheEnabled(bool enabled) noexcept
+{
+    m_impl_up->m_is_cache_enabled = enabled;
+    return *this;
+}
+
 std::optional<Model> ModelLoader::load(const std::filesystem::path &path) const noexcept
+{
+    auto streaming_model_opt = this->loadStreaming(path);
+    if (not streaming_model_opt) { return std::nullopt; }
+    for (const auto & pending_texture : streaming_model_opt->m_pending_textures) {
+        pending_texture.bind();
+    }
+    return std::move(streaming_model_opt->m_model);
+}
+
+std::optional<ModelLoader::StreamingModel> ModelLoader::loadStreaming(const std::filesystem::path &path) const noexcept
 {
     auto resolved_path = ra::Config::instance().resolvePath(path);
     return m_impl_up->load(resolved_path);
 }
 
-std::optional<Model> ModelLoader::Impl::load(const std::filesystem::path &path) noexcept
+bool ModelLoader::PendingTexture::isReady() const noexcept
 {
+    return m_texture_future.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+}
+
+bool ModelLoader::PendingTexture::bind() const noexcept
+{
+    const auto & texture_sp = m_texture_future.get();
+    if (not texture_sp) { return false; }
+    for (const auto & [material_sp, semantic] : m_bindings) {
+        material_sp->setTextureResource(semantic, texture_sp);
+    }
+    return true;
+}
+
+std::optional<ModelLoader::StreamingModel> ModelLoader::Impl::load(const std::filesystem::path &path) noexcept
+{
+    if (m_is_cache_enabled) {
+        if (auto entry_opt = m_cache.tryLoad(path)) {
+            auto pending_textures = this->dispatchTextureDecodes(entry_opt->m_textures, entry_opt->m_materials, entry_opt->m_storage_sp);
+            return StreamingModel {std::move(entry_opt->m_model), std::move(pending_textures)};
+        }
+    }
     auto expected_model = this->analyze(path);
     if (not expected_model) {
         lcf_log_error("Failed to analyze model: {}", expected_model.error().message());
         return std::nullopt;
     }
     auto & model = expected_model.value();
+    //- the scene leaves the importer so the next load can read another one, the decode jobs keep it alive for its embedded textures
+    std::shared_ptr<const aiScene> ai_scene_sp {m_importer.GetOrphanedScene()};
+    auto texture_records = this->collectTextureRecords();
+    auto pending_textures = this->dispatchTextureDecodes(texture_records, m_material_resource_list, ai_scene_sp);
     this->processGeometries(model);
-    this->loadTextures();
     this->processMaterials(model);
-    return std::move(model);
+    if (m_is_cache_enabled) {
+        m_cache.store(path, m_io_system_p->getOpenedPaths(), model, m_material_resource_list, texture_records);
+    }
+    return StreamingModel {std::move(model), std::move(pending_textures)};
 }
 
 std::expected<Model, std::error_code> ModelLoader::Impl::analyze(const std::filesystem::path &path) noexcept
@@ -123,6 +237,7 @@ std::expected<Model, std::error_code> ModelLoader::Impl::analyze(const std::file
     if (not std::filesystem::is_regular_file(path)) {
         return std::unexpected(std::make_error_code(std::errc::is_a_directory));
     }
+    m_io_system_p->clearOpenedPaths();
     const aiScene * ai_scene = m_importer.ReadFile(
         path.string().c_str(),
         aiProcess_Triangulate |
@@ -143,42 +258,119 @@ std::expected<Model, std::error_code> ModelLoader::Impl::analyze(const std::file
     return model;
 }
 
-void ModelLoader::Impl::loadTextures() noexcept
+ModelCache::TextureRecordList ModelLoader::Impl::collectTextureRecords() const noexcept
 {
-    std::unordered_map<std::string, Texture2D::SharedPointer> texture_resource_map;
+    std::unordered_map<std::string, size_t> texture_record_index_map;
+    ModelCache::TextureRecordList texture_records;
     for (uint32_t i = 0; i < m_ai_scene_p->mNumMaterials; ++i) {
         const aiMaterial & ai_material = *m_ai_scene_p->mMaterials[i];
-        Material & material = *m_material_resource_list[i];
         for (auto texture_semantic : enum_values_v<TextureSemantic>) {
             aiString ai_path_str;
             auto result = ai_material.GetTexture(enum_cast<aiTextureType>(texture_semantic), 0, &ai_path_str);
             if (result != AI_SUCCESS) { continue; } //- this type of texture is not present in the material
             std::filesystem::path texture_path = m_asset_directory_path / ai_path_str.C_Str();
-            if (texture_resource_map.contains(texture_path.string())) {
-                material.setTextureResource(texture_semantic, texture_resource_map[texture_path.string()]);
-                continue;
-            }
-            auto texture_sp = Texture2D::makeShared();
-            const aiTexture * ai_texture_p = m_ai_scene_p->GetEmbeddedTexture(ai_path_str.C_Str());
-            std::error_code error_code;
-            if (ai_texture_p) {
-                auto expected = to_texture2d(*ai_texture_p);
-                if (not expected) { error_code = expected.error(); }
-                else {
-                    texture_sp = Texture2D::makeShared(std::move(*expected));
-                    error_code = texture_sp->convertToGpuFriendly();
+            auto [it, inserted] = texture_record_index_map.try_emplace(texture_path.string(), texture_records.size());
+            if (inserted) {
+                auto & texture_record = texture_records.emplace_back();
+                texture_record.m_path = texture_path;
+                if (const aiTexture * ai_texture_p = m_ai_scene_p->GetEmbeddedTexture(ai_path_str.C_Str())) {
+                    bool is_compressed = (ai_texture_p->mHeight == 0);
+                    size_t size_in_bytes = is_compressed ? ai_texture_p->mWidth : size_t(ai_texture_p->mWidth) * ai_texture_p->mHeight * sizeof(aiTexel);
+                    texture_record.m_embedded_bytes = std::span(reinterpret_cast<const std::byte *>(ai_texture_p->pcData), size_in_bytes);
+                    texture_record.m_embedded_width = is_compressed ? 0 : ai_texture_p->mWidth;
+                    texture_record.m_embedded_height = ai_texture_p->mHeight;
                 }
-            } else {
-                error_code = texture_sp->loadFromFileGpuFriendly(texture_path);
             }
-            if (error_code) {
-                lcf_log_error("Failed to load texture at: {}, error: {}", texture_path.string(), error_code.message());
-                continue;
+            texture_records[it->second].m_slots.push_back({i, texture_semantic});
+        }
+    }
+    return texture_records;
+}
+
+ModelLoader::PendingTextureList ModelLoader::Impl::dispatchTextureDecodes(
+    std::span<const ModelCache::TextureRecord> texture_records,
+    std::span<const Material::SharedPointer> materials,
+    const std::shared_ptr<const void> & storage_sp) noexcept
+{
+    PendingTextureList pending_textures;
+    pending_textures.reserve(texture_records.size());
+    std::vector<TextureDecodeJobSharedPointer> decode_jobs;
+    decode_jobs.reserve(texture_records.size());
+    for (const auto & texture_record : texture_records) {
+        auto job_sp = make_texture_decode_job(texture_record, storage_sp);
+        auto & pending_texture = pending_textures.emplace_back();
+        pending_texture.m_path = texture_record.m_path;
+        pending_texture.m_texture_future = job_sp->m_promise.get_future().share();
+        for (const auto & [material_index, semantic] : texture_record.m_slots) {
+            pending_texture.m_bindings.push_back({materials[material_index], semantic});
+        }
+        decode_jobs.emplace_back(std::move(job_sp));
+    }
+    {
+        std::lock_guard lock {m_decode_mutex};
+        m_decode_job_queue.append_range(std::move(decode_jobs));
+    }
+    this->pumpTextureDecodes();
+    return pending_textures;
+}
+
+void ModelLoader::Impl::pumpTextureDecodes() noexcept
+{
+    std::lock_guard lock {m_decode_mutex};
+    while (not m_decode_job_queue.empty()) {
+        auto & job_sp = m_decode_job_queue.front();
+        bool is_idle = m_in_flight_decode_bytes == 0;
+        if (not is_idle and m_in_flight_decode_bytes + job_sp->m_estimated_size_in_bytes > m_decode_budget_in_bytes) { break; }
+        m_in_flight_decode_bytes += job_sp->m_estimated_size_in_bytes;
+        m_executor.silent_async([this, job_sp = std::move(job_sp)] {
+            job_sp->m_promise.set_value(this->decodeTexture(*job_sp));
+            {
+                std::lock_guard lock {m_decode_mutex};
+                m_in_flight_decode_bytes -= job_sp->m_estimated_size_in_bytes;
             }
-            texture_resource_map[texture_path.string()] = texture_sp;
-            material.setTextureResource(texture_semantic, texture_sp);
+            this->pumpTextureDecodes();
+        });
+        m_decode_job_queue.pop_front();
+    }
+}
+
+Texture2D::SharedPointer ModelLoader::Impl::decodeTexture(TextureDecodeJob & job) noexcept
+{
+    auto texture_sp = Texture2D::makeShared();
+    std::error_code error_code;
+    if (not job.m_embedded_bytes.empty()) {
+        auto expected = to_texture2d(job.m_embedded_bytes, job.m_embedded_width, job.m_embedded_height);
+        if (not expected) { error_code = expected.error(); }
+        else {
+            texture_sp = Texture2D::makeShared(std::move(*expected));
+            error_code = texture_sp->convertToGpuFriendly();
+        }
+    } else if (auto expected_bytes = read_file_as_bytes(job.m_path); not expected_bytes) {
+        error_code = expected_bytes.error();
+    } else { //- read once on this worker, probed and decoded from the same buffer
+        const auto & encoded_bytes = expected_bytes.value();
+        ImageInfo info {job.m_path, encoded_bytes};
+        this->chargeDecodeBytes(job, get_decoded_size_in_bytes(info));
+        if (info.getEncodeFormat() == ImageFormat::eInvalid) { //- stb could not probe it, the gil fallback sets the format from the decoded pixels
+            error_code = texture_sp->loadFromMemoryEncoded(encoded_bytes);
+            if (not error_code) { error_code = texture_sp->convertToGpuFriendly(); }
+        } else {
+            error_code = texture_sp->loadFromMemoryEncoded(encoded_bytes, enum_decode::decode_gpu_friendly(info.getEncodeFormat()));
         }
     }
+    if (error_code) {
+        lcf_log_error("Failed to load texture at: {}, error: {}", job.m_path.string(), error_code.message());
+        return nullptr;
+    }
+    return texture_sp;
+}
+
+void ModelLoader::Impl::chargeDecodeBytes(TextureDecodeJob & job, size_t size_in_bytes) noexcept
+{
+    std::lock_guard lock {m_decode_mutex};
+    if (size_in_bytes <= job.m_estimated_size_in_bytes) { return; }
+    m_in_flight_decode_bytes += size_in_bytes - job.m_estimated_size_in_bytes;
+    job.m_estimated_size_in_bytes = size_in_bytes;
 }
 
 void ModelLoader::Impl::processGeometries(Model &model) noexcept
@@ -256,6 +448,7 @@ void process_mesh(Geometry & geometry, const aiMesh & ai_mesh)
         .setAttributes<VertexAttribute::ePosition>(std::span(ai_mesh.mVertices, vertex_num))
         .setAttributes<VertexAttribute::eNormal>(std::span(ai_mesh.mNormals, vertex_num))
         .setAttributes<VertexAttribute::eTangent>(std::span(ai_mesh.mTangents, vertex_num));
+    geometry.setBoundingSphere(BoundingSphere<float> {geometry.getAttributes<VertexAttribute::ePosition>()});
     for (auto i : {0, 1}) {
         if (not ai_mesh.HasTextureCoords(i)) { break; }
         auto span = std::span(ai_mesh.mTextureCoords[0], vertex_num);
@@ -263,6 +456,7 @@ void process_mesh(Geometry & geometry, const aiMesh & ai_mesh)
             geometry.setAttribute<VertexAttribute::eTexCoord0>(i, {ai_texture_coord.x, ai_texture_coord.y});
         }
     }
+    optimize_geometry(geometry); //- point and line meshes are left in import order
 }
 
 void process_material(Material & material, const aiMaterial & ai_material)
@@ -315,20 +509,45 @@ Matrix4x4<float> to_matrix4x4(const aiMatrix4x4 & ai_mat) noexcept
     };
 }
 
-std::expected<Texture2D, std::error_code> to_texture2d(const aiTexture &ai_texture)
+std::expected<Texture2D, std::error_code> to_texture2d(std::span<const std::byte> data, uint32_t width, uint32_t height)
 {
     Texture2D texture;
-    uint32_t width = ai_texture.mWidth;
-    uint32_t height = ai_texture.mHeight;
     bool is_compressed = (height == 0);
-    size_t size_in_bytes = is_compressed ? width : width * height * sizeof(aiTexel);
-    auto data_span = std::span(reinterpret_cast<const std::byte *>(ai_texture.pcData), size_in_bytes);
     std::error_code error_code;
     if (is_compressed) {
-        error_code = texture.loadFromMemoryEncoded(data_span);
+        error_code = texture.loadFromMemoryEncoded(data);
     } else {
-        error_code = texture.loadFromMemoryPixels(data_span, width, ImageFormat::eRGBA8Uint);
+        error_code = texture.loadFromMemoryPixels(data, width, ImageFormat::eRGBA8Uint);
     }
     if (error_code) { return std::unexpected(error_code); }
     return texture;
 }
+
+TextureDecodeJobSharedPointer make_texture_decode_job(
+    const ModelCache::TextureRecord & texture_record,
+    const std::shared_ptr<const void> & storage_sp)
+{
+    const auto & path = texture_record.m_path;
+    auto job_sp = std::make_shared<TextureDecodeJob>();
+    job_sp->m_path = path;
+    if (texture_record.isEmbedded()) {
+        job_sp->m_embedded_bytes = texture_record.m_embedded_bytes;
+        job_sp->m_embedded_width = texture_record.m_embedded_width;
+        job_sp->m_embedded_height = texture_record.m_embedded_height;
+        job_sp->m_storage_sp = storage_sp;
+        job_sp->m_estimated_size_in_bytes = texture_record.m_embedded_bytes.size();
+        return job_sp;
+    }
+    std::error_code error_code;
+    auto file_size = std::filesystem::file_size(path, error_code); //- only a stat, the read happens in the decode task
+    job_sp->m_estimated_size_in_bytes = error_code ? 0 : static_cast<size_t>(file_size);
+    return job_sp;
+}
+
+size_t get_decoded_size_in_bytes(const ImageInfo & info) noexcept
+{
+    if (info.getEncodeFormat() == ImageFormat::eInvalid) { return 0; }
+    auto gpu_friendly_format = enum_decode::decode_gpu_friendly(info.getEncodeFormat());
+    return size_t(info.getWidth()) * info.getHeight() *
+        enum_decode::get_channel_count(gpu_friendly_format) * enum_decode::get_bytes_per_channel(gpu_friendly_format);
+}
@@ -0,0 +1,196 @@
+#include "render_assets/VertexEncoding.h"
+#include "render_assets/Geometry.h"
+#include "float16_convert.h"
+#include "bytes.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace lcf;
+
+namespace {
+    constexpr float k_unorm16_max = 65535.0f;
+    constexpr float k_snorm16_max = 32767.0f;
+    constexpr uint8_t k_index_codec_version = 1;
+}
+
+//- auxiliary function forward declarations begin
+uint16_t to_snorm16(float value) noexcept;
+
+float from_snorm16(uint16_t value) noexcept;
+
+uint32_t encode_octahedral_at(std::span<const float> vectors, size_t index) noexcept;
+
+void append_varint(std::vector<uint8_t> & bytes, uint64_t value) noexcept;
+
+bool read_varint(std::span<const uint8_t> bytes, size_t & offset, uint64_t & value) noexcept;
+//- auxiliary function forward declarations end
+
+BufferWriteSegments QuantizedVertexData::generateVertexBufferSegments() const noexcept
+{
+    BufferWriteSegments segments;
+    segments.add(as_bytes_from_value(m_decode_info), 0);
+    if (not m_vertices.empty()) { segments.add(as_bytes(m_vertices), sizeof(VertexDecodeInfo)); }
+    return segments;
+}
+
+QuantizedVertexData lcf::quantize_vertices(const Geometry & geometry) noexcept
+{
+    QuantizedVertexData data;
+    const size_t vertex_count = geometry.getVertexCount();
+    data.m_vertices.resize(vertex_count);
+    auto positions = geometry.getBasicAttributes<VertexAttribute::ePosition>();
+    if (positions.size() >= vertex_count * 3) {
+        std::array<float, 3> min_corner, max_corner;
+        min_corner.fill(std::numeric_limits<float>::max());
+        max_corner.fill(std::numeric_limits<float>::lowest());
+        for (size_t i = 0; i < vertex_count * 3; ++i) {
+            min_corner[i % 3] = std::min(min_corner[i % 3], positions[i]);
+            max_corner[i % 3] = std::max(max_corner[i % 3], positions[i]);
+        }
+        std::array<float, 3> inverse_extent {};
+        for (size_t axis = 0; axis < 3 and vertex_count > 0; ++axis) {
+            float extent = max_corner[axis] - min_corner[axis];
+            data.m_decode_info.m_position_offset[axis] = min_corner[axis];
+            data.m_decode_info.m_position_scale[axis] = extent / k_unorm16_max;
+            inverse_extent[axis] = extent > 0.0f ? k_unorm16_max / extent : 0.0f; //- a flat axis decodes to the offset
+        }
+        for (size_t i = 0; i < vertex_count; ++i) {
+            for (size_t axis = 0; axis < 3; ++axis) {
+                float unorm = (positions[i * 3 + axis] - min_corner[axis]) * inverse_extent[axis];
+                data.m_vertices[i].m_position[axis] = static_cast<uint16_t>(std::clamp(std::lround(unorm), 0l, 65535l));
+            }
+        }
+    }
+    auto normals = geometry.getBasicAttributes<VertexAttribute::eNormal>();
+    if (normals.size() >= vertex_count * 3) {
+        for (size_t i = 0; i < vertex_count; ++i) { data.m_vertices[i].m_normal = encode_octahedral_at(normals, i); }
+    }
+    auto tangents = geometry.getBasicAttributes<VertexAttribute::eTangent>();
+    if (tangents.size() >= vertex_count * 3) {
+        for (size_t i = 0; i < vertex_count; ++i) { data.m_vertices[i].m_tangent = encode_octahedral_at(tangents, i); }
+    }
+    auto uvs = geometry.getBasicAttributes<VertexAttribute::eTexCoord0>();
+    if (uvs.size() >= vertex_count * 2) {
+        std::vector<float16_t> half_uvs(vertex_count * 2);
+        convert_f32_to_f16(uvs.first(vertex_count * 2), half_uvs);
+        for (size_t i = 0; i < vertex_count; ++i) {
+            auto u = std::bit_cast<uint16_t>(half_uvs[i * 2]);
+            auto v = std::bit_cast<uint16_t>(half_uvs[i * 2 + 1]);
+            data.m_vertices[i].m_uv = uint32_t(u) | (uint32_t(v) << 16);
+        }
+    }
+    return data;
+}
+
+uint32_t lcf::encode_octahedral(float x, float y, float z) noexcept
+{
+    //- project onto the octahedron |x| + |y| + |z| = 1, then fold the lower half over the diagonals
+    float inverse_l1 = 1.0f / (std::abs(x) + std::abs(y) + std::abs(z));
+    float u = x * inverse_l1, v = y * inverse_l1;
+    if (z < 0.0f) {
+        float folded_u = (1.0f - std::abs(v)) * (u >= 0.0f ? 1.0f : -1.0f);
+        float folded_v = (1.0f - std::abs(u)) * (v >= 0.0f ? 1.0f : -1.0f);
+        u = folded_u;
+        v = folded_v;
+    }
+    return uint32_t(to_snorm16(u)) | (uint32_t(to_snorm16(v)) << 16);
+}
+
+std::array<float, 3> lcf::decode_octahedral(uint32_t encoded) noexcept
+{
+    float x = from_snorm16(static_cast<uint16_t>(encoded)), y = from_snorm16(static_cast<uint16_t>(encoded >> 16));
+    float z = 1.0f - std::abs(x) - std::abs(y);
+    float t = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -t : t;
+    y += y >= 0.0f ? -t : t;
+    float inverse_length = 1.0f / std::sqrt(x * x + y * y + z * z);
+    return {x * inverse_length, y * inverse_length, z * inverse_length};
+}
+
+std::vector<uint8_t> lcf::encode_index_buffer(std::span<const uint32_t> indices) noexcept
+{
+    std::vector<uint8_t> bytes;
+    bytes.reserve(indices.size() + indices.size() / 2 + 1);
+    bytes.push_back(k_index_codec_version);
+    uint32_t next_vertex = 0, previous_index = 0;
+    for (uint32_t index : indices) {
+        if (index == next_vertex) { //- the common case once vertices are ordered by first use
+            bytes.push_back(0);
+            ++next_vertex;
+        } else {
+            auto delta = static_cast<int32_t>(index - previous_index);
+            uint32_t zigzag = (static_cast<uint32_t>(delta) << 1) ^ static_cast<uint32_t>(delta >> 31);
+            append_varint(bytes, uint64_t(zigzag) + 1); //- 0 is taken by the next vertex code, a full 32 bit jump needs 33 bits
+            next_vertex = std::max(next_vertex, index + 1);
+        }
+        previous_index = index;
+    }
+    return bytes;
+}
+
+std::expected<std::vector<uint32_t>, std::error_code> lcf::decode_index_buffer(std::span<const uint8_t> encoded, size_t index_count) noexcept
+{
+    if (encoded.empty() or encoded[0] != k_index_codec_version) { return std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence)); }
+    //- every index takes at least one byte, so a count the stream cannot hold is rejected before allocating for it
+    if (index_count > encoded.size() - 1) { return std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence)); }
+    std::vector<uint32_t> indices(index_count);
+    uint32_t next_vertex = 0, previous_index = 0;
+    size_t offset = 1;
+    for (auto & index : indices) {
+        uint64_t code = 0;
+        if (not read_varint(encoded, offset, code) or code > uint64_t(std::numeric_limits<uint32_t>::max()) + 1) {
+            return std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence));
+        }
+        if (code == 0) {
+            index = next_vertex++;
+        } else {
+            auto zigzag = static_cast<uint32_t>(code - 1);
+            auto delta = static_cast<int32_t>((zigzag >> 1) ^ (0u - (zigzag & 1)));
+            index = previous_index + static_cast<uint32_t>(delta);
+            next_vertex = std::max(next_vertex, index + 1);
+        }
+        previous_index = index;
+    }
+    return indices;
+}
+
+//- auxiliary function implementations begin
+uint16_t to_snorm16(float value) noexcept
+{
+    return static_cast<uint16_t>(static_cast<int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * k_snorm16_max)));
+}
+
+float from_snorm16(uint16_t value) noexcept
+{
+    return std::max(static_cast<int16_t>(value) / k_snorm16_max, -1.0f);
+}
+
+uint32_t encode_octahedral_at(std::span<const float> vectors, size_t index) noexcept
+{
+    float x = vectors[index * 3], y = vectors[index * 3 + 1], z = vectors[index * 3 + 2];
+    if (x == 0.0f and y == 0.0f and z == 0.0f) { return 0; } //- degenerate input decodes to +z
+    return encode_octahedral(x, y, z);
+}
+
+void append_varint(std::vector<uint8_t> & bytes, uint64_t value) noexcept
+{
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+bool read_varint(std::span<const uint8_t> bytes, size_t & offset, uint64_t & value) noexcept
+{
+    value = 0;
+    for (uint32_t shift = 0; shift < 35; shift += 7) {
+        if (offset >= bytes.size()) { return false; }
+        uint8_t byte = bytes[offset++];
+        value |= uint64_t(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) { return true; }
+    }
+    return false;
+}
+//- auxiliary function implementations end
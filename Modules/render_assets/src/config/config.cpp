@@ -18,4 +18,10 @@ auto Config::registerVirtualPath(std::string virtual_alias, std::filesystem::pat
 std::filesystem::path Config::resolvePath(const std::filesystem::path &path) const noexcept
 {
     return VirtualPathRegistry::instance().resolve(path);
+}
+
+auto Config::setCacheDirectory(const std::filesystem::path & cache_directory) noexcept -> Self &
+{
+    m_cache_directory = cache_directory;
+    return *this;
 }
\ No newline at end of file
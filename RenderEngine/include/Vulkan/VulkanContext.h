@@ -30,6 +30,8 @@ namespace lcf::render {
         const vk::Instance & getInstance() const noexcept { return m_instance.get(); }
         const vk::PhysicalDevice & getPhysicalDevice() const noexcept { return m_physical_device; }
         const vk::Device & getDevice() const noexcept { return m_device.get(); }
+        const vk::PhysicalDeviceFeatures & getEnabledFeatures() const noexcept { return m_enabled_features; }
+        bool isFormatSampleable(vk::Format format) const noexcept; //- enabled on the device and sampleable with optimal tiling
         uint32_t getQueueFamilyIndex(vk::QueueFlagBits type) const noexcept;
         const vk::Queue & getQueue(vk::QueueFlagBits type) const noexcept;
         std::span<const vk::Queue> getSubQueues(vk::QueueFlagBits type) const noexcept;
@@ -47,6 +49,7 @@ namespace lcf::render {
         vk::UniqueInstance m_instance;
         vk::PhysicalDevice m_physical_device;
         vk::UniqueDevice m_device;
+        vk::PhysicalDeviceFeatures m_enabled_features;
         SurfaceRenderTargetList m_surface_render_targets;
         QueueFamilyIndexMap m_queue_family_indices;
         QueueListMap m_queue_lists;
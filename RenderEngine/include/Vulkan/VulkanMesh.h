@@ -15,6 +15,9 @@ namespace lcf::render {
             VulkanCommandBufferObject & cmd,
             const BufferWriteSegments & vertex_data_segments, 
             std::span<const uint32_t> indices);
+        //- packs the geometry with quantize_vertices, shaders read it through include/vertex_decode.glsl
+        std::error_code createQuantized(VulkanContext * context_p, VulkanCommandBufferObject & cmd, const Geometry & geometry);
+        bool isQuantized() const noexcept { return m_is_quantized; }
         const vk::DeviceAddress & getVertexBufferAddress() const noexcept { return m_vertex_buffer.getDeviceAddress(); }
         const vk::DeviceAddress & getIndexBufferAddress() const noexcept { return m_index_buffer.getDeviceAddress(); }
         uint32_t getVertexCount() const noexcept { return m_vertex_count; }
@@ -28,5 +31,6 @@ namespace lcf::render {
         uint32_t m_index_count;
         std::vector<uint32_t> m_indices;
         BoundingSphere<float> m_bounding_sphere;
+        bool m_is_quantized = false;
     };
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #include "memory/VulkanBufferObjectGroup.h"
 #include "VulkanMesh.h"
 #include "VulkanSampler.h"
+#include "VulkanTextureManager.h"
 #include "ds/VulkanDescriptorSet.h"
 #include <unordered_map>
 
@@ -27,6 +28,8 @@ namespace ecf {
         VulkanRenderer(const VulkanRenderer&) = delete;
         VulkanRenderer& operator=(const VulkanRenderer&) = delete;
         ~VulkanRenderer();
+        //- opt-in, call before create: meshes upload as lcf::QuantizedVertex and draw with quantized_vertex_test.vert
+        void setQuantizedVerticesEnabled(bool enabled) noexcept { m_is_quantized_vertices_enabled = enabled; }
         void create(VulkanContext * context_p, const std::pair<uint32_t, uint32_t> & max_extent, ecs::Registry & registry);
         void render(const ecs::Entity & camera, const ecs::Entity & render_target);
     private:
@@ -43,6 +46,7 @@ namespace ecf {
         };
         std::vector<FrameResources> m_frame_resources;
         uint32_t m_current_frame_index = 0;
+        bool m_is_quantized_vertices_enabled = false;
 
         //! temporary
         VulkanDescriptorSet m_per_view_descriptor_set;
@@ -68,6 +72,8 @@ namespace ecf {
         std::vector<MeshPack> m_mesh_packs;
         std::vector<VulkanBufferObject> m_material_params_list;
         std::vector<VulkanBufferObject> m_material_texture_ids_list;
+        std::vector<std::vector<uint32_t>> m_material_texture_slots; //- bindless slots each material samples, marked used when it is bound
+        VulkanTextureManager m_texture_manager;
 
         //- device generated ext 
         struct DrawSequence 
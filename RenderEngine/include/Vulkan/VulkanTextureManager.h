@@ -2,14 +2,25 @@
 
 #include "Vulkan/vulkan_enums.h"
 #include "Vulkan/vulkan_fwd_decls.h"
+#include "Vulkan/memory/VulkanImageObject.h"
 #include "resource_utils.h"
 #include "SequentialIdAllocator.h"
 #include "enums/enum_count.h"
 #include <vulkan/vulkan.hpp>
 #include <array>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <span>
 #include <tsl/robin_map.h>
 
+namespace lcf {
+    class MipChain;
+}
+
 namespace lcf::render {
+    class VulkanBindlessDescriptorSet;
+
     class VulkanBindlessTextureIdTable
     {
         using Self = VulkanBindlessTextureIdTable;
@@ -59,9 +70,71 @@ namespace lcf::render {
         IdTable m_table;
     };
 
+    //- keeps the low mip tail of every texture resident and streams finer levels in for textures materials actually use;
+    //- each texture owns one bindless slot whose descriptor is rewritten in place whenever its image is swapped
     class VulkanTextureManager
     {
+        using Self = VulkanTextureManager;
+        using Id = uint32_t;
+        using IdAllocator = SequentialIdAllocator<Id>;
+        using MipChainSharedPointer = std::shared_ptr<const MipChain>;
+        struct StreamedTexture
+        {
+            MipChainSharedPointer m_mip_chain_sp;
+            vk::Format m_format = vk::Format::eUndefined;
+            VulkanImageObject m_image;
+            uint32_t m_tail_level = 0;      //- coarsest levels from here on are never evicted
+            uint32_t m_resident_level = 0;  //- finest chain level currently on the gpu
+            uint32_t m_requested_level = 0; //- finest chain level asked for since the last update
+            uint64_t m_last_used_frame = 0;
+        };
+        using TextureMap = tsl::robin_map<Id, StreamedTexture>;
+        using RetiredImageQueue = std::deque<std::pair<uint64_t, VulkanImageObject>>; //- views die with the object, so it outlives in-flight frames
+    public:
+        VulkanTextureManager() = default;
+        ~VulkanTextureManager() noexcept = default;
+        VulkanTextureManager(const Self &) = delete;
+        Self & operator=(const Self &) = delete;
+        VulkanTextureManager(Self &&) = default;
+        Self & operator=(Self &&) = default;
     public:
+        bool create(VulkanContext * context_p, VulkanBindlessDescriptorSet * bindless_set_p, vk::DeviceSize budget_in_bytes);
+        //- levels no larger than this stay resident for the texture's lifetime
+        Self & setResidentTailExtent(uint32_t extent) noexcept { m_resident_tail_extent = extent; return *this; }
+        //- caps staging traffic per update so a burst of newly visible textures is spread over several frames
+        Self & setUploadBudget(vk::DeviceSize bytes_per_frame) noexcept { m_upload_budget = bytes_per_frame; return *this; }
+        Self & setBudget(vk::DeviceSize budget_in_bytes) noexcept { m_budget = budget_in_bytes; return *this; }
+        //- slots below this are left to textures bound outside the manager
+        Self & setFirstSlot(Id first_slot) noexcept { m_first_slot = first_slot; return *this; }
+        //- frames a swapped out image is kept alive, at least the bindless set's frame copy count
+        Self & setRetireDelay(uint32_t frame_count) noexcept { m_retire_delay = frame_count; return *this; }
+        //- nullopt once every slot of the bindless texture array is taken, or when the mip tail cannot be uploaded
+        std::optional<Id> registerTexture(VulkanCommandBufferObject & cmd, MipChainSharedPointer mip_chain_sp, vk::Format format);
+        void unregisterTexture(Id id) noexcept;
+        //- record a use coming from a material binding this frame
+        void markUsed(Id id, uint32_t finest_level = 0u) noexcept;
+        void markUsed(std::span<const Id> ids) noexcept { for (auto id : ids) { this->markUsed(id); } }
+        //- evicts least recently used fine levels over budget, then streams requested levels in; call before recording draws
+        void update(VulkanCommandBufferObject & cmd, uint64_t frame_index);
+        vk::DeviceSize getResidentBytes() const noexcept { return m_resident_bytes; }
+        vk::DeviceSize getBudget() const noexcept { return m_budget; }
+    private:
+        bool makeResident(VulkanCommandBufferObject & cmd, Id id, StreamedTexture & texture, uint32_t level);
+        void retireImage(VulkanImageObject && image);
+        static vk::DeviceSize computeResidentBytes(const MipChain & mip_chain, uint32_t level) noexcept;
     private:
+        VulkanContext * m_context_p = nullptr;
+        VulkanBindlessDescriptorSet * m_bindless_set_p = nullptr;
+        IdAllocator m_id_allocator;
+        TextureMap m_textures;
+        RetiredImageQueue m_retired_images;
+        uint64_t m_frame_index = 0;
+        Id m_first_slot = 0;
+        uint32_t m_retire_delay = 3u;
+        uint32_t m_resident_tail_extent = 128u;
+        uint32_t m_min_idle_frames = 2u;
+        vk::DeviceSize m_budget = 0;
+        vk::DeviceSize m_upload_budget = 16ull << 20;
+        vk::DeviceSize m_resident_bytes = 0;
     };
 }
\ No newline at end of file
@@ -63,6 +63,11 @@ namespace detail {
         vkenums::DescriptorSetStrategy getStrategy() const noexcept { return m_layout.getStrategy(); }
         std::span<const VulkanDescriptorSetBinding> getBindings() const noexcept { return m_layout.getBindings(); }
         const VulkanDescriptorSetLayout & getLayout() const noexcept { return m_layout; }
+        //- array indices at or past this are dropped, the variable count binding grows up to it on commit
+        uint32_t getCapacity(uint32_t binding) const noexcept
+        {
+            return binding < this->getBindings().size() ? this->getBindings()[binding].getDescriptorCount() : 0u;
+        }
     private:
         std::error_code recreateSlot(vk::Device device, Slot & slot);
     private:
@@ -72,5 +77,6 @@ namespace detail {
         FrameSlots m_frame_slots;
         RetiredSlots m_retired_slots;
         uint32_t m_current_index = 0u;
+        uint32_t m_variable_descriptor_extent = 0u; //- highest array index written to the variable count binding plus one
     };
 } // namespace lcf::render
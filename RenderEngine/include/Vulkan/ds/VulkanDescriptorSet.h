@@ -27,7 +27,8 @@ namespace lcf::render {
             vk::DescriptorSet handle,
             std::span<const VulkanDescriptorSetBinding> bindings,
             vkenums::DescriptorSetStrategy strategy,
-            uint32_t set_index);
+            uint32_t set_index,
+            vk::DescriptorUpdateTemplate update_template = nullptr);
         ~VulkanDescriptorSet() = default;
         VulkanDescriptorSet(Self && other) noexcept;
         Self & operator=(Self && other) noexcept;
@@ -38,7 +39,7 @@ namespace lcf::render {
     public:
         Self & addDescriptorInfo(uint32_t binding, const DescriptorInfo & info);
         Self & addDescriptorInfo(uint32_t binding, uint32_t array_index, const DescriptorInfo & info);
-        void commitUpdate(vk::Device device);
+        void commitUpdate(vk::Device device); //- merges consecutive array elements, uses the layout's update template when every element is written
         const vk::DescriptorSet & getHandle() const noexcept { return m_descriptor_set; }
         uint32_t getIndex() const noexcept { return m_set_index; }
         vkenums::DescriptorSetStrategy getStrategy() const noexcept { return m_strategy; }
@@ -48,6 +49,8 @@ namespace lcf::render {
         BindingList m_binding_list;
         vkenums::DescriptorSetStrategy m_strategy = vkenums::DescriptorSetStrategy::eIndividual;
         uint32_t m_set_index = 0u;
+        uint32_t m_descriptor_count = 0u;
+        vk::DescriptorUpdateTemplate m_update_template = nullptr; //- owned by the layout
         std::vector<PendingWrite> m_pending_writes;
     };
 
@@ -7,6 +7,14 @@
 #include <vector>
 
 namespace lcf::render {
+    union VulkanDescriptorRecord //- one element of descriptor update data, buffer and image infos share the same stride
+    {
+        VulkanDescriptorRecord() noexcept : buffer_info() {}
+        vk::DescriptorBufferInfo buffer_info;
+        vk::DescriptorImageInfo image_info;
+    };
+    static_assert(sizeof(VulkanDescriptorRecord) == sizeof(vk::DescriptorBufferInfo) and sizeof(VulkanDescriptorRecord) == sizeof(vk::DescriptorImageInfo));
+
     class VulkanDescriptorSetLayout
     {
         using Self = VulkanDescriptorSetLayout;
@@ -31,11 +39,15 @@ namespace lcf::render {
         vkenums::DescriptorSetStrategy getStrategy() const noexcept { return m_strategy; }
         const VulkanDescriptorSetLayoutBindings & getBindings() const noexcept { return m_bindings; }
         const vk::DescriptorSetLayout & getHandle() const noexcept { return m_layout.get(); }
+        vk::DescriptorUpdateTemplate getUpdateTemplate() const noexcept { return m_update_template.get(); } //- null for bindless or non-template-compatible layouts
+    private:
+        void createUpdateTemplate(vk::Device device) noexcept;
     private:
         VulkanDescriptorSetLayoutBindings m_bindings;
         vkenums::DescriptorSetStrategy m_strategy = vkenums::DescriptorSetStrategy::eIndividual;
         uint32_t m_layout_index = 0u;
         vk::UniqueDescriptorSetLayout m_layout;
+        vk::UniqueDescriptorUpdateTemplate m_update_template; //- writes every element of every binding from VulkanDescriptorRecord data
     };
 
 }
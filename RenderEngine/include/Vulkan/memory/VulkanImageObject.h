@@ -5,6 +5,10 @@
 #include "resource_utils.h"
 #include <memory>
 
+namespace lcf {
+    class MipChain;
+}
+
 namespace lcf::render {
     class VulkanImageProxy;
 
@@ -22,6 +26,11 @@ namespace lcf::render {
         bool create(VulkanContext * context_p);
         bool create(VulkanContext * context_p, vk::Image external_image);
         void setData(VulkanCommandBufferObject & cmd, std::span<const std::byte> data, uint32_t layer = 0);
+        void setData(VulkanCommandBufferObject & cmd, const MipChain & mip_chain, uint32_t layer = 0); //- every level in one staging copy, no blit chain
+        void setData(VulkanCommandBufferObject & cmd, const MipChain & mip_chain, uint32_t layer, uint32_t first_level); //- chain levels [first_level, ...) into image levels [0, ...)
+        void setData(VulkanCommandBufferObject & cmd, const MipChain & mip_chain, uint32_t layer, uint32_t first_level, uint32_t level_count); //- stops after level_count chain levels
+        //- whole levels [src_first_level, src_first_level + level_count) of every layer into dst, both are left in transfer layouts
+        void copyLevelsTo(VulkanCommandBufferObject & cmd, VulkanImageObject & dst, uint32_t src_first_level, uint32_t dst_first_level, uint32_t level_count);
         void generateMipmaps(VulkanCommandBufferObject & cmd);
         Self & addImageFlags(vk::ImageCreateFlags flags) noexcept;
         Self & setFormat(vk::Format format) noexcept;
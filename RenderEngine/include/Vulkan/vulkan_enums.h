@@ -209,4 +209,17 @@ namespace lcf {
             { ImageFormat::eYCCK8Uint, vk::Format::eUndefined },
         };
     };
+
+    template <>
+    struct enum_mapping_traits<BlockCompression, vk::Format>
+    {
+        static constexpr std::tuple<BlockCompression, vk::Format> mappings[] = {
+            { BlockCompression::eNone, vk::Format::eUndefined },
+            { BlockCompression::eBC1, vk::Format::eBc1RgbaUnormBlock },
+            { BlockCompression::eBC3, vk::Format::eBc3UnormBlock },
+            { BlockCompression::eBC4, vk::Format::eBc4UnormBlock },
+            { BlockCompression::eBC5, vk::Format::eBc5UnormBlock },
+            { BlockCompression::eBC7, vk::Format::eBc7UnormBlock },
+        };
+    };
 }
\ No newline at end of file
@@ -72,6 +72,18 @@ const vk::CommandPool &VulkanContext::getCommandPool(vk::QueueFlagBits queue_typ
     return m_command_pools.at(queue_type).get();
 }
 
+bool VulkanContext::isFormatSampleable(vk::Format format) const noexcept
+{
+    auto in_range = [format](vk::Format first, vk::Format last) {
+        return std::to_underlying(format) >= std::to_underlying(first) and std::to_underlying(format) <= std::to_underlying(last);
+    };
+    if (in_range(vk::Format::eBc1RgbUnormBlock, vk::Format::eBc7SrgbBlock) and not m_enabled_features.textureCompressionBC) { return false; }
+    if (in_range(vk::Format::eEtc2R8G8B8UnormBlock, vk::Format::eEacR11G11SnormBlock) and not m_enabled_features.textureCompressionETC2) { return false; }
+    if (in_range(vk::Format::eAstc4x4UnormBlock, vk::Format::eAstc12x12SrgbBlock) and not m_enabled_features.textureCompressionASTC_LDR) { return false; }
+    auto format_properties = m_physical_device.getFormatProperties(format);
+    return static_cast<bool>(format_properties.optimalTilingFeatures & vk::FormatFeatureFlagBits::eSampledImage);
+}
+
 void VulkanContext::setupVulkanInstance()
 {
     vkdispatch::initialize_loader();
@@ -213,7 +225,10 @@ void VulkanContext::createLogicalDevice()
         .setTimelineSemaphore(true);
     device_info.get<vk::PhysicalDeviceVulkan11Features>().setShaderDrawParameters(true)
         .setStorageBuffer16BitAccess(true);
-    device_info.get<vk::PhysicalDeviceFeatures2>().setFeatures(m_physical_device.getFeatures());
+    //- every supported core feature is enabled, textureCompressionBC included, so BCn textures are usable wherever
+    //- the hardware decodes them; isFormatSampleable checks the recorded set before a compressed image is created
+    m_enabled_features = m_physical_device.getFeatures();
+    device_info.get<vk::PhysicalDeviceFeatures2>().setFeatures(m_enabled_features);
 
     static const std::unordered_map<vk::QueueFlagBits, uint32_t> s_ideal_queue_counts {
         { vk::QueueFlagBits::eGraphics, 2 },
@@ -3,6 +3,7 @@
 #include "Vulkan/VulkanCommandBufferObject.h"
 #include "common/glsl_type_traits.h"
 #include "render_assets/Geometry.h"
+#include "render_assets/VertexEncoding.h"
 
 using namespace lcf::render;
 namespace stdr = std::ranges;
@@ -26,3 +27,11 @@ std::error_code VulkanMesh::create(VulkanContext *context_p, VulkanCommandBuffer
     m_index_count = indices.size();
     return {};
 }
+
+std::error_code VulkanMesh::createQuantized(VulkanContext * context_p, VulkanCommandBufferObject & cmd, const Geometry & geometry)
+{
+    auto quantized_data = quantize_vertices(geometry); //- the segments point into it, create commits them before it goes away
+    if (auto error_code = this->create(context_p, cmd, quantized_data.generateVertexBufferSegments(), geometry.getIndices())) { return error_code; }
+    m_is_quantized = true;
+    return {};
+}
@@ -11,6 +11,9 @@
 #include "bytes.h"
 #include "render_assets/ModelLoader.h"
 #include "render_assets/Texture2D.h"
+#include "image/MipChain.h"
+#include "image/BlockCompression.h"
+#include "log.h"
 #include "common/glsl_type_traits.h"
 #include "Vulkan/vulkan_enums.h"
 #include "Vulkan/VulkanTextureManager.h"
@@ -29,6 +32,24 @@ lcf::VulkanRenderer::~VulkanRenderer()
     device.waitIdle();
 }
 
+namespace {
+    //- slots below this are left to textures uploaded eagerly when streaming cannot take them
+    constexpr uint32_t k_unmanaged_texture_slot_count = 64u;
+    constexpr vk::DeviceSize k_texture_budget_in_bytes = 256ull << 20; //todo derive from the device local budget
+
+    //- color textures are filtered in linear light, data textures as stored
+    ColorTransfer get_color_transfer(TextureSemantic semantic) noexcept
+    {
+        switch (semantic) {
+            case TextureSemantic::eBaseColor:
+            case TextureSemantic::eEmissive:
+            case TextureSemantic::eSheenColor:
+            case TextureSemantic::eSpecularColor: { return ColorTransfer::eSRGB; }
+            default: return ColorTransfer::eLinear;
+        }
+    }
+}
+
 struct CameraData
 {
     Matrix4x4<float> m_projection;
@@ -105,7 +126,8 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
     m_compute_pipeline.create(m_context_p, compute_pipeline_info);
 
     auto shader_program = std::make_shared<VulkanShaderProgram>();
-    shader_program->addShaderFromGlslFile(ShaderTypeFlagBits::eVertex, "shaders://vertex_buffer_test.vert")
+    const char * vertex_shader_path = m_is_quantized_vertices_enabled ? "shaders://quantized_vertex_test.vert" : "shaders://vertex_buffer_test.vert";
+    shader_program->addShaderFromGlslFile(ShaderTypeFlagBits::eVertex, vertex_shader_path)
         .addShaderFromGlslFile(ShaderTypeFlagBits::eFragment, "shaders://vertex_buffer_test.frag")
         .specifyDescriptorSetLayout(m_per_view_descriptor_set_layout)
         .specifyDescriptorSetLayout(descriptor_set_manager.getBindlessBufferSet().getLayout())
@@ -173,6 +195,12 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
         m_per_renderable_ssbo_group[std::to_underlying(vkenums::BindlessBufferBinding::eBoundingVolume)].generateBufferInfo()
     ).commitUpdate(device);
 
+    m_texture_manager.setFirstSlot(k_unmanaged_texture_slot_count)
+        .setRetireDelay(static_cast<uint32_t>(m_frame_resources.size()));
+    if (not m_texture_manager.create(m_context_p, &descriptor_set_manager.getBindlessTextureSet(), k_texture_budget_in_bytes)) {
+        lcf_log_error("Failed to create texture manager");
+    }
+
     auto image_assets_dir = VirtualPathRegistry::instance().resolve("assets://images");
     auto image1_sp = Texture2D::makeShared();
     image1_sp->loadFromFileGpuFriendly(image_assets_dir / "bk.jpg");
@@ -186,13 +214,16 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
         auto & mesh_pack = m_mesh_packs.emplace_back();
         for (const auto & geometry: model.getRenderPrimitives() | view_geometries) {
             auto & mesh = mesh_pack.meshes.emplace_back();
-            mesh.create(m_context_p, cmd,
-                generate_interleaved_segments<glsl::std140::enum_value_type_mapping_t>(
-                    geometry,
-                    VertexAttributeFlags::ePosition | VertexAttributeFlags::eNormal | VertexAttributeFlags::eTexCoord0 | VertexAttributeFlags::eTangent
-                ), geometry.getIndices());
-            BoundingSphere<float> sphere {geometry.getAttributes<VertexAttribute::ePosition>()};
-            mesh.setBoundingSphere(sphere);
+            if (m_is_quantized_vertices_enabled) {
+                mesh.createQuantized(m_context_p, cmd, geometry);
+            } else {
+                mesh.create(m_context_p, cmd,
+                    generate_interleaved_segments<glsl::std140::enum_value_type_mapping_t>(
+                        geometry,
+                        VertexAttributeFlags::ePosition | VertexAttributeFlags::eNormal | VertexAttributeFlags::eTexCoord0 | VertexAttributeFlags::eTangent
+                    ), geometry.getIndices());
+            }
+            mesh.setBoundingSphere(geometry.getBoundingSphere());
         }
 
         for (const auto & material: model.getRenderPrimitives() | view_materials) {
@@ -205,8 +236,22 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
             texture_ids_buffer.setUsage(GPUBufferUsage::eShaderStorage)
                 .setPattern(GPUBufferPattern::eStatic)
                 .create(m_context_p, 1);
-            for (const auto & texture_resource : get_textures(material, ShadingModel::eStandard)) {
+            for (auto semantic : get_texture_semantics(ShadingModel::eStandard)) {
+                const auto & texture_resource = material.getTexture(semantic);
                 if (texture_id_map.contains(&texture_resource)) { continue; }
+                //- streamed: the mip tail stays resident and finer levels follow the materials drawn
+                auto mip_chain_result = generate_mip_chain(texture_resource, MipFilter::eBox, get_color_transfer(semantic));
+                std::optional<uint32_t> slot_opt;
+                if (mip_chain_result) {
+                    slot_opt = m_texture_manager.registerTexture(cmd,
+                        std::make_shared<const MipChain>(std::move(*mip_chain_result)),
+                        enum_cast<vk::Format>(texture_resource.getDecodeFormat()));
+                }
+                if (slot_opt) {
+                    texture_id_map[&texture_resource] = *slot_opt;
+                    continue;
+                }
+                lcf_log_warn("Texture cannot be streamed, uploading it whole");
                 VulkanImageObject image_obj;
                 image_obj.setFormat(enum_cast<vk::Format>(texture_resource.getDecodeFormat()))
                     .setExtent({ texture_resource.getWidth(), texture_resource.getHeight(), 1u })
@@ -218,8 +263,10 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
                 texture_id_map[&texture_resource] = texture_id;
                 texture_re_list.emplace_back(texture_id, std::move(texture_re));
             }
+            auto & texture_slots = m_material_texture_slots.emplace_back();
             for (uint32_t offset = 0; const auto & texture_resource : get_textures(material, ShadingModel::eStandard)) {
                 texture_ids_buffer.addWriteSegment({as_bytes_from_value(texture_id_map[&texture_resource]), offset});
+                texture_slots.push_back(texture_id_map[&texture_resource]);
                 offset += sizeof(uint32_t);
             }
             texture_params_buffer.commit(cmd);
@@ -241,20 +288,38 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
     TypedResourceEntity<VulkanImageObject> texture2_re;
     std::shared_ptr<VulkanSampler> sampler_sp;
 
+    //- a failed mip chain still leaves a usable texture, it is uploaded as a single level instead
+    auto image1_mip_chain_result = generate_mip_chain(*image1_sp, MipFilter::eBox, ColorTransfer::eSRGB);
+    if (not image1_mip_chain_result) {
+        lcf_log_warn("Failed to generate mip chain for bk.jpg, uploading a single level: {}", image1_mip_chain_result.error().message());
+    }
     {
         VulkanImageObject texture1;
         texture1.setFormat(enum_cast<vk::Format>(image1_sp->getDecodeFormat()))
             .setUsage(vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst)
-            .setMipmapped(true)
+            .setMipmapped(image1_mip_chain_result.has_value())
             .setExtent({ image1_sp->getWidth(), image1_sp->getHeight(), 1u })
             .create(m_context_p);
         texture1_re = resource_system.registerResource(std::move(texture1));
     }
+    //- devices without BC support, most mobile and some integrated gpus, keep the uncompressed rgba8 chain
+    BlockCompressionInfo image2_compression_info;
+    bool is_image2_compression_supported = m_context_p->isFormatSampleable(enum_cast<vk::Format>(image2_compression_info.getCompression()));
+    auto image2_mip_chain_result = generate_mip_chain(*image2_sp, MipFilter::eKaiser, ColorTransfer::eSRGB);
+    if (not image2_mip_chain_result) {
+        lcf_log_warn("Failed to generate mip chain for qt256.png, uploading a single level: {}", image2_mip_chain_result.error().message());
+    } else if (not is_image2_compression_supported) {
+        lcf_log_info("BC7 is not sampleable on this device, qt256.png stays uncompressed");
+    } else if (auto compressed_result = compress_mip_chain(*image2_mip_chain_result, image2_compression_info); compressed_result) {
+        image2_mip_chain_result = std::move(compressed_result);
+    }
     {
         VulkanImageObject texture2;
-        texture2.setFormat(enum_cast<vk::Format>(image2_sp->getDecodeFormat()))
+        texture2.setFormat(image2_mip_chain_result and image2_mip_chain_result->isCompressed() ?
+                enum_cast<vk::Format>(image2_mip_chain_result->getCompression()) :
+                enum_cast<vk::Format>(image2_sp->getDecodeFormat()))
             .setUsage(vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferDst)
-            .setMipmapped(true)
+            .setMipmapped(image2_mip_chain_result.has_value())
             .setExtent({ image2_sp->getWidth(), image2_sp->getHeight(), 1u })
             .create(m_context_p);
         texture2_re = resource_system.registerResource(std::move(texture2));
@@ -285,8 +350,11 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
     stc_pipeline.create(m_context_p, stc_pipeline_info);
 
     vkutils::immediate_submit(m_context_p, vk::QueueFlagBits::eGraphics, [&](VulkanCommandBufferObject & cmd) {
-        texture1_re->setData(cmd, image1_sp->getDataSpan());
-        texture1_re->generateMipmaps(cmd);
+        if (image1_mip_chain_result) {
+            texture1_re->setData(cmd, *image1_mip_chain_result);
+        } else {
+            texture1_re->setData(cmd, image1_sp->getDataSpan());
+        }
 
         vk::DescriptorImageInfo image_info;
         image_info.setImageLayout(*texture1_re->getLayout())
@@ -313,8 +381,11 @@ void lcf::VulkanRenderer::create(VulkanContext * context_p, const std::pair<uint
         fbo.endRendering(cmd);
         cube_map_re->transitLayout(cmd, vk::ImageLayout::eShaderReadOnlyOptimal);
 
-        texture2_re->setData(cmd, image2_sp->getDataSpan());
-        texture2_re->generateMipmaps(cmd);
+        if (image2_mip_chain_result) {
+            texture2_re->setData(cmd, *image2_mip_chain_result);
+        } else {
+            texture2_re->setData(cmd, image2_sp->getDataSpan());
+        }
     });
 
     auto skybox_shader_program = std::make_shared<VulkanShaderProgram>();
@@ -498,6 +569,7 @@ void lcf::VulkanRenderer::render(const ecs::Entity & camera, const ecs::Entity &
             const auto & texture_ids_buffer = m_material_texture_ids_list[object_id];
             object_data.m_material_params_address = material_params_buffer.getDeviceAddress();
             object_data.m_material_texture_ids_address = texture_ids_buffer.getDeviceAddress();
+            m_texture_manager.markUsed(m_material_texture_slots[object_id]);
             bounding_spheres_list.emplace_back(mesh.getBoundingSphere());
         }
     }
@@ -599,6 +671,8 @@ void lcf::VulkanRenderer::render(const ecs::Entity & camera, const ecs::Entity &
     auto compute_complete_info = compute_cmd.submit();
 
     cmd.begin(vk::CommandBufferBeginInfo{});
+    //- on the graphics queue, so swapped out images are ordered after the frames still sampling them
+    m_texture_manager.update(cmd, frame_count);
     cmd.setViewport(0, viewport);
     cmd.setScissor(0, scissor);
 
@@ -0,0 +1,163 @@
+#include "Vulkan/VulkanTextureManager.h"
+#include "Vulkan/VulkanContext.h"
+#include "Vulkan/VulkanCommandBufferObject.h"
+#include "Vulkan/ds/VulkanBindlessDescriptorSet.h"
+#include "image/MipChain.h"
+#include <algorithm>
+#include <vector>
+
+using namespace lcf::render;
+
+bool VulkanTextureManager::create(VulkanContext * context_p, VulkanBindlessDescriptorSet * bindless_set_p, vk::DeviceSize budget_in_bytes)
+{
+    if (not context_p or not bindless_set_p) { return false; }
+    m_context_p = context_p;
+    m_bindless_set_p = bindless_set_p;
+    m_budget = budget_in_bytes;
+    return true;
+}
+
+auto VulkanTextureManager::registerTexture(VulkanCommandBufferObject & cmd, MipChainSharedPointer mip_chain_sp, vk::Format format) -> std::optional<Id>
+{
+    if (not m_context_p or not mip_chain_sp or mip_chain_sp->getLevelCount() == 0) { return std::nullopt; }
+    const auto levels = mip_chain_sp->getLevels();
+    auto tail_it = std::ranges::find_if(levels, [this](const auto & level) {
+        return std::max(level.m_width, level.m_height) <= m_resident_tail_extent;
+    });
+    const auto tail_level = tail_it == levels.end() ? mip_chain_sp->getLevelCount() - 1 : static_cast<uint32_t>(tail_it - levels.begin());
+    StreamedTexture texture;
+    texture.m_mip_chain_sp = std::move(mip_chain_sp);
+    texture.m_format = format;
+    texture.m_tail_level = tail_level;
+    texture.m_resident_level = tail_level;
+    texture.m_requested_level = tail_level;
+    texture.m_last_used_frame = m_frame_index;
+    const Id id = m_first_slot + m_id_allocator.allocate();
+    //- the descriptor would be dropped past the bindless array, reject instead of handing out a slot that samples nothing
+    if (id >= m_bindless_set_p->getCapacity(std::to_underlying(vkenums::BindlessTextureBinding::eTexture2Ds))) {
+        m_id_allocator.deallocate(id - m_first_slot);
+        return std::nullopt;
+    }
+    if (not this->makeResident(cmd, id, texture, tail_level)) {
+        m_id_allocator.deallocate(id - m_first_slot);
+        return std::nullopt;
+    }
+    m_bindless_set_p->commitUpdate(m_context_p->getDevice());
+    m_textures.emplace(id, std::move(texture));
+    return id;
+}
+
+void VulkanTextureManager::unregisterTexture(Id id) noexcept
+{
+    auto it = m_textures.find(id);
+    if (it == m_textures.end()) { return; }
+    auto & texture = it.value();
+    m_resident_bytes -= computeResidentBytes(*texture.m_mip_chain_sp, texture.m_resident_level);
+    this->retireImage(std::move(texture.m_image));
+    m_textures.erase(it);
+    m_id_allocator.deallocate(id - m_first_slot);
+}
+
+void VulkanTextureManager::markUsed(Id id, uint32_t finest_level) noexcept
+{
+    auto it = m_textures.find(id);
+    if (it == m_textures.end()) { return; }
+    auto & texture = it.value();
+    texture.m_last_used_frame = m_frame_index;
+    texture.m_requested_level = std::min(texture.m_requested_level, finest_level);
+}
+
+void VulkanTextureManager::update(VulkanCommandBufferObject & cmd, uint64_t frame_index)
+{
+    m_frame_index = frame_index;
+    while (not m_retired_images.empty() and m_retired_images.front().first + m_retire_delay <= frame_index) {
+        m_retired_images.pop_front();
+    }
+    bool descriptors_dirty = false;
+    std::vector<std::pair<uint64_t, Id>> candidates;
+    //- over budget: drop idle textures back to their tail, least recently used first
+    if (m_budget != 0 and m_resident_bytes > m_budget) {
+        for (const auto & [id, texture] : m_textures) {
+            if (texture.m_resident_level >= texture.m_tail_level) { continue; }
+            if (texture.m_last_used_frame + m_min_idle_frames > frame_index) { continue; }
+            candidates.emplace_back(texture.m_last_used_frame, id);
+        }
+        std::ranges::sort(candidates);
+        for (const auto & [_, id] : candidates) {
+            if (m_resident_bytes <= m_budget) { break; }
+            auto & texture = m_textures.find(id).value();
+            descriptors_dirty |= this->makeResident(cmd, id, texture, texture.m_tail_level);
+        }
+        candidates.clear();
+    }
+    //- stream in what was asked for, most recently used first, bounded by the upload and residency budgets
+    for (const auto & [id, texture] : m_textures) {
+        if (texture.m_requested_level >= texture.m_resident_level) { continue; }
+        candidates.emplace_back(texture.m_last_used_frame, id);
+    }
+    std::ranges::sort(candidates, std::ranges::greater {});
+    vk::DeviceSize uploaded_bytes = 0;
+    for (const auto & [_, id] : candidates) {
+        auto & texture = m_textures.find(id).value();
+        const auto & mip_chain = *texture.m_mip_chain_sp;
+        //- the resident levels are copied over on the gpu, only the new finer ones go through staging
+        const vk::DeviceSize growth = computeResidentBytes(mip_chain, texture.m_requested_level) - computeResidentBytes(mip_chain, texture.m_resident_level);
+        if (uploaded_bytes != 0 and uploaded_bytes + growth > m_upload_budget) { break; }
+        if (m_budget != 0 and m_resident_bytes + growth > m_budget) { continue; }
+        if (this->makeResident(cmd, id, texture, texture.m_requested_level)) {
+            uploaded_bytes += growth;
+            descriptors_dirty = true;
+        }
+    }
+    for (auto it = m_textures.begin(); it != m_textures.end(); ++it) {
+        it.value().m_requested_level = it->second.m_tail_level;
+    }
+    if (descriptors_dirty) { m_bindless_set_p->commitUpdate(m_context_p->getDevice()); }
+}
+
+bool VulkanTextureManager::makeResident(VulkanCommandBufferObject & cmd, Id id, StreamedTexture & texture, uint32_t level)
+{
+    const auto & mip_chain = *texture.m_mip_chain_sp;
+    const auto & level_info = mip_chain.getLevel(level);
+    VulkanImageObject image;
+    image.setFormat(texture.m_format)
+        .setExtent({ level_info.m_width, level_info.m_height, 1u })
+        .setMipmapped(mip_chain.getLevelCount() - level > 1)
+        .setUsage(vk::ImageUsageFlagBits::eSampled | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst);
+    if (not image.create(m_context_p)) { return false; }
+    //- image level i holds chain level level + i; what the old image already has is copied, the rest is uploaded
+    const uint32_t copied_level = texture.m_image.isCreated() ? std::max(level, texture.m_resident_level) : mip_chain.getLevelCount();
+    if (copied_level < mip_chain.getLevelCount()) {
+        texture.m_image.copyLevelsTo(cmd, image, copied_level - texture.m_resident_level, copied_level - level, mip_chain.getLevelCount() - copied_level);
+        //- frame copies of the bindless set may still sample it until they are rewritten
+        texture.m_image.transitLayout(cmd, vk::ImageLayout::eShaderReadOnlyOptimal);
+    }
+    image.setData(cmd, mip_chain, 0, level, copied_level - level);
+    image.transitLayout(cmd, vk::ImageLayout::eShaderReadOnlyOptimal);
+    vk::DescriptorImageInfo image_info;
+    image_info.setImageLayout(vk::ImageLayout::eShaderReadOnlyOptimal)
+        .setImageView(image.getDefaultView());
+    m_bindless_set_p->addDescriptorInfo(
+        std::to_underlying(vkenums::BindlessTextureBinding::eTexture2Ds),
+        id,
+        image_info,
+        image.lease());
+    if (texture.m_image.isCreated()) {
+        m_resident_bytes -= computeResidentBytes(mip_chain, texture.m_resident_level);
+        this->retireImage(std::move(texture.m_image));
+    }
+    texture.m_image = std::move(image);
+    texture.m_resident_level = level;
+    m_resident_bytes += computeResidentBytes(mip_chain, level);
+    return true;
+}
+
+void VulkanTextureManager::retireImage(VulkanImageObject && image)
+{
+    m_retired_images.emplace_back(m_frame_index, std::move(image));
+}
+
+vk::DeviceSize VulkanTextureManager::computeResidentBytes(const MipChain & mip_chain, uint32_t level) noexcept
+{
+    return mip_chain.getDataSpan().size_bytes() - mip_chain.getLevel(level).m_offset_in_bytes;
+}
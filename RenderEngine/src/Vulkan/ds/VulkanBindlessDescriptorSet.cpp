@@ -3,6 +3,7 @@
 #include "Vulkan/ds/VulkanDescriptorSetLayout.h"
 #include "Vulkan/vulkan_constants.h"
 #include <utility>
+#include <algorithm>
 #include <ranges>
 
 using namespace lcf::render;
@@ -46,9 +47,9 @@ VulkanBindlessDescriptorSet & VulkanBindlessDescriptorSet::addDescriptorInfo(
 {
     if (binding >= this->getBindings().size()) { return *this; }
     const auto & layout_binding = this->getBindings()[binding];
-    if (not layout_binding.containsFlags(vk::DescriptorBindingFlagBits::eVariableDescriptorCount) and
-        array_index >= layout_binding.getDescriptorCount()) {
-        return *this;
+    if (array_index >= layout_binding.getDescriptorCount()) { return *this; } //- the variable count binding is capped by its layout count too
+    if (layout_binding.containsFlags(vk::DescriptorBindingFlagBits::eVariableDescriptorCount)) {
+        m_variable_descriptor_extent = std::max(m_variable_descriptor_extent, array_index + 1u);
     }
     m_authority_binding_map[binding][array_index].descriptor_info = info;
     for (auto & slot : m_frame_slots) {
@@ -72,7 +73,7 @@ void VulkanBindlessDescriptorSet::commitUpdate(vk::Device device) noexcept
     auto & slot = m_frame_slots[m_current_index];
     const auto & bindings = m_layout.getBindings();
     if (bindings.containsFlags(vk::DescriptorBindingFlagBits::eVariableDescriptorCount) and
-        m_authority_binding_map.back().size() > slot.m_variable_count) {
+        m_variable_descriptor_extent > slot.m_variable_count) {
         this->recreateSlot(device, slot);
     }
     slot.commitUpdate(device);
@@ -91,6 +92,8 @@ const vk::DescriptorSet & VulkanBindlessDescriptorSet::getHandle() const noexcep
 std::error_code lcf::render::VulkanBindlessDescriptorSet::recreateSlot(vk::Device device, Slot & slot)
 {
     uint32_t variable_count = slot.m_variable_count << 1;
+    while (variable_count < m_variable_descriptor_extent) { variable_count <<= 1; }
+    variable_count = std::min(variable_count, this->getBindings().back().getDescriptorCount());
     auto result = m_allocator_up->allocate(m_layout, variable_count);
     if (not result) { return result.error(); }
     m_retired_slots.emplace_back(std::move(slot));
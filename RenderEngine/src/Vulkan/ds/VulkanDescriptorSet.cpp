@@ -1,19 +1,33 @@
 #include "Vulkan/ds/VulkanDescriptorSet.h"
+#include "Vulkan/ds/VulkanDescriptorSetLayout.h"
+#include <algorithm>
 #include <utility>
 #include <ranges>
 
 using namespace lcf::render;
 
+namespace {
+    struct CommitScratch //- reused by every commit on the thread, steady state updates do not allocate
+    {
+        std::vector<VulkanDescriptorRecord> records;
+        std::vector<vk::WriteDescriptorSet> writes;
+    };
+    thread_local CommitScratch t_commit_scratch;
+}
+
 VulkanDescriptorSet::VulkanDescriptorSet(
     vk::DescriptorSet handle,
     std::span<const VulkanDescriptorSetBinding> bindings,
     vkenums::DescriptorSetStrategy strategy,
-    uint32_t set_index) :
+    uint32_t set_index,
+    vk::DescriptorUpdateTemplate update_template) :
     m_descriptor_set(handle),
     m_binding_list(bindings.begin(), bindings.end()),
     m_strategy(strategy),
-    m_set_index(set_index)
+    m_set_index(set_index),
+    m_update_template(update_template)
 {
+    for (const auto & binding : m_binding_list) { m_descriptor_count += binding.getDescriptorCount(); }
 }
 
 VulkanDescriptorSet::VulkanDescriptorSet(Self && other) noexcept :
@@ -21,6 +35,8 @@ VulkanDescriptorSet::VulkanDescriptorSet(Self && other) noexcept :
     m_binding_list(std::move(other.m_binding_list)),
     m_strategy(other.m_strategy),
     m_set_index(other.m_set_index),
+    m_descriptor_count(other.m_descriptor_count),
+    m_update_template(std::exchange(other.m_update_template, nullptr)),
     m_pending_writes(std::move(other.m_pending_writes))
 {
 }
@@ -32,6 +48,8 @@ VulkanDescriptorSet & VulkanDescriptorSet::operator=(Self && other) noexcept
     m_binding_list = std::move(other.m_binding_list);
     m_strategy = other.m_strategy;
     m_set_index = other.m_set_index;
+    m_descriptor_count = other.m_descriptor_count;
+    m_update_template = std::exchange(other.m_update_template, nullptr);
     m_pending_writes = std::move(other.m_pending_writes);
     return *this;
 }
@@ -51,23 +69,55 @@ void VulkanDescriptorSet::commitUpdate(vk::Device device)
 {
     if (m_pending_writes.empty() || not device) { return; }
 
-    auto to_write = [this](PendingWrite & pending_write) -> vk::WriteDescriptorSet
-    {
-        const auto & binding = m_binding_list[pending_write.binding];
+    auto to_key = [](const PendingWrite & pending_write) { return std::pair(pending_write.binding, pending_write.array_index); };
+    std::ranges::stable_sort(m_pending_writes, std::less {}, to_key);
+    auto last_it = m_pending_writes.begin();
+    for (auto it = std::next(last_it); it != m_pending_writes.end(); ++it) {
+        if (to_key(*it) != to_key(*last_it)) { ++last_it; }
+        if (last_it != it) { *last_it = std::move(*it); } //- later writes to the same element win
+    }
+    m_pending_writes.erase(std::next(last_it), m_pending_writes.end());
+
+    auto & scratch = t_commit_scratch;
+    scratch.records.resize(m_pending_writes.size());
+    bool is_in_range = true;
+    for (size_t i = 0; i < m_pending_writes.size(); ++i) {
+        const auto & pending_write = m_pending_writes[i];
+        is_in_range = is_in_range and pending_write.array_index < m_binding_list[pending_write.binding].getDescriptorCount();
+        std::visit([&record = scratch.records[i]](const auto & info) {
+            using T = std::decay_t<decltype(info)>;
+            if constexpr (std::is_same_v<T, vk::DescriptorBufferInfo>) { record.buffer_info = info; }
+            else { record.image_info = info; }
+        }, pending_write.info);
+    }
+
+    if (m_update_template and is_in_range and m_pending_writes.size() == m_descriptor_count) {
+        //- sorted and unique, so the records line up with the template entries
+        device.updateDescriptorSetWithTemplate(m_descriptor_set, m_update_template, static_cast<const void *>(scratch.records.data()));
+        m_pending_writes.clear();
+        return;
+    }
+
+    scratch.writes.clear();
+    for (size_t first = 0, last = 0; first < m_pending_writes.size(); first = last) {
+        const auto & first_write = m_pending_writes[first];
+        for (last = first + 1; last < m_pending_writes.size(); ++last) {
+            const auto & pending_write = m_pending_writes[last];
+            if (pending_write.binding != first_write.binding
+                or pending_write.array_index != first_write.array_index + (last - first)
+                or pending_write.info.index() != first_write.info.index()) { break; }
+        }
+        const auto & binding = m_binding_list[first_write.binding];
         vk::WriteDescriptorSet write;
         write.setDstSet(m_descriptor_set)
             .setDstBinding(binding.getLayoutBinding().binding)
-            .setDstArrayElement(pending_write.array_index)
+            .setDstArrayElement(first_write.array_index)
+            .setDescriptorCount(static_cast<uint32_t>(last - first))
             .setDescriptorType(binding.getLayoutBinding().descriptorType);
-        std::visit([&write](auto & info) {
-            using T = std::decay_t<decltype(info)>;
-            if constexpr (std::is_same_v<T, vk::DescriptorBufferInfo>) { write.setBufferInfo(info); }
-            else { write.setImageInfo(info); }
-        }, pending_write.info);
-        return write;
-    };
-
-    auto writes = m_pending_writes | std::views::transform(to_write) | std::ranges::to<std::vector>();
-    device.updateDescriptorSets(writes, nullptr);
+        if (std::holds_alternative<vk::DescriptorBufferInfo>(first_write.info)) { write.setPBufferInfo(&scratch.records[first].buffer_info); }
+        else { write.setPImageInfo(&scratch.records[first].image_info); }
+        scratch.writes.push_back(write);
+    }
+    device.updateDescriptorSets(scratch.writes, nullptr);
     m_pending_writes.clear();
 }
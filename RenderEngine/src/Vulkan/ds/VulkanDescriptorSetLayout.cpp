@@ -57,5 +57,45 @@ std::error_code VulkanDescriptorSetLayout::create(vk::Device device, vkenums::De
     } catch (const vk::SystemError & e) {
         return e.code();
     }
+    this->createUpdateTemplate(device);
     return {};
 }
+
+void VulkanDescriptorSetLayout::createUpdateTemplate(vk::Device device) noexcept
+{
+    m_update_template.reset();
+    if (m_strategy == vkenums::DescriptorSetStrategy::eBindless) { return; }
+    constexpr vk::DescriptorBindingFlags unsupported_flags = vk::DescriptorBindingFlagBits::ePartiallyBound | vk::DescriptorBindingFlagBits::eVariableDescriptorCount;
+    auto is_record_type = [](vk::DescriptorType type) {
+        switch (type) {
+            case vk::DescriptorType::eSampler:
+            case vk::DescriptorType::eCombinedImageSampler:
+            case vk::DescriptorType::eSampledImage:
+            case vk::DescriptorType::eStorageImage:
+            case vk::DescriptorType::eInputAttachment:
+            case vk::DescriptorType::eUniformBuffer:
+            case vk::DescriptorType::eStorageBuffer:
+            case vk::DescriptorType::eUniformBufferDynamic:
+            case vk::DescriptorType::eStorageBufferDynamic: return true;
+            default: return false;
+        }
+    };
+    std::vector<vk::DescriptorUpdateTemplateEntry> entries;
+    entries.reserve(m_bindings.size());
+    size_t offset = 0;
+    for (const auto & binding : m_bindings) {
+        if (binding.getDescriptorCount() == 0 or (binding.getFlags() & unsupported_flags) or not is_record_type(binding.getDescriptorType())) { return; }
+        entries.emplace_back(binding.getBindingIndex(), 0u, binding.getDescriptorCount(), binding.getDescriptorType(), offset, sizeof(VulkanDescriptorRecord));
+        offset += binding.getDescriptorCount() * sizeof(VulkanDescriptorRecord);
+    }
+    if (entries.empty()) { return; }
+    vk::DescriptorUpdateTemplateCreateInfo template_info;
+    template_info.setDescriptorUpdateEntries(entries)
+        .setTemplateType(vk::DescriptorUpdateTemplateType::eDescriptorSet)
+        .setDescriptorSetLayout(m_layout.get());
+    try {
+        m_update_template = device.createDescriptorUpdateTemplateUnique(template_info);
+    } catch (const vk::SystemError &) {
+        m_update_template.reset(); //- the template is only a fast path, VulkanDescriptorSet falls back to batched writes
+    }
+}
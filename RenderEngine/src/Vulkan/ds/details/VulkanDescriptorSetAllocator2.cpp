@@ -62,7 +62,7 @@ VulkanDescriptorSetAllocator::AllocResult VulkanDescriptorSetAllocator::allocate
         return std::unexpected(e.code());
     }
     m_set_to_pool_map[layout.getStrategy()][descriptor_set] = alloc_info.descriptorPool;
-    return VulkanDescriptorSet { descriptor_set, layout.getBindings(), layout.getStrategy(), layout.getIndex() };
+    return VulkanDescriptorSet { descriptor_set, layout.getBindings(), layout.getStrategy(), layout.getIndex(), layout.getUpdateTemplate() };
 }
 
 vk::DescriptorPool VulkanDescriptorSetAllocator::tryGetPool(vkenums::DescriptorSetStrategy strategy) noexcept
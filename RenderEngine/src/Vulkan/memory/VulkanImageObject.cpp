@@ -4,7 +4,9 @@
 #include "Vulkan/VulkanCommandBufferObject.h"
 #include "Vulkan/memory/vulkan_memory_resources.h"
 #include "Vulkan/memory/VulkanBufferObject.h"
+#include "image/MipChain.h"
 #include "log.h"
+#include <algorithm>
 
 using namespace lcf;
 using namespace lcf::render;
@@ -49,6 +51,58 @@ void VulkanImageObject::setData(VulkanCommandBufferObject &cmd, std::span<const
     m_proxy_sp->transitLayout(cmd, vk::ImageLayout::eShaderReadOnlyOptimal);
 }
 
+void VulkanImageObject::setData(VulkanCommandBufferObject & cmd, const MipChain & mip_chain, uint32_t layer)
+{
+    this->setData(cmd, mip_chain, layer, 0u);
+}
+
+void VulkanImageObject::setData(VulkanCommandBufferObject & cmd, const MipChain & mip_chain, uint32_t layer, uint32_t first_level)
+{
+    this->setData(cmd, mip_chain, layer, first_level, mip_chain.getLevelCount());
+}
+
+void VulkanImageObject::setData(VulkanCommandBufferObject & cmd, const MipChain & mip_chain, uint32_t layer, uint32_t first_level, uint32_t level_count)
+{
+    if (first_level >= mip_chain.getLevelCount() or level_count == 0) { return; }
+    level_count = std::min({level_count, mip_chain.getLevelCount() - first_level, m_proxy_sp->getMipLevelCount()});
+    cmd.acquireResourceLease(m_proxy_sp->lease());
+    const size_t base_offset = mip_chain.getLevel(first_level).m_offset_in_bytes;
+    const auto & last_level_info = mip_chain.getLevel(first_level + level_count - 1);
+    auto data = mip_chain.getDataSpan().subspan(base_offset, last_level_info.m_offset_in_bytes + last_level_info.m_size_in_bytes - base_offset);
+    VulkanBufferProxy staging_buffer;
+    staging_buffer.setUsage(GPUBufferUsage::eStaging)
+        .create(m_proxy_sp->m_context_p, data.size_bytes());
+    staging_buffer.writeSegmentDirectly(data);
+    cmd.acquireResourceLease(staging_buffer.lease());
+    std::vector<vk::BufferImageCopy> regions(level_count);
+    for (uint32_t level = 0; level < level_count; ++level) {
+        const auto & level_info = mip_chain.getLevel(first_level + level);
+        regions[level].setBufferOffset(level_info.m_offset_in_bytes - base_offset)
+            .setImageSubresource({ m_proxy_sp->getAspectFlags(), level, layer, 1 })
+            .setImageOffset({ 0, 0, 0 })
+            .setImageExtent({ level_info.m_width, level_info.m_height, 1 });
+    }
+    m_proxy_sp->copyFrom(cmd, staging_buffer.getHandle(), regions);
+    m_proxy_sp->transitLayout(cmd, vk::ImageLayout::eShaderReadOnlyOptimal);
+}
+
+void VulkanImageObject::copyLevelsTo(VulkanCommandBufferObject & cmd, VulkanImageObject & dst, uint32_t src_first_level, uint32_t dst_first_level, uint32_t level_count)
+{
+    auto & src_proxy = *m_proxy_sp;
+    auto & dst_proxy = *dst.m_proxy_sp;
+    const auto extent = src_proxy.getExtent();
+    const uint32_t layer_count = std::min(src_proxy.getArrayLayerCount(), dst_proxy.getArrayLayerCount());
+    for (uint32_t i = 0; i < level_count; ++i) {
+        const uint32_t src_level = src_first_level + i;
+        if (src_level >= src_proxy.getMipLevelCount() or dst_first_level + i >= dst_proxy.getMipLevelCount()) { break; }
+        src_proxy.copyTo(cmd,
+            {src_proxy.getAspectFlags(), src_level, 0, layer_count}, {0, 0, 0},
+            dst_proxy,
+            {dst_proxy.getAspectFlags(), dst_first_level + i, 0, layer_count}, {0, 0, 0},
+            {std::max(extent.width >> src_level, 1u), std::max(extent.height >> src_level, 1u), std::max(extent.depth >> src_level, 1u)});
+    }
+}
+
 void VulkanImageObject::generateMipmaps(VulkanCommandBufferObject & cmd)
 {
     cmd.acquireResourceLease(m_proxy_sp->lease());
@@ -0,0 +1,22 @@
+// matches lcf::Meshlet and lcf::MeshletBounds in render_assets/GeometryOptimization.h
+
+struct Meshlet
+{
+    uint vertex_offset;
+    uint triangle_offset; // in bytes, 4 byte aligned
+    uint vertex_count;
+    uint triangle_count;
+};
+
+struct MeshletBounds
+{
+    vec4 sphere; // xyz center, w radius
+    vec4 cone_apex; // w unused
+    vec4 cone; // xyz axis, w cutoff
+};
+
+// true when every triangle of the meshlet faces away from the camera, all in the meshlet's space
+bool meshlet_cone_culled(MeshletBounds bounds, vec3 camera_position)
+{
+    return dot(normalize(bounds.cone_apex.xyz - camera_position), bounds.cone.xyz) >= bounds.cone.w;
+}
@@ -0,0 +1,43 @@
+// matches lcf::VertexDecodeInfo and lcf::QuantizedVertex in render_assets/VertexEncoding.h
+// requires GL_EXT_buffer_reference
+
+struct VertexDecodeInfo
+{
+    vec4 position_offset;
+    vec4 position_scale;
+};
+
+struct QuantizedVertex
+{
+    uint position_xy; // unorm16 x2
+    uint position_z; // unorm16 in the low half
+    uint normal; // octahedral snorm16 x2
+    uint tangent; // octahedral snorm16 x2
+    uint uv; // half x2
+};
+
+layout(buffer_reference, std430) readonly buffer QuantizedVertexBufferAddress
+{
+    VertexDecodeInfo decode_info;
+    QuantizedVertex vertices[];
+};
+
+vec3 decode_octahedral(uint encoded)
+{
+    vec2 f = unpackSnorm2x16(encoded);
+    vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+    float t = max(-n.z, 0.0);
+    n.xy += mix(vec2(t), vec2(-t), greaterThanEqual(n.xy, vec2(0.0)));
+    return normalize(n);
+}
+
+vec3 decode_position(VertexDecodeInfo info, QuantizedVertex vertex)
+{
+    vec3 unorm = vec3(unpackUnorm2x16(vertex.position_xy), unpackUnorm2x16(vertex.position_z).x) * 65535.0;
+    return info.position_offset.xyz + info.position_scale.xyz * unorm;
+}
+
+vec2 decode_uv(QuantizedVertex vertex)
+{
+    return unpackHalf2x16(vertex.uv);
+}
@@ -0,0 +1,89 @@
+#version 460
+
+#extension GL_EXT_shader_16bit_storage : require
+#extension GL_EXT_shader_explicit_arithmetic_types_int64 : require
+#extension GL_EXT_buffer_reference : require
+#extension GL_EXT_debug_printf : require
+#extension GL_EXT_spirv_intrinsics : require
+
+#include "camera_uniform.glsl"
+
+#include "bindless_structs.glsl"
+
+#include "vertex_decode.glsl"
+
+layout(std430, set = 1, binding = 0) readonly buffer DrawMetaInfoBuffer {
+    uint draw_count;
+    DrawMetaInfo draw_meta_infos[];
+};
+
+layout(std430, set = 1, binding = 1) readonly buffer ObjectInfos {
+    uint64_t object_count;
+    ObjectInfo object_infos[];
+};
+
+layout(std430, set = 1, binding = 2) readonly buffer VisibleInstanceBuffer {
+    uint instance_count;
+    uint visible_instance_ids[];
+};
+
+layout(std430, set = 1, binding = 3) readonly buffer InstanceInfos {
+    InstanceInfo instance_infos[];
+};
+
+
+layout(buffer_reference, std430) readonly buffer IndexBufferAddress
+{ 
+	uint indices[];
+};
+
+layout(location = 0) out VS_OUT {
+    vec2 uv;
+    flat uint object_id;
+    vec3 world_position;
+    vec3 world_normal;
+    vec3 world_tangent;
+    vec3 world_bitangent;
+    vec3 view_direction;
+} vs_out;
+
+void main()
+{
+    DrawMetaInfo draw_meta_info = draw_meta_infos[gl_DrawID];
+    uint object_id = draw_meta_info.object_id;
+    uint instance_id = visible_instance_ids[gl_InstanceIndex];
+    // uint instance_id = gl_BaseInstance + gl_InstanceIndex;
+
+    ObjectInfo object_info = object_infos[object_id];
+    // the vertex buffer holds lcf::QuantizedVertexData, the decode info followed by the packed vertices
+    QuantizedVertexBufferAddress vertex_buffer = QuantizedVertexBufferAddress(object_info.vertex_buffer);
+    QuantizedVertex quantized_vertex = vertex_buffer.vertices[IndexBufferAddress(object_info.index_buffer).indices[gl_VertexIndex]];
+    vec3 position = decode_position(vertex_buffer.decode_info, quantized_vertex);
+    vec3 normal = decode_octahedral(quantized_vertex.normal);
+    vec3 tangent = decode_octahedral(quantized_vertex.tangent);
+
+    InstanceInfo instance_info = instance_infos[instance_id];
+    mat4 model = instance_info.transform;
+    mat3 model_3x3 = mat3(model);
+    mat3 normal_matrix = transpose(inverse(model_3x3));
+
+    vec4 world_pos = model * vec4(position, 1.0);
+
+    gl_Position = projection_view * world_pos;
+
+    vs_out.uv = decode_uv(quantized_vertex);
+    vs_out.object_id = object_id;
+    vs_out.world_position = world_pos.xyz;
+
+    // Transform normal and tangent to world space
+    vec3 N = normalize(normal_matrix * normal);
+    vec3 T = normalize(model_3x3 * tangent);
+    // Orthonormalize T with respect to N (Gram-Schmidt)
+    T = normalize(T - dot(T, N) * N);
+    vec3 B = cross(N, T);
+
+    vs_out.world_normal = N;
+    vs_out.world_tangent = T;
+    vs_out.world_bitangent = B;
+    vs_out.view_direction = normalize(camera_position - world_pos.xyz);
+}
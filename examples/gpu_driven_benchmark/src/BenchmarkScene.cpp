@@ -216,9 +216,7 @@ namespace lcf::benchmark {
                     VertexAttributeFlags::eTexCoord0 |
                     VertexAttributeFlags::eTangent),
                 geometry.getIndices());
-            BoundingSphere<float> sphere{
-                geometry.getAttributes<VertexAttribute::ePosition>()};
-            mesh.setBoundingSphere(sphere);
+            mesh.setBoundingSphere(geometry.getBoundingSphere());
         }
 
         for (const auto & material : model.getRenderPrimitives() | view_materials) {
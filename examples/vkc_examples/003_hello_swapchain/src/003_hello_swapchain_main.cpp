@@ -19,6 +19,7 @@
 #include <variant>
 #include <array>
 #include <optional>
+#include <algorithm>
 #include "log.h"
 
 using namespace lcf;
@@ -94,6 +95,16 @@ int main()
     }
     auto & surface = expected_surface.value();
 
+    //- present wait is optional here, only require it when every GPU can provide it so device selection is unaffected
+    vkc::DeviceExtensionManifest present_wait_manifest;
+    vkc::entry::register_present_wait(present_wait_manifest);
+    bool is_present_wait_available = std::ranges::all_of(instance_context.getInstance().enumeratePhysicalDevices(),
+        [&present_wait_manifest](vk::PhysicalDevice physical_device) {
+            return present_wait_manifest.getUnsupportedExtensionsMessage(physical_device).empty() and
+                present_wait_manifest.isRequiredFeaturesSupported(physical_device);
+        });
+    if (is_present_wait_available) { vkc::entry::register_present_wait(device_ext_manifest); }
+
     vkc::bs::PhysicalDeviceSelectInfo physical_device_select_info;
     physical_device_select_info.setRequiredDeviceExtensionManifest(device_ext_manifest)
         .setPreferredType(vk::PhysicalDeviceType::eDiscreteGpu);
@@ -122,6 +133,7 @@ int main()
     }
 
     vkc::wsi::Swapchain swapchain;
+    swapchain.enablePresentWait(device_ext_manifest).setMaxFrameLatency(2u);
     if (auto ec = swapchain.create(
         std::move(surface),
         device_context.getPhysicalDevice(),
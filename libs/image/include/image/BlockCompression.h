@@ -0,0 +1,27 @@
+#pragma once
+
+#include "image_enums.h"
+#include <expected>
+#include <system_error>
+
+namespace lcf {
+    class MipChain;
+
+    class BlockCompressionInfo
+    {
+        using Self = BlockCompressionInfo;
+    public:
+        Self & setCompression(BlockCompression compression) noexcept { m_compression = compression; return *this; }
+        Self & setQuality(CompressionQuality quality) noexcept { m_quality = quality; return *this; }
+        Self & setNormalMap(bool is_normal_map) noexcept { m_is_normal_map = is_normal_map; return *this; }
+        BlockCompression getCompression() const noexcept { return m_compression; }
+        CompressionQuality getQuality() const noexcept { return m_quality; }
+        bool isNormalMap() const noexcept { return m_is_normal_map; }
+    private:
+        BlockCompression m_compression = BlockCompression::eBC7;
+        CompressionQuality m_quality = CompressionQuality::eNormal;
+        bool m_is_normal_map = false; //- renormalizes xyz before keeping xy, only affects bc5
+    };
+
+    std::expected<MipChain, std::error_code> compress_mip_chain(const MipChain & mip_chain, const BlockCompressionInfo & info) noexcept; //- expects an uncompressed 8 bit chain
+}
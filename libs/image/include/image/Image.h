@@ -3,15 +3,23 @@
 #include "image_enums.h"
 #include <filesystem>
 #include "details/ImageVariant.h"
+#include "details/PixelAllocator.h"
 #include <span>
+#include <cstdio>
+#include <expected>
+#include <system_error>
 
 namespace lcf {
     class ImageInfo
     {
     public:
+        //- opens the file once and parses only the header
         ImageInfo(const std::filesystem::path & path);
+        //- probes a file that is already read or mapped, no io; the path only names it and picks the file type,
+        //- the header signature is used when the path has no known extension, e.g. embedded textures
+        ImageInfo(const std::filesystem::path & path, std::span<const std::byte> encoded_data);
         ~ImageInfo() noexcept = default;
-        ImageInfo(ImageInfo &) = default;
+        ImageInfo(const ImageInfo &) = default;
         ImageInfo & operator=(const ImageInfo &) = default;
         ImageInfo(ImageInfo &&) noexcept = default;
         ImageInfo & operator=(ImageInfo &&) noexcept = default;
@@ -31,13 +39,54 @@ namespace lcf {
         ImageFormat m_format = ImageFormat::eInvalid;
     };
 
+    struct EncodedImageDescription
+    {
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+        ImageFormat m_format = ImageFormat::eInvalid; //- the decoded format
+        size_t getSizeInBytes() const noexcept
+        {
+            return static_cast<size_t>(m_width) * m_height * enum_decode::get_channel_count(m_format) * enum_decode::get_bytes_per_channel(m_format);
+        }
+    };
+
+    //- reads the header only; without a specific format the native channel count and bit depth are reported
+    std::expected<EncodedImageDescription, std::error_code> peek_encoded_image(
+        std::span<const std::byte> data,
+        ImageFormat specific_format = ImageFormat::eInvalid) noexcept;
+
+    //- decodes straight into dst, e.g. an arena or a mapped staging range, without an intermediate pixel buffer;
+    //- fails with std::errc::no_buffer_space if dst is smaller than the decoded image. A few spare bytes let decoders
+    //- that pad their output, like jpeg, decode in place as well
+    std::error_code decode_image_into(
+        std::span<const std::byte> data,
+        std::span<std::byte> dst,
+        ImageFormat specific_format = ImageFormat::eInvalid) noexcept;
+    std::error_code decode_image_into(const ImageInfo & info, std::span<std::byte> dst, ImageFormat specific_format) noexcept;
+
+    class ImageSaveInfo
+    {
+        using Self = ImageSaveInfo;
+    public:
+        Self & setCompressionLevel(uint32_t level) noexcept { m_compression_level = level; return *this; }
+        Self & setQuality(uint32_t quality) noexcept { m_quality = quality; return *this; }
+        uint32_t getCompressionLevel() const noexcept { return m_compression_level; }
+        uint32_t getQuality() const noexcept { return m_quality; }
+    private:
+        uint32_t m_compression_level = 6; //- png, zlib level 0 to 9
+        uint32_t m_quality = 100; //- jpeg, 1 to 100
+    };
+
     class Image
     {
         using Self = Image;
-        using ImageVariant = details::ImageVariant<>; //todo use allocator
+        using PixelAllocator = details::PixelAllocator<unsigned char>;
+        using ImageVariant = details::ImageVariant<PixelAllocator>;
     public:
         Image() = default;
-        Image(uint32_t width, uint32_t height, ImageFormat format);
+        //- pixels come from the resource, by default the process wide PixelMemoryPool; it must outlive the image
+        explicit Image(std::pmr::memory_resource * memory_resource_p) noexcept : m_memory_resource_p(memory_resource_p) {}
+        Image(uint32_t width, uint32_t height, ImageFormat format, std::pmr::memory_resource * memory_resource_p = get_default_pixel_memory_pool());
         Image(const Image & other) = default;
         Image & operator=(const Image & other) = default;
         Image(Image && other) noexcept;
@@ -45,17 +94,25 @@ namespace lcf {
     private:
         Image(ImageVariant && image) noexcept;
         Image & operator=(ImageVariant && image);
+        //- gil decodes into the pixel type the file holds; that sets the format, then it converts when another one was asked for
+        std::error_code adoptDecodedImage(ImageVariant && image, ImageFormat specific_format) noexcept;
     public:
         std::error_code convertTo(ImageFormat format) noexcept;
         std::error_code convertToGpuFriendly() noexcept;
-        Self & resize(uint32_t width, uint32_t height, ImageSampler sampler) noexcept;
+        //- every sampler but nearest runs the separable float resampler for native 8, 16 bit and float formats
+        Self & resize(uint32_t width, uint32_t height, ImageSampler sampler, AlphaMode alpha_mode = AlphaMode::eStraight) noexcept;
         std::error_code loadFromFile(const ImageInfo & info) noexcept;
         std::error_code loadFromFile(const ImageInfo & info, ImageFormat specific_format) noexcept;
         std::error_code loadFromFileGpuFriendly(const ImageInfo & info) noexcept; //- RGB -> RGBA
         std::error_code loadFromMemoryEncoded(std::span<const std::byte> data) noexcept;
+        //- pairs with ImageInfo(path, encoded_data) so a file read once is probed and decoded from the same buffer
+        std::error_code loadFromMemoryEncoded(std::span<const std::byte> data, ImageFormat specific_format) noexcept;
         std::error_code loadFromMemoryPixels(std::span<const std::byte> data, uint32_t width, ImageFormat src_format) noexcept;
         std::error_code loadFromMemoryPixels(std::span<const std::byte> data, uint32_t width, ImageFormat src_format, ImageFormat dst_format) noexcept;
-        std::error_code saveToFile(const std::filesystem::path & path) const noexcept;
+        //- png and jpeg encode row blocks in parallel and write them as they finish; the file is removed on failure
+        std::error_code saveToFile(const std::filesystem::path & path, const ImageSaveInfo & info = {}) const noexcept;
+        //- streams into an open file, e.g. one from fdopen or a pipe; the file is neither flushed nor closed
+        std::error_code saveToFile(std::FILE * file_p, ImageFileType file_type, const ImageSaveInfo & info = {}) const noexcept;
         std::span<std::byte> getDataSpan() noexcept;
         std::span<const std::byte> getDataSpan() const noexcept;
         ImageFormat getDecodeFormat() const noexcept { return m_format; }
@@ -66,8 +123,11 @@ namespace lcf {
         uint32_t getWidth() const noexcept { return static_cast<uint32_t>(m_image.width()); }
         uint32_t getHeight() const noexcept { return static_cast<uint32_t>(m_image.height()); }
         std::pair<uint32_t, uint32_t> getDimensions() const noexcept { return { this->getWidth(), this->getHeight() }; }
+        std::pmr::memory_resource * getMemoryResource() const noexcept { return m_memory_resource_p; }
+        void setMemoryResource(std::pmr::memory_resource * memory_resource_p) noexcept { m_memory_resource_p = memory_resource_p; } //- for the next allocation
     private:
         ImageVariant m_image;
         ImageFormat m_format;
+        std::pmr::memory_resource * m_memory_resource_p = get_default_pixel_memory_pool();
     };
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "image_enums.h"
+#include <vector>
+#include <span>
+#include <expected>
+#include <system_error>
+
+namespace lcf {
+    class Image;
+
+    class MipChain //- every level of an image in one contiguous allocation, level 0 first, optionally block compressed
+    {
+        using Self = MipChain;
+    public:
+        struct Level
+        {
+            uint32_t m_width = 0;
+            uint32_t m_height = 0;
+            size_t m_offset_in_bytes = 0;
+            size_t m_size_in_bytes = 0;
+        };
+        using LevelList = std::vector<Level>;
+    public:
+        MipChain() = default;
+        MipChain(uint32_t width, uint32_t height, ImageFormat format, BlockCompression compression = BlockCompression::eNone);
+        ~MipChain() noexcept = default;
+        MipChain(const Self &) = default;
+        Self & operator=(const Self &) = default;
+        MipChain(Self &&) noexcept = default;
+        Self & operator=(Self &&) noexcept = default;
+    public:
+        ImageFormat getFormat() const noexcept { return m_format; } //- texel format before compression
+        BlockCompression getCompression() const noexcept { return m_compression; }
+        bool isCompressed() const noexcept { return m_compression != BlockCompression::eNone; }
+        uint32_t getWidth() const noexcept { return m_levels.empty() ? 0 : m_levels.front().m_width; }
+        uint32_t getHeight() const noexcept { return m_levels.empty() ? 0 : m_levels.front().m_height; }
+        uint32_t getLevelCount() const noexcept { return static_cast<uint32_t>(m_levels.size()); }
+        const Level & getLevel(uint32_t level) const noexcept { return m_levels[level]; }
+        std::span<const Level> getLevels() const noexcept { return m_levels; }
+        std::span<std::byte> getLevelDataSpan(uint32_t level) noexcept;
+        std::span<const std::byte> getLevelDataSpan(uint32_t level) const noexcept;
+        std::span<std::byte> getDataSpan() noexcept { return m_data; }
+        std::span<const std::byte> getDataSpan() const noexcept { return m_data; }
+    private:
+        ImageFormat m_format = ImageFormat::eInvalid;
+        BlockCompression m_compression = BlockCompression::eNone;
+        LevelList m_levels;
+        std::vector<std::byte> m_data;
+    };
+
+    uint32_t compute_mip_level_count(uint32_t width, uint32_t height) noexcept; //- full chain down to 1x1
+
+    std::expected<MipChain, std::error_code> generate_mip_chain(const Image & image, MipFilter filter, ColorTransfer transfer) noexcept;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+namespace lcf {
+    //- keeps freed pixel buffers for reuse instead of handing multi megabyte blocks back to the system between loads.
+    //- Requests from k_min_pooled_size up are rounded to size classes with four steps per power of two, so a block
+    //- wastes at most a quarter of its size; smaller ones go straight upstream. Every block records its capacity, so
+    //- a deallocation may pass any size up to the one allocated. Thread safe
+    class PixelMemoryPool : public std::pmr::memory_resource
+    {
+        using Self = PixelMemoryPool;
+        using BlockList = std::vector<std::byte *>;
+        using FreeBlockMap = std::unordered_map<size_t, BlockList>; //- capacity -> blocks, most recently freed last
+    public:
+        static constexpr size_t k_min_pooled_size = 64 * 1024;
+        static constexpr size_t k_default_max_cached_bytes = 256 * 1024 * 1024;
+    public:
+        PixelMemoryPool(
+            size_t max_cached_bytes = k_default_max_cached_bytes,
+            std::pmr::memory_resource * upstream_p = std::pmr::new_delete_resource()) noexcept;
+        ~PixelMemoryPool() noexcept override;
+        PixelMemoryPool(const Self &) = delete;
+        Self & operator=(const Self &) = delete;
+        PixelMemoryPool(Self &&) = delete;
+        Self & operator=(Self &&) = delete;
+    public:
+        void release() noexcept; //- frees the cached blocks, live allocations are untouched
+        size_t getCachedBytes() const noexcept;
+        size_t getMaxCachedBytes() const noexcept { return m_max_cached_bytes; }
+    private:
+        void * do_allocate(size_t bytes, size_t alignment) override;
+        void do_deallocate(void * data_p, size_t bytes, size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource & other) const noexcept override { return this == &other; }
+    private:
+        std::pmr::memory_resource * m_upstream_p;
+        size_t m_max_cached_bytes;
+        mutable std::mutex m_mutex;
+        FreeBlockMap m_free_blocks;
+        size_t m_cached_bytes = 0;
+    };
+
+    //- a process wide pool that is never destroyed, so images in static storage can still free into it
+    PixelMemoryPool * get_default_pixel_memory_pool() noexcept;
+}
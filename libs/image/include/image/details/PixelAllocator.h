@@ -0,0 +1,48 @@
+#pragma once
+
+#include "image/PixelMemoryPool.h"
+#include <memory_resource>
+#include <type_traits>
+#include <cstddef>
+
+namespace lcf::details {
+    inline constexpr size_t k_pixel_alignment = 64; //- a cache line, enough for any simd load
+    inline constexpr size_t k_pixel_tail_padding = 1; //- stb's jpeg decoder asks for one byte past the pixels, reserved so it decodes in place
+
+    //- std allocator over a memory resource. std::pmr::polymorphic_allocator is not assignable, which gil images
+    //- need for swap and move assignment; this one is, and it travels with the pixels
+    template <typename T>
+    class PixelAllocator
+    {
+        template <typename U> friend class PixelAllocator;
+    public:
+        using value_type = T;
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+        template <typename U>
+        struct rebind { using other = PixelAllocator<U>; };
+    public:
+        PixelAllocator() noexcept : m_resource_p(get_default_pixel_memory_pool()) {}
+        PixelAllocator(std::pmr::memory_resource * resource_p) noexcept : m_resource_p(resource_p) {}
+        template <typename U>
+        PixelAllocator(const PixelAllocator<U> & other) noexcept : m_resource_p(other.m_resource_p) {}
+    public:
+        T * allocate(size_t count)
+        {
+            return static_cast<T *>(m_resource_p->allocate(count * sizeof(T) + k_pixel_tail_padding, k_pixel_alignment));
+        }
+        void deallocate(T * data_p, size_t count) noexcept
+        {
+            m_resource_p->deallocate(data_p, count * sizeof(T) + k_pixel_tail_padding, k_pixel_alignment);
+        }
+        std::pmr::memory_resource * getResource() const noexcept { return m_resource_p; }
+        template <typename U>
+        bool operator==(const PixelAllocator<U> & other) const noexcept
+        {
+            return m_resource_p == other.m_resource_p or m_resource_p->is_equal(*other.m_resource_p);
+        }
+    private:
+        std::pmr::memory_resource * m_resource_p;
+    };
+}
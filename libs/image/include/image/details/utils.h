@@ -85,25 +85,25 @@ namespace lcf::details {
     }
 
     template <typename Allocator = std::allocator<unsigned char>>
-    ImageVariant<Allocator> generate_image(uint32_t width, uint32_t height, ImageFormat format)
+    ImageVariant<Allocator> generate_image(uint32_t width, uint32_t height, ImageFormat format, const Allocator & allocator = Allocator())
     {
         switch (format) {
-            case ImageFormat::eGray8Uint: { return gray8_image_t<Allocator>(width, height); }
-            case ImageFormat::eGray16Uint: { return gray16_image_t<Allocator>(width, height); }
-            case ImageFormat::eGray16Float: { return gray16f_image_t<Allocator>(width, height); }
-            case ImageFormat::eGray32Float: { return gray32f_image_t<Allocator>(width, height); }
-            case ImageFormat::eGrayAlpha8Uint: { return gray_alpha8_image_t<Allocator>(width, height); }
-            case ImageFormat::eGrayAlpha16Uint: { return gray_alpha16_image_t<Allocator>(width, height); }
-            case ImageFormat::eGrayAlpha16Float: { return gray_alpha16f_image_t<Allocator>(width, height); }
-            case ImageFormat::eGrayAlpha32Float: { return gray_alpha32f_image_t<Allocator>(width, height); }
-            case ImageFormat::eRGB8Uint: { return rgb8_image_t<Allocator>(width, height); }
-            case ImageFormat::eRGB16Uint: { return rgb16_image_t<Allocator>(width, height); }
-            case ImageFormat::eRGB16Float: { return rgb16f_image_t<Allocator>(width, height); }
-            case ImageFormat::eRGB32Float: { return rgb32f_image_t<Allocator>(width, height); }
-            case ImageFormat::eRGBA8Uint: { return rgba8_image_t<Allocator>(width, height); }    
-            case ImageFormat::eRGBA16Uint: { return rgba16_image_t<Allocator>(width, height); }
-            case ImageFormat::eRGBA16Float: { return rgba16f_image_t<Allocator>(width, height); }
-            case ImageFormat::eRGBA32Float: { return rgba32f_image_t<Allocator>(width, height); }
+            case ImageFormat::eGray8Uint: { return gray8_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eGray16Uint: { return gray16_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eGray16Float: { return gray16f_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eGray32Float: { return gray32f_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eGrayAlpha8Uint: { return gray_alpha8_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eGrayAlpha16Uint: { return gray_alpha16_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eGrayAlpha16Float: { return gray_alpha16f_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eGrayAlpha32Float: { return gray_alpha32f_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eRGB8Uint: { return rgb8_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eRGB16Uint: { return rgb16_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eRGB16Float: { return rgb16f_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eRGB32Float: { return rgb32f_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eRGBA8Uint: { return rgba8_image_t<Allocator>(width, height, 0, allocator); }    
+            case ImageFormat::eRGBA16Uint: { return rgba16_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eRGBA16Float: { return rgba16f_image_t<Allocator>(width, height, 0, allocator); }
+            case ImageFormat::eRGBA32Float: { return rgba32f_image_t<Allocator>(width, height, 0, allocator); }
             default: break;
         }
         return {};
@@ -133,4 +133,26 @@ namespace lcf::details {
         }
         return {};
     }
+
+    template <typename Pixel>
+    constexpr ImageFormat get_image_format_of() noexcept
+    {
+        using channel_t = typename boost::gil::channel_type<Pixel>::type;
+        constexpr auto channel_count = static_cast<uint8_t>(boost::gil::num_channels<Pixel>::value);
+        PixelDataType pixel_data_type = PixelDataType::eFloat32;
+        if constexpr (sizeof(channel_t) == 1) { pixel_data_type = PixelDataType::eUint8; }
+        else if constexpr (std::is_integral_v<channel_t>) { pixel_data_type = PixelDataType::eUint16; }
+        else if constexpr (sizeof(channel_t) == 2) { pixel_data_type = PixelDataType::eFloat16; }
+        return enum_decode::decode_image_format(pixel_data_type, channel_count);
+    }
+
+    //- the format of whichever image the variant holds, eInvalid when its pixel type has no ImageFormat
+    template <typename ImageVar>
+    ImageFormat get_image_format(const ImageVar & image_var) noexcept
+    {
+        return boost::variant2::visit([](const auto & image) {
+            using image_t = std::remove_cvref_t<decltype(image)>;
+            return get_image_format_of<typename image_t::value_type>();
+        }, image_var);
+    }
 }
\ No newline at end of file
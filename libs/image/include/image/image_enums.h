@@ -27,7 +27,45 @@ namespace lcf {
     enum class ImageSampler : uint8_t
     {
         eNearest,
+        eLinear, //- tent, widened when downscaling so every source texel contributes
+        eBox,
+        eMitchell, //- B = C = 1/3, little ringing, slightly soft
+        eLanczos3, //- sharpest, may ring around hard edges
+    };
+
+    enum class AlphaMode : uint8_t
+    {
+        eStraight, //- every channel is filtered on its own
+        ePremultiplied, //- color is weighted by alpha while filtering, keeps transparent texels from bleeding their color
+    };
+
+    enum class MipFilter : uint8_t
+    {
+        eBox,
+        eKaiser,
+    };
+
+    enum class ColorTransfer : uint8_t
+    {
         eLinear,
+        eSRGB, //- color channels are sRGB encoded, alpha is always linear
+    };
+
+    enum class BlockCompression : uint8_t //- 4x4 texel blocks
+    {
+        eNone,
+        eBC1, //- rgb with 1 bit alpha
+        eBC3, //- rgba, bc1 colors with a bc4 alpha block
+        eBC4, //- single channel
+        eBC5, //- two channels, e.g. tangent space normal xy
+        eBC7, //- rgba
+    };
+
+    enum class CompressionQuality : uint8_t
+    {
+        eFast,
+        eNormal,
+        eHigh,
     };
 
     enum class ImageFlags : uint8_t
@@ -193,4 +231,16 @@ namespace lcf::enum_decode {
     {
         return is_native_color_space(get_color_space(format));
     }
+
+    inline constexpr uint32_t get_block_size_in_bytes(BlockCompression compression) noexcept
+    {
+        switch (compression) {
+            case BlockCompression::eBC1:
+            case BlockCompression::eBC4: { return 8; }
+            case BlockCompression::eBC3:
+            case BlockCompression::eBC5:
+            case BlockCompression::eBC7: { return 16; }
+            default: return 0;
+        }
+    }
 }
\ No newline at end of file
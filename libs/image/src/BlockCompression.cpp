@@ -0,0 +1,469 @@
+#include "image/BlockCompression.h"
+#include "image/MipChain.h"
+#include "details/parallel_rows.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LCF_IMAGE_SSE2
+#include <emmintrin.h>
+#endif
+
+using namespace lcf;
+
+namespace {
+    constexpr uint32_t k_block_rows_per_task = 4;
+    constexpr uint32_t k_block_texel_count = 16;
+    constexpr std::array<uint32_t, 16> k_bc7_index_weights = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+}
+
+//- auxiliary structs begin
+using Texel = std::array<float, 4>; //- rgba in [0, 255]
+
+using BlockIndices = std::array<uint8_t, k_block_texel_count>;
+
+struct BlockTexels //- one 4x4 block widened to float rgba, partial blocks replicate their edge texels
+{
+    std::array<Texel, k_block_texel_count> m_texels;
+};
+
+struct BlockBitWriter //- little endian bit stream of one 128 bit block
+{
+    void write(uint64_t value, uint32_t bit_count) noexcept
+    {
+        for (uint32_t i = 0; i < bit_count; ++i, ++m_offset) {
+            m_bits[m_offset >> 6] |= ((value >> i) & 1ull) << (m_offset & 63);
+        }
+    }
+    uint64_t m_bits[2] = {};
+    uint32_t m_offset = 0;
+};
+//- auxiliary structs end
+
+//- auxiliary function forward declarations begin
+BlockTexels fetch_block(const uint8_t * src_p, uint32_t width, uint32_t height, uint32_t channel_count, uint32_t block_x, uint32_t block_y, bool is_normal_map) noexcept;
+
+float compute_distance(const Texel & lhs, const Texel & rhs, const Texel & channel_weights) noexcept;
+
+uint32_t find_nearest(const Texel & texel, std::span<const Texel> palette, const Texel & channel_weights, float & distance) noexcept;
+
+std::pair<Texel, Texel> compute_endpoints(const BlockTexels & block, uint16_t texel_mask, const Texel & channel_weights, CompressionQuality quality) noexcept;
+
+bool refine_endpoints(const BlockTexels & block, uint16_t texel_mask, const BlockIndices & indices, std::span<const float> index_weights, Texel & endpoint0, Texel & endpoint1) noexcept;
+
+uint16_t to_rgb565(const Texel & color) noexcept;
+
+Texel from_rgb565(uint16_t color) noexcept;
+
+void encode_bc1(const BlockTexels & block, CompressionQuality quality, bool allow_transparency, uint8_t * dst_p) noexcept;
+
+void encode_bc4(const std::array<float, k_block_texel_count> & values, CompressionQuality quality, uint8_t * dst_p) noexcept;
+
+void encode_bc7(const BlockTexels & block, CompressionQuality quality, uint8_t * dst_p) noexcept;
+
+void encode_block(const BlockTexels & block, const BlockCompressionInfo & info, uint8_t * dst_p) noexcept;
+//- auxiliary function forward declarations end
+
+std::expected<MipChain, std::error_code> lcf::compress_mip_chain(const MipChain & mip_chain, const BlockCompressionInfo & info) noexcept
+{
+    if (mip_chain.isCompressed() or info.getCompression() == BlockCompression::eNone) {
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    ImageFormat format = mip_chain.getFormat();
+    if (not enum_decode::is_native_image_format(format) or enum_decode::get_pixel_data_type(format) != PixelDataType::eUint8) {
+        return std::unexpected(std::make_error_code(std::errc::not_supported));
+    }
+    uint32_t channel_count = enum_decode::get_channel_count(format);
+    uint32_t block_size_in_bytes = enum_decode::get_block_size_in_bytes(info.getCompression());
+    MipChain compressed_mip_chain {mip_chain.getWidth(), mip_chain.getHeight(), format, info.getCompression()};
+    for (uint32_t i = 0; i < mip_chain.getLevelCount(); ++i) {
+        const auto & level = mip_chain.getLevel(i);
+        const auto * src_p = reinterpret_cast<const uint8_t *>(mip_chain.getLevelDataSpan(i).data());
+        auto * dst_p = reinterpret_cast<uint8_t *>(compressed_mip_chain.getLevelDataSpan(i).data());
+        uint32_t block_column_count = (level.m_width + 3) / 4;
+        uint32_t block_row_count = (level.m_height + 3) / 4;
+        details::parallel_for_rows(block_row_count, k_block_rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+            for (uint32_t block_y = row_begin; block_y < row_end; ++block_y) {
+                for (uint32_t block_x = 0; block_x < block_column_count; ++block_x) {
+                    auto block = fetch_block(src_p, level.m_width, level.m_height, channel_count, block_x, block_y, info.isNormalMap());
+                    encode_block(block, info, dst_p + (size_t(block_y) * block_column_count + block_x) * block_size_in_bytes);
+                }
+            }
+        });
+    }
+    return compressed_mip_chain;
+}
+
+//- auxiliary function implementations begin
+
+BlockTexels fetch_block(const uint8_t * src_p, uint32_t width, uint32_t height, uint32_t channel_count, uint32_t block_x, uint32_t block_y, bool is_normal_map) noexcept
+{
+    BlockTexels block;
+    for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+        uint32_t x = std::min(block_x * 4 + i % 4, width - 1);
+        uint32_t y = std::min(block_y * 4 + i / 4, height - 1);
+        const uint8_t * texel_p = src_p + (size_t(y) * width + x) * channel_count;
+        auto & texel = block.m_texels[i];
+        switch (channel_count) {
+            case 1: { texel = {float(texel_p[0]), float(texel_p[0]), float(texel_p[0]), 255.0f}; } break;
+            case 2: { texel = {float(texel_p[0]), float(texel_p[0]), float(texel_p[0]), float(texel_p[1])}; } break;
+            case 3: { texel = {float(texel_p[0]), float(texel_p[1]), float(texel_p[2]), 255.0f}; } break;
+            default: { texel = {float(texel_p[0]), float(texel_p[1]), float(texel_p[2]), float(texel_p[3])}; } break;
+        }
+        if (not is_normal_map) { continue; }
+        float normal[3] = {texel[0] / 127.5f - 1.0f, texel[1] / 127.5f - 1.0f, texel[2] / 127.5f - 1.0f};
+        float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if (length < 1e-6f) { continue; }
+        for (uint32_t c = 0; c < 3; ++c) { texel[c] = (normal[c] / length + 1.0f) * 127.5f; } //- filtered mips shorten normals, shaders rebuild z assuming unit length
+    }
+    return block;
+}
+
+float compute_distance(const Texel & lhs, const Texel & rhs, const Texel & channel_weights) noexcept
+{
+#if defined(LCF_IMAGE_SSE2)
+    __m128 diff_v = _mm_sub_ps(_mm_loadu_ps(lhs.data()), _mm_loadu_ps(rhs.data()));
+    __m128 sum_v = _mm_mul_ps(_mm_mul_ps(diff_v, diff_v), _mm_loadu_ps(channel_weights.data()));
+    sum_v = _mm_add_ps(sum_v, _mm_shuffle_ps(sum_v, sum_v, _MM_SHUFFLE(1, 0, 3, 2)));
+    sum_v = _mm_add_ss(sum_v, _mm_shuffle_ps(sum_v, sum_v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtss_f32(sum_v);
+#else
+    float sum = 0.0f;
+    for (uint32_t c = 0; c < 4; ++c) {
+        float diff = lhs[c] - rhs[c];
+        sum += diff * diff * channel_weights[c];
+    }
+    return sum;
+#endif
+}
+
+uint32_t find_nearest(const Texel & texel, std::span<const Texel> palette, const Texel & channel_weights, float & distance) noexcept
+{
+    uint32_t nearest_index = 0;
+    distance = std::numeric_limits<float>::max();
+    for (uint32_t i = 0; i < palette.size(); ++i) {
+        float candidate_distance = compute_distance(texel, palette[i], channel_weights);
+        if (candidate_distance >= distance) { continue; }
+        distance = candidate_distance;
+        nearest_index = i;
+    }
+    return nearest_index;
+}
+
+std::pair<Texel, Texel> compute_endpoints(const BlockTexels & block, uint16_t texel_mask, const Texel & channel_weights, CompressionQuality quality) noexcept
+{
+    Texel min_texel, max_texel, mean = {};
+    min_texel.fill(std::numeric_limits<float>::max());
+    max_texel.fill(std::numeric_limits<float>::lowest());
+    uint32_t texel_count = 0;
+    for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+        if (not (texel_mask & (1u << i))) { continue; }
+        for (uint32_t c = 0; c < 4; ++c) {
+            min_texel[c] = std::min(min_texel[c], block.m_texels[i][c]);
+            max_texel[c] = std::max(max_texel[c], block.m_texels[i][c]);
+            mean[c] += block.m_texels[i][c];
+        }
+        ++texel_count;
+    }
+    if (texel_count == 0) { return {Texel {}, Texel {}}; }
+    for (uint32_t c = 0; c < 4; ++c) {
+        if (channel_weights[c] == 0.0f) { min_texel[c] = max_texel[c] = 255.0f; } //- unused channel, keep it at the decoder's default
+    }
+    if (quality == CompressionQuality::eFast) { return {max_texel, min_texel}; }
+
+    for (float & value : mean) { value /= texel_count; }
+    float covariance[4][4] = {};
+    for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+        if (not (texel_mask & (1u << i))) { continue; }
+        Texel diff;
+        for (uint32_t c = 0; c < 4; ++c) { diff[c] = (block.m_texels[i][c] - mean[c]) * (channel_weights[c] != 0.0f); }
+        for (uint32_t r = 0; r < 4; ++r) {
+            for (uint32_t c = 0; c < 4; ++c) { covariance[r][c] += diff[r] * diff[c]; }
+        }
+    }
+    Texel axis;
+    for (uint32_t c = 0; c < 4; ++c) { axis[c] = (max_texel[c] - min_texel[c]) * (channel_weights[c] != 0.0f); }
+    for (uint32_t iteration = 0; iteration < 8; ++iteration) { //- power iteration towards the principal axis
+        Texel next_axis = {};
+        for (uint32_t r = 0; r < 4; ++r) {
+            for (uint32_t c = 0; c < 4; ++c) { next_axis[r] += covariance[r][c] * axis[c]; }
+        }
+        float length = std::sqrt(next_axis[0] * next_axis[0] + next_axis[1] * next_axis[1] + next_axis[2] * next_axis[2] + next_axis[3] * next_axis[3]);
+        if (length < 1e-6f) { break; }
+        for (uint32_t c = 0; c < 4; ++c) { axis[c] = next_axis[c] / length; }
+    }
+    float axis_length_sq = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3];
+    if (axis_length_sq < 1e-12f) { return {max_texel, min_texel}; } //- flat block
+    float min_t = std::numeric_limits<float>::max(), max_t = std::numeric_limits<float>::lowest();
+    for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+        if (not (texel_mask & (1u << i))) { continue; }
+        float t = 0.0f;
+        for (uint32_t c = 0; c < 4; ++c) { t += (block.m_texels[i][c] - mean[c]) * axis[c]; }
+        min_t = std::min(min_t, t / axis_length_sq);
+        max_t = std::max(max_t, t / axis_length_sq);
+    }
+    Texel endpoint0, endpoint1;
+    for (uint32_t c = 0; c < 4; ++c) {
+        endpoint0[c] = channel_weights[c] == 0.0f ? 255.0f : std::clamp(mean[c] + axis[c] * max_t, 0.0f, 255.0f);
+        endpoint1[c] = channel_weights[c] == 0.0f ? 255.0f : std::clamp(mean[c] + axis[c] * min_t, 0.0f, 255.0f);
+    }
+    return {endpoint0, endpoint1};
+}
+
+bool refine_endpoints(const BlockTexels & block, uint16_t texel_mask, const BlockIndices & indices, std::span<const float> index_weights, Texel & endpoint0, Texel & endpoint1) noexcept
+{
+    //- least squares fit of both endpoints for fixed indices, texel = (1 - w) * endpoint0 + w * endpoint1
+    float a = 0.0f, b = 0.0f, c = 0.0f;
+    Texel x = {}, y = {};
+    for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+        if (not (texel_mask & (1u << i))) { continue; }
+        float weight1 = index_weights[indices[i]];
+        float weight0 = 1.0f - weight1;
+        a += weight0 * weight0;
+        b += weight1 * weight1;
+        c += weight0 * weight1;
+        for (uint32_t k = 0; k < 4; ++k) {
+            x[k] += weight0 * block.m_texels[i][k];
+            y[k] += weight1 * block.m_texels[i][k];
+        }
+    }
+    float determinant = a * b - c * c;
+    if (std::abs(determinant) < 1e-6f) { return false; }
+    for (uint32_t k = 0; k < 4; ++k) {
+        endpoint0[k] = std::clamp((b * x[k] - c * y[k]) / determinant, 0.0f, 255.0f);
+        endpoint1[k] = std::clamp((a * y[k] - c * x[k]) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+uint16_t to_rgb565(const Texel & color) noexcept
+{
+    auto r = static_cast<uint16_t>(std::lround(color[0] * 31.0f / 255.0f));
+    auto g = static_cast<uint16_t>(std::lround(color[1] * 63.0f / 255.0f));
+    auto b = static_cast<uint16_t>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+Texel from_rgb565(uint16_t color) noexcept
+{
+    uint32_t r = (color >> 11) & 0x1F, g = (color >> 5) & 0x3F, b = color & 0x1F;
+    return {float((r << 3) | (r >> 2)), float((g << 2) | (g >> 4)), float((b << 3) | (b >> 2)), 255.0f};
+}
+
+void encode_bc1(const BlockTexels & block, CompressionQuality quality, bool allow_transparency, uint8_t * dst_p) noexcept
+{
+    constexpr Texel channel_weights = {1.0f, 1.0f, 1.0f, 0.0f};
+    constexpr float four_color_weights[] = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+    uint16_t opaque_mask = 0xFFFF;
+    if (allow_transparency) {
+        for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+            if (block.m_texels[i][3] < 128.0f) { opaque_mask &= ~(1u << i); }
+        }
+    }
+    bool is_three_color = opaque_mask != 0xFFFF; //- index 3 decodes to transparent black
+    auto [endpoint0, endpoint1] = compute_endpoints(block, opaque_mask, channel_weights, quality);
+
+    uint16_t best_colors[2] = {};
+    BlockIndices best_indices = {};
+    float best_error = std::numeric_limits<float>::max();
+    uint32_t iteration_count = quality == CompressionQuality::eHigh ? 3 : 1;
+    for (uint32_t iteration = 0; iteration < iteration_count; ++iteration) {
+        uint16_t color0 = to_rgb565(endpoint0), color1 = to_rgb565(endpoint1);
+        if (is_three_color ? color0 > color1 : color0 < color1) { std::swap(color0, color1); } //- endpoint order selects the decode mode
+        Texel palette[4] = {from_rgb565(color0), from_rgb565(color1)};
+        for (uint32_t c = 0; c < 3; ++c) {
+            if (is_three_color) {
+                palette[2][c] = (palette[0][c] + palette[1][c]) * 0.5f;
+                palette[3][c] = 0.0f;
+            } else {
+                palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+                palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+            }
+        }
+        BlockIndices indices = {};
+        float error = 0.0f;
+        for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+            if (not (opaque_mask & (1u << i))) { indices[i] = 3; continue; }
+            float distance = 0.0f;
+            indices[i] = static_cast<uint8_t>(find_nearest(block.m_texels[i], std::span(palette, is_three_color ? 3 : 4), channel_weights, distance));
+            error += distance;
+        }
+        if (error < best_error) {
+            best_error = error;
+            best_colors[0] = color0;
+            best_colors[1] = color1;
+            best_indices = indices;
+        }
+        if (is_three_color or iteration + 1 == iteration_count) { break; }
+        endpoint0 = palette[0];
+        endpoint1 = palette[1];
+        if (not refine_endpoints(block, opaque_mask, indices, four_color_weights, endpoint0, endpoint1)) { break; }
+    }
+    uint32_t packed_indices = 0;
+    for (uint32_t i = 0; i < k_block_texel_count; ++i) { packed_indices |= uint32_t(best_indices[i]) << (2 * i); }
+    std::memcpy(dst_p, best_colors, sizeof(best_colors));
+    std::memcpy(dst_p + 4, &packed_indices, sizeof(packed_indices));
+}
+
+void encode_bc4(const std::array<float, k_block_texel_count> & values, CompressionQuality quality, uint8_t * dst_p) noexcept
+{
+    auto evaluate = [&values](uint32_t value0, uint32_t value1, BlockIndices & indices) {
+        float palette[8] = {float(value0), float(value1)};
+        if (value0 > value1) {
+            for (uint32_t i = 2; i < 8; ++i) { palette[i] = ((8 - i) * palette[0] + (i - 1) * palette[1]) / 7.0f; }
+        } else {
+            for (uint32_t i = 2; i < 6; ++i) { palette[i] = ((6 - i) * palette[0] + (i - 1) * palette[1]) / 5.0f; }
+            palette[6] = 0.0f;
+            palette[7] = 255.0f;
+        }
+        float error = 0.0f;
+        for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+            float best_distance = std::numeric_limits<float>::max();
+            for (uint32_t k = 0; k < 8; ++k) {
+                float distance = (values[i] - palette[k]) * (values[i] - palette[k]);
+                if (distance >= best_distance) { continue; }
+                best_distance = distance;
+                indices[i] = static_cast<uint8_t>(k);
+            }
+            error += best_distance;
+        }
+        return error;
+    };
+    auto [min_it, max_it] = std::ranges::minmax_element(values);
+    uint32_t best_values[2] = {static_cast<uint32_t>(std::lround(*max_it)), static_cast<uint32_t>(std::lround(*min_it))};
+    BlockIndices best_indices = {};
+    float best_error = evaluate(best_values[0], best_values[1], best_indices);
+    auto try_endpoints = [&](int32_t value0, int32_t value1) {
+        if (value0 < 0 or value0 > 255 or value1 < 0 or value1 > 255) { return; }
+        BlockIndices indices = {};
+        float error = evaluate(value0, value1, indices);
+        if (error >= best_error) { return; }
+        best_error = error;
+        best_values[0] = value0;
+        best_values[1] = value1;
+        best_indices = indices;
+    };
+    if (quality != CompressionQuality::eFast and best_error > 0.0f) { //- six value mode spends two indices on exact 0 and 255
+        float inner_min = 255.0f, inner_max = 0.0f;
+        for (float value : values) {
+            if (value == 0.0f or value == 255.0f) { continue; }
+            inner_min = std::min(inner_min, value);
+            inner_max = std::max(inner_max, value);
+        }
+        if (inner_min <= inner_max) { try_endpoints(std::lround(inner_min), std::lround(inner_max)); }
+    }
+    if (quality == CompressionQuality::eHigh and best_error > 0.0f) {
+        int32_t value0 = best_values[0], value1 = best_values[1];
+        for (int32_t offset0 = -2; offset0 <= 2; ++offset0) {
+            for (int32_t offset1 = -2; offset1 <= 2; ++offset1) { try_endpoints(value0 + offset0, value1 + offset1); }
+        }
+    }
+    uint64_t packed_indices = 0;
+    for (uint32_t i = 0; i < k_block_texel_count; ++i) { packed_indices |= uint64_t(best_indices[i]) << (3 * i); }
+    dst_p[0] = static_cast<uint8_t>(best_values[0]);
+    dst_p[1] = static_cast<uint8_t>(best_values[1]);
+    std::memcpy(dst_p + 2, &packed_indices, 6);
+}
+
+void encode_bc7(const BlockTexels & block, CompressionQuality quality, uint8_t * dst_p) noexcept
+{
+    //- mode 6 only: one subset, rgba 7.7.7.7 endpoints with a p-bit each and 4 bit indices
+    constexpr Texel channel_weights = {1.0f, 1.0f, 1.0f, 1.0f};
+    static const auto s_index_weights = [] {
+        std::array<float, 16> weights;
+        for (uint32_t i = 0; i < weights.size(); ++i) { weights[i] = k_bc7_index_weights[i] / 64.0f; }
+        return weights;
+    }();
+    auto quantize = [](const Texel & endpoint, uint32_t (&quantized)[4], uint32_t & p_bit) {
+        float best_error = std::numeric_limits<float>::max();
+        for (uint32_t p = 0; p < 2; ++p) {
+            uint32_t candidate[4];
+            float error = 0.0f;
+            for (uint32_t c = 0; c < 4; ++c) {
+                candidate[c] = static_cast<uint32_t>(std::clamp<long>(std::lround((endpoint[c] - p) * 0.5f), 0, 127));
+                float diff = endpoint[c] - float((candidate[c] << 1) | p);
+                error += diff * diff;
+            }
+            if (error >= best_error) { continue; }
+            best_error = error;
+            p_bit = p;
+            std::copy_n(candidate, 4, quantized);
+        }
+    };
+    auto [endpoint0, endpoint1] = compute_endpoints(block, 0xFFFF, channel_weights, quality);
+
+    uint32_t best_quantized[2][4] = {}, best_p_bits[2] = {};
+    BlockIndices best_indices = {};
+    float best_error = std::numeric_limits<float>::max();
+    uint32_t iteration_count = quality == CompressionQuality::eFast ? 1 : (quality == CompressionQuality::eNormal ? 2 : 4);
+    for (uint32_t iteration = 0; iteration < iteration_count; ++iteration) {
+        uint32_t quantized[2][4], p_bits[2];
+        quantize(endpoint0, quantized[0], p_bits[0]);
+        quantize(endpoint1, quantized[1], p_bits[1]);
+        Texel palette[16];
+        for (uint32_t k = 0; k < 16; ++k) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                uint32_t value0 = (quantized[0][c] << 1) | p_bits[0], value1 = (quantized[1][c] << 1) | p_bits[1];
+                palette[k][c] = float(((64 - k_bc7_index_weights[k]) * value0 + k_bc7_index_weights[k] * value1 + 32) >> 6);
+            }
+        }
+        BlockIndices indices = {};
+        float error = 0.0f;
+        for (uint32_t i = 0; i < k_block_texel_count; ++i) {
+            float distance = 0.0f;
+            indices[i] = static_cast<uint8_t>(find_nearest(block.m_texels[i], palette, channel_weights, distance));
+            error += distance;
+        }
+        if (error < best_error) {
+            best_error = error;
+            std::memcpy(best_quantized, quantized, sizeof(quantized));
+            std::memcpy(best_p_bits, p_bits, sizeof(p_bits));
+            best_indices = indices;
+        }
+        if (best_error == 0.0f or iteration + 1 == iteration_count) { break; }
+        if (not refine_endpoints(block, 0xFFFF, indices, s_index_weights, endpoint0, endpoint1)) { break; }
+    }
+    if (best_indices[0] & 0x8) { //- the anchor index drops its top bit, so it must sit in the lower half of the palette
+        std::swap(best_quantized[0], best_quantized[1]);
+        std::swap(best_p_bits[0], best_p_bits[1]);
+        for (auto & index : best_indices) { index = static_cast<uint8_t>(15 - index); }
+    }
+    BlockBitWriter writer;
+    writer.write(1u << 6, 7);
+    for (uint32_t c = 0; c < 4; ++c) {
+        writer.write(best_quantized[0][c], 7);
+        writer.write(best_quantized[1][c], 7);
+    }
+    writer.write(best_p_bits[0], 1);
+    writer.write(best_p_bits[1], 1);
+    writer.write(best_indices[0], 3);
+    for (uint32_t i = 1; i < k_block_texel_count; ++i) { writer.write(best_indices[i], 4); }
+    std::memcpy(dst_p, writer.m_bits, sizeof(writer.m_bits));
+}
+
+void encode_block(const BlockTexels & block, const BlockCompressionInfo & info, uint8_t * dst_p) noexcept
+{
+    auto extract_channel = [&block](uint32_t channel) {
+        std::array<float, k_block_texel_count> values;
+        for (uint32_t i = 0; i < k_block_texel_count; ++i) { values[i] = block.m_texels[i][channel]; }
+        return values;
+    };
+    CompressionQuality quality = info.getQuality();
+    switch (info.getCompression()) {
+        case BlockCompression::eBC1: { encode_bc1(block, quality, true, dst_p); } break;
+        case BlockCompression::eBC3: {
+            encode_bc4(extract_channel(3), quality, dst_p);
+            encode_bc1(block, quality, false, dst_p + 8); //- bc3 always decodes its color block in four color mode
+        } break;
+        case BlockCompression::eBC4: { encode_bc4(extract_channel(0), quality, dst_p); } break;
+        case BlockCompression::eBC5: {
+            encode_bc4(extract_channel(0), quality, dst_p);
+            encode_bc4(extract_channel(1), quality, dst_p + 8);
+        } break;
+        case BlockCompression::eBC7: { encode_bc7(block, quality, dst_p); } break;
+        default: break;
+    }
+}
+//- auxiliary function implementations end
@@ -1,19 +1,34 @@
 #include "image/Image.h"
 #include "image/details/utils.h"
 #include "image/details/convert.h"
-#include "enums/enum_name.h"
-#include "enums/enum_values.h"
-#include "string_view_hash.h"
+#include "details/convert_kernels.h"
+#include "details/resample.h"
+#include "details/encode.h"
 #include <boost/gil/extension/io/png.hpp>
 #include <boost/gil/extension/io/jpeg.hpp>
 #include <boost/gil/extension/io/targa.hpp>
 #include <boost/gil/extension/io/bmp.hpp>
 #include <boost/gil/extension/numeric/sampler.hpp>
 #include <boost/gil/extension/numeric/resample.hpp>
-#include <boost/algorithm/string.hpp>
 #include "log.h"
 #include "span_cast.h"
+#include "float16_convert.h"
 #include <expected>
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <spanstream>
+
+//- stb allocations go through these hooks so a decode can land in storage the caller already owns
+void * stb_malloc(size_t size) noexcept;
+void * stb_realloc(void * data_p, size_t size) noexcept;
+void stb_free(void * data_p) noexcept;
+
+#define STBI_MALLOC(size) stb_malloc(size)
+#define STBI_REALLOC(data_p, size) stb_realloc(data_p, size)
+#define STBI_FREE(data_p) stb_free(data_p)
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image.h>
@@ -22,49 +37,86 @@
 using namespace lcf;
 namespace gil = boost::gil;
 namespace variant2 = boost::variant2;
-using ImageVariant = details::ImageVariant<>;
+using PixelAllocator = details::PixelAllocator<unsigned char>;
+using ImageVariant = details::ImageVariant<PixelAllocator>;
 using ConstImageViewVariant = details::ConstImageViewVariant;
 
 //- auxiliary structs begin
-struct ImageInfoData
-{
-    ImageInfoData() = default;
-    ImageInfoData(uint32_t width, uint32_t height, ImageFormat format) :
-        m_width(width),
-        m_height(height),
-        m_format(format)
-    {}
-    ~ImageInfoData() noexcept = default;
-    ImageInfoData(const ImageInfoData &) = default;
-    ImageInfoData(ImageInfoData &&) noexcept = default;
-    ImageInfoData & operator=(const ImageInfoData &) = default;
-    ImageInfoData & operator=(ImageInfoData &&) noexcept = default;
-    uint32_t m_width = 0;
-    uint32_t m_height = 0;
-    ImageFormat m_format = ImageFormat::eInvalid;
+struct FileExtensionEntry
+{
+    std::string_view m_extension; //- lower case, with the dot
+    ImageFileType m_file_type;
 };
+
+//- the buffer stb's output allocation is redirected into; only one live allocation may claim it. Only the output
+//- size itself or, when the capacity has room for it, the output plus jpeg's one spare byte is claimed, so scratch
+//- buffers that merely fit never land in the destination
+struct StbDecodeTarget
+{
+    std::byte * m_data_p = nullptr;
+    size_t m_size = 0;
+    size_t m_capacity = 0;
+    size_t m_claimed_size = 0; //- 0 while unclaimed
+};
+
+thread_local StbDecodeTarget t_stb_decode_target;
 //- auxiliary structs end
 
+namespace {
+    constexpr size_t k_stb_jpeg_output_padding = 1; //- stbi__malloc_mad3(n, w, h, 1) for the decoded jpeg
+
+    constexpr std::array k_file_extension_table {
+        FileExtensionEntry {".png", ImageFileType::ePNG},
+        FileExtensionEntry {".jpg", ImageFileType::eJPEG},
+        FileExtensionEntry {".jpeg", ImageFileType::eJPEG},
+        FileExtensionEntry {".hdr", ImageFileType::eHDR},
+        FileExtensionEntry {".exr", ImageFileType::eEXR},
+        FileExtensionEntry {".tga", ImageFileType::eTGA},
+        FileExtensionEntry {".bmp", ImageFileType::eBMP},
+    };
+}
+
 //- auxiliary function forward declarations begin
-std::filesystem::path get_extension(ImageFileType type) noexcept;
+template <typename Char>
+bool equals_ignore_ascii_case(std::basic_string_view<Char> str, std::string_view lower_str) noexcept;
 
 ImageFileType get_file_type(const std::filesystem::path & path) noexcept;
 
-ImageInfoData read_info_from_png(const std::filesystem::path & path);
+ImageFileType get_file_type(std::span<const std::byte> data) noexcept; //- from the header signature
+
+ImageFormat get_native_format(bool is_hdr, bool is_16_bit, int channels) noexcept;
 
-ImageInfoData read_info_from_jpeg(const std::filesystem::path & path);
+std::expected<EncodedImageDescription, std::error_code> peek_encoded_file(std::FILE * file_p) noexcept;
+
+details::ResampleKernel to_resample_kernel(ImageSampler sampler) noexcept;
 
 bool is_stb_load_supported(const ImageInfo & info) noexcept;
 
-std::expected<ImageVariant, std::error_code> load_from_file_gil(const ImageInfo &info) noexcept;
+template <typename Source>
+std::expected<ImageVariant, std::error_code> read_image_gil(Source & source, ImageFileType file_type, const PixelAllocator & allocator) noexcept;
+
+std::expected<ImageVariant, std::error_code> load_from_file_gil(const ImageInfo &info, const PixelAllocator & allocator) noexcept;
+
+std::expected<ImageVariant, std::error_code> load_from_memory_gil(std::span<const std::byte> data, const PixelAllocator & allocator) noexcept;
+
+std::expected<ImageVariant, std::error_code> load_from_file_stb(const ImageInfo & info, ImageFormat specific_format, const PixelAllocator & allocator) noexcept;
 
-std::expected<ImageVariant, std::error_code> load_from_file_stb(const ImageInfo & info, ImageFormat specific_format) noexcept;
+//- format holds the requested format on input, eInvalid for the native one, and the decoded format on output
+std::expected<ImageVariant, std::error_code> load_from_memory_stb(std::span<const std::byte> data, ImageFormat & format, const PixelAllocator & allocator) noexcept;
 
-std::expected<ImageVariant, std::error_code> load_from_memory_stb(std::span<const std::byte> data, ImageFormat & format) noexcept;
+template <typename Decode>
+std::error_code stb_decode_into(std::span<std::byte> dst, size_t capacity, uint32_t width, uint32_t height, Decode && decode) noexcept;
+
+//- capacity is how many bytes from dst.data() are writable, at least dst.size()
+std::error_code stb_decode_file_into(const ImageInfo & info, std::span<std::byte> dst, size_t capacity, ImageFormat format) noexcept;
+
+std::error_code stb_decode_memory_into(std::span<const std::byte> data, std::span<std::byte> dst, size_t capacity, const EncodedImageDescription & desc) noexcept;
 
 bool is_stb_save_supported(ImageFileType file_type) noexcept;
 
-std::error_code save_to_file_stb(const ImageVariant & image, ImageFormat format, ImageFileType file_type, const std::filesystem::path & path) noexcept;
+std::error_code save_to_file_stb(const ImageVariant & image, ImageFormat format, ImageFileType file_type, const ImageSaveInfo & info, std::FILE * file_p) noexcept;
+
+void stb_write_to_file(void * context_p, void * data_p, int size) noexcept;
 
 //- auxiliary function forward declarations end
 
@@ -75,27 +127,40 @@ ImageInfo::ImageInfo(const std::filesystem::path & path)
         lcf_log_error("Invalid image file type: {}", path.string());
         return;
     }
-    if (not std::filesystem::exists(path)) {
+    m_path = path;
+    std::FILE * file_p = std::fopen(path.string().c_str(), "rb");
+    if (not file_p) {
         lcf_log_error("Image file not found: {}", path.string());
         return;
     }
-    ImageInfoData data;
-    switch (m_file_type) {
-        case ImageFileType::ePNG: { data = read_info_from_png(path); } break;
-        case ImageFileType::eJPEG: { data = read_info_from_jpeg(path); } break;
-        default: break;
+    auto expected_desc = peek_encoded_file(file_p);
+    std::fclose(file_p);
+    if (not expected_desc) { return; } //- not readable by stb, e.g. exr; loading falls back to gil where it can
+    m_width = expected_desc->m_width;
+    m_height = expected_desc->m_height;
+    m_format = expected_desc->m_format;
+}
+
+ImageInfo::ImageInfo(const std::filesystem::path & path, std::span<const std::byte> encoded_data) :
+    m_path(path)
+{
+    m_file_type = get_file_type(path);
+    if (m_file_type == ImageFileType::eInvalid) { m_file_type = get_file_type(encoded_data); }
+    auto expected_desc = peek_encoded_image(encoded_data);
+    if (not expected_desc) {
+        lcf_log_error("Failed to read image header: {}", path.string());
+        return;
     }
-    
-    m_width = data.m_width;
-    m_height = data.m_height;
-    m_format = data.m_format;
-    m_path = path;
+    m_width = expected_desc->m_width;
+    m_height = expected_desc->m_height;
+    m_format = expected_desc->m_format;
 }
 
-Image::Image(uint32_t width, uint32_t height, ImageFormat format)
+Image::Image(uint32_t width, uint32_t height, ImageFormat format, std::pmr::memory_resource * memory_resource_p) :
+    m_memory_resource_p(memory_resource_p)
 {
     m_format = enum_decode::decode(format);
-    m_image = details::generate_image<>(width, height, m_format);
+    m_image = details::generate_image<PixelAllocator>(width, height, m_format, m_memory_resource_p);
 }
 
 Image & Image::operator=(Image && other) noexcept
@@ -103,12 +168,14 @@ Image & Image::operator=(Image && other) noexcept
     if (this == &other) { return *this; }
     m_image = std::exchange(other.m_image, {});
     m_format = std::exchange(other.m_format, {});
+    m_memory_resource_p = other.m_memory_resource_p;
     return *this;
 }
 
 Image::Image(Image && other) noexcept :
     m_image(std::exchange(other.m_image, {})),
-    m_format(std::exchange(other.m_format, {}))
+    m_format(std::exchange(other.m_format, {})),
+    m_memory_resource_p(other.m_memory_resource_p)
 {
 }
 
@@ -127,7 +194,7 @@ std::error_code Image::convertTo(ImageFormat format) noexcept
 {
     format = enum_decode::decode(format);
     if (m_format == format) { return {}; }
-    auto new_image = details::generate_image<>(this->getWidth(), this->getHeight(), format);
+    auto new_image = details::generate_image<PixelAllocator>(this->getWidth(), this->getHeight(), format, m_memory_resource_p);
     try {
         details::convert(details::view(m_image), details::view(new_image));
     } catch (const std::exception & e) {
@@ -143,19 +210,30 @@ std::error_code lcf::Image::convertToGpuFriendly() noexcept
     return this->convertTo(enum_decode::decode_gpu_friendly(m_format));
 }
 
-Image & Image::resize(uint32_t width, uint32_t height, ImageSampler sampler) noexcept
+Image & Image::resize(uint32_t width, uint32_t height, ImageSampler sampler, AlphaMode alpha_mode) noexcept
 {
     if (width == this->getWidth() and height == this->getHeight()) { return *this; }
-    variant2::visit([width, height, sampler](auto && image) {
+    bool is_separable = sampler != ImageSampler::eNearest and width != 0 and height != 0 and this->getWidth() != 0 and this->getHeight() != 0;
+    if (is_separable and details::is_float_image_supported(m_format)) {
+        uint32_t channel_count = this->getChannelCount();
+        auto src = details::decode_float_image(this->getDataSpan(), this->getWidth(), this->getHeight(), m_format, ColorTransfer::eLinear);
+        if (alpha_mode == AlphaMode::ePremultiplied) { details::premultiply_alpha(src, channel_count); }
+        details::FloatImage dst {width, height, channel_count};
+        details::resample(src, dst, channel_count, to_resample_kernel(sampler));
+        if (alpha_mode == AlphaMode::ePremultiplied) { details::unpremultiply_alpha(dst, channel_count); }
+        auto new_image = details::generate_image<PixelAllocator>(width, height, m_format, m_memory_resource_p);
+        details::encode_float_image(dst, details::view_as_bytes(new_image), m_format, ColorTransfer::eLinear);
+        m_image = std::move(new_image);
+        return *this;
+    }
+    //- nearest, and formats the float path does not cover
+    variant2::visit([width, height, sampler, this](auto && image) {
         using image_t = std::decay_t<decltype(image)>;
-        image_t new_image {width, height};
+        image_t new_image(width, height, 0, PixelAllocator(m_memory_resource_p));
         auto image_const_view = gil::const_view(image);
         auto new_image_view = gil::view(new_image);
-        switch (sampler) {
-            case ImageSampler::eNearest: { gil::resize_view(image_const_view, new_image_view, gil::nearest_neighbor_sampler{}); } break;
-            case ImageSampler::eLinear: { gil::resize_view(image_const_view, new_image_view, gil::bilinear_sampler{}); } break;
-            default: break;
-        }
+        if (sampler == ImageSampler::eNearest) { gil::resize_view(image_const_view, new_image_view, gil::nearest_neighbor_sampler{}); }
+        else { gil::resize_view(image_const_view, new_image_view, gil::bilinear_sampler{}); }
         image = std::move(new_image);
     }, m_image);
     return *this;
@@ -175,40 +253,57 @@ std::error_code Image::loadFromFile(const ImageInfo &info, ImageFormat specific_
     std::expected<ImageVariant, std::error_code> expected;
     bool load_with_stb = is_stb_load_supported(info);
     if (load_with_stb) {
-        expected = load_from_file_stb(info, format);
+        expected = load_from_file_stb(info, format, m_memory_resource_p);
     } else {
         // Nonnative format like bgr, arbg, etc.
-        expected = load_from_file_gil(info);
+        expected = load_from_file_gil(info, m_memory_resource_p);
     }
     if (not expected) { return expected.error(); }
-    else { m_image = std::move(*expected); }
+    if (not load_with_stb) { return this->adoptDecodedImage(std::move(*expected), specific_format); }
+    m_image = std::move(*expected);
     m_format = format;
-
-    if (not load_with_stb) {
-        //! load from file with gil won't return specific format, so convertion may be needed
-        size_t current_size = this->getDataSpan().size();
-        size_t expected_size = this->getWidth() * this->getHeight() * this->getChannelCount() * this->getBytesPerChannel();
-        if (current_size != expected_size) {
-            this->convertTo(format);
-        }
-    }
-    
     return {};
 }
 
 std::error_code Image::loadFromFileGpuFriendly(const ImageInfo &info) noexcept
 {
+    if (info.getEncodeFormat() == ImageFormat::eInvalid) { //- stb could not probe it, the gil decode decides the format
+        if (auto error = this->loadFromFile(info, ImageFormat::eInvalid); error) { return error; }
+        return this->convertToGpuFriendly();
+    }
     return this->loadFromFile(info, enum_decode::decode_gpu_friendly(info.getEncodeFormat()));
 }
 
 std::error_code lcf::Image::loadFromMemoryEncoded(std::span<const std::byte> data) noexcept
 {
-    auto expected = load_from_memory_stb(data, m_format);
-    if (not expected) { return expected.error(); }
-    else { m_image = std::move(*expected); }
+    return this->loadFromMemoryEncoded(data, ImageFormat::eInvalid);
+}
+
+std::error_code lcf::Image::loadFromMemoryEncoded(std::span<const std::byte> data, ImageFormat specific_format) noexcept
+{
+    ImageFormat format = specific_format;
+    auto expected = load_from_memory_stb(data, format, m_memory_resource_p);
+    if (not expected) {
+        //- the buffer stb can't read goes through gil, as loadFromFile does for the file
+        auto expected_gil = load_from_memory_gil(data, m_memory_resource_p);
+        if (not expected_gil) { return expected.error(); }
+        return this->adoptDecodedImage(std::move(*expected_gil), specific_format);
+    }
+    m_image = std::move(*expected);
+    m_format = format;
     return {};
 }
 
+std::error_code Image::adoptDecodedImage(ImageVariant && image, ImageFormat specific_format) noexcept
+{
+    ImageFormat decoded_format = details::get_image_format(image);
+    if (decoded_format == ImageFormat::eInvalid) { return std::make_error_code(std::errc::not_supported); }
+    m_image = std::move(image);
+    m_format = decoded_format;
+    if (specific_format == ImageFormat::eInvalid) { return {}; }
+    return this->convertTo(specific_format);
+}
+
 std::error_code lcf::Image::loadFromMemoryPixels(std::span<const std::byte> data, uint32_t width, ImageFormat src_format) noexcept
 {
     return this->loadFromMemoryPixels(data, width, src_format, src_format);
@@ -216,25 +311,52 @@ std::error_code lcf::Image::loadFromMemoryPixels(std::span<const std::byte> data
 
 std::error_code lcf::Image::loadFromMemoryPixels(std::span<const std::byte> data, uint32_t width, ImageFormat src_format, ImageFormat dst_format) noexcept
 {
+    bool is_bgra_src = src_format == ImageFormat::eBGRA8Uint; //- not an image variant member, swizzled on the way in
     src_format = enum_decode::decode(src_format);
     size_t row_size_in_bytes = enum_decode::get_channel_count(src_format) * enum_decode::get_bytes_per_channel(src_format) * width;
     if (data.size() % row_size_in_bytes != 0) { return std::make_error_code(std::errc::invalid_argument); }
     uint32_t height = static_cast<uint32_t>(data.size() / row_size_in_bytes);
     dst_format = enum_decode::decode(dst_format);
-    m_image = details::generate_image<>(width, height, dst_format);
+    m_image = details::generate_image<PixelAllocator>(width, height, dst_format, m_memory_resource_p);
     m_format = dst_format;
+    if (is_bgra_src) {
+        ImageVariant rgba_image = dst_format == ImageFormat::eRGBA8Uint ? ImageVariant {} : details::generate_image<PixelAllocator>(width, height, src_format, m_memory_resource_p);
+        auto rgba_span = dst_format == ImageFormat::eRGBA8Uint ? this->getDataSpan() : details::view_as_bytes(rgba_image);
+        details::swizzle_rgba8_bgra8(reinterpret_cast<const uint8_t *>(data.data()), reinterpret_cast<uint8_t *>(rgba_span.data()), size_t(width) * height);
+        if (dst_format != ImageFormat::eRGBA8Uint) { details::convert(details::view(rgba_image), details::view(m_image)); }
+        return {};
+    }
     auto src_view = details::generate_image_view(data, src_format, width);
     details::convert(src_view, details::view(m_image));
     return {};
 }
 
-std::error_code Image::saveToFile(const std::filesystem::path &path) const noexcept
+std::error_code Image::saveToFile(const std::filesystem::path &path, const ImageSaveInfo & info) const noexcept
 {
     ImageFileType file_type = get_file_type(path);
-    if (is_stb_save_supported(file_type)) {
-        return save_to_file_stb(m_image, m_format, file_type, path);
+    if (not is_stb_save_supported(file_type)) { return std::make_error_code(std::errc::invalid_argument); } //todo: save functions for other file types
+    std::FILE * file_p = std::fopen(path.string().c_str(), "wb");
+    if (not file_p) { return std::make_error_code(std::errc::io_error); }
+    auto error = this->saveToFile(file_p, file_type, info);
+    if (std::fclose(file_p) != 0 and not error) { error = std::make_error_code(std::errc::io_error); }
+    if (error) {
+        std::error_code remove_error;
+        std::filesystem::remove(path, remove_error);
     }
-    //todo: save functions for other file types
+    return error;
+}
+
+std::error_code Image::saveToFile(std::FILE * file_p, ImageFileType file_type, const ImageSaveInfo & info) const noexcept
+{
+    if (not file_p) { return std::make_error_code(std::errc::invalid_argument); }
+    auto bytes = this->getDataSpan();
+    if (file_type == ImageFileType::ePNG and details::is_png_encode_supported(m_format)) {
+        return details::encode_png(bytes, this->getWidth(), this->getHeight(), m_format, info.getCompressionLevel(), file_p);
+    }
+    if (file_type == ImageFileType::eJPEG and details::is_jpeg_encode_supported(m_format)) {
+        return details::encode_jpeg(bytes, this->getWidth(), this->getHeight(), m_format, info.getQuality(), file_p);
+    }
+    if (is_stb_save_supported(file_type)) { return save_to_file_stb(m_image, m_format, file_type, info, file_p); }
     return std::make_error_code(std::errc::invalid_argument);
 }
 
@@ -248,73 +370,128 @@ std::span<const std::byte> Image::getDataSpan() const noexcept
     return details::view_as_bytes(m_image);
 }
 
+std::expected<EncodedImageDescription, std::error_code> lcf::peek_encoded_image(std::span<const std::byte> data, ImageFormat specific_format) noexcept
+{
+    const auto * src_data_p = reinterpret_cast<const stbi_uc *>(data.data());
+    const int src_size = static_cast<int>(data.size());
+    int width = 0, height = 0, channels = 0;
+    if (not stbi_info_from_memory(src_data_p, src_size, &width, &height, &channels)) {
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    EncodedImageDescription desc;
+    desc.m_width = static_cast<uint32_t>(width);
+    desc.m_height = static_cast<uint32_t>(height);
+    if (specific_format != ImageFormat::eInvalid) {
+        desc.m_format = enum_decode::decode(specific_format);
+    } else {
+        bool is_hdr = stbi_is_hdr_from_memory(src_data_p, src_size);
+        desc.m_format = get_native_format(is_hdr, not is_hdr and stbi_is_16_bit_from_memory(src_data_p, src_size), channels);
+    }
+    return desc;
+}
+
+std::error_code lcf::decode_image_into(std::span<const std::byte> data, std::span<std::byte> dst, ImageFormat specific_format) noexcept
+{
+    auto expected_desc = peek_encoded_image(data, specific_format);
+    if (not expected_desc) { return expected_desc.error(); }
+    const auto & desc = expected_desc.value();
+    if (dst.size() < desc.getSizeInBytes()) { return std::make_error_code(std::errc::no_buffer_space); }
+    return stb_decode_memory_into(data, dst, dst.size(), desc);
+}
+
+std::error_code lcf::decode_image_into(const ImageInfo & info, std::span<std::byte> dst, ImageFormat specific_format) noexcept
+{
+    if (info.getFileType() == ImageFileType::eInvalid or not is_stb_load_supported(info)) {
+        return std::make_error_code(std::errc::invalid_argument);
+    }
+    EncodedImageDescription desc;
+    desc.m_width = info.getWidth();
+    desc.m_height = info.getHeight();
+    desc.m_format = enum_decode::decode(specific_format);
+    if (dst.size() < desc.getSizeInBytes()) { return std::make_error_code(std::errc::no_buffer_space); }
+    return stb_decode_file_into(info, dst, dst.size(), desc.m_format);
+}
+
 //- auxiliary function implementations begin
 
-std::filesystem::path get_extension(ImageFileType type) noexcept
+template <typename Char>
+bool equals_ignore_ascii_case(std::basic_string_view<Char> str, std::string_view lower_str) noexcept
 {
-    return std::filesystem::path{}.replace_extension(boost::to_lower_copy(std::string{enum_name(type).substr(1)}));
+    if (str.size() != lower_str.size()) { return false; }
+    for (size_t i = 0; i < str.size(); ++i) {
+        Char c = str[i];
+        if (c >= Char('A') and c <= Char('Z')) { c = static_cast<Char>(c - Char('A') + Char('a')); }
+        if (c != static_cast<Char>(lower_str[i])) { return false; }
+    }
+    return true;
 }
 
 ImageFileType get_file_type(const std::filesystem::path & path) noexcept
 {
-    ImageFileType result = ImageFileType::eInvalid;
-    auto ext_str = boost::to_lower_copy(path.extension().string());
-    if (ext_str == ".jpg") { return ImageFileType::eJPEG; } //- special case for jpeg
-    auto hash_value = hash(ext_str);
-    for (auto type : enum_values_v<ImageFileType>) {
-        if (hash(get_extension(type).string()) != hash_value) { continue; }
-        result = type;
-        break;
+    const auto & native = path.native();
+    using Char = std::filesystem::path::value_type;
+    std::basic_string_view<Char> native_view {native};
+    auto dot_pos = native_view.find_last_of(Char('.'));
+    if (dot_pos == native_view.npos) { return ImageFileType::eInvalid; }
+    auto ext_view = native_view.substr(dot_pos);
+    if (ext_view.find_first_of(std::filesystem::path::preferred_separator) != ext_view.npos or
+        ext_view.find_first_of(Char('/')) != ext_view.npos) {
+        return ImageFileType::eInvalid; //- the dot belongs to a directory name
     }
-    return result;
+    for (const auto & entry : k_file_extension_table) {
+        if (equals_ignore_ascii_case(ext_view, entry.m_extension)) { return entry.m_file_type; }
+    }
+    return ImageFileType::eInvalid;
 }
 
-ImageInfoData read_info_from_png(const std::filesystem::path & path)
+ImageFileType get_file_type(std::span<const std::byte> data) noexcept
 {
-    auto info = gil::read_image_info(path.string(), gil::png_tag {})._info;
-    ColorSpace color_space = ColorSpace::eInvalid;
-    switch (info._color_type) {
-        case PNG_COLOR_TYPE_GRAY: { color_space = ColorSpace::eGray; } break;
-        case PNG_COLOR_TYPE_GA: { color_space = ColorSpace::eGrayAlpha; } break;
-        case PNG_COLOR_TYPE_PALETTE:
-        case PNG_COLOR_TYPE_RGB: { color_space = ColorSpace::eRGB; } break;
-        case PNG_COLOR_TYPE_RGBA: { color_space = ColorSpace::eRGBA; } break;
-        default: break;
-    }
-    return {
-        info._width,
-        info._height, 
-        enum_decode::get_image_format(color_space, info._bit_depth == 16 ? PixelDataType::eUint16 : PixelDataType::eUint8)
+    auto starts_with = [data](std::initializer_list<uint8_t> signature) {
+        if (data.size() < signature.size()) { return false; }
+        return std::equal(signature.begin(), signature.end(), data.begin(), [](uint8_t lhs, std::byte rhs) {
+            return lhs == std::to_integer<uint8_t>(rhs);
+        });
     };
+    if (starts_with({0x89, 'P', 'N', 'G'})) { return ImageFileType::ePNG; }
+    if (starts_with({0xFF, 0xD8, 0xFF})) { return ImageFileType::eJPEG; }
+    if (starts_with({'#', '?'})) { return ImageFileType::eHDR; }
+    if (starts_with({0x76, 0x2F, 0x31, 0x01})) { return ImageFileType::eEXR; }
+    if (starts_with({'B', 'M'})) { return ImageFileType::eBMP; }
+    return ImageFileType::eInvalid; //- tga has no signature
 }
 
-ImageInfoData read_info_from_jpeg(const std::filesystem::path &path)
-{
-    auto info = gil::read_image_info(path.string(), gil::jpeg_tag {})._info;
-    ColorSpace color_space = ColorSpace::eInvalid;
-    switch (info._color_space) {
-        case JCS_GRAYSCALE: { color_space = ColorSpace::eGray; } break;
-        case JCS_EXT_RGB:
-        case JCS_RGB: { color_space = ColorSpace::eRGB; } break;
-        case JCS_YCbCr: { color_space = ColorSpace::eYCbCr; } break;
-        case JCS_CMYK: { color_space = ColorSpace::eCMYK; } break;
-        case JCS_YCCK: { color_space = ColorSpace::eYCCK; } break;
-        case JCS_EXT_RGBX:
-        case JCS_EXT_RGBA: { color_space = ColorSpace::eRGBA; } break;
-        case JCS_EXT_BGR: { color_space = ColorSpace::eBGR; } break;
-        case JCS_EXT_BGRX:
-        case JCS_EXT_BGRA: { color_space = ColorSpace::eBGRA; } break;
-        case JCS_EXT_XBGR:
-        case JCS_EXT_ABGR: { color_space = ColorSpace::eABGR; } break;
-        case JCS_EXT_XRGB:
-        case JCS_EXT_ARGB: { color_space = ColorSpace::eARGB; } break;
-        default: break;
+ImageFormat get_native_format(bool is_hdr, bool is_16_bit, int channels) noexcept
+{
+    PixelDataType pixel_data_type = PixelDataType::eUint8;
+    if (is_hdr) { pixel_data_type = PixelDataType::eFloat32; }
+    else if (is_16_bit) { pixel_data_type = PixelDataType::eUint16; }
+    return enum_decode::decode_image_format(pixel_data_type, static_cast<uint8_t>(channels));
+}
+
+std::expected<EncodedImageDescription, std::error_code> peek_encoded_file(std::FILE * file_p) noexcept
+{
+    //- the stb probes only read the header and seek back, so one handle serves all three
+    int width = 0, height = 0, channels = 0;
+    if (not stbi_info_from_file(file_p, &width, &height, &channels)) {
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+    }
+    bool is_hdr = stbi_is_hdr_from_file(file_p);
+    bool is_16_bit = not is_hdr and stbi_is_16_bit_from_file(file_p);
+    EncodedImageDescription desc;
+    desc.m_width = static_cast<uint32_t>(width);
+    desc.m_height = static_cast<uint32_t>(height);
+    desc.m_format = get_native_format(is_hdr, is_16_bit, channels);
+    return desc;
+}
+
+details::ResampleKernel to_resample_kernel(ImageSampler sampler) noexcept
+{
+    switch (sampler) {
+        case ImageSampler::eBox: { return details::ResampleKernel::eBox; }
+        case ImageSampler::eMitchell: { return details::ResampleKernel::eMitchell; }
+        case ImageSampler::eLanczos3: { return details::ResampleKernel::eLanczos3; }
+        default: return details::ResampleKernel::eTent;
     }
-    return {
-        info._width,
-        info._height,
-        enum_decode::get_image_format(color_space, PixelDataType::eUint8), 
-    };
 }
 
 bool is_stb_load_supported(const ImageInfo & info) noexcept
@@ -324,83 +501,204 @@ bool is_stb_load_supported(const ImageInfo & info) noexcept
     return color_space == ColorSpace::eYCbCr or color_space == ColorSpace::eCMYK or color_space == ColorSpace::eYCCK;
 }
 
-std::expected<ImageVariant, std::error_code> load_from_file_gil(const ImageInfo &info) noexcept
+template <typename Source>
+std::expected<ImageVariant, std::error_code> read_image_gil(Source & source, ImageFileType file_type, const PixelAllocator & allocator) noexcept
 {
-    std::string path_str = info.getPath().string();
     ImageVariant image;
     try {
-        switch (info.getFileType()) {
-            case ImageFileType::ePNG: { gil::read_image(path_str, image, gil::png_tag {}); } break;
-            case ImageFileType::eJPEG: { gil::read_image(path_str, image, gil::jpeg_tag {}); } break;
-            case ImageFileType::eBMP: { gil::read_image(path_str, image, gil::bmp_tag {}); } break;
-            case ImageFileType::eTGA: { gil::read_image(path_str, image, gil::targa_tag {}); } break;
+        switch (file_type) {
+            case ImageFileType::ePNG: { gil::read_image(source, image, gil::png_tag {}); } break;
+            case ImageFileType::eJPEG: { gil::read_image(source, image, gil::jpeg_tag {}); } break;
+            case ImageFileType::eBMP: { gil::read_image(source, image, gil::bmp_tag {}); } break;
+            case ImageFileType::eTGA: { gil::read_image(source, image, gil::targa_tag {}); } break;
             default: return std::unexpected(std::make_error_code(std::errc::invalid_argument));
         }
+        //- gil default constructs the matched image, so its pixels sit in the default pool; move them to the configured one
+        if (allocator == PixelAllocator {}) { return image; }
+        variant2::visit([&allocator](auto && loaded_image) {
+            using image_t = std::decay_t<decltype(loaded_image)>;
+            image_t relocated_image(loaded_image.width(), loaded_image.height(), 0, allocator);
+            gil::copy_pixels(gil::const_view(loaded_image), gil::view(relocated_image));
+            loaded_image = std::move(relocated_image);
+        }, image);
     } catch (const std::exception & e) {
         return std::unexpected(std::make_error_code(std::errc::invalid_argument));
     }
     return image;
 }
 
-std::expected<ImageVariant, std::error_code> load_from_file_stb(const ImageInfo &info, ImageFormat specific_format) noexcept
+std::expected<ImageVariant, std::error_code> load_from_file_gil(const ImageInfo &info, const PixelAllocator & allocator) noexcept
+{
+    std::string path_str = info.getPath().string();
+    return read_image_gil(path_str, info.getFileType(), allocator);
+}
+
+std::expected<ImageVariant, std::error_code> load_from_memory_gil(std::span<const std::byte> data, const PixelAllocator & allocator) noexcept
+{
+    std::ispanstream stream {std::span(reinterpret_cast<const char *>(data.data()), data.size())};
+    return read_image_gil(static_cast<std::istream &>(stream), get_file_type(data), allocator);
+}
+
+std::expected<ImageVariant, std::error_code> load_from_file_stb(const ImageInfo &info, ImageFormat specific_format, const PixelAllocator & allocator) noexcept
+{
+    auto image = details::generate_image<PixelAllocator>(info.getWidth(), info.getHeight(), specific_format, allocator);
+    auto image_span = details::view_as_bytes(image);
+    if (auto error = stb_decode_file_into(info, image_span, image_span.size() + details::k_pixel_tail_padding, specific_format); error) {
+        return std::unexpected(error);
+    }
+    return image;
+}
+
+std::expected<ImageVariant, std::error_code> load_from_memory_stb(std::span<const std::byte> data, ImageFormat &format, const PixelAllocator & allocator) noexcept
+{
+    auto expected_desc = peek_encoded_image(data, format);
+    if (not expected_desc) { return std::unexpected(expected_desc.error()); }
+    const auto & desc = expected_desc.value();
+    auto image = details::generate_image<PixelAllocator>(desc.m_width, desc.m_height, desc.m_format, allocator);
+    auto image_span = details::view_as_bytes(image);
+    if (auto error = stb_decode_memory_into(data, image_span, image_span.size() + details::k_pixel_tail_padding, desc); error) {
+        return std::unexpected(error);
+    }
+    format = desc.m_format;
+    return image;
+}
+
+void * stb_malloc(size_t size) noexcept
+{
+    auto & target = t_stb_decode_target;
+    bool is_output_size = size == target.m_size or size == target.m_size + k_stb_jpeg_output_padding;
+    if (target.m_data_p and target.m_claimed_size == 0 and is_output_size and size <= target.m_capacity) {
+        target.m_claimed_size = size;
+        return target.m_data_p;
+    }
+    return std::malloc(size);
+}
+
+void * stb_realloc(void * data_p, size_t size) noexcept
+{
+    auto & target = t_stb_decode_target;
+    if (not data_p or data_p != target.m_data_p) { return std::realloc(data_p, size); }
+    //- the target cannot grow, move the contents out and hand the target back
+    void * new_data_p = std::malloc(size);
+    if (not new_data_p) { return nullptr; }
+    std::memcpy(new_data_p, data_p, std::min(size, target.m_claimed_size));
+    target.m_claimed_size = 0;
+    return new_data_p;
+}
+
+void stb_free(void * data_p) noexcept
+{
+    auto & target = t_stb_decode_target;
+    if (data_p and data_p == target.m_data_p) {
+        target.m_claimed_size = 0;
+        return;
+    }
+    std::free(data_p);
+}
+
+template <typename Decode>
+std::error_code stb_decode_into(std::span<std::byte> dst, size_t capacity, uint32_t width, uint32_t height, Decode && decode) noexcept
+{
+    t_stb_decode_target = {dst.data(), dst.size(), std::max(capacity, dst.size()), 0};
+    int decoded_width = 0, decoded_height = 0;
+    void * decoded_p = decode(&decoded_width, &decoded_height);
+    t_stb_decode_target = {};
+    if (not decoded_p) { return std::make_error_code(std::errc::invalid_argument); }
+    std::error_code error;
+    if (static_cast<uint32_t>(decoded_width) != width or static_cast<uint32_t>(decoded_height) != height) {
+        error = std::make_error_code(std::errc::invalid_argument);
+    } else if (decoded_p != dst.data()) {
+        //- stb allocated the result itself, e.g. after a channel or bit depth conversion pass
+        std::memcpy(dst.data(), decoded_p, dst.size());
+    }
+    if (decoded_p != dst.data()) { std::free(decoded_p); }
+    return error;
+}
+
+std::error_code stb_decode_file_into(const ImageInfo & info, std::span<std::byte> dst, size_t capacity, ImageFormat format) noexcept
 {
     std::string path_str = info.getPath().string();
-    auto image = details::generate_image<>(info.getWidth(), info.getHeight(), specific_format);
-    auto data_span = details::view_as_bytes(image);
-    int width, height, channels;
-    int requested_channels = enum_decode::get_channel_count(specific_format);
-    void * src_data_p = nullptr;
-    PixelDataType pixel_data_type = enum_decode::get_pixel_data_type(specific_format);
-    switch(pixel_data_type) {
+    const size_t size = static_cast<size_t>(info.getWidth()) * info.getHeight() *
+        enum_decode::get_channel_count(format) * enum_decode::get_bytes_per_channel(format);
+    int channels = 0;
+    int requested_channels = enum_decode::get_channel_count(format);
+    PixelDataType pixel_data_type = enum_decode::get_pixel_data_type(format);
+    switch (pixel_data_type) {
         case PixelDataType::eUint8: {
-            src_data_p = stbi_load(path_str.c_str(), &width, &height, &channels, requested_channels);
-        } break;
+            return stb_decode_into(dst.first(size), capacity, info.getWidth(), info.getHeight(), [&](int * width_p, int * height_p) -> void * {
+                return stbi_load(path_str.c_str(), width_p, height_p, &channels, requested_channels);
+            });
+        }
         case PixelDataType::eUint16: {
-            src_data_p = stbi_load_16(path_str.c_str(), &width, &height, &channels, requested_channels);
-        } break;
-        case PixelDataType::eFloat16:
+            return stb_decode_into(dst.first(size), capacity, info.getWidth(), info.getHeight(), [&](int * width_p, int * height_p) -> void * {
+                return stbi_load_16(path_str.c_str(), width_p, height_p, &channels, requested_channels);
+            });
+        }
         case PixelDataType::eFloat32: {
-            src_data_p = stbi_loadf(path_str.c_str(), &width, &height, &channels, requested_channels);
+            return stb_decode_into(dst.first(size), capacity, info.getWidth(), info.getHeight(), [&](int * width_p, int * height_p) -> void * {
+                return stbi_loadf(path_str.c_str(), width_p, height_p, &channels, requested_channels);
+            });
+        }
+        case PixelDataType::eFloat16: {
+            //- stb has no half output, decode to float once and narrow into the destination in one batch
+            int width = 0, height = 0;
+            auto src_data_p = stbi_loadf(path_str.c_str(), &width, &height, &channels, requested_channels);
+            if (not src_data_p) { return std::make_error_code(std::errc::invalid_argument); }
+            std::error_code error;
+            if (static_cast<uint32_t>(width) != info.getWidth() or static_cast<uint32_t>(height) != info.getHeight()) {
+                error = std::make_error_code(std::errc::invalid_argument);
+            } else {
+                auto f16_data_span = span_cast<float16_t>(dst.first(size));
+                convert_f32_to_f16(std::span<const float>(src_data_p, f16_data_span.size()), f16_data_span);
+            }
+            stbi_image_free(src_data_p);
+            return error;
         }
         default: break;
     }
-    if (pixel_data_type == PixelDataType::eFloat16) {
-        auto f16_data_span = span_cast<float16_t>(data_span);
-        auto src_data_span = std::span(static_cast<const float *>(src_data_p), data_span.size() / sizeof(float));
-        std::ranges::copy(src_data_span, f16_data_span.begin());
-    } else {
-        memcpy(data_span.data(), src_data_p, data_span.size());
-    }
-    stbi_image_free(src_data_p);
-    return image;
+    return std::make_error_code(std::errc::invalid_argument);
 }
 
-std::expected<ImageVariant, std::error_code> load_from_memory_stb(std::span<const std::byte> data, ImageFormat &format) noexcept
-{
-    const stbi_uc * src_data_p = (const stbi_uc *)data.data();
-    size_t data_size = data.size();
-    bool is_16_bit = stbi_is_16_bit_from_memory(src_data_p, data_size);
-    bool is_float = stbi_is_hdr_from_memory(src_data_p, data_size);
-    int width, height, channels;
-    void * dst_data_p = nullptr;
-    if (is_float) {
-        dst_data_p = stbi_loadf_from_memory(src_data_p, data_size, &width, &height, &channels, 0);
-        data_size = width * height * channels * sizeof(float);
-    } else if (is_16_bit) {
-        dst_data_p = stbi_load_16_from_memory(src_data_p, data_size, &width, &height, &channels, 0);
-        data_size = width * height * channels * sizeof(uint16_t);
-    } else {
-        dst_data_p = stbi_load_from_memory(src_data_p, data_size, &width, &height, &channels, 0);
-        data_size = width * height * channels * sizeof(uint8_t);
+std::error_code stb_decode_memory_into(std::span<const std::byte> data, std::span<std::byte> dst, size_t capacity, const EncodedImageDescription & desc) noexcept
+{
+    const auto * src_data_p = reinterpret_cast<const stbi_uc *>(data.data());
+    const int src_size = static_cast<int>(data.size());
+    const size_t size = desc.getSizeInBytes();
+    int channels = 0;
+    int requested_channels = enum_decode::get_channel_count(desc.m_format);
+    switch (enum_decode::get_pixel_data_type(desc.m_format)) {
+        case PixelDataType::eUint8: {
+            return stb_decode_into(dst.first(size), capacity, desc.m_width, desc.m_height, [&](int * width_p, int * height_p) -> void * {
+                return stbi_load_from_memory(src_data_p, src_size, width_p, height_p, &channels, requested_channels);
+            });
+        }
+        case PixelDataType::eUint16: {
+            return stb_decode_into(dst.first(size), capacity, desc.m_width, desc.m_height, [&](int * width_p, int * height_p) -> void * {
+                return stbi_load_16_from_memory(src_data_p, src_size, width_p, height_p, &channels, requested_channels);
+            });
+        }
+        case PixelDataType::eFloat32: {
+            return stb_decode_into(dst.first(size), capacity, desc.m_width, desc.m_height, [&](int * width_p, int * height_p) -> void * {
+                return stbi_loadf_from_memory(src_data_p, src_size, width_p, height_p, &channels, requested_channels);
+            });
+        }
+        case PixelDataType::eFloat16: {
+            int width = 0, height = 0;
+            auto src_data_p_f = stbi_loadf_from_memory(src_data_p, src_size, &width, &height, &channels, requested_channels);
+            if (not src_data_p_f) { return std::make_error_code(std::errc::invalid_argument); }
+            std::error_code error;
+            if (static_cast<uint32_t>(width) != desc.m_width or static_cast<uint32_t>(height) != desc.m_height) {
+                error = std::make_error_code(std::errc::invalid_argument);
+            } else {
+                auto f16_data_span = span_cast<float16_t>(dst.first(size));
+                convert_f32_to_f16(std::span<const float>(src_data_p_f, f16_data_span.size()), f16_data_span);
+            }
+            stbi_image_free(src_data_p_f);
+            return error;
+        }
+        default: break;
     }
-    if (not dst_data_p) { return std::unexpected(std::make_error_code(std::errc::invalid_argument)); }
-    PixelDataType pixel_data_type = is_float ? PixelDataType::eFloat32 : (is_16_bit ? PixelDataType::eUint16 : PixelDataType::eUint8);
-    format = enum_decode::decode_image_format(pixel_data_type, static_cast<uint8_t>(channels));
-    auto image = details::generate_image<>(width, height, format);
-    auto data_span = details::view_as_bytes(image);
-    memcpy(data_span.data(), dst_data_p, data_size);
-    stbi_image_free(dst_data_p);
-    return image;
+    return std::make_error_code(std::errc::invalid_argument);
 }
 
 bool is_stb_save_supported(ImageFileType file_type) noexcept
@@ -412,23 +710,28 @@ bool is_stb_save_supported(ImageFileType file_type) noexcept
         file_type == ImageFileType::eHDR;
 }
 
-std::error_code save_to_file_stb(const ImageVariant &image, ImageFormat format, ImageFileType file_type, const std::filesystem::path &path) noexcept
+std::error_code save_to_file_stb(const ImageVariant &image, ImageFormat format, ImageFileType file_type, const ImageSaveInfo & info, std::FILE * file_p) noexcept
 {
     auto bytes = details::view_as_bytes(image);
-    auto path_str = path.string();
     bool success = false;
     int width = image.width();
     int height = image.height();
     int channels = enum_decode::get_channel_count(format);
+    int quality = static_cast<int>(std::clamp(info.getQuality(), 1u, 100u));
     switch (file_type) {
-        case ImageFileType::ePNG: { success = stbi_write_png(path_str.c_str(), width, height, channels, bytes.data(), 0); } break;
-        case ImageFileType::eJPEG: { success = stbi_write_jpg(path_str.c_str(), width, height, channels, bytes.data(), 100); } break;
-        case ImageFileType::eBMP: { success = stbi_write_bmp(path_str.c_str(), width, height, channels, bytes.data()); } break;
-        case ImageFileType::eTGA: { success = stbi_write_tga(path_str.c_str(), width, height, channels, bytes.data()); } break;
-        case ImageFileType::eHDR: { success = stbi_write_hdr(path_str.c_str(), width, height, channels, (const float *)(bytes.data())); } break;
+        case ImageFileType::ePNG: { success = stbi_write_png_to_func(stb_write_to_file, file_p, width, height, channels, bytes.data(), 0); } break;
+        case ImageFileType::eJPEG: { success = stbi_write_jpg_to_func(stb_write_to_file, file_p, width, height, channels, bytes.data(), quality); } break;
+        case ImageFileType::eBMP: { success = stbi_write_bmp_to_func(stb_write_to_file, file_p, width, height, channels, bytes.data()); } break;
+        case ImageFileType::eTGA: { success = stbi_write_tga_to_func(stb_write_to_file, file_p, width, height, channels, bytes.data()); } break;
+        case ImageFileType::eHDR: { success = stbi_write_hdr_to_func(stb_write_to_file, file_p, width, height, channels, (const float *)(bytes.data())); } break;
         default: break;
     }
-    if (success) { return {}; }
+    if (success and not std::ferror(file_p)) { return {}; }
     return std::make_error_code(std::errc::io_error);
 }
+
+void stb_write_to_file(void * context_p, void * data_p, int size) noexcept
+{
+    std::fwrite(data_p, 1, static_cast<size_t>(size), static_cast<std::FILE *>(context_p));
+}
 // - auxiliary function implementations end
@@ -0,0 +1,87 @@
+#include "image/MipChain.h"
+#include "image/Image.h"
+#include "details/resample.h"
+#include <algorithm>
+#include <bit>
+
+using namespace lcf;
+
+//- auxiliary function forward declarations begin
+details::ResampleKernel to_resample_kernel(MipFilter filter) noexcept;
+//- auxiliary function forward declarations end
+
+MipChain::MipChain(uint32_t width, uint32_t height, ImageFormat format, BlockCompression compression) :
+    m_format(enum_decode::decode(format)),
+    m_compression(compression)
+{
+    size_t texel_size_in_bytes = enum_decode::get_channel_count(m_format) * enum_decode::get_bytes_per_channel(m_format);
+    size_t block_size_in_bytes = enum_decode::get_block_size_in_bytes(m_compression);
+    uint32_t level_count = compute_mip_level_count(width, height);
+    m_levels.resize(level_count);
+    size_t offset_in_bytes = 0;
+    for (uint32_t i = 0; i < level_count; ++i) {
+        auto & level = m_levels[i];
+        level.m_width = std::max(width >> i, 1u);
+        level.m_height = std::max(height >> i, 1u);
+        level.m_offset_in_bytes = offset_in_bytes;
+        if (this->isCompressed()) {
+            level.m_size_in_bytes = size_t((level.m_width + 3) / 4) * ((level.m_height + 3) / 4) * block_size_in_bytes;
+        } else {
+            level.m_size_in_bytes = size_t(level.m_width) * level.m_height * texel_size_in_bytes;
+        }
+        offset_in_bytes += level.m_size_in_bytes;
+    }
+    m_data.resize(offset_in_bytes);
+}
+
+std::span<std::byte> MipChain::getLevelDataSpan(uint32_t level) noexcept
+{
+    const auto & level_info = m_levels[level];
+    return std::span(m_data).subspan(level_info.m_offset_in_bytes, level_info.m_size_in_bytes);
+}
+
+std::span<const std::byte> MipChain::getLevelDataSpan(uint32_t level) const noexcept
+{
+    const auto & level_info = m_levels[level];
+    return std::span(m_data).subspan(level_info.m_offset_in_bytes, level_info.m_size_in_bytes);
+}
+
+uint32_t lcf::compute_mip_level_count(uint32_t width, uint32_t height) noexcept
+{
+    uint32_t max_extent = std::max(width, height);
+    if (max_extent == 0) { return 0; }
+    return std::bit_width(max_extent);
+}
+
+std::expected<MipChain, std::error_code> lcf::generate_mip_chain(const Image & image, MipFilter filter, ColorTransfer transfer) noexcept
+{
+    ImageFormat format = image.getDecodeFormat();
+    if (not details::is_float_image_supported(format)) { return std::unexpected(std::make_error_code(std::errc::not_supported)); }
+    auto [width, height] = image.getDimensions();
+    if (width == 0 or height == 0) { return std::unexpected(std::make_error_code(std::errc::invalid_argument)); }
+    uint32_t channel_count = image.getChannelCount();
+    MipChain mip_chain {width, height, format};
+    auto src_data = image.getDataSpan();
+    std::ranges::copy(src_data, mip_chain.getLevelDataSpan(0).begin());
+    auto kernel = to_resample_kernel(filter);
+    details::FloatImage src_level = details::decode_float_image(src_data, width, height, format, transfer);
+    for (uint32_t i = 1; i < mip_chain.getLevelCount(); ++i) {
+        const auto & level = mip_chain.getLevel(i);
+        details::FloatImage dst_level {level.m_width, level.m_height, channel_count};
+        details::resample(src_level, dst_level, channel_count, kernel); //- always from the previous level, keeps each pass's kernel small
+        details::encode_float_image(dst_level, mip_chain.getLevelDataSpan(i), format, transfer);
+        src_level = std::move(dst_level);
+    }
+    return mip_chain;
+}
+
+//- auxiliary function implementations begin
+
+details::ResampleKernel to_resample_kernel(MipFilter filter) noexcept
+{
+    switch (filter) {
+        case MipFilter::eKaiser: { return details::ResampleKernel::eKaiser; }
+        default: return details::ResampleKernel::eBox;
+    }
+}
+//- auxiliary function implementations end
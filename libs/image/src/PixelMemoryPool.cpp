@@ -0,0 +1,109 @@
+#include "image/PixelMemoryPool.h"
+#include <algorithm>
+#include <bit>
+#include <new>
+
+using namespace lcf;
+
+namespace {
+    constexpr size_t k_block_header_size = 64; //- keeps the pixels cache line aligned
+    constexpr size_t k_size_class_steps = 4; //- per power of two
+}
+
+//- auxiliary structs begin
+struct BlockHeader //- placed right before the pointer handed out
+{
+    size_t m_capacity; //- bytes taken from upstream, header included
+    size_t m_offset; //- from the upstream block to the pointer handed out
+};
+//- auxiliary structs end
+
+//- auxiliary function forward declarations begin
+size_t round_to_size_class(size_t size) noexcept;
+
+BlockHeader & get_block_header(void * data_p) noexcept;
+//- auxiliary function forward declarations end
+
+PixelMemoryPool::PixelMemoryPool(size_t max_cached_bytes, std::pmr::memory_resource * upstream_p) noexcept :
+    m_upstream_p(upstream_p),
+    m_max_cached_bytes(max_cached_bytes)
+{
+}
+
+PixelMemoryPool::~PixelMemoryPool() noexcept
+{
+    this->release();
+}
+
+void PixelMemoryPool::release() noexcept
+{
+    std::lock_guard lock {m_mutex};
+    for (auto & [capacity, blocks] : m_free_blocks) {
+        for (std::byte * base_p : blocks) { m_upstream_p->deallocate(base_p, capacity, k_block_header_size); }
+    }
+    m_free_blocks.clear();
+    m_cached_bytes = 0;
+}
+
+size_t PixelMemoryPool::getCachedBytes() const noexcept
+{
+    std::lock_guard lock {m_mutex};
+    return m_cached_bytes;
+}
+
+void * PixelMemoryPool::do_allocate(size_t bytes, size_t alignment)
+{
+    size_t offset = std::max(alignment, k_block_header_size);
+    size_t size = offset + bytes;
+    bool is_pooled = offset == k_block_header_size and size >= k_min_pooled_size;
+    size_t capacity = is_pooled ? round_to_size_class(size) : size;
+    std::byte * base_p = nullptr;
+    if (is_pooled) {
+        std::lock_guard lock {m_mutex};
+        if (auto it = m_free_blocks.find(capacity); it != m_free_blocks.end() and not it->second.empty()) {
+            base_p = it->second.back(); //- the most recently freed block is the likeliest to still be cached
+            it->second.pop_back();
+            m_cached_bytes -= capacity;
+        }
+    }
+    if (not base_p) { base_p = static_cast<std::byte *>(m_upstream_p->allocate(capacity, offset)); }
+    std::byte * data_p = base_p + offset;
+    new (data_p - sizeof(BlockHeader)) BlockHeader {capacity, offset};
+    return data_p;
+}
+
+void PixelMemoryPool::do_deallocate(void * data_p, size_t, size_t)
+{
+    //- the size and alignment come from the header, the caller may pass a smaller size than it was given
+    const auto [capacity, offset] = get_block_header(data_p);
+    std::byte * base_p = static_cast<std::byte *>(data_p) - offset;
+    if (offset == k_block_header_size and capacity >= k_min_pooled_size) {
+        std::lock_guard lock {m_mutex};
+        if (m_cached_bytes + capacity <= m_max_cached_bytes) {
+            m_free_blocks[capacity].emplace_back(base_p);
+            m_cached_bytes += capacity;
+            return;
+        }
+    }
+    m_upstream_p->deallocate(base_p, capacity, offset);
+}
+
+PixelMemoryPool * lcf::get_default_pixel_memory_pool() noexcept
+{
+    static auto * s_pool_p = new PixelMemoryPool; //- leaked on purpose, see the declaration
+    return s_pool_p;
+}
+
+//- auxiliary function implementations begin
+
+size_t round_to_size_class(size_t size) noexcept
+{
+    size_t step = std::bit_floor(size) / k_size_class_steps;
+    return (size + step - 1) / step * step;
+}
+
+BlockHeader & get_block_header(void * data_p) noexcept
+{
+    return *std::launder(reinterpret_cast<BlockHeader *>(static_cast<std::byte *>(data_p) - sizeof(BlockHeader)));
+}
+//- auxiliary function implementations end
@@ -4,6 +4,7 @@
 #include "image/details/convert_from_color_to_gray.h"
 #include "image/details/convert_from_gray_to_color.h"
 #include "image/details/convert_from_gray_to_gray.h"
+#include "details/convert_kernels.h"
 
 /*
 Rationale:
@@ -32,10 +33,13 @@ Implementation note:
 - We classify `src_view` and `dst_view` into Color/Gray at compile time using
   traits (is_any_type_of_v) and dispatch to the minimal dedicated function,
   which significantly reduces per-TU code size.
+- Hot pairs such as RGB8 -> RGBA8 or u8 <-> float are first offered to the
+  row parallel kernels in convert_kernels.cpp; gil stays the fallback.
 */
 
 void lcf::details::convert(ConstImageViewVariant src_view_var, ImageViewVariant dst_view_var)
 {
+    if (try_convert_fast(src_view_var, dst_view_var)) { return; }
     boost::variant2::visit([&](auto && src_view) {
         using src_view_t = std::remove_cvref_t<decltype(src_view)>;
         boost::variant2::visit([&](auto && dst_view) {
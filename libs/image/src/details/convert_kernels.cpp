@@ -0,0 +1,449 @@
+#include "details/convert_kernels.h"
+#include "details/cpu_features.h"
+#include "details/parallel_rows.h"
+#include "image/image_enums.h"
+#include "image/details/utils.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LCF_IMAGE_SSE2 //- x86 baseline, the wider kernels below are picked at runtime
+#include <emmintrin.h>
+#endif
+
+using namespace lcf;
+
+namespace {
+    constexpr uint32_t k_pixels_per_task = 64 * 1024;
+    constexpr uint32_t k_linear_to_srgb_table_size = 8192; //- keeps the table error below one 8 bit step near black
+}
+
+//- auxiliary structs begin
+template <typename Byte>
+struct RawImageView
+{
+    Byte * m_data_p = nullptr;
+    ptrdiff_t m_row_size = 0;
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    ImageFormat m_format = ImageFormat::eInvalid;
+};
+
+using RowKernel = void (*)(const std::byte * src_p, std::byte * dst_p, uint32_t width, uint32_t channel_count);
+//- auxiliary structs end
+
+//- auxiliary function forward declarations begin
+template <typename Byte, typename ViewVar>
+RawImageView<Byte> get_raw_view(const ViewVar & view_var) noexcept;
+
+RowKernel select_row_kernel(ImageFormat src_format, ImageFormat dst_format) noexcept;
+
+uint8_t normalized_to_u8(float value) noexcept;
+
+const std::array<float, 256> & get_srgb_to_linear_table() noexcept;
+
+const std::array<uint8_t, k_linear_to_srgb_table_size> & get_linear_to_srgb_table() noexcept;
+
+#if defined(LCF_IMAGE_SSE2)
+__m128i pack_normalized_to_u8(__m128 v0, __m128 v1, __m128 v2, __m128 v3) noexcept;
+
+//- the simd kernels start at element or pixel i and return where the scalar tail picks up
+LCF_IMAGE_TARGET_SSSE3 size_t convert_rgb8_to_rgba8_ssse3(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept;
+
+LCF_IMAGE_TARGET_SSSE3 size_t convert_gray8_to_rgba8_ssse3(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept;
+
+LCF_IMAGE_TARGET_AVX2 size_t swizzle_rgba8_bgra8_avx2(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept;
+
+LCF_IMAGE_TARGET_SSSE3 size_t swizzle_rgba8_bgra8_ssse3(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept;
+
+LCF_IMAGE_TARGET_AVX2 size_t convert_u8_to_f32_avx2(const uint8_t * src_p, float * dst_p, size_t i, size_t element_count) noexcept;
+
+size_t convert_u8_to_f32_sse2(const uint8_t * src_p, float * dst_p, size_t i, size_t element_count) noexcept;
+
+LCF_IMAGE_TARGET_F16C size_t convert_u8_to_f16_f16c(const uint8_t * src_p, float16_t * dst_p, size_t i, size_t element_count) noexcept;
+
+LCF_IMAGE_TARGET_F16C size_t convert_f16_to_u8_f16c(const float16_t * src_p, uint8_t * dst_p, size_t i, size_t element_count) noexcept;
+#endif
+//- auxiliary function forward declarations end
+
+float lcf::details::srgb_to_linear(float value) noexcept
+{
+    if (value <= 0.04045f) { return value / 12.92f; }
+    return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float lcf::details::linear_to_srgb(float value) noexcept
+{
+    if (value <= 0.0031308f) { return value * 12.92f; }
+    return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+void lcf::details::convert_rgb8_to_rgba8(const uint8_t * src_p, uint8_t * dst_p, size_t pixel_count) noexcept
+{
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    if (details::get_cpu_features().m_has_ssse3) { i = convert_rgb8_to_rgba8_ssse3(src_p, dst_p, i, pixel_count); }
+#endif
+    for (; i < pixel_count; ++i) {
+        dst_p[i * 4 + 0] = src_p[i * 3 + 0];
+        dst_p[i * 4 + 1] = src_p[i * 3 + 1];
+        dst_p[i * 4 + 2] = src_p[i * 3 + 2];
+        dst_p[i * 4 + 3] = 0xFF;
+    }
+}
+
+void lcf::details::convert_gray8_to_rgba8(const uint8_t * src_p, uint8_t * dst_p, size_t pixel_count) noexcept
+{
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    if (details::get_cpu_features().m_has_ssse3) { i = convert_gray8_to_rgba8_ssse3(src_p, dst_p, i, pixel_count); }
+#endif
+    for (; i < pixel_count; ++i) {
+        dst_p[i * 4 + 0] = src_p[i];
+        dst_p[i * 4 + 1] = src_p[i];
+        dst_p[i * 4 + 2] = src_p[i];
+        dst_p[i * 4 + 3] = 0xFF;
+    }
+}
+
+void lcf::details::swizzle_rgba8_bgra8(const uint8_t * src_p, uint8_t * dst_p, size_t pixel_count) noexcept
+{
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    const auto & cpu_features = details::get_cpu_features();
+    if (cpu_features.m_has_avx2) { i = swizzle_rgba8_bgra8_avx2(src_p, dst_p, i, pixel_count); }
+    if (cpu_features.m_has_ssse3) { i = swizzle_rgba8_bgra8_ssse3(src_p, dst_p, i, pixel_count); }
+#endif
+    for (; i < pixel_count; ++i) {
+        dst_p[i * 4 + 0] = src_p[i * 4 + 2];
+        dst_p[i * 4 + 1] = src_p[i * 4 + 1];
+        dst_p[i * 4 + 2] = src_p[i * 4 + 0];
+        dst_p[i * 4 + 3] = src_p[i * 4 + 3];
+    }
+}
+
+void lcf::details::convert_u8_to_f32(const uint8_t * src_p, float * dst_p, size_t element_count) noexcept
+{
+    constexpr float scale = 1.0f / 255.0f;
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    if (details::get_cpu_features().m_has_avx2) { i = convert_u8_to_f32_avx2(src_p, dst_p, i, element_count); }
+    i = convert_u8_to_f32_sse2(src_p, dst_p, i, element_count);
+#endif
+    for (; i < element_count; ++i) { dst_p[i] = src_p[i] * scale; }
+}
+
+void lcf::details::convert_f32_to_u8(const float * src_p, uint8_t * dst_p, size_t element_count) noexcept
+{
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    for (; i + 16 <= element_count; i += 16) {
+        __m128i dst_v = pack_normalized_to_u8(
+            _mm_loadu_ps(src_p + i),
+            _mm_loadu_ps(src_p + i + 4),
+            _mm_loadu_ps(src_p + i + 8),
+            _mm_loadu_ps(src_p + i + 12));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p + i), dst_v);
+    }
+#endif
+    for (; i < element_count; ++i) { dst_p[i] = normalized_to_u8(src_p[i]); }
+}
+
+void lcf::details::convert_u8_to_f16(const uint8_t * src_p, float16_t * dst_p, size_t element_count) noexcept
+{
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    if (details::get_cpu_features().m_has_f16c) { i = convert_u8_to_f16_f16c(src_p, dst_p, i, element_count); }
+#endif
+    static const auto s_table = [] { //- 256 exact results, cheaper than a float to half rounding per element
+        std::array<float16_t, 256> table;
+        for (uint32_t v = 0; v < table.size(); ++v) { table[v] = static_cast<float16_t>(v / 255.0f); }
+        return table;
+    }();
+    for (; i < element_count; ++i) { dst_p[i] = s_table[src_p[i]]; }
+}
+
+void lcf::details::convert_f16_to_u8(const float16_t * src_p, uint8_t * dst_p, size_t element_count) noexcept
+{
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    if (details::get_cpu_features().m_has_f16c) { i = convert_f16_to_u8_f16c(src_p, dst_p, i, element_count); }
+#endif
+    for (; i < element_count; ++i) { dst_p[i] = normalized_to_u8(static_cast<float>(src_p[i])); }
+}
+
+void lcf::details::convert_srgb8_to_linear_f32(const uint8_t * src_p, float * dst_p, size_t pixel_count, uint32_t channel_count) noexcept
+{
+    const auto & table = get_srgb_to_linear_table();
+    const uint32_t color_channel_count = (channel_count == 2 or channel_count == 4) ? channel_count - 1 : channel_count;
+    if (color_channel_count == channel_count) {
+        for (size_t i = 0; i < pixel_count * channel_count; ++i) { dst_p[i] = table[src_p[i]]; }
+        return;
+    }
+    for (size_t i = 0; i < pixel_count; ++i, src_p += channel_count, dst_p += channel_count) {
+        for (uint32_t c = 0; c < color_channel_count; ++c) { dst_p[c] = table[src_p[c]]; }
+        dst_p[color_channel_count] = src_p[color_channel_count] / 255.0f;
+    }
+}
+
+void lcf::details::convert_linear_f32_to_srgb8(const float * src_p, uint8_t * dst_p, size_t pixel_count, uint32_t channel_count) noexcept
+{
+    constexpr float table_scale = static_cast<float>(k_linear_to_srgb_table_size - 1);
+    const auto & table = get_linear_to_srgb_table();
+    const uint32_t color_channel_count = (channel_count == 2 or channel_count == 4) ? channel_count - 1 : channel_count;
+    auto encode = [&table](float value) {
+        value = value > 0.0f ? std::min(value, 1.0f) : 0.0f;
+        return table[static_cast<uint32_t>(value * table_scale + 0.5f)];
+    };
+    if (color_channel_count == channel_count) {
+        for (size_t i = 0; i < pixel_count * channel_count; ++i) { dst_p[i] = encode(src_p[i]); }
+        return;
+    }
+    for (size_t i = 0; i < pixel_count; ++i, src_p += channel_count, dst_p += channel_count) {
+        for (uint32_t c = 0; c < color_channel_count; ++c) { dst_p[c] = encode(src_p[c]); }
+        dst_p[color_channel_count] = normalized_to_u8(src_p[color_channel_count]);
+    }
+}
+
+bool lcf::details::try_convert_fast(ConstImageViewVariant src_view_var, ImageViewVariant dst_view_var) noexcept
+{
+    auto src = get_raw_view<const std::byte>(src_view_var);
+    auto dst = get_raw_view<std::byte>(dst_view_var);
+    if (not src.m_data_p or not dst.m_data_p) { return false; }
+    if (src.m_width != dst.m_width or src.m_height != dst.m_height or src.m_width == 0) { return false; }
+    const uint32_t channel_count = enum_decode::get_channel_count(src.m_format);
+    const uint32_t rows_per_task = std::max(1u, k_pixels_per_task / src.m_width);
+    if (src.m_format == dst.m_format) {
+        const size_t row_size_in_bytes = size_t(src.m_width) * channel_count * enum_decode::get_bytes_per_channel(src.m_format);
+        parallel_for_rows(src.m_height, rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+            for (uint32_t y = row_begin; y < row_end; ++y) {
+                std::memcpy(dst.m_data_p + y * dst.m_row_size, src.m_data_p + y * src.m_row_size, row_size_in_bytes);
+            }
+        });
+        return true;
+    }
+    RowKernel kernel = select_row_kernel(src.m_format, dst.m_format);
+    if (not kernel) { return false; }
+    parallel_for_rows(src.m_height, rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+        for (uint32_t y = row_begin; y < row_end; ++y) {
+            kernel(src.m_data_p + y * src.m_row_size, dst.m_data_p + y * dst.m_row_size, src.m_width, channel_count);
+        }
+    });
+    return true;
+}
+
+//- auxiliary function implementations begin
+template <typename Byte, typename ViewVar>
+RawImageView<Byte> get_raw_view(const ViewVar & view_var) noexcept
+{
+    return boost::variant2::visit([](auto && view) {
+        using view_t = std::remove_cvref_t<decltype(view)>;
+        RawImageView<Byte> raw_view;
+        raw_view.m_data_p = reinterpret_cast<Byte *>(boost::gil::interleaved_view_get_raw_data(view));
+        raw_view.m_row_size = view.pixels().row_size();
+        raw_view.m_width = static_cast<uint32_t>(view.width());
+        raw_view.m_height = static_cast<uint32_t>(view.height());
+        raw_view.m_format = details::get_image_format_of<typename view_t::value_type>();
+        return raw_view;
+    }, view_var);
+}
+
+RowKernel select_row_kernel(ImageFormat src_format, ImageFormat dst_format) noexcept
+{
+    if (src_format == ImageFormat::eRGB8Uint and dst_format == ImageFormat::eRGBA8Uint) {
+        return [](const std::byte * src_p, std::byte * dst_p, uint32_t width, uint32_t) {
+            details::convert_rgb8_to_rgba8(reinterpret_cast<const uint8_t *>(src_p), reinterpret_cast<uint8_t *>(dst_p), width);
+        };
+    }
+    if (src_format == ImageFormat::eGray8Uint and dst_format == ImageFormat::eRGBA8Uint) {
+        return [](const std::byte * src_p, std::byte * dst_p, uint32_t width, uint32_t) {
+            details::convert_gray8_to_rgba8(reinterpret_cast<const uint8_t *>(src_p), reinterpret_cast<uint8_t *>(dst_p), width);
+        };
+    }
+    if (enum_decode::get_color_space(src_format) != enum_decode::get_color_space(dst_format)) { return nullptr; }
+    //- same channels, only the channel type changes
+    PixelDataType src_type = enum_decode::get_pixel_data_type(src_format);
+    PixelDataType dst_type = enum_decode::get_pixel_data_type(dst_format);
+    if (src_type == PixelDataType::eUint8 and dst_type == PixelDataType::eFloat32) {
+        return [](const std::byte * src_p, std::byte * dst_p, uint32_t width, uint32_t channel_count) {
+            details::convert_u8_to_f32(reinterpret_cast<const uint8_t *>(src_p), reinterpret_cast<float *>(dst_p), size_t(width) * channel_count);
+        };
+    }
+    if (src_type == PixelDataType::eFloat32 and dst_type == PixelDataType::eUint8) {
+        return [](const std::byte * src_p, std::byte * dst_p, uint32_t width, uint32_t channel_count) {
+            details::convert_f32_to_u8(reinterpret_cast<const float *>(src_p), reinterpret_cast<uint8_t *>(dst_p), size_t(width) * channel_count);
+        };
+    }
+    if (src_type == PixelDataType::eUint8 and dst_type == PixelDataType::eFloat16) {
+        return [](const std::byte * src_p, std::byte * dst_p, uint32_t width, uint32_t channel_count) {
+            details::convert_u8_to_f16(reinterpret_cast<const uint8_t *>(src_p), reinterpret_cast<float16_t *>(dst_p), size_t(width) * channel_count);
+        };
+    }
+    if (src_type == PixelDataType::eFloat16 and dst_type == PixelDataType::eUint8) {
+        return [](const std::byte * src_p, std::byte * dst_p, uint32_t width, uint32_t channel_count) {
+            details::convert_f16_to_u8(reinterpret_cast<const float16_t *>(src_p), reinterpret_cast<uint8_t *>(dst_p), size_t(width) * channel_count);
+        };
+    }
+    return nullptr;
+}
+
+uint8_t normalized_to_u8(float value) noexcept
+{
+    value = value > 0.0f ? std::min(value, 1.0f) : 0.0f; //- also maps nan to zero
+    return static_cast<uint8_t>(value * 255.0f + 0.5f);
+}
+
+const std::array<float, 256> & get_srgb_to_linear_table() noexcept
+{
+    static const auto s_table = [] {
+        std::array<float, 256> table;
+        for (uint32_t i = 0; i < table.size(); ++i) { table[i] = details::srgb_to_linear(i / 255.0f); }
+        return table;
+    }();
+    return s_table;
+}
+
+const std::array<uint8_t, k_linear_to_srgb_table_size> & get_linear_to_srgb_table() noexcept
+{
+    static const auto s_table = [] {
+        std::array<uint8_t, k_linear_to_srgb_table_size> table;
+        for (uint32_t i = 0; i < table.size(); ++i) {
+            float value = details::linear_to_srgb(i / static_cast<float>(k_linear_to_srgb_table_size - 1));
+            table[i] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
+        return table;
+    }();
+    return s_table;
+}
+
+#if defined(LCF_IMAGE_SSE2)
+__m128i pack_normalized_to_u8(__m128 v0, __m128 v1, __m128 v2, __m128 v3) noexcept
+{
+    //- max(v, 0) returns the second operand for nan, so nan lands on zero like the scalar path
+    const __m128 zero_v = _mm_setzero_ps();
+    const __m128 one_v = _mm_set1_ps(1.0f);
+    const __m128 scale_v = _mm_set1_ps(255.0f);
+    const __m128 half_v = _mm_set1_ps(0.5f);
+    auto to_int = [&](__m128 v) {
+        v = _mm_min_ps(_mm_max_ps(v, zero_v), one_v);
+        return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(v, scale_v), half_v));
+    };
+    __m128i lo_v = _mm_packs_epi32(to_int(v0), to_int(v1));
+    __m128i hi_v = _mm_packs_epi32(to_int(v2), to_int(v3));
+    return _mm_packus_epi16(lo_v, hi_v);
+}
+
+LCF_IMAGE_TARGET_SSSE3 size_t convert_rgb8_to_rgba8_ssse3(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept
+{
+    const __m128i shuffle_v = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha_v = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    for (; i + 6 <= pixel_count; i += 4) { //- reads 16 bytes for 4 texels, stay clear of the row end
+        __m128i src_v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p + i * 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p + i * 4), _mm_or_si128(_mm_shuffle_epi8(src_v, shuffle_v), alpha_v));
+    }
+    return i;
+}
+
+LCF_IMAGE_TARGET_SSSE3 size_t convert_gray8_to_rgba8_ssse3(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept
+{
+    const __m128i alpha_v = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    const __m128i shuffle_v[4] = {
+        _mm_setr_epi8(0, 0, 0, -1, 1, 1, 1, -1, 2, 2, 2, -1, 3, 3, 3, -1),
+        _mm_setr_epi8(4, 4, 4, -1, 5, 5, 5, -1, 6, 6, 6, -1, 7, 7, 7, -1),
+        _mm_setr_epi8(8, 8, 8, -1, 9, 9, 9, -1, 10, 10, 10, -1, 11, 11, 11, -1),
+        _mm_setr_epi8(12, 12, 12, -1, 13, 13, 13, -1, 14, 14, 14, -1, 15, 15, 15, -1),
+    };
+    for (; i + 16 <= pixel_count; i += 16) {
+        __m128i src_v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p + i));
+        for (uint32_t k = 0; k < 4; ++k) {
+            __m128i dst_v = _mm_or_si128(_mm_shuffle_epi8(src_v, shuffle_v[k]), alpha_v);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p + (i + k * 4) * 4), dst_v);
+        }
+    }
+    return i;
+}
+
+LCF_IMAGE_TARGET_AVX2 size_t swizzle_rgba8_bgra8_avx2(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept
+{
+    const __m256i shuffle_v = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for (; i + 8 <= pixel_count; i += 8) {
+        __m256i src_v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src_p + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst_p + i * 4), _mm256_shuffle_epi8(src_v, shuffle_v));
+    }
+    return i;
+}
+
+LCF_IMAGE_TARGET_SSSE3 size_t swizzle_rgba8_bgra8_ssse3(const uint8_t * src_p, uint8_t * dst_p, size_t i, size_t pixel_count) noexcept
+{
+    const __m128i shuffle_v = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    for (; i + 4 <= pixel_count; i += 4) {
+        __m128i src_v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p + i * 4), _mm_shuffle_epi8(src_v, shuffle_v));
+    }
+    return i;
+}
+
+LCF_IMAGE_TARGET_AVX2 size_t convert_u8_to_f32_avx2(const uint8_t * src_p, float * dst_p, size_t i, size_t element_count) noexcept
+{
+    const __m256 scale_v = _mm256_set1_ps(1.0f / 255.0f);
+    for (; i + 8 <= element_count; i += 8) {
+        __m256i src_v = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src_p + i)));
+        _mm256_storeu_ps(dst_p + i, _mm256_mul_ps(_mm256_cvtepi32_ps(src_v), scale_v));
+    }
+    return i;
+}
+
+size_t convert_u8_to_f32_sse2(const uint8_t * src_p, float * dst_p, size_t i, size_t element_count) noexcept
+{
+    const __m128 scale_v = _mm_set1_ps(1.0f / 255.0f);
+    const __m128i zero_v = _mm_setzero_si128();
+    for (; i + 16 <= element_count; i += 16) {
+        __m128i src_v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p + i));
+        __m128i lo_v = _mm_unpacklo_epi8(src_v, zero_v);
+        __m128i hi_v = _mm_unpackhi_epi8(src_v, zero_v);
+        __m128i words_v[4] = {
+            _mm_unpacklo_epi16(lo_v, zero_v),
+            _mm_unpackhi_epi16(lo_v, zero_v),
+            _mm_unpacklo_epi16(hi_v, zero_v),
+            _mm_unpackhi_epi16(hi_v, zero_v),
+        };
+        for (uint32_t k = 0; k < 4; ++k) {
+            _mm_storeu_ps(dst_p + i + k * 4, _mm_mul_ps(_mm_cvtepi32_ps(words_v[k]), scale_v));
+        }
+    }
+    return i;
+}
+
+LCF_IMAGE_TARGET_F16C size_t convert_u8_to_f16_f16c(const uint8_t * src_p, float16_t * dst_p, size_t i, size_t element_count) noexcept
+{
+    const __m128 scale_v = _mm_set1_ps(1.0f / 255.0f);
+    const __m128i zero_v = _mm_setzero_si128();
+    for (; i + 8 <= element_count; i += 8) {
+        __m128i words_v = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src_p + i)), zero_v);
+        __m128 lo_v = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(words_v, zero_v)), scale_v);
+        __m128 hi_v = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(words_v, zero_v)), scale_v);
+        __m128i dst_v = _mm_unpacklo_epi64(_mm_cvtps_ph(lo_v, _MM_FROUND_TO_NEAREST_INT), _mm_cvtps_ph(hi_v, _MM_FROUND_TO_NEAREST_INT));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p + i), dst_v);
+    }
+    return i;
+}
+
+LCF_IMAGE_TARGET_F16C size_t convert_f16_to_u8_f16c(const float16_t * src_p, uint8_t * dst_p, size_t i, size_t element_count) noexcept
+{
+    for (; i + 16 <= element_count; i += 16) {
+        __m128i src_lo_v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p + i));
+        __m128i src_hi_v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p + i + 8));
+        __m128i dst_v = pack_normalized_to_u8(
+            _mm_cvtph_ps(src_lo_v),
+            _mm_cvtph_ps(_mm_srli_si128(src_lo_v, 8)),
+            _mm_cvtph_ps(src_hi_v),
+            _mm_cvtph_ps(_mm_srli_si128(src_hi_v, 8)));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p + i), dst_v);
+    }
+    return i;
+}
+#endif
+//- auxiliary function implementations end
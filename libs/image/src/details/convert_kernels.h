@@ -0,0 +1,35 @@
+#pragma once
+
+#include "image/details/ImageVariant.h"
+#include "float16.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace lcf::details {
+    float srgb_to_linear(float value) noexcept;
+
+    float linear_to_srgb(float value) noexcept;
+
+    //- row kernels, counts are in pixels unless noted otherwise; src and dst must not overlap
+    void convert_rgb8_to_rgba8(const uint8_t * src_p, uint8_t * dst_p, size_t pixel_count) noexcept;
+
+    void convert_gray8_to_rgba8(const uint8_t * src_p, uint8_t * dst_p, size_t pixel_count) noexcept;
+
+    void swizzle_rgba8_bgra8(const uint8_t * src_p, uint8_t * dst_p, size_t pixel_count) noexcept; //- works in either direction
+
+    void convert_u8_to_f32(const uint8_t * src_p, float * dst_p, size_t element_count) noexcept; //- normalized to [0, 1]
+
+    void convert_f32_to_u8(const float * src_p, uint8_t * dst_p, size_t element_count) noexcept; //- clamped and rounded
+
+    void convert_u8_to_f16(const uint8_t * src_p, float16_t * dst_p, size_t element_count) noexcept;
+
+    void convert_f16_to_u8(const float16_t * src_p, uint8_t * dst_p, size_t element_count) noexcept;
+
+    //- the alpha channel of 2 and 4 channel texels stays linear
+    void convert_srgb8_to_linear_f32(const uint8_t * src_p, float * dst_p, size_t pixel_count, uint32_t channel_count) noexcept;
+
+    void convert_linear_f32_to_srgb8(const float * src_p, uint8_t * dst_p, size_t pixel_count, uint32_t channel_count) noexcept;
+
+    //- runs the hot format pairs row parallel through the kernels above, returns false if the pair needs the generic path
+    bool try_convert_fast(ConstImageViewVariant src_view_var, ImageViewVariant dst_view_var) noexcept;
+}
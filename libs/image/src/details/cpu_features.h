@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LCF_IMAGE_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+//- kernels past the sse2 baseline are compiled with target attributes so default builds carry them,
+//- callers pick them through get_cpu_features() at runtime, the same scheme as float16_convert.h
+#if defined(LCF_IMAGE_X86) && (defined(__GNUC__) || defined(__clang__))
+#define LCF_IMAGE_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define LCF_IMAGE_TARGET_AVX2 __attribute__((target("avx2")))
+#define LCF_IMAGE_TARGET_F16C __attribute__((target("avx,f16c")))
+#else
+#define LCF_IMAGE_TARGET_SSSE3
+#define LCF_IMAGE_TARGET_AVX2
+#define LCF_IMAGE_TARGET_F16C
+#endif
+
+namespace lcf::details {
+    struct CpuFeatures
+    {
+        bool m_has_ssse3 = false;
+        bool m_has_avx2 = false;
+        bool m_has_f16c = false;
+    };
+
+#if defined(LCF_IMAGE_X86)
+    inline CpuFeatures detect_cpu_features() noexcept
+    {
+        CpuFeatures features;
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4] = {};
+        __cpuid(info, 1);
+        const bool os_saves_avx = (info[2] & (1 << 27)) and (_xgetbv(0) & 0x6) == 0x6;
+        features.m_has_ssse3 = info[2] & (1 << 9);
+        features.m_has_f16c = os_saves_avx and (info[2] & (1 << 28)) and (info[2] & (1 << 29));
+        __cpuidex(info, 7, 0);
+        features.m_has_avx2 = os_saves_avx and (info[1] & (1 << 5));
+#else
+        __builtin_cpu_init();
+        features.m_has_ssse3 = __builtin_cpu_supports("ssse3");
+        features.m_has_avx2 = __builtin_cpu_supports("avx2");
+        features.m_has_f16c = __builtin_cpu_supports("avx") and __builtin_cpu_supports("f16c");
+#endif
+        return features;
+    }
+#else
+    inline CpuFeatures detect_cpu_features() noexcept
+    {
+        return {};
+    }
+#endif
+
+    inline const CpuFeatures & get_cpu_features() noexcept
+    {
+        static const CpuFeatures s_features = detect_cpu_features();
+        return s_features;
+    }
+}
@@ -0,0 +1,673 @@
+#include "details/encode.h"
+#include "details/parallel_rows.h"
+#include <zlib.h>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace lcf;
+
+namespace {
+    constexpr size_t k_png_block_size = 256 * 1024; //- filtered bytes per deflate block
+    constexpr size_t k_deflate_window_size = 32 * 1024;
+    constexpr uint32_t k_blocks_per_worker = 4; //- depth of a wave, bounds the encoded bytes held before they are written
+    constexpr std::array<uint8_t, 8> k_png_signature {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    constexpr std::array<uint8_t, 64> k_zigzag_to_natural {
+        0, 1, 8, 16, 9, 2, 3, 10, 17, 24, 32, 25, 18, 11, 4, 5,
+        12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13, 6, 7, 14, 21, 28,
+        35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+        58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63,
+    };
+
+    //- annex k.1, natural order, scaled by quality
+    constexpr std::array<uint8_t, 64> k_luma_quantization {
+        16, 11, 10, 16, 24, 40, 51, 61,
+        12, 12, 14, 19, 26, 58, 60, 55,
+        14, 13, 16, 24, 40, 57, 69, 56,
+        14, 17, 22, 29, 51, 87, 80, 62,
+        18, 22, 37, 56, 68, 109, 103, 77,
+        24, 35, 55, 64, 81, 104, 113, 92,
+        49, 64, 78, 87, 103, 121, 120, 101,
+        72, 92, 95, 98, 112, 100, 103, 99,
+    };
+
+    constexpr std::array<uint8_t, 64> k_chroma_quantization {
+        17, 18, 24, 47, 99, 99, 99, 99,
+        18, 21, 26, 66, 99, 99, 99, 99,
+        24, 26, 56, 99, 99, 99, 99, 99,
+        47, 66, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+        99, 99, 99, 99, 99, 99, 99, 99,
+    };
+
+    constexpr std::array<float, 8> k_aan_scale {1.0f, 1.387039845f, 1.306562965f, 1.175875602f, 1.0f, 0.785694958f, 0.541196100f, 0.275899379f};
+
+    //- annex k.3 huffman tables, code counts per length 1 to 16 followed by the symbols
+    constexpr std::array<uint8_t, 16> k_luma_dc_counts {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+    constexpr std::array<uint8_t, 12> k_luma_dc_symbols {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    constexpr std::array<uint8_t, 16> k_chroma_dc_counts {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0};
+    constexpr std::array<uint8_t, 12> k_chroma_dc_symbols {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    constexpr std::array<uint8_t, 16> k_luma_ac_counts {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D};
+    constexpr std::array<uint8_t, 162> k_luma_ac_symbols {
+        0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+        0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+        0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+        0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+        0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+        0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+        0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+        0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5,
+        0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+        0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+        0xF9, 0xFA,
+    };
+    constexpr std::array<uint8_t, 16> k_chroma_ac_counts {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77};
+    constexpr std::array<uint8_t, 162> k_chroma_ac_symbols {
+        0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+        0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+        0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26,
+        0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+        0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+        0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+        0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+        0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+        0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+        0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+        0xF9, 0xFA,
+    };
+}
+
+//- auxiliary structs begin
+struct PngLayout
+{
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_bytes_per_pixel = 0;
+    uint32_t m_bytes_per_channel = 0;
+    size_t m_row_size = 0; //- unfiltered, without the filter type byte
+};
+
+struct PngBlock
+{
+    std::vector<uint8_t> m_deflated;
+    uint32_t m_adler = 1;
+    size_t m_filtered_size = 0;
+    bool m_failed = false;
+};
+
+struct HuffmanTable
+{
+    std::array<uint16_t, 256> m_codes {};
+    std::array<uint8_t, 256> m_lengths {};
+};
+
+struct JpegComponent
+{
+    uint8_t m_id = 0;
+    uint8_t m_sampling = 0x11; //- horizontal in the high nibble
+    uint8_t m_table_index = 0; //- 0 luma, 1 chroma
+};
+
+struct JpegEncoder
+{
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_channel_count = 0; //- of the source pixels
+    uint32_t m_component_count = 0; //- 1 gray, 3 ycbcr
+    bool m_is_subsampled = false;
+    std::array<std::array<uint8_t, 64>, 2> m_quantization {}; //- natural order
+    std::array<std::array<float, 64>, 2> m_divisors {}; //- folds the aan output scale into 1 / quantizer
+    uint32_t getMcuSize() const noexcept { return m_is_subsampled ? 16 : 8; }
+    uint32_t getMcusPerRow() const noexcept { return (m_width + this->getMcuSize() - 1) / this->getMcuSize(); }
+    uint32_t getMcuRowCount() const noexcept { return (m_height + this->getMcuSize() - 1) / this->getMcuSize(); }
+};
+
+class JpegBitWriter
+{
+public:
+    JpegBitWriter(std::vector<uint8_t> & bytes) noexcept : m_bytes(bytes) {}
+    void put(uint32_t bits, uint32_t length) noexcept //- length up to 16
+    {
+        m_buffer = (m_buffer << length) | (bits & ((1u << length) - 1));
+        m_bit_count += length;
+        while (m_bit_count >= 8) {
+            m_bit_count -= 8;
+            auto byte = static_cast<uint8_t>(m_buffer >> m_bit_count);
+            m_bytes.push_back(byte);
+            if (byte == 0xFF) { m_bytes.push_back(0); } //- stuffed so entropy data never looks like a marker
+        }
+        m_buffer &= (1u << m_bit_count) - 1;
+    }
+    void flush() noexcept //- pads the last byte with ones
+    {
+        if (m_bit_count > 0) { this->put((1u << (8 - m_bit_count)) - 1, 8 - m_bit_count); }
+    }
+private:
+    std::vector<uint8_t> & m_bytes;
+    uint32_t m_buffer = 0;
+    uint32_t m_bit_count = 0;
+};
+//- auxiliary structs end
+
+//- auxiliary function forward declarations begin
+bool write_bytes(std::FILE * file_p, const void * data_p, size_t size) noexcept;
+
+void append_u16_be(std::vector<uint8_t> & bytes, uint32_t value) noexcept;
+
+void append_u32_be(std::vector<uint8_t> & bytes, uint32_t value) noexcept;
+
+bool write_png_chunk(std::FILE * file_p, const char * type, std::span<const uint8_t> data) noexcept;
+
+uint8_t get_png_color_type(uint32_t channel_count) noexcept;
+
+uint8_t get_zlib_flags(uint32_t compression_level) noexcept;
+
+const uint8_t * load_png_row(std::span<const std::byte> pixels, const PngLayout & layout, uint32_t y, std::vector<uint8_t> & swap_buffer) noexcept;
+
+uint8_t paeth_predictor(uint8_t left, uint8_t up, uint8_t up_left) noexcept;
+
+//- picks the filter with the smallest sum of absolute signed residuals and writes the type byte plus the filtered row
+void filter_png_row(const uint8_t * row_p, const uint8_t * prev_row_p, size_t row_size, uint32_t bytes_per_pixel, uint8_t * dst_p, std::vector<uint8_t> & scratch) noexcept;
+
+void filter_png_rows(std::span<const std::byte> pixels, const PngLayout & layout, uint32_t row_begin, uint32_t row_end, std::vector<uint8_t> & filtered) noexcept;
+
+PngBlock deflate_png_block(std::span<const std::byte> pixels, const PngLayout & layout, uint32_t row_begin, uint32_t row_end, uint32_t compression_level, bool is_last) noexcept;
+
+uint32_t get_wave_size() noexcept;
+
+template <size_t symbol_count>
+HuffmanTable make_huffman_table(const std::array<uint8_t, 16> & counts, const std::array<uint8_t, symbol_count> & symbols) noexcept;
+
+std::array<uint8_t, 64> scale_quantization(const std::array<uint8_t, 64> & base, uint32_t quality) noexcept;
+
+JpegEncoder make_jpeg_encoder(uint32_t width, uint32_t height, uint32_t channel_count, uint32_t quality) noexcept;
+
+std::vector<uint8_t> make_jpeg_header(const JpegEncoder & encoder) noexcept;
+
+template <size_t symbol_count>
+void append_huffman_segment(std::vector<uint8_t> & bytes, uint8_t table_class_and_id, const std::array<uint8_t, 16> & counts, const std::array<uint8_t, symbol_count> & symbols) noexcept;
+
+void forward_dct(float * block_p) noexcept; //- aan, in place, output scaled by 8 * aan scale per axis
+
+void encode_jpeg_block(float * block_p, const std::array<float, 64> & divisors, const HuffmanTable & dc_table, const HuffmanTable & ac_table, int32_t & dc_prediction, JpegBitWriter & writer) noexcept;
+
+void encode_jpeg_mcu_row(std::span<const std::byte> pixels, const JpegEncoder & encoder, uint32_t mcu_row, std::vector<uint8_t> & bytes) noexcept;
+//- auxiliary function forward declarations end
+
+namespace {
+    const HuffmanTable k_luma_dc_table = make_huffman_table(k_luma_dc_counts, k_luma_dc_symbols);
+    const HuffmanTable k_chroma_dc_table = make_huffman_table(k_chroma_dc_counts, k_chroma_dc_symbols);
+    const HuffmanTable k_luma_ac_table = make_huffman_table(k_luma_ac_counts, k_luma_ac_symbols);
+    const HuffmanTable k_chroma_ac_table = make_huffman_table(k_chroma_ac_counts, k_chroma_ac_symbols);
+}
+
+bool details::is_png_encode_supported(ImageFormat format) noexcept
+{
+    if (not enum_decode::is_native_image_format(format)) { return false; }
+    auto data_type = enum_decode::get_pixel_data_type(format);
+    return data_type == PixelDataType::eUint8 or data_type == PixelDataType::eUint16;
+}
+
+std::error_code details::encode_png(
+    std::span<const std::byte> pixels,
+    uint32_t width,
+    uint32_t height,
+    ImageFormat format,
+    uint32_t compression_level,
+    std::FILE * file_p) noexcept
+{
+    if (not is_png_encode_supported(format) or width == 0 or height == 0) { return std::make_error_code(std::errc::invalid_argument); }
+    if (width > INT32_MAX or height > INT32_MAX) { return std::make_error_code(std::errc::value_too_large); }
+    compression_level = std::min(compression_level, 9u);
+    PngLayout layout;
+    layout.m_width = width;
+    layout.m_height = height;
+    layout.m_bytes_per_channel = enum_decode::get_bytes_per_channel(format);
+    layout.m_bytes_per_pixel = enum_decode::get_channel_count(format) * layout.m_bytes_per_channel;
+    layout.m_row_size = size_t(width) * layout.m_bytes_per_pixel;
+    if (pixels.size() < layout.m_row_size * height) { return std::make_error_code(std::errc::invalid_argument); }
+
+    std::vector<uint8_t> header;
+    append_u32_be(header, width);
+    append_u32_be(header, height);
+    header.push_back(static_cast<uint8_t>(layout.m_bytes_per_channel * 8));
+    header.push_back(get_png_color_type(enum_decode::get_channel_count(format)));
+    header.insert(header.end(), {0, 0, 0}); //- deflate, adaptive filtering, no interlace
+    if (not write_bytes(file_p, k_png_signature.data(), k_png_signature.size()) or not write_png_chunk(file_p, "IHDR", header)) {
+        return std::make_error_code(std::errc::io_error);
+    }
+
+    const uint32_t rows_per_block = static_cast<uint32_t>(std::max<size_t>(1, k_png_block_size / (layout.m_row_size + 1)));
+    const uint32_t block_count = (height + rows_per_block - 1) / rows_per_block;
+    const uint32_t wave_size = get_wave_size();
+    uint32_t adler = adler32(0, nullptr, 0);
+    std::vector<PngBlock> blocks;
+    for (uint32_t wave_begin = 0; wave_begin < block_count; wave_begin += wave_size) {
+        const uint32_t wave_end = std::min(wave_begin + wave_size, block_count);
+        blocks.assign(wave_end - wave_begin, PngBlock {});
+        parallel_for_rows(wave_end - wave_begin, 1, [&](uint32_t task_begin, uint32_t task_end) {
+            for (uint32_t task = task_begin; task < task_end; ++task) {
+                uint32_t block_index = wave_begin + task;
+                uint32_t row_begin = block_index * rows_per_block;
+                blocks[task] = deflate_png_block(pixels, layout, row_begin, std::min(row_begin + rows_per_block, height), compression_level, block_index + 1 == block_count);
+            }
+        });
+        for (uint32_t task = 0; task < blocks.size(); ++task) {
+            auto & block = blocks[task];
+            if (block.m_failed) { return std::make_error_code(std::errc::not_enough_memory); }
+            adler = adler32_combine(adler, block.m_adler, static_cast<z_off_t>(block.m_filtered_size));
+            if (wave_begin + task == 0) { block.m_deflated.insert(block.m_deflated.begin(), {0x78, get_zlib_flags(compression_level)}); }
+            if (wave_begin + task + 1 == block_count) { append_u32_be(block.m_deflated, adler); }
+            if (not write_png_chunk(file_p, "IDAT", block.m_deflated)) { return std::make_error_code(std::errc::io_error); }
+        }
+    }
+    if (not write_png_chunk(file_p, "IEND", {})) { return std::make_error_code(std::errc::io_error); }
+    return {};
+}
+
+bool details::is_jpeg_encode_supported(ImageFormat format) noexcept
+{
+    return enum_decode::is_native_image_format(format) and enum_decode::get_pixel_data_type(format) == PixelDataType::eUint8;
+}
+
+std::error_code details::encode_jpeg(
+    std::span<const std::byte> pixels,
+    uint32_t width,
+    uint32_t height,
+    ImageFormat format,
+    uint32_t quality,
+    std::FILE * file_p) noexcept
+{
+    if (not is_jpeg_encode_supported(format) or width == 0 or height == 0) { return std::make_error_code(std::errc::invalid_argument); }
+    if (width > UINT16_MAX or height > UINT16_MAX) { return std::make_error_code(std::errc::value_too_large); }
+    const uint32_t channel_count = enum_decode::get_channel_count(format);
+    if (pixels.size() < size_t(width) * height * channel_count) { return std::make_error_code(std::errc::invalid_argument); }
+    auto encoder = make_jpeg_encoder(width, height, channel_count, std::clamp(quality, 1u, 100u));
+    auto header = make_jpeg_header(encoder);
+    if (not write_bytes(file_p, header.data(), header.size())) { return std::make_error_code(std::errc::io_error); }
+
+    const uint32_t mcu_row_count = encoder.getMcuRowCount();
+    const uint32_t wave_size = get_wave_size();
+    std::vector<std::vector<uint8_t>> rows;
+    for (uint32_t wave_begin = 0; wave_begin < mcu_row_count; wave_begin += wave_size) {
+        const uint32_t wave_end = std::min(wave_begin + wave_size, mcu_row_count);
+        rows.resize(wave_end - wave_begin);
+        parallel_for_rows(wave_end - wave_begin, 1, [&](uint32_t task_begin, uint32_t task_end) {
+            for (uint32_t task = task_begin; task < task_end; ++task) {
+                rows[task].clear();
+                encode_jpeg_mcu_row(pixels, encoder, wave_begin + task, rows[task]);
+            }
+        });
+        for (const auto & row : rows) {
+            if (not write_bytes(file_p, row.data(), row.size())) { return std::make_error_code(std::errc::io_error); }
+        }
+    }
+    constexpr std::array<uint8_t, 2> end_of_image {0xFF, 0xD9};
+    if (not write_bytes(file_p, end_of_image.data(), end_of_image.size())) { return std::make_error_code(std::errc::io_error); }
+    return {};
+}
+
+//- auxiliary function implementations begin
+bool write_bytes(std::FILE * file_p, const void * data_p, size_t size) noexcept
+{
+    return size == 0 or std::fwrite(data_p, 1, size, file_p) == size;
+}
+
+void append_u16_be(std::vector<uint8_t> & bytes, uint32_t value) noexcept
+{
+    bytes.insert(bytes.end(), {static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)});
+}
+
+void append_u32_be(std::vector<uint8_t> & bytes, uint32_t value) noexcept
+{
+    bytes.insert(bytes.end(), {static_cast<uint8_t>(value >> 24), static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)});
+}
+
+bool write_png_chunk(std::FILE * file_p, const char * type, std::span<const uint8_t> data) noexcept
+{
+    std::vector<uint8_t> prefix;
+    append_u32_be(prefix, static_cast<uint32_t>(data.size()));
+    prefix.insert(prefix.end(), type, type + 4);
+    uLong crc = crc32(0, prefix.data() + 4, 4);
+    crc = crc32(crc, data.data(), static_cast<uInt>(data.size()));
+    std::vector<uint8_t> suffix;
+    append_u32_be(suffix, static_cast<uint32_t>(crc));
+    return write_bytes(file_p, prefix.data(), prefix.size()) and write_bytes(file_p, data.data(), data.size()) and write_bytes(file_p, suffix.data(), suffix.size());
+}
+
+uint8_t get_png_color_type(uint32_t channel_count) noexcept
+{
+    switch (channel_count) {
+        case 1: { return 0; }
+        case 2: { return 4; }
+        case 3: { return 2; }
+        default: return 6;
+    }
+}
+
+uint8_t get_zlib_flags(uint32_t compression_level) noexcept
+{
+    uint32_t level_bits = compression_level < 2 ? 0 : compression_level < 6 ? 1 : compression_level == 6 ? 2 : 3;
+    uint32_t flags = level_bits << 6;
+    flags += 31 - (0x78 * 256 + flags) % 31; //- the header check bits
+    return static_cast<uint8_t>(flags);
+}
+
+const uint8_t * load_png_row(std::span<const std::byte> pixels, const PngLayout & layout, uint32_t y, std::vector<uint8_t> & swap_buffer) noexcept
+{
+    const auto * row_p = reinterpret_cast<const uint8_t *>(pixels.data()) + y * layout.m_row_size;
+    if (layout.m_bytes_per_channel == 1) { return row_p; }
+    swap_buffer.resize(layout.m_row_size);
+    for (size_t i = 0; i < layout.m_row_size; i += 2) { //- png stores 16 bit samples big endian
+        swap_buffer[i] = row_p[i + 1];
+        swap_buffer[i + 1] = row_p[i];
+    }
+    return swap_buffer.data();
+}
+
+uint8_t paeth_predictor(uint8_t left, uint8_t up, uint8_t up_left) noexcept
+{
+    int estimate = int(left) + up - up_left;
+    int left_distance = std::abs(estimate - left);
+    int up_distance = std::abs(estimate - up);
+    int up_left_distance = std::abs(estimate - up_left);
+    if (left_distance <= up_distance and left_distance <= up_left_distance) { return left; }
+    return up_distance <= up_left_distance ? up : up_left;
+}
+
+void filter_png_row(const uint8_t * row_p, const uint8_t * prev_row_p, size_t row_size, uint32_t bytes_per_pixel, uint8_t * dst_p, std::vector<uint8_t> & scratch) noexcept
+{
+    scratch.resize(row_size);
+    uint64_t best_cost = UINT64_MAX;
+    for (uint8_t filter = 0; filter < 5; ++filter) {
+        uint64_t cost = 0;
+        for (size_t i = 0; i < row_size; ++i) {
+            uint8_t left = i >= bytes_per_pixel ? row_p[i - bytes_per_pixel] : 0;
+            uint8_t up = prev_row_p ? prev_row_p[i] : 0;
+            uint8_t up_left = prev_row_p and i >= bytes_per_pixel ? prev_row_p[i - bytes_per_pixel] : 0;
+            uint8_t prediction = 0;
+            switch (filter) {
+                case 1: { prediction = left; } break;
+                case 2: { prediction = up; } break;
+                case 3: { prediction = static_cast<uint8_t>((uint32_t(left) + up) >> 1); } break;
+                case 4: { prediction = paeth_predictor(left, up, up_left); } break;
+                default: break;
+            }
+            scratch[i] = static_cast<uint8_t>(row_p[i] - prediction);
+            cost += std::abs(static_cast<int8_t>(scratch[i]));
+        }
+        if (cost < best_cost) {
+            best_cost = cost;
+            dst_p[0] = filter;
+            std::memcpy(dst_p + 1, scratch.data(), row_size);
+        }
+    }
+}
+
+void filter_png_rows(std::span<const std::byte> pixels, const PngLayout & layout, uint32_t row_begin, uint32_t row_end, std::vector<uint8_t> & filtered) noexcept
+{
+    std::vector<uint8_t> row_buffer, prev_row_buffer, scratch;
+    const uint8_t * prev_row_p = row_begin > 0 ? load_png_row(pixels, layout, row_begin - 1, prev_row_buffer) : nullptr;
+    filtered.resize(size_t(row_end - row_begin) * (layout.m_row_size + 1));
+    for (uint32_t y = row_begin; y < row_end; ++y) {
+        const uint8_t * row_p = load_png_row(pixels, layout, y, row_buffer);
+        filter_png_row(row_p, prev_row_p, layout.m_row_size, layout.m_bytes_per_pixel, filtered.data() + size_t(y - row_begin) * (layout.m_row_size + 1), scratch);
+        if (layout.m_bytes_per_channel != 1) { std::swap(row_buffer, prev_row_buffer); prev_row_p = prev_row_buffer.data(); }
+        else { prev_row_p = row_p; }
+    }
+}
+
+PngBlock deflate_png_block(std::span<const std::byte> pixels, const PngLayout & layout, uint32_t row_begin, uint32_t row_end, uint32_t compression_level, bool is_last) noexcept
+{
+    //- the rows just before the block are filtered again to prime the window, so the block compresses about as well
+    //- as it would inside one serial stream
+    const size_t filtered_row_size = layout.m_row_size + 1;
+    const auto dictionary_row_count = static_cast<uint32_t>(std::min<size_t>(row_begin, (k_deflate_window_size + filtered_row_size - 1) / filtered_row_size));
+    std::vector<uint8_t> filtered;
+    filter_png_rows(pixels, layout, row_begin - dictionary_row_count, row_end, filtered);
+    const size_t dictionary_size = std::min(k_deflate_window_size, size_t(dictionary_row_count) * filtered_row_size);
+    const uint8_t * block_p = filtered.data() + size_t(dictionary_row_count) * filtered_row_size;
+    PngBlock block;
+    block.m_filtered_size = filtered.size() - size_t(dictionary_row_count) * filtered_row_size;
+    block.m_adler = adler32(adler32(0, nullptr, 0), block_p, static_cast<uInt>(block.m_filtered_size));
+
+    z_stream stream {};
+    if (deflateInit2(&stream, static_cast<int>(compression_level), Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        block.m_failed = true;
+        return block;
+    }
+    if (dictionary_size > 0) { deflateSetDictionary(&stream, block_p - dictionary_size, static_cast<uInt>(dictionary_size)); }
+    //- a sync flush ends every block but the last on a byte boundary, so the blocks concatenate into one stream
+    block.m_deflated.resize(deflateBound(&stream, static_cast<uLong>(block.m_filtered_size)) + 16);
+    stream.next_in = const_cast<Bytef *>(block_p);
+    stream.avail_in = static_cast<uInt>(block.m_filtered_size);
+    const int flush = is_last ? Z_FINISH : Z_SYNC_FLUSH;
+    int result = Z_OK;
+    do {
+        if (stream.total_out == block.m_deflated.size()) { block.m_deflated.resize(block.m_deflated.size() * 2); }
+        stream.next_out = block.m_deflated.data() + stream.total_out;
+        stream.avail_out = static_cast<uInt>(block.m_deflated.size() - stream.total_out);
+        result = deflate(&stream, flush);
+    } while (result == Z_OK and (stream.avail_out == 0 or (is_last and result != Z_STREAM_END)));
+    block.m_failed = is_last ? result != Z_STREAM_END : (result != Z_OK and result != Z_BUF_ERROR);
+    block.m_deflated.resize(stream.total_out);
+    deflateEnd(&stream);
+    return block;
+}
+
+uint32_t get_wave_size() noexcept
+{
+    return std::max<uint32_t>(1, static_cast<uint32_t>(details::get_executor().num_workers()) * k_blocks_per_worker);
+}
+
+template <size_t symbol_count>
+HuffmanTable make_huffman_table(const std::array<uint8_t, 16> & counts, const std::array<uint8_t, symbol_count> & symbols) noexcept
+{
+    HuffmanTable table;
+    uint32_t code = 0;
+    size_t symbol_index = 0;
+    for (uint32_t length = 1; length <= 16; ++length) {
+        for (uint32_t i = 0; i < counts[length - 1]; ++i, ++code, ++symbol_index) {
+            table.m_codes[symbols[symbol_index]] = static_cast<uint16_t>(code);
+            table.m_lengths[symbols[symbol_index]] = static_cast<uint8_t>(length);
+        }
+        code <<= 1;
+    }
+    return table;
+}
+
+std::array<uint8_t, 64> scale_quantization(const std::array<uint8_t, 64> & base, uint32_t quality) noexcept
+{
+    const uint32_t scale = quality < 50 ? 5000 / quality : 200 - quality * 2; //- the ijg quality curve
+    std::array<uint8_t, 64> table;
+    for (size_t i = 0; i < 64; ++i) { table[i] = static_cast<uint8_t>(std::clamp((base[i] * scale + 50) / 100, 1u, 255u)); }
+    return table;
+}
+
+JpegEncoder make_jpeg_encoder(uint32_t width, uint32_t height, uint32_t channel_count, uint32_t quality) noexcept
+{
+    JpegEncoder encoder;
+    encoder.m_width = width;
+    encoder.m_height = height;
+    encoder.m_channel_count = channel_count;
+    encoder.m_component_count = channel_count >= 3 ? 3 : 1;
+    encoder.m_is_subsampled = encoder.m_component_count == 3 and quality <= 90;
+    encoder.m_quantization[0] = scale_quantization(k_luma_quantization, quality);
+    encoder.m_quantization[1] = scale_quantization(k_chroma_quantization, quality);
+    for (size_t table = 0; table < 2; ++table) {
+        for (size_t i = 0; i < 64; ++i) {
+            encoder.m_divisors[table][i] = 1.0f / (encoder.m_quantization[table][i] * k_aan_scale[i / 8] * k_aan_scale[i % 8] * 8.0f);
+        }
+    }
+    return encoder;
+}
+
+std::vector<uint8_t> make_jpeg_header(const JpegEncoder & encoder) noexcept
+{
+    std::vector<uint8_t> bytes {0xFF, 0xD8};
+    bytes.insert(bytes.end(), {0xFF, 0xE0, 0, 16, 'J', 'F', 'I', 'F', 0, 1, 1, 0, 0, 1, 0, 1, 0, 0});
+    const size_t table_count = encoder.m_component_count == 3 ? 2 : 1;
+    for (size_t table = 0; table < table_count; ++table) {
+        bytes.insert(bytes.end(), {0xFF, 0xDB, 0, 67, static_cast<uint8_t>(table)});
+        for (uint8_t natural_index : k_zigzag_to_natural) { bytes.push_back(encoder.m_quantization[table][natural_index]); }
+    }
+    std::array<JpegComponent, 3> components {{{1, static_cast<uint8_t>(encoder.m_is_subsampled ? 0x22 : 0x11), 0}, {2, 0x11, 1}, {3, 0x11, 1}}};
+    bytes.insert(bytes.end(), {0xFF, 0xC0});
+    append_u16_be(bytes, 8 + 3 * encoder.m_component_count);
+    bytes.push_back(8);
+    append_u16_be(bytes, encoder.m_height);
+    append_u16_be(bytes, encoder.m_width);
+    bytes.push_back(static_cast<uint8_t>(encoder.m_component_count));
+    for (uint32_t i = 0; i < encoder.m_component_count; ++i) {
+        bytes.insert(bytes.end(), {components[i].m_id, components[i].m_sampling, components[i].m_table_index});
+    }
+    append_huffman_segment(bytes, 0x00, k_luma_dc_counts, k_luma_dc_symbols);
+    append_huffman_segment(bytes, 0x10, k_luma_ac_counts, k_luma_ac_symbols);
+    if (encoder.m_component_count == 3) {
+        append_huffman_segment(bytes, 0x01, k_chroma_dc_counts, k_chroma_dc_symbols);
+        append_huffman_segment(bytes, 0x11, k_chroma_ac_counts, k_chroma_ac_symbols);
+    }
+    bytes.insert(bytes.end(), {0xFF, 0xDD, 0, 4}); //- restart interval of one mcu row
+    append_u16_be(bytes, encoder.getMcusPerRow());
+    bytes.insert(bytes.end(), {0xFF, 0xDA});
+    append_u16_be(bytes, 6 + 2 * encoder.m_component_count);
+    bytes.push_back(static_cast<uint8_t>(encoder.m_component_count));
+    for (uint32_t i = 0; i < encoder.m_component_count; ++i) {
+        bytes.insert(bytes.end(), {components[i].m_id, static_cast<uint8_t>(components[i].m_table_index * 0x11)});
+    }
+    bytes.insert(bytes.end(), {0, 63, 0}); //- full spectral range, no successive approximation
+    return bytes;
+}
+
+template <size_t symbol_count>
+void append_huffman_segment(std::vector<uint8_t> & bytes, uint8_t table_class_and_id, const std::array<uint8_t, 16> & counts, const std::array<uint8_t, symbol_count> & symbols) noexcept
+{
+    bytes.insert(bytes.end(), {0xFF, 0xC4});
+    append_u16_be(bytes, static_cast<uint32_t>(3 + counts.size() + symbols.size()));
+    bytes.push_back(table_class_and_id);
+    bytes.insert(bytes.end(), counts.begin(), counts.end());
+    bytes.insert(bytes.end(), symbols.begin(), symbols.end());
+}
+
+void forward_dct(float * block_p) noexcept
+{
+    auto transform = [](float * data_p, size_t stride) {
+        float tmp0 = data_p[0] + data_p[stride * 7], tmp7 = data_p[0] - data_p[stride * 7];
+        float tmp1 = data_p[stride] + data_p[stride * 6], tmp6 = data_p[stride] - data_p[stride * 6];
+        float tmp2 = data_p[stride * 2] + data_p[stride * 5], tmp5 = data_p[stride * 2] - data_p[stride * 5];
+        float tmp3 = data_p[stride * 3] + data_p[stride * 4], tmp4 = data_p[stride * 3] - data_p[stride * 4];
+        //- even part
+        float tmp10 = tmp0 + tmp3, tmp13 = tmp0 - tmp3;
+        float tmp11 = tmp1 + tmp2, tmp12 = tmp1 - tmp2;
+        data_p[0] = tmp10 + tmp11;
+        data_p[stride * 4] = tmp10 - tmp11;
+        float z1 = (tmp12 + tmp13) * 0.707106781f;
+        data_p[stride * 2] = tmp13 + z1;
+        data_p[stride * 6] = tmp13 - z1;
+        //- odd part
+        tmp10 = tmp4 + tmp5;
+        tmp11 = tmp5 + tmp6;
+        tmp12 = tmp6 + tmp7;
+        float z5 = (tmp10 - tmp12) * 0.382683433f;
+        float z2 = 0.541196100f * tmp10 + z5;
+        float z4 = 1.306562965f * tmp12 + z5;
+        float z3 = tmp11 * 0.707106781f;
+        float z11 = tmp7 + z3, z13 = tmp7 - z3;
+        data_p[stride * 5] = z13 + z2;
+        data_p[stride * 3] = z13 - z2;
+        data_p[stride] = z11 + z4;
+        data_p[stride * 7] = z11 - z4;
+    };
+    for (size_t row = 0; row < 8; ++row) { transform(block_p + row * 8, 1); }
+    for (size_t column = 0; column < 8; ++column) { transform(block_p + column, 8); }
+}
+
+void encode_jpeg_block(float * block_p, const std::array<float, 64> & divisors, const HuffmanTable & dc_table, const HuffmanTable & ac_table, int32_t & dc_prediction, JpegBitWriter & writer) noexcept
+{
+    forward_dct(block_p);
+    std::array<int32_t, 64> coefficients; //- zigzag order
+    for (size_t i = 0; i < 64; ++i) {
+        uint8_t natural_index = k_zigzag_to_natural[i];
+        coefficients[i] = static_cast<int32_t>(std::lround(block_p[natural_index] * divisors[natural_index]));
+    }
+    auto put_value = [&writer](const HuffmanTable & table, uint32_t symbol, int32_t value, uint32_t category) {
+        writer.put(table.m_codes[symbol], table.m_lengths[symbol]);
+        if (category > 0) { writer.put(static_cast<uint32_t>(value < 0 ? value - 1 : value), category); } //- negatives as one's complement
+    };
+    auto get_category = [](int32_t value) { return static_cast<uint32_t>(std::bit_width(static_cast<uint32_t>(std::abs(value)))); };
+    const int32_t dc_difference = coefficients[0] - dc_prediction;
+    dc_prediction = coefficients[0];
+    const uint32_t dc_category = get_category(dc_difference);
+    put_value(dc_table, dc_category, dc_difference, dc_category);
+    uint32_t zero_run = 0;
+    for (size_t i = 1; i < 64; ++i) {
+        if (coefficients[i] == 0) {
+            ++zero_run;
+            continue;
+        }
+        for (; zero_run >= 16; zero_run -= 16) { writer.put(ac_table.m_codes[0xF0], ac_table.m_lengths[0xF0]); }
+        const uint32_t category = get_category(coefficients[i]);
+        put_value(ac_table, (zero_run << 4) | category, coefficients[i], category);
+        zero_run = 0;
+    }
+    if (zero_run > 0) { writer.put(ac_table.m_codes[0x00], ac_table.m_lengths[0x00]); } //- end of block
+}
+
+void encode_jpeg_mcu_row(std::span<const std::byte> pixels, const JpegEncoder & encoder, uint32_t mcu_row, std::vector<uint8_t> & bytes) noexcept
+{
+    //- every row is one restart interval: the dc predictions start over and the row ends on a byte boundary, followed
+    //- by its restart marker unless it is the last one
+    const uint32_t mcu_size = encoder.getMcuSize();
+    const auto * src_p = reinterpret_cast<const uint8_t *>(pixels.data());
+    std::array<int32_t, 3> dc_predictions {};
+    std::array<std::array<float, 256>, 3> planes; //- y, cb, cr of one mcu, level shifted
+    std::array<float, 64> block;
+    JpegBitWriter writer {bytes};
+    const uint32_t y_begin = mcu_row * mcu_size;
+    for (uint32_t x_begin = 0; x_begin < encoder.m_width; x_begin += mcu_size) {
+        for (uint32_t y = 0; y < mcu_size; ++y) {
+            const uint8_t * row_p = src_p + size_t(std::min(y_begin + y, encoder.m_height - 1)) * encoder.m_width * encoder.m_channel_count;
+            for (uint32_t x = 0; x < mcu_size; ++x) { //- edge texels repeat past the image
+                const uint8_t * pixel_p = row_p + size_t(std::min(x_begin + x, encoder.m_width - 1)) * encoder.m_channel_count;
+                const uint32_t index = y * mcu_size + x;
+                if (encoder.m_component_count == 1) {
+                    planes[0][index] = pixel_p[0] - 128.0f;
+                    continue;
+                }
+                const float r = pixel_p[0], g = pixel_p[1], b = pixel_p[2];
+                planes[0][index] = 0.299f * r + 0.587f * g + 0.114f * b - 128.0f;
+                planes[1][index] = -0.168736f * r - 0.331264f * g + 0.5f * b;
+                planes[2][index] = 0.5f * r - 0.418688f * g - 0.081312f * b;
+            }
+        }
+        const uint32_t luma_block_count = encoder.m_is_subsampled ? 4 : 1;
+        for (uint32_t block_index = 0; block_index < luma_block_count; ++block_index) {
+            const uint32_t offset = (block_index / 2) * 8 * mcu_size + (block_index % 2) * 8;
+            for (uint32_t i = 0; i < 64; ++i) { block[i] = planes[0][offset + (i / 8) * mcu_size + i % 8]; }
+            encode_jpeg_block(block.data(), encoder.m_divisors[0], k_luma_dc_table, k_luma_ac_table, dc_predictions[0], writer);
+        }
+        for (uint32_t component = 1; component < encoder.m_component_count; ++component) {
+            const auto & plane = planes[component];
+            for (uint32_t i = 0; i < 64; ++i) {
+                const uint32_t x = i % 8, y = i / 8;
+                if (encoder.m_is_subsampled) {
+                    const uint32_t index = y * 2 * mcu_size + x * 2;
+                    block[i] = 0.25f * (plane[index] + plane[index + 1] + plane[index + mcu_size] + plane[index + mcu_size + 1]);
+                } else {
+                    block[i] = plane[i];
+                }
+            }
+            encode_jpeg_block(block.data(), encoder.m_divisors[1], k_chroma_dc_table, k_chroma_ac_table, dc_predictions[component], writer);
+        }
+    }
+    writer.flush();
+    if (mcu_row + 1 < encoder.getMcuRowCount()) { bytes.insert(bytes.end(), {0xFF, static_cast<uint8_t>(0xD0 + mcu_row % 8)}); }
+}
+//- auxiliary function implementations end
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "image/image_enums.h"
+#include <span>
+#include <cstdio>
+#include <cstdint>
+#include <system_error>
+
+namespace lcf::details {
+    //- 8 or 16 bit gray, gray alpha, rgb and rgba. Row blocks are filtered and deflated in parallel, each primed with
+    //- the tail of the block before it, and stitched into one zlib stream; blocks are written as they finish, in waves
+    //- a few times the worker count deep, so the encoded file is never held whole
+    bool is_png_encode_supported(ImageFormat format) noexcept;
+
+    std::error_code encode_png(
+        std::span<const std::byte> pixels,
+        uint32_t width,
+        uint32_t height,
+        ImageFormat format,
+        uint32_t compression_level, //- zlib level, 0 to 9
+        std::FILE * file_p) noexcept;
+
+    //- 8 bit, one or two channels become grayscale and alpha is dropped. Baseline with a restart marker after every
+    //- mcu row so rows are entropy coded in parallel; chroma is subsampled 2x2 at quality 90 and below
+    bool is_jpeg_encode_supported(ImageFormat format) noexcept;
+
+    std::error_code encode_jpeg(
+        std::span<const std::byte> pixels,
+        uint32_t width,
+        uint32_t height,
+        ImageFormat format,
+        uint32_t quality, //- 1 to 100
+        std::FILE * file_p) noexcept;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <taskflow/taskflow.hpp>
+#include <taskflow/algorithm/for_each.hpp>
+#include <algorithm>
+#include <cstdint>
+
+namespace lcf::details {
+    inline tf::Executor & get_executor() noexcept
+    {
+        static tf::Executor s_executor;
+        return s_executor;
+    }
+
+    template <typename Function>
+    void parallel_for_rows(uint32_t row_count, uint32_t rows_per_task, Function && function) noexcept //- function(row_begin, row_end)
+    {
+        uint32_t task_count = (row_count + rows_per_task - 1) / rows_per_task;
+        if (task_count <= 1) {
+            function(0u, row_count);
+            return;
+        }
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(0u, task_count, 1u, [row_count, rows_per_task, &function](uint32_t task_index) {
+            uint32_t row_begin = task_index * rows_per_task;
+            function(row_begin, std::min(row_begin + rows_per_task, row_count));
+        });
+        auto & executor = get_executor();
+        if (executor.this_worker_id() >= 0) { executor.corun(taskflow); } //- called from one of our own workers, run inline instead of blocking it
+        else { executor.run(taskflow).wait(); }
+    }
+}
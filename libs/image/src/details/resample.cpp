@@ -0,0 +1,394 @@
+#include "details/resample.h"
+#include "details/parallel_rows.h"
+#include "details/convert_kernels.h"
+#include "details/cpu_features.h"
+#include "float16.h"
+#include "float16_convert.h"
+#include <algorithm>
+#include <numbers>
+#include <limits>
+#include <cmath>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LCF_IMAGE_SSE2 //- x86 baseline, the avx2 kernels below are picked at runtime
+#include <emmintrin.h>
+#endif
+
+using namespace lcf;
+
+namespace {
+    constexpr uint32_t k_rows_per_task = 16;
+    constexpr float k_kaiser_radius = 3.0f; //- in destination texels
+    constexpr float k_kaiser_alpha = 4.0f;
+    constexpr float k_lanczos_radius = 3.0f;
+    constexpr float k_mitchell_b = 1.0f / 3.0f;
+    constexpr float k_mitchell_c = 1.0f / 3.0f;
+    constexpr float k_min_unpremultiply_alpha = 1.0f / 65536.0f; //- below this the color is meaningless and left at zero
+}
+
+//- auxiliary function forward declarations begin
+float get_kernel_radius(details::ResampleKernel kernel) noexcept;
+
+float evaluate_kernel(details::ResampleKernel kernel, float x) noexcept;
+
+float sinc(float x) noexcept;
+
+void accumulate_row(float * dst_p, const float * src_p, float weight, size_t count) noexcept;
+
+void filter_row(const float * src_p, float * dst_p, uint32_t dst_width, uint32_t channel_count, const details::FilterTaps & taps) noexcept;
+
+#if defined(LCF_IMAGE_SSE2)
+//- the avx2 kernels start at element or texel i and return where the narrower paths pick up
+LCF_IMAGE_TARGET_AVX2 size_t accumulate_row_avx2(float * dst_p, const float * src_p, float weight, size_t i, size_t count) noexcept;
+
+LCF_IMAGE_TARGET_AVX2 uint32_t filter_row_avx2(const float * src_p, float * dst_p, uint32_t x, uint32_t dst_width, uint32_t channel_count, const details::FilterTaps & taps) noexcept;
+#endif
+
+template <typename T>
+void decode_texels(const T * src_p, float * dst_p, size_t texel_count, uint32_t channel_count, ColorTransfer transfer) noexcept;
+
+template <typename T>
+void encode_texels(const float * src_p, T * dst_p, size_t texel_count, uint32_t channel_count, ColorTransfer transfer) noexcept;
+//- auxiliary function forward declarations end
+
+bool details::is_float_image_supported(ImageFormat format) noexcept
+{
+    if (not enum_decode::is_native_image_format(format)) { return false; }
+    switch (enum_decode::get_pixel_data_type(format)) {
+        case PixelDataType::eUint8:
+        case PixelDataType::eUint16:
+        case PixelDataType::eFloat16:
+        case PixelDataType::eFloat32: { return true; }
+        default: return false;
+    }
+}
+
+details::FloatImage details::decode_float_image(std::span<const std::byte> data, uint32_t width, uint32_t height, ImageFormat format, ColorTransfer transfer) noexcept
+{
+    uint32_t channel_count = enum_decode::get_channel_count(format);
+    FloatImage image {width, height, channel_count};
+    parallel_for_rows(height, k_rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+        size_t texel_begin = size_t(row_begin) * width;
+        size_t texel_count = size_t(row_end - row_begin) * width;
+        float * dst_p = image.m_texels.data() + texel_begin * channel_count;
+        switch (enum_decode::get_pixel_data_type(format)) {
+            case PixelDataType::eUint8: { decode_texels(reinterpret_cast<const uint8_t *>(data.data()) + texel_begin * channel_count, dst_p, texel_count, channel_count, transfer); } break;
+            case PixelDataType::eUint16: { decode_texels(reinterpret_cast<const uint16_t *>(data.data()) + texel_begin * channel_count, dst_p, texel_count, channel_count, transfer); } break;
+            case PixelDataType::eFloat16: { decode_texels(reinterpret_cast<const float16_t *>(data.data()) + texel_begin * channel_count, dst_p, texel_count, channel_count, transfer); } break;
+            case PixelDataType::eFloat32: { decode_texels(reinterpret_cast<const float *>(data.data()) + texel_begin * channel_count, dst_p, texel_count, channel_count, transfer); } break;
+            default: break;
+        }
+    });
+    return image;
+}
+
+void details::encode_float_image(const FloatImage & image, std::span<std::byte> data, ImageFormat format, ColorTransfer transfer) noexcept
+{
+    uint32_t channel_count = enum_decode::get_channel_count(format);
+    parallel_for_rows(image.m_height, k_rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+        size_t texel_begin = size_t(row_begin) * image.m_width;
+        size_t texel_count = size_t(row_end - row_begin) * image.m_width;
+        const float * src_p = image.m_texels.data() + texel_begin * channel_count;
+        switch (enum_decode::get_pixel_data_type(format)) {
+            case PixelDataType::eUint8: { encode_texels(src_p, reinterpret_cast<uint8_t *>(data.data()) + texel_begin * channel_count, texel_count, channel_count, transfer); } break;
+            case PixelDataType::eUint16: { encode_texels(src_p, reinterpret_cast<uint16_t *>(data.data()) + texel_begin * channel_count, texel_count, channel_count, transfer); } break;
+            case PixelDataType::eFloat16: { encode_texels(src_p, reinterpret_cast<float16_t *>(data.data()) + texel_begin * channel_count, texel_count, channel_count, transfer); } break;
+            case PixelDataType::eFloat32: { encode_texels(src_p, reinterpret_cast<float *>(data.data()) + texel_begin * channel_count, texel_count, channel_count, transfer); } break;
+            default: break;
+        }
+    });
+}
+
+details::FilterTaps details::compute_filter_taps(uint32_t src_size, uint32_t dst_size, ResampleKernel kernel) noexcept
+{
+    FilterTaps taps;
+    if (src_size == dst_size) {
+        taps.m_tap_count = 1;
+        taps.m_indices.resize(dst_size);
+        std::ranges::generate(taps.m_indices, [i = 0u]() mutable { return i++; });
+        taps.m_weights.assign(dst_size, 1.0f);
+        return taps;
+    }
+    float scale = static_cast<float>(src_size) / dst_size;
+    float kernel_scale = std::max(scale, 1.0f); //- upscaling interpolates, downscaling also has to low pass
+    float support = get_kernel_radius(kernel) * kernel_scale;
+    std::vector<std::pair<int32_t, std::vector<float>>> texel_weights(dst_size); //- first source index and its contiguous weights
+    for (uint32_t x = 0; x < dst_size; ++x) {
+        float center = (x + 0.5f) * scale;
+        int32_t first = static_cast<int32_t>(std::floor(center - support));
+        int32_t last = static_cast<int32_t>(std::ceil(center + support));
+        auto & [first_index, weights] = texel_weights[x];
+        float weight_sum = 0.0f;
+        for (int32_t i = first; i <= last; ++i) {
+            float weight = evaluate_kernel(kernel, (i + 0.5f - center) / kernel_scale);
+            if (weights.empty() and weight == 0.0f) { ++first; continue; }
+            weights.emplace_back(weight);
+            weight_sum += weight;
+        }
+        while (not weights.empty() and weights.back() == 0.0f) { weights.pop_back(); }
+        for (float & weight : weights) { weight /= weight_sum; }
+        first_index = first;
+        taps.m_tap_count = std::max(taps.m_tap_count, static_cast<uint32_t>(weights.size()));
+    }
+    taps.m_indices.resize(size_t(dst_size) * taps.m_tap_count);
+    taps.m_weights.resize(size_t(dst_size) * taps.m_tap_count);
+    for (uint32_t x = 0; x < dst_size; ++x) {
+        const auto & [first_index, weights] = texel_weights[x];
+        for (uint32_t k = 0; k < taps.m_tap_count; ++k) {
+            size_t tap_index = size_t(x) * taps.m_tap_count + k;
+            taps.m_indices[tap_index] = static_cast<uint32_t>(std::clamp<int32_t>(first_index + static_cast<int32_t>(k), 0, static_cast<int32_t>(src_size) - 1)); //- clamp to edge
+            taps.m_weights[tap_index] = k < weights.size() ? weights[k] : 0.0f;
+        }
+    }
+    return taps;
+}
+
+void details::resample(const FloatImage & src, FloatImage & dst, uint32_t channel_count, ResampleKernel kernel) noexcept
+{
+    auto horizontal_taps = compute_filter_taps(src.m_width, dst.m_width, kernel);
+    auto vertical_taps = compute_filter_taps(src.m_height, dst.m_height, kernel);
+    size_t src_row_size = size_t(src.m_width) * channel_count;
+    size_t dst_row_size = size_t(dst.m_width) * channel_count;
+    parallel_for_rows(dst.m_height, k_rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+        std::vector<float> row(src_row_size);
+        for (uint32_t y = row_begin; y < row_end; ++y) {
+            std::ranges::fill(row, 0.0f);
+            for (uint32_t k = 0; k < vertical_taps.m_tap_count; ++k) { //- vertical pass first, whole rows are contiguous
+                size_t tap_index = size_t(y) * vertical_taps.m_tap_count + k;
+                float weight = vertical_taps.m_weights[tap_index];
+                if (weight == 0.0f) { continue; }
+                accumulate_row(row.data(), src.m_texels.data() + vertical_taps.m_indices[tap_index] * src_row_size, weight, src_row_size);
+            }
+            filter_row(row.data(), dst.m_texels.data() + y * dst_row_size, dst.m_width, channel_count, horizontal_taps);
+        }
+    });
+}
+
+void details::premultiply_alpha(FloatImage & image, uint32_t channel_count) noexcept
+{
+    if (channel_count != 2 and channel_count != 4) { return; }
+    parallel_for_rows(image.m_height, k_rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+        float * texel_p = image.m_texels.data() + size_t(row_begin) * image.m_width * channel_count;
+        float * end_p = image.m_texels.data() + size_t(row_end) * image.m_width * channel_count;
+        for (; texel_p != end_p; texel_p += channel_count) {
+            float alpha = texel_p[channel_count - 1];
+            for (uint32_t c = 0; c + 1 < channel_count; ++c) { texel_p[c] *= alpha; }
+        }
+    });
+}
+
+void details::unpremultiply_alpha(FloatImage & image, uint32_t channel_count) noexcept
+{
+    if (channel_count != 2 and channel_count != 4) { return; }
+    parallel_for_rows(image.m_height, k_rows_per_task, [&](uint32_t row_begin, uint32_t row_end) {
+        float * texel_p = image.m_texels.data() + size_t(row_begin) * image.m_width * channel_count;
+        float * end_p = image.m_texels.data() + size_t(row_end) * image.m_width * channel_count;
+        for (; texel_p != end_p; texel_p += channel_count) {
+            float alpha = texel_p[channel_count - 1];
+            float inverse_alpha = alpha > k_min_unpremultiply_alpha ? 1.0f / alpha : 0.0f;
+            for (uint32_t c = 0; c + 1 < channel_count; ++c) { texel_p[c] *= inverse_alpha; }
+        }
+    });
+}
+
+//- auxiliary function implementations begin
+
+float get_kernel_radius(details::ResampleKernel kernel) noexcept
+{
+    switch (kernel) {
+        case details::ResampleKernel::eBox: { return 0.5f; }
+        case details::ResampleKernel::eTent: { return 1.0f; }
+        case details::ResampleKernel::eMitchell: { return 2.0f; }
+        case details::ResampleKernel::eLanczos3: { return k_lanczos_radius; }
+        case details::ResampleKernel::eKaiser: { return k_kaiser_radius; }
+        default: return 0.5f;
+    }
+}
+
+float evaluate_kernel(details::ResampleKernel kernel, float x) noexcept
+{
+    switch (kernel) {
+        case details::ResampleKernel::eBox: { return (x >= -0.5f and x < 0.5f) ? 1.0f : 0.0f; }
+        case details::ResampleKernel::eTent: { return std::max(1.0f - std::abs(x), 0.0f); }
+        case details::ResampleKernel::eMitchell: {
+            constexpr float b = k_mitchell_b, c = k_mitchell_c;
+            float t = std::abs(x);
+            if (t >= 2.0f) { return 0.0f; }
+            if (t < 1.0f) {
+                return ((12.0f - 9.0f * b - 6.0f * c) * t * t * t + (-18.0f + 12.0f * b + 6.0f * c) * t * t + (6.0f - 2.0f * b)) / 6.0f;
+            }
+            return ((-b - 6.0f * c) * t * t * t + (6.0f * b + 30.0f * c) * t * t + (-12.0f * b - 48.0f * c) * t + (8.0f * b + 24.0f * c)) / 6.0f;
+        }
+        case details::ResampleKernel::eLanczos3: {
+            if (std::abs(x) >= k_lanczos_radius) { return 0.0f; }
+            return sinc(x) * sinc(x / k_lanczos_radius);
+        }
+        case details::ResampleKernel::eKaiser: {
+            if (std::abs(x) >= k_kaiser_radius) { return 0.0f; }
+            auto bessel_i0 = [](float value) {
+                float sum = 1.0f, term = 1.0f, half_value = value * 0.5f;
+                for (int k = 1; k < 16; ++k) {
+                    term *= half_value / k;
+                    sum += term * term;
+                }
+                return sum;
+            };
+            float ratio = x / k_kaiser_radius;
+            float window = bessel_i0(k_kaiser_alpha * std::sqrt(1.0f - ratio * ratio)) / bessel_i0(k_kaiser_alpha);
+            return sinc(x) * window;
+        }
+        default: return 0.0f;
+    }
+}
+
+float sinc(float x) noexcept
+{
+    if (x == 0.0f) { return 1.0f; }
+    float pi_x = std::numbers::pi_v<float> * x;
+    return std::sin(pi_x) / pi_x;
+}
+
+void accumulate_row(float * dst_p, const float * src_p, float weight, size_t count) noexcept
+{
+    size_t i = 0;
+#if defined(LCF_IMAGE_SSE2)
+    if (details::get_cpu_features().m_has_avx2) { i = accumulate_row_avx2(dst_p, src_p, weight, i, count); }
+    const __m128 weight_v = _mm_set1_ps(weight);
+    for (; i + 4 <= count; i += 4) {
+        __m128 sum_v = _mm_add_ps(_mm_loadu_ps(dst_p + i), _mm_mul_ps(_mm_loadu_ps(src_p + i), weight_v));
+        _mm_storeu_ps(dst_p + i, sum_v);
+    }
+#endif
+    for (; i < count; ++i) { dst_p[i] += src_p[i] * weight; }
+}
+
+void filter_row(const float * src_p, float * dst_p, uint32_t dst_width, uint32_t channel_count, const details::FilterTaps & taps) noexcept
+{
+    const uint32_t tap_count = taps.m_tap_count;
+    uint32_t x = 0;
+#if defined(LCF_IMAGE_SSE2)
+    if (details::get_cpu_features().m_has_avx2) { x = filter_row_avx2(src_p, dst_p, x, dst_width, channel_count, taps); }
+#endif
+    const uint32_t * index_p = taps.m_indices.data() + size_t(x) * tap_count;
+    const float * weight_p = taps.m_weights.data() + size_t(x) * tap_count;
+#if defined(LCF_IMAGE_SSE2)
+    if (channel_count == 4) { //- one rgba texel per register
+        for (; x < dst_width; ++x) {
+            __m128 sum_v = _mm_setzero_ps();
+            for (uint32_t k = 0; k < tap_count; ++k, ++index_p, ++weight_p) {
+                sum_v = _mm_add_ps(sum_v, _mm_mul_ps(_mm_loadu_ps(src_p + size_t(*index_p) * 4), _mm_set1_ps(*weight_p)));
+            }
+            _mm_storeu_ps(dst_p + size_t(x) * 4, sum_v);
+        }
+        return;
+    }
+#endif
+    for (; x < dst_width; ++x) {
+        float * dst_texel_p = dst_p + size_t(x) * channel_count;
+        std::fill_n(dst_texel_p, channel_count, 0.0f);
+        for (uint32_t k = 0; k < tap_count; ++k, ++index_p, ++weight_p) {
+            const float * src_texel_p = src_p + size_t(*index_p) * channel_count;
+            for (uint32_t c = 0; c < channel_count; ++c) { dst_texel_p[c] += src_texel_p[c] * *weight_p; }
+        }
+    }
+}
+
+#if defined(LCF_IMAGE_SSE2)
+LCF_IMAGE_TARGET_AVX2 size_t accumulate_row_avx2(float * dst_p, const float * src_p, float weight, size_t i, size_t count) noexcept
+{
+    const __m256 weight_v = _mm256_set1_ps(weight);
+    for (; i + 8 <= count; i += 8) {
+        __m256 sum_v = _mm256_add_ps(_mm256_loadu_ps(dst_p + i), _mm256_mul_ps(_mm256_loadu_ps(src_p + i), weight_v));
+        _mm256_storeu_ps(dst_p + i, sum_v);
+    }
+    return i;
+}
+
+LCF_IMAGE_TARGET_AVX2 uint32_t filter_row_avx2(const float * src_p, float * dst_p, uint32_t x, uint32_t dst_width, uint32_t channel_count, const details::FilterTaps & taps) noexcept
+{
+    const uint32_t tap_count = taps.m_tap_count;
+    const uint32_t * index_p = taps.m_indices.data() + size_t(x) * tap_count;
+    const float * weight_p = taps.m_weights.data() + size_t(x) * tap_count;
+    if (channel_count == 4) { //- two rgba texels per register, one in each 128 bit lane
+        for (; x + 2 <= dst_width; x += 2, index_p += 2 * tap_count, weight_p += 2 * tap_count) {
+            __m256 sum_v = _mm256_setzero_ps();
+            for (uint32_t k = 0; k < tap_count; ++k) {
+                __m256 texels_v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src_p + size_t(index_p[k]) * 4)),
+                    _mm_loadu_ps(src_p + size_t(index_p[tap_count + k]) * 4), 1);
+                __m256 weights_v = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_set1_ps(weight_p[k])), _mm_set1_ps(weight_p[tap_count + k]), 1);
+                sum_v = _mm256_add_ps(sum_v, _mm256_mul_ps(texels_v, weights_v));
+            }
+            _mm256_storeu_ps(dst_p + size_t(x) * 4, sum_v);
+        }
+    } else if (channel_count == 1) { //- eight gray texels per register, the taps are gathered with a stride of tap_count
+        const __m256i tap_stride_v = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(tap_count)));
+        for (; x + 8 <= dst_width; x += 8, index_p += 8 * tap_count, weight_p += 8 * tap_count) {
+            __m256 sum_v = _mm256_setzero_ps();
+            for (uint32_t k = 0; k < tap_count; ++k) {
+                __m256i indices_v = _mm256_i32gather_epi32(reinterpret_cast<const int *>(index_p + k), tap_stride_v, 4);
+                __m256 weights_v = _mm256_i32gather_ps(weight_p + k, tap_stride_v, 4);
+                sum_v = _mm256_add_ps(sum_v, _mm256_mul_ps(_mm256_i32gather_ps(src_p, indices_v, 4), weights_v));
+            }
+            _mm256_storeu_ps(dst_p + x, sum_v);
+        }
+    }
+    return x;
+}
+#endif
+
+template <typename T>
+void decode_texels(const T * src_p, float * dst_p, size_t texel_count, uint32_t channel_count, ColorTransfer transfer) noexcept
+{
+    uint32_t color_channel_count = (channel_count == 2 or channel_count == 4) ? channel_count - 1 : channel_count;
+    bool is_srgb = transfer == ColorTransfer::eSRGB;
+    if constexpr (std::is_same_v<T, uint8_t>) {
+        if (is_srgb) { details::convert_srgb8_to_linear_f32(src_p, dst_p, texel_count, channel_count); }
+        else { details::convert_u8_to_f32(src_p, dst_p, texel_count * channel_count); }
+    } else if constexpr (std::is_same_v<T, float16_t>) {
+        convert_f16_to_f32(std::span(src_p, texel_count * channel_count), std::span(dst_p, texel_count * channel_count));
+        if (not is_srgb) { return; }
+        for (size_t i = 0; i < texel_count * channel_count; ++i) {
+            if (i % channel_count < color_channel_count) { dst_p[i] = details::srgb_to_linear(dst_p[i]); }
+        }
+    } else {
+        constexpr float scale = std::is_integral_v<T> ? 1.0f / std::numeric_limits<T>::max() : 1.0f;
+        for (size_t i = 0; i < texel_count * channel_count; ++i) {
+            bool is_color = i % channel_count < color_channel_count;
+            float value = static_cast<float>(src_p[i]) * scale;
+            dst_p[i] = is_srgb and is_color ? details::srgb_to_linear(value) : value;
+        }
+    }
+}
+
+template <typename T>
+void encode_texels(const float * src_p, T * dst_p, size_t texel_count, uint32_t channel_count, ColorTransfer transfer) noexcept
+{
+    uint32_t color_channel_count = (channel_count == 2 or channel_count == 4) ? channel_count - 1 : channel_count;
+    bool is_srgb = transfer == ColorTransfer::eSRGB;
+    if constexpr (std::is_same_v<T, uint8_t>) {
+        if (is_srgb) { details::convert_linear_f32_to_srgb8(src_p, dst_p, texel_count, channel_count); }
+        else { details::convert_f32_to_u8(src_p, dst_p, texel_count * channel_count); }
+    } else if constexpr (std::is_same_v<T, float16_t>) {
+        if (is_srgb) {
+            for (size_t i = 0; i < texel_count * channel_count; ++i) {
+                bool is_color = i % channel_count < color_channel_count;
+                dst_p[i] = static_cast<T>(is_color ? details::linear_to_srgb(std::max(src_p[i], 0.0f)) : src_p[i]);
+            }
+        } else {
+            convert_f32_to_f16(std::span(src_p, texel_count * channel_count), std::span(dst_p, texel_count * channel_count));
+        }
+    } else {
+        for (size_t i = 0; i < texel_count * channel_count; ++i) {
+            bool is_color = i % channel_count < color_channel_count;
+            float value = src_p[i];
+            if constexpr (std::is_integral_v<T>) {
+                value = std::clamp(value, 0.0f, 1.0f); //- negative lobes can ring outside the representable range
+                if (is_srgb and is_color) { value = details::linear_to_srgb(value); }
+                dst_p[i] = static_cast<T>(value * std::numeric_limits<T>::max() + 0.5f);
+            } else {
+                if (is_srgb and is_color) { value = details::linear_to_srgb(std::max(value, 0.0f)); }
+                dst_p[i] = static_cast<T>(value);
+            }
+        }
+    }
+}
+//- auxiliary function implementations end
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "image/image_enums.h"
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace lcf::details {
+    enum class ResampleKernel : uint8_t
+    {
+        eBox,
+        eTent,
+        eMitchell,
+        eLanczos3,
+        eKaiser,
+    };
+
+    struct FilterTaps //- separable weights along one axis, every destination texel has m_tap_count taps
+    {
+        uint32_t m_tap_count = 0;
+        std::vector<uint32_t> m_indices; //- clamped source texel indices
+        std::vector<float> m_weights; //- normalized, zero for padding taps
+    };
+
+    struct FloatImage //- float texels, channel count is kept by the caller
+    {
+        FloatImage() = default;
+        FloatImage(uint32_t width, uint32_t height, uint32_t channel_count) :
+            m_width(width),
+            m_height(height),
+            m_texels(size_t(width) * height * channel_count)
+        {}
+        uint32_t m_width = 0;
+        uint32_t m_height = 0;
+        std::vector<float> m_texels;
+    };
+
+    //- native formats with 8, 16 bit unorm or float channels
+    bool is_float_image_supported(ImageFormat format) noexcept;
+
+    FloatImage decode_float_image(std::span<const std::byte> data, uint32_t width, uint32_t height, ImageFormat format, ColorTransfer transfer) noexcept;
+
+    void encode_float_image(const FloatImage & image, std::span<std::byte> data, ImageFormat format, ColorTransfer transfer) noexcept;
+
+    //- the kernel is stretched by the scale factor when downscaling and used as is when upscaling; edges clamp
+    FilterTaps compute_filter_taps(uint32_t src_size, uint32_t dst_size, ResampleKernel kernel) noexcept;
+
+    //- two separable passes over precomputed weight tables, rows in parallel; dst decides the target size
+    void resample(const FloatImage & src, FloatImage & dst, uint32_t channel_count, ResampleKernel kernel) noexcept;
+
+    //- no-ops without an alpha channel, i.e. for 1 and 3 channels
+    void premultiply_alpha(FloatImage & image, uint32_t channel_count) noexcept;
+
+    void unpremultiply_alpha(FloatImage & image, uint32_t channel_count) noexcept;
+}
@@ -3,6 +3,7 @@
 #include <vulkan/vulkan.hpp>
 #include "vk_core/sync/TimelineSemaphore.h"
 #include "vk_core/queue/LogicalQueue.h"
+#include "vk_core/memory/Image.h"
 #include "resource_utils.h"
 #include "AtomicSnapshot.h"
 #include "SPSCValue.h"
@@ -15,12 +16,32 @@
 
 namespace lcf::vkc {
 
+class DeviceExtensionManifest;
+
 namespace wsi {
 
+class SwapchainFrame //- a swapchain image acquired for direct rendering, valid until it is passed to Swapchain::presentFrame
+{
+    friend class Swapchain;
+public:
+    const Image & getImage() const noexcept { return *m_image_p; }
+    uint32_t getImageIndex() const noexcept { return m_image_index; }
+    uint64_t getGeneration() const noexcept { return m_generation; } //- changes when the swapchain is recreated, render targets cached per image index must be rebuilt
+    vk::SemaphoreSubmitInfo getAcquireWaitInfo() const noexcept { return {m_image_available, 0u, vk::PipelineStageFlagBits2::eColorAttachmentOutput}; }
+    vk::SemaphoreSubmitInfo getPresentSignalInfo() const noexcept { return {m_render_finished, 0u, vk::PipelineStageFlagBits2::eColorAttachmentOutput}; }
+private:
+    const Image * m_image_p = nullptr;
+    uint32_t m_image_index = 0u;
+    uint64_t m_generation = 0u;
+    vk::Semaphore m_image_available;
+    vk::Semaphore m_render_finished;
+};
+
 class Swapchain
 {
     using Self = Swapchain;
     using ImageList = std::vector<vk::Image>;
+    using WrappedImageList = std::vector<Image>;
     struct DesiredParams
     {
         bool operator==(const DesiredParams & other) const noexcept = default;
@@ -67,10 +88,19 @@ public:
         ResourceLease image_lease = {},
         vk::SemaphoreSubmitInfo wait_info = {},
         vk::ImageSubresourceLayers src_subresource_layers = {vk::ImageAspectFlagBits::eColor, 0u, 0u, 1u}) noexcept;
+    //- direct path: render into the acquired image and hand it back, no blit or extra submission;
+    //- one frame is outstanding at a time, acquiring or blit presenting again before presentFrame fails
+    std::expected<SwapchainFrame, std::error_code> acquireFrame() noexcept;
+    //- a frame acquired before the swapchain was recreated is released without presenting and reported out of date
+    std::error_code presentFrame(const SwapchainFrame & frame, ResourceLease lease = {}) noexcept;
     std::error_code resizeToFit() noexcept;
     Self & setDesiredSwapchainImageCount(uint32_t desired_count) noexcept;
     Self & setDesiredSurfaceFormat(const vk::SurfaceFormatKHR & surface_format) noexcept;
     Self & setDesiredPresentMode(const vk::PresentModeKHR & present_mode) noexcept;
+    Self & setMaxFrameLatency(uint32_t max_frame_latency) noexcept { m_max_frame_latency = max_frame_latency; return *this; } //- 0 disables limiting
+    //- pass the manifest the device was created from, present wait is used only when it went through entry::register_present_wait,
+    //- otherwise frame latency falls back to present fences
+    Self & enablePresentWait(const DeviceExtensionManifest & device_ext_manifest) noexcept;
 private:
     std::expected<vk::SemaphoreSubmitInfo, std::error_code> _present(
         const std::array<vk::Offset3D, 2> & src_offsets,
@@ -80,11 +110,16 @@ private:
         vk::ImageSubresourceLayers src_subresource_layers) noexcept;
     std::error_code recreate(const DesiredParams & desired_params) noexcept;
     std::error_code acquireNextImage() noexcept;
+    std::error_code acquirePresentResources() noexcept;
+    vk::Result queuePresent() noexcept;
+    void limitFrameLatency() noexcept;
+    bool isPresentWaitActive() const noexcept { return m_is_present_wait_enabled; }
     std::expected<vk::CommandBuffer, std::error_code> acquireCmdBuffer() noexcept;
     std::expected<vk::UniqueFence, std::error_code> acquireFence() noexcept;
     std::expected<vk::UniqueSemaphore, std::error_code> acquireSemaphore() noexcept;
     void recyclePresentResources(PresentResources & present_resources) noexcept;
     void tryRecyclePendingResources() noexcept;
+    void releaseAcquiredFrame() noexcept;
 private:
     vk::PhysicalDevice m_physical_device;
     vk::Device m_device;
@@ -92,10 +127,16 @@ private:
     vk::UniqueSurfaceKHR m_surface;
     vk::UniqueSwapchainKHR m_swapchain;
     ImageList m_swapchain_images;
+    WrappedImageList m_wrapped_images;
+    uint64_t m_generation = 0u;
+    uint64_t m_present_id = 0u;
+    uint32_t m_max_frame_latency = 0u;
+    bool m_is_present_wait_enabled = false; //- the device enabled present id and present wait
     vk::SurfaceFormatKHR m_surface_format;
     vk::PresentModeKHR m_present_mode;
     uint32_t m_width = 0u, m_height = 0u;
     uint32_t m_image_index = 0u;
+    bool m_is_frame_acquired = false; //- acquireFrame handed out m_present_resources and presentFrame has not taken them back
     LatchedSnapshot<DesiredParams> m_desired_params_snapshot;
     SPSCValue<CachedPresentInput> m_cached_present_input;
     std::mutex m_present_mutex;
@@ -65,11 +65,20 @@ struct WindowHandle
 
 } // namespace metal
 
+namespace headless {
+
+struct WindowHandle //- VK_EXT_headless_surface, lets swapchain paths run without a window (e.g. on a software driver)
+{
+};
+
+} // namespace headless
+
 using WindowHandle = std::variant<
     win32::WindowHandle,
     xcb::WindowHandle,
     xlib::WindowHandle,
     wayland::WindowHandle,
-    metal::WindowHandle>;
+    metal::WindowHandle,
+    headless::WindowHandle>;
 
 } // namespace lcf::vkc::surf
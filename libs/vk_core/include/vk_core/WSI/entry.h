@@ -12,8 +12,12 @@ namespace lcf::vkc::entry {
 
 void register_surface(InstanceExtensionManifest & manifest) noexcept;
 
+void register_headless_surface(InstanceExtensionManifest & manifest) noexcept;
+
 void register_swapchain(InstanceExtensionManifest & instance_ext_manifest, DeviceExtensionManifest & device_ext_manifest) noexcept;
 
 void register_compat_swapchain(DeviceExtensionManifest & manifest) noexcept;
 
+void register_present_wait(DeviceExtensionManifest & manifest) noexcept;
+
 } // namespace lcf::vkc::entry
\ No newline at end of file
@@ -4,6 +4,11 @@
 #include <expected>
 #include <unordered_map>
 #include <system_error>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
 #include "vk_core/command/details/command_pools.h"
 #include "vk_core/command/info_structs.h"
 
@@ -18,24 +23,37 @@ class CommandBufferAllocator
     using ResetablePoolMap = std::unordered_map<CommandBufferPoolKey, details::ResetableCommandPool, CommandBufferPoolKey>;
     using RotatingPoolMap = std::unordered_map<CommandBufferPoolKey, details::RotatingCommandPool, CommandBufferPoolKey>;
     using ValidationData = const void *;
+    struct Shard //- pools of one recording thread, the mutex only contends with retire/recycle from the submitting thread
+    {
+        bool isIdle() const noexcept;
+        std::mutex m_mutex;
+        std::atomic_bool m_is_thread_exited = false; //- set by the recording thread's exit guard, the shard is released once idle
+        ResetablePoolMap m_resetable_pool_map;
+        RotatingPoolMap m_rotating_pool_map;
+    };
+    using ShardPointer = std::shared_ptr<Shard>;
+    using ShardMap = std::unordered_map<std::thread::id, ShardPointer>;
 public:
     ~CommandBufferAllocator() noexcept = default;
     CommandBufferAllocator() = default;
     CommandBufferAllocator(const Self &) = delete;
     Self & operator=(const Self &) = delete;
-    CommandBufferAllocator(Self &&) noexcept = default;
-    Self & operator=(Self &&) noexcept = default;
+    CommandBufferAllocator(Self &&) = delete;
+    Self & operator=(Self &&) = delete;
 public:
     std::error_code create(vk::Device device, uint32_t family_index, ValidationData validation_data) noexcept;
-    std::expected<CommandBufferBatch, std::error_code> allocate(const CommandBufferAllocateInfo & info) noexcept;
-    void retire(uint64_t timestamp, CommandBufferBatch && batch) noexcept;
-    void recycle(uint64_t completed) noexcept;
+    std::expected<CommandBufferBatch, std::error_code> allocate(const CommandBufferAllocateInfo & info) noexcept; //- thread safe, allocates from the calling thread's shard
+    void retire(uint64_t timestamp, CommandBufferBatch && batch) noexcept; //- also retires the batch's adopted secondary batches
+    void recycle(uint64_t completed) noexcept; //- also releases the shards of exited threads once nothing of theirs is in flight
+private:
+    ShardPointer acquireShard(std::thread::id thread_id) noexcept;
+    ShardPointer findShard(std::thread::id thread_id) const noexcept;
 private:
     vk::Device m_device;
     uint32_t m_family_index = 0u;
     ValidationData m_validation_data = nullptr;
-    ResetablePoolMap m_resetable_pool_map;
-    RotatingPoolMap m_rotating_pool_map;
+    mutable std::shared_mutex m_shard_map_mutex;
+    ShardMap m_shard_map;
 };
 
 } // namespace lcf::vkc
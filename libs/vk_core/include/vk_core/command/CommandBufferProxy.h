@@ -6,9 +6,12 @@
 #include <span>
 #include <expected>
 #include <system_error>
+#include <thread>
+#include <unordered_set>
 #include "enums.h"
 #include "vk_core/error.h"
 #include "vk_core/command/info_structs.h"
+#include "vk_core/command/details/CommandStateCache.h"
 #include "resource_utils.h"
 #include "concepts/range_concept.h"
 
@@ -26,8 +29,10 @@ class CommandBufferProxy : public vk::CommandBuffer
     using Base = vk::CommandBuffer;
     using SemaphoreSubmitInfoList = std::vector<vk::SemaphoreSubmitInfo>;
     using ResourceLeaseList = std::vector<ResourceLease>;
+    using PinnedLeaseSet = std::unordered_set<const void *>;
     using ValidationData = const void *;
 public:
+    using DynamicStateKey = details::DynamicStateKey;
     ~CommandBufferProxy() = default;
     CommandBufferProxy(vk::CommandBuffer cmd_buffer, ValidationData validation_data) noexcept :
         Base(cmd_buffer), m_validation_data(validation_data) {}
@@ -36,9 +41,14 @@ public:
     CommandBufferProxy(Self && other) noexcept { this->stealFrom(other); }
     Self & operator=(Self && other) noexcept { if (this != &other) { this->stealFrom(other); } return *this; }
 public:
-    Self & pinLease(ResourceLease lease) noexcept
+    Self & pinLease(const ResourceLease & lease) noexcept
     {
-        if (lease) { m_leases.emplace_back(std::move(lease)); }
+        if (this->shouldPin(lease)) { m_leases.emplace_back(lease); }
+        return *this;
+    }
+    Self & pinLease(ResourceLease && lease) noexcept
+    {
+        if (this->shouldPin(lease)) { m_leases.emplace_back(std::move(lease)); }
         return *this;
     }
     Self & pinLeases(range_of_c<ResourceLease> auto && leases) noexcept
@@ -56,17 +66,49 @@ public:
         if (signal_info.semaphore) { m_signal_infos.emplace_back(signal_info); }
         return *this;
     }
+    //- the *IfChanged family consults a shadow of what this command buffer already recorded and drops redundant commands;
+    //- call invalidateStateCache() after recording state behind the cache's back (raw binds, executeCommands)
+    Self & bindShadersIfChanged(
+        std::span<const vk::ShaderStageFlagBits> stages,
+        std::span<const vk::ShaderEXT> shaders) noexcept;
+    Self & bindDescriptorSetsIfChanged(
+        vk::PipelineBindPoint bind_point,
+        vk::PipelineLayout layout,
+        uint32_t first_set,
+        std::span<const vk::DescriptorSet> sets,
+        std::span<const uint32_t> dynamic_offsets = {}) noexcept;
+    Self & pushConstantsIfChanged(
+        vk::PipelineLayout layout,
+        vk::ShaderStageFlags stages,
+        uint32_t offset,
+        std::span<const std::byte> data) noexcept;
+    template <typename... Values>
+    bool isDynamicStateChanged(DynamicStateKey key, const Values & ... values) noexcept
+    {
+        return m_state_cache.updateDynamicState(key, values...);
+    }
+    //- binding a pipeline replaces bound shaders and statically baked state, descriptor sets and push constants survive
+    Self & invalidatePipelineState() noexcept { m_state_cache.invalidatePipelineState(); return *this; }
+    Self & invalidateStateCache() noexcept { m_state_cache.reset(); return *this; }
 private:
+    bool shouldPin(const ResourceLease & lease) noexcept
+    {
+        return lease and m_pinned_leases.insert(lease.identity()).second;
+    }
     void stealFrom(Self & other) noexcept
     {
         Base::operator=(std::exchange(static_cast<vk::CommandBuffer &>(other), nullptr));
         m_leases = std::move(other.m_leases);
+        m_pinned_leases = std::move(other.m_pinned_leases);
+        m_state_cache = std::move(other.m_state_cache);
         m_wait_infos = std::move(other.m_wait_infos);
         m_signal_infos = std::move(other.m_signal_infos);
         m_validation_data = std::exchange(other.m_validation_data, nullptr);
     }
 private:
     ResourceLeaseList m_leases;
+    PinnedLeaseSet m_pinned_leases;
+    details::CommandStateCache m_state_cache;
     SemaphoreSubmitInfoList m_wait_infos;
     SemaphoreSubmitInfoList m_signal_infos;
     ValidationData m_validation_data = nullptr;
@@ -79,24 +121,29 @@ class CommandBufferBatch
     using SemaphoreSubmitInfoList = std::vector<vk::SemaphoreSubmitInfo>;
     using ResourceLeaseList = std::vector<ResourceLease>;
     using CommandBufferList = std::vector<vk::CommandBuffer>;
+    using SecondaryBatchList = std::vector<CommandBufferBatch>;
     using ValidationData = const void *;
 public:
     ~CommandBufferBatch() = default;
     CommandBufferBatch(
         std::span<vk::CommandBuffer> cmd_buffers,
         CommandBufferPoolKey pool_key,
-        ValidationData validation_data 
+        ValidationData validation_data,
+        std::thread::id shard_id = std::this_thread::get_id()
     ) noexcept : 
         m_cmd_buffers(cmd_buffers.begin(), cmd_buffers.end()),
         m_pool_key(pool_key),
+        m_shard_id(shard_id),
         m_validation_data(validation_data) {}
-CommandBufferBatch(
+    CommandBufferBatch(
         CommandBufferList cmd_buffers,
         CommandBufferPoolKey pool_key,
-        ValidationData validation_data 
+        ValidationData validation_data,
+        std::thread::id shard_id = std::this_thread::get_id()
     ) noexcept : 
         m_cmd_buffers(std::move(cmd_buffers)),
         m_pool_key(pool_key),
+        m_shard_id(shard_id),
         m_validation_data(validation_data) {}
     CommandBufferBatch(const Self &) = delete;
     Self & operator=(const Self &) = delete;
@@ -116,6 +163,20 @@ public:
         m_signal_infos.append_range(std::exchange(proxy.m_signal_infos, {}));
         return *this;
     }
+    //- record executeCommands(secondary_batch.getCommandBuffers()) into one of this batch's proxies first,
+    //- the secondaries are then retired with this batch and go back to the shard of the thread that recorded them;
+    //- a batch from another queue or a primary one is rejected and left with the caller
+    std::error_code adoptSecondary(CommandBufferBatch && secondary_batch) noexcept
+    {
+        if (secondary_batch.m_validation_data != m_validation_data) { return make_error_code(errc::command_buffer_batch_queue_mismatch); }
+        if (not secondary_batch.isSecondary()) { return make_error_code(errc::command_buffer_batch_level_mismatch); }
+        m_leases.append_range(std::exchange(secondary_batch.m_leases, {}));
+        m_wait_infos.append_range(std::exchange(secondary_batch.m_wait_infos, {}));
+        m_signal_infos.append_range(std::exchange(secondary_batch.m_signal_infos, {}));
+        m_secondary_batches.emplace_back(std::move(secondary_batch));
+        return {};
+    }
+    bool isSecondary() const noexcept { return m_pool_key.m_cmd_level == vk::CommandBufferLevel::eSecondary; }
     ValidationData getValidationData() const noexcept { return m_validation_data; }
     std::span<const vk::CommandBuffer> getCommandBuffers() const noexcept { return m_cmd_buffers; }
     std::span<const vk::SemaphoreSubmitInfo> getWaitInfos() const noexcept { return m_wait_infos; }
@@ -130,6 +191,8 @@ private:
         m_signal_infos = std::move(other.m_signal_infos);
         m_pool_key = std::exchange(other.m_pool_key, {});
         m_leases = std::move(other.m_leases);
+        m_secondary_batches = std::move(other.m_secondary_batches);
+        m_shard_id = std::exchange(other.m_shard_id, {});
         m_validation_data = std::exchange(other.m_validation_data, nullptr);
     }
 private:
@@ -138,7 +201,9 @@ private:
     SemaphoreSubmitInfoList m_wait_infos;
     SemaphoreSubmitInfoList m_signal_infos;
     ResourceLeaseList m_leases;
+    SecondaryBatchList m_secondary_batches;
     CommandBufferPoolKey m_pool_key;
+    std::thread::id m_shard_id; //- thread whose allocator shard owns the command buffers
     ValidationData m_validation_data = nullptr;
 };
 
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <vector>
+#include <span>
+#include <flat_map>
+#include <ranges>
+#include <type_traits>
+
+namespace lcf::vkc::details {
+
+struct DynamicStateKey
+{
+    DynamicStateKey(vk::DynamicState state, uint32_t index = 0u) noexcept : m_state(state), m_index(index) {}
+    uint64_t pack() const noexcept { return (static_cast<uint64_t>(m_state) << 32u) | m_index; }
+    vk::DynamicState m_state;
+    uint32_t m_index; //- disambiguates commands recorded per face / per attachment range
+};
+
+//- shadow copy of the state recorded into one command buffer, every update*() returns whether the command has to be recorded;
+//- comparisons are bytewise, so padding can only cause a spurious re-record, never a missed one
+class CommandStateCache
+{
+    using Self = CommandStateCache;
+    using ByteList = std::vector<std::byte>;
+    using DescriptorSetList = std::vector<vk::DescriptorSet>;
+    struct BoundDescriptorSets
+    {
+        vk::PipelineLayout m_layout;
+        DescriptorSetList m_sets; //- indexed by set number, null when unknown
+    };
+    struct PushConstantShadow
+    {
+        ByteList m_bytes;
+        std::vector<uint8_t> m_known; //- per byte, cleared when an overlapping stage combination overwrites it
+    };
+    using ShaderStageMap = std::flat_map<vk::ShaderStageFlagBits, vk::ShaderEXT>;
+    using DescriptorSetMap = std::flat_map<vk::PipelineBindPoint, BoundDescriptorSets>;
+    using PushConstantMap = std::flat_map<VkShaderStageFlags, PushConstantShadow>;
+    using DynamicStateMap = std::flat_map<uint64_t, ByteList>;
+public:
+    ~CommandStateCache() noexcept = default;
+    CommandStateCache() noexcept = default;
+    CommandStateCache(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    CommandStateCache(Self &&) noexcept = default;
+    Self & operator=(Self &&) noexcept = default;
+public:
+    void reset() noexcept;
+    void invalidatePipelineState() noexcept;
+    bool updateShader(vk::ShaderStageFlagBits stage, vk::ShaderEXT shader) noexcept;
+    bool updateDescriptorSets(
+        vk::PipelineBindPoint bind_point,
+        vk::PipelineLayout layout,
+        uint32_t first_set,
+        std::span<const vk::DescriptorSet> sets,
+        std::span<const uint32_t> dynamic_offsets) noexcept;
+    bool updatePushConstants(
+        vk::PipelineLayout layout,
+        vk::ShaderStageFlags stages,
+        uint32_t offset,
+        std::span<const std::byte> data) noexcept;
+    template <typename... Values>
+    bool updateDynamicState(DynamicStateKey key, const Values & ... values) noexcept
+    {
+        m_scratch.clear();
+        (appendBytes(m_scratch, values), ...);
+        return this->updateDynamicStateBytes(key.pack());
+    }
+private:
+    bool updateDynamicStateBytes(uint64_t key) noexcept;
+    template <typename Value>
+    static void appendBytes(ByteList & bytes, const Value & value) noexcept
+    {
+        if constexpr (std::ranges::contiguous_range<Value> and std::ranges::sized_range<Value>) {
+            using Element = std::ranges::range_value_t<Value>;
+            static_assert(std::is_trivially_copyable_v<Element>);
+            const auto count = static_cast<uint64_t>(std::ranges::size(value));
+            bytes.append_range(std::as_bytes(std::span {&count, 1u}));
+            bytes.append_range(std::as_bytes(std::span {std::ranges::data(value), std::ranges::size(value)}));
+        } else {
+            static_assert(std::is_trivially_copyable_v<Value>);
+            bytes.append_range(std::as_bytes(std::span {&value, 1u}));
+        }
+    }
+private:
+    ShaderStageMap m_shaders;
+    DescriptorSetMap m_descriptor_sets;
+    vk::PipelineLayout m_push_constant_layout;
+    PushConstantMap m_push_constants;
+    DynamicStateMap m_dynamic_states;
+    ByteList m_scratch;
+};
+
+} // namespace lcf::vkc::details
@@ -24,11 +24,13 @@ public:
     void recycle(CommandBufferList && cmd_buffers) noexcept;
     void recycle(Self && cmd_buffers) noexcept;
     void clear() noexcept { m_cmd_free_list.clear(); }
+    bool empty() const noexcept { return m_cmd_free_list.empty(); }
+    size_t size() const noexcept { return m_cmd_free_list.size(); }
 private:
     CommandBufferList m_cmd_free_list;
 };
 
-class ResetableCommandPool
+class ResetableCommandPool //- hybrid: buffers are individually resettable, but completed ones are reset in bulk
 {
     using Self = ResetableCommandPool;
     using CommandBufferList = std::vector<vk::CommandBuffer>;
@@ -55,24 +57,32 @@ public:
     std::expected<CommandBufferList, std::error_code> allocate(uint32_t count) noexcept;
     void retire(uint64_t timestamp, CommandBufferList && cmd_batch) noexcept;
     void recycle(uint64_t completed_timestamp) noexcept;
+    bool isIdle() const noexcept { return m_pending_entries.empty() and m_reusable_buffers.size() == m_allocated_count; }
 private:
     vk::Device m_device;
     vk::CommandBufferLevel m_cmd_level;
     vk::UniqueCommandPool m_cmd_pool;
-    PendingEntryDeque m_pending_entries;
+    PendingEntryDeque m_pending_entries; //- one entry per completion timestamp, ordered by it
     PooledCommandBuffers m_reusable_buffers;
+    uint32_t m_allocated_count = 0u;
 };
 
-class RotatingCommandPool
+class RotatingCommandPool //- ring of whole pools keyed by timeline value, each completed slot costs one vkResetCommandPool
 {
     using Self = RotatingCommandPool;
     using CommandBufferList = std::vector<vk::CommandBuffer>;
     struct PoolSlot
     {
         bool isValid() const noexcept { return m_cmd_pool.get(); }
-        uint64_t m_timestamp;
+        bool isResettable(uint64_t completed_timestamp) const noexcept
+        {
+            return m_outstanding_buffers.empty() and m_timestamp <= completed_timestamp;
+        }
+        uint64_t m_timestamp = 0; //- latest timestamp the slot's buffers were retired with
+        CommandBufferList m_outstanding_buffers; //- allocated but not yet retired, the slot is not reset before they are
         vk::UniqueCommandPool m_cmd_pool;
         PooledCommandBuffers m_reusable_buffers;
+        PooledCommandBuffers m_retired_buffers;
     };
     using PoolSlotDeque = std::deque<PoolSlot>;
 public:
@@ -90,16 +100,19 @@ public:
     std::expected<CommandBufferList, std::error_code> allocate(uint32_t count) noexcept;
     void retire(uint64_t timestamp, CommandBufferList && cmd_batch) noexcept;
     void recycle(uint64_t completed_timestamp) noexcept;
+    bool isIdle() const noexcept
+    {
+        return m_in_flight_slots.empty() and m_active_slot.m_outstanding_buffers.empty() and m_active_slot.m_retired_buffers.empty();
+    }
 private:
     std::error_code activateSlot() noexcept;
+    PoolSlot * findOwningSlot(vk::CommandBuffer cmd_buffer) noexcept;
 private:
     vk::Device m_device;
     vk::CommandPoolCreateInfo m_pool_info;
     vk::CommandBufferLevel m_cmd_level;
     PoolSlot m_active_slot;
-    uint64_t m_pending_timestamp = 0;
-    PooledCommandBuffers m_pending_cmds;
-    PoolSlot m_sealed_slot;
+    PoolSlotDeque m_in_flight_slots; //- slots sealed at each recycle, any number of frames may be in flight
     PoolSlotDeque m_reusable_slots;
 };
 
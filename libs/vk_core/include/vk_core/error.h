@@ -23,8 +23,17 @@ enum class errc
     missing_required_device_extension,
     missing_required_device_feature,
     present_skipped_for_resize,
+    swapchain_frame_already_acquired,
+    swapchain_frame_out_of_date,
     command_buffer_batch_exhausted,
     command_buffer_batch_queue_mismatch,
+    command_buffer_batch_level_mismatch,
+    pipeline_compile_queue_full,
+    pipeline_compile_cancelled,
+    transient_buffer_ring_exhausted,
+    memory_budget_exceeded,
+    render_graph_invalid_resource,
+    render_graph_not_compiled,
 };
 
 enum class warnc
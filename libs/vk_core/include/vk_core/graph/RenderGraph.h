@@ -0,0 +1,212 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "resource_utils.h"
+#include "vk_core/memory/Buffer.h"
+#include "vk_core/memory/Image.h"
+#include "vk_core/memory/MemoryBlock.h"
+#include "vk_core/pipeline/graphics/enums.h"
+
+namespace lcf::vkc {
+
+class MemoryAllocator;
+
+class CommandBufferProxy;
+
+class RenderGraph;
+
+//- how a pass touches a resource; the layout is ignored for buffers
+class ResourceAccessInfo
+{
+    using Self = ResourceAccessInfo;
+public:
+    ~ResourceAccessInfo() noexcept = default;
+    ResourceAccessInfo(
+        vk::PipelineStageFlags2 stage_flags = {},
+        vk::AccessFlags2 access_flags = {},
+        vk::ImageLayout layout = vk::ImageLayout::eUndefined) noexcept :
+        m_stage_flags(stage_flags),
+        m_access_flags(access_flags),
+        m_layout(layout) {}
+    ResourceAccessInfo(AttachmentUsage usage, bool unified_layouts_enabled = false) noexcept :
+        m_stage_flags(enum_traits<AttachmentUsage>::stage_flags_of(usage)),
+        m_access_flags(enum_traits<AttachmentUsage>::access_flags_of(usage)),
+        m_layout(enum_traits<AttachmentUsage>::layout_of(usage, unified_layouts_enabled)) {}
+    ResourceAccessInfo(const Self &) noexcept = default;
+    ResourceAccessInfo(Self &&) noexcept = default;
+    Self & operator=(const Self &) noexcept = default;
+    Self & operator=(Self &&) noexcept = default;
+public:
+    const vk::PipelineStageFlags2 & getStageFlags() const noexcept { return m_stage_flags; }
+    const vk::AccessFlags2 & getAccessFlags() const noexcept { return m_access_flags; }
+    const vk::ImageLayout & getImageLayout() const noexcept { return m_layout; }
+private:
+    vk::PipelineStageFlags2 m_stage_flags;
+    vk::AccessFlags2 m_access_flags;
+    vk::ImageLayout m_layout;
+};
+
+class RenderGraphPassBuilder
+{
+    using Self = RenderGraphPassBuilder;
+public:
+    enum class ImageId : uint32_t {};
+    enum class BufferId : uint32_t {};
+public:
+    ~RenderGraphPassBuilder() noexcept = default;
+    RenderGraphPassBuilder(RenderGraph & graph, uint32_t pass_index) noexcept : m_graph(graph), m_pass_index(pass_index) {}
+    RenderGraphPassBuilder(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    RenderGraphPassBuilder(Self &&) noexcept = default;
+    Self & operator=(Self &&) = delete;
+public:
+    Self & read(ImageId id, const ResourceAccessInfo & access) noexcept;
+    Self & write(ImageId id, const ResourceAccessInfo & access) noexcept;
+    Self & read(BufferId id, vk::PipelineStageFlags2 stage_flags, vk::AccessFlags2 access_flags) noexcept;
+    Self & write(BufferId id, vk::PipelineStageFlags2 stage_flags, vk::AccessFlags2 access_flags) noexcept;
+    //- the pass is kept even if nothing it writes is consumed, e.g. readbacks or debug output
+    Self & setSideEffects() noexcept;
+private:
+    RenderGraph & m_graph;
+    uint32_t m_pass_index;
+};
+
+//- passes declare what they read and write; compile() culls passes whose output is never consumed, orders the rest,
+//- derives every layout transition and hazard into one barrier batch per pass, and places transient resources with
+//- disjoint lifetimes into shared memory blocks. Compile once, then execute() every frame until the declarations change.
+//- Resources are tracked as a whole, subresource ranges are not split.
+class RenderGraph
+{
+    friend class RenderGraphPassBuilder;
+    using Self = RenderGraph;
+public:
+    using ImageId = RenderGraphPassBuilder::ImageId;
+    using BufferId = RenderGraphPassBuilder::BufferId;
+    using ExecuteCallback = std::move_only_function<void(CommandBufferProxy &, const RenderGraph &)>;
+private:
+    enum class ResourceKind : uint8_t
+    {
+        eImage,
+        eBuffer,
+    };
+    struct Resource
+    {
+        ResourceKind m_kind = ResourceKind::eImage;
+        bool m_imported = false;
+        ImageDescription m_image_desc;
+        vk::ImageSubresourceRange m_image_range;
+        vk::Image m_image;
+        vk::ImageView m_image_view;
+        vk::DeviceSize m_buffer_size = 0;
+        vk::BufferUsageFlags m_buffer_usage;
+        vk::Buffer m_buffer;
+        ResourceAccessInfo m_initial_access; //- imported only, the state the resource is in when execute() starts
+        std::optional<ResourceAccessInfo> m_final_access_opt; //- imported only, transitioned to after the last pass
+    };
+    using ResourceList = std::vector<Resource>;
+    struct ResourceUse
+    {
+        uint32_t m_resource_index;
+        ResourceAccessInfo m_access;
+        bool m_write;
+    };
+    using ResourceUseList = std::vector<ResourceUse>;
+    struct Pass
+    {
+        std::string m_name;
+        ExecuteCallback m_execute;
+        ResourceUseList m_uses;
+        bool m_side_effects = false;
+    };
+    using PassList = std::vector<Pass>;
+    struct BarrierBatch
+    {
+        uint32_t m_first_image_barrier = 0;
+        uint32_t m_image_barrier_count = 0;
+        uint32_t m_first_buffer_barrier = 0;
+        uint32_t m_buffer_barrier_count = 0;
+    };
+    struct CompiledPass
+    {
+        uint32_t m_pass_index;
+        BarrierBatch m_barriers;
+    };
+    using CompiledPassList = std::vector<CompiledPass>;
+    using ImageBarrierList = std::vector<vk::ImageMemoryBarrier2>;
+    using BufferBarrierList = std::vector<vk::BufferMemoryBarrier2>;
+    using ResourceIndexList = std::vector<uint32_t>;
+    using AliasPredecessorTable = std::vector<ResourceIndexList>; //- earlier transients that occupied the same memory
+    struct TransientResources
+    {
+        std::vector<MemoryBlock> m_memory_blocks; //- declared first so it is released last
+        std::vector<Image> m_images;
+        std::vector<vk::UniqueImageView> m_image_views;
+        std::vector<Buffer> m_buffers;
+    };
+public:
+    ~RenderGraph() noexcept = default;
+    RenderGraph() noexcept = default;
+    RenderGraph(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    RenderGraph(Self &&) noexcept = default;
+    Self & operator=(Self &&) noexcept = default;
+public:
+    ImageId importImage(
+        const Image & image,
+        vk::ImageView view,
+        const ResourceAccessInfo & initial_access,
+        std::optional<ResourceAccessInfo> final_access_opt = std::nullopt) noexcept;
+    BufferId importBuffer(
+        const Buffer & buffer,
+        vk::DeviceSize size,
+        const ResourceAccessInfo & initial_access,
+        std::optional<ResourceAccessInfo> final_access_opt = std::nullopt) noexcept;
+    //- usage flags implied by the declared accesses are added on compile
+    ImageId createImage(const ImageDescription & desc) noexcept;
+    BufferId createBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage = {}) noexcept;
+    RenderGraphPassBuilder addPass(std::string_view name, ExecuteCallback execute) noexcept;
+    //- rebinds an imported resource, e.g. to this frame's swapchain image, without recompiling
+    void setImportedImage(ImageId id, const Image & image, vk::ImageView view) noexcept;
+    void setImportedBuffer(BufferId id, const Buffer & buffer) noexcept;
+    std::error_code compile(const MemoryAllocator & allocator) noexcept;
+    std::error_code execute(CommandBufferProxy & cmd) noexcept;
+    //- drops every declaration; transients stay alive until command buffers that executed them retire
+    void reset() noexcept;
+    vk::Image getImage(ImageId id) const noexcept { return m_resources[std::to_underlying(id)].m_image; }
+    vk::ImageView getImageView(ImageId id) const noexcept { return m_resources[std::to_underlying(id)].m_image_view; }
+    vk::Buffer getBuffer(BufferId id) const noexcept { return m_resources[std::to_underlying(id)].m_buffer; }
+    uint32_t getCompiledPassCount() const noexcept { return static_cast<uint32_t>(m_compiled_passes.size()); }
+    //- transient memory before and after aliasing
+    vk::DeviceSize getTransientResourceBytes() const noexcept { return m_transient_resource_bytes; }
+    vk::DeviceSize getTransientMemoryBytes() const noexcept { return m_transient_memory_bytes; }
+private:
+    void addUse(uint32_t pass_index, uint32_t resource_index, ResourceKind kind, const ResourceAccessInfo & access, bool write) noexcept;
+    std::vector<bool> cullPasses() const noexcept;
+    CompiledPassList schedulePasses(const std::vector<bool> & pass_needed) const noexcept;
+    std::error_code allocateTransients(const MemoryAllocator & allocator, const CompiledPassList & schedule, AliasPredecessorTable & alias_predecessors) noexcept;
+    void buildBarriers(CompiledPassList & schedule, const AliasPredecessorTable & alias_predecessors) noexcept;
+    void recordBarriers(CommandBufferProxy & cmd, const BarrierBatch & batch) noexcept;
+private:
+    ResourceList m_resources;
+    PassList m_passes;
+    std::error_code m_declaration_error;
+    bool m_compiled = false;
+    CompiledPassList m_compiled_passes;
+    ImageBarrierList m_image_barriers;
+    ResourceIndexList m_image_barrier_resources;
+    BufferBarrierList m_buffer_barriers;
+    ResourceIndexList m_buffer_barrier_resources;
+    BarrierBatch m_final_barriers;
+    ResourcePtr<TransientResources> m_transients_rp;
+    vk::DeviceSize m_transient_resource_bytes = 0;
+    vk::DeviceSize m_transient_memory_bytes = 0;
+};
+
+} // namespace lcf::vkc
@@ -14,6 +14,8 @@ class MemoryAllocator;
 
 class MemoryAllocationInfo;
 
+class MemoryBlock;
+
 class ImageDescription
 {
     using Self = ImageDescription;
@@ -106,6 +108,13 @@ public:
         const MemoryAllocator & allocator,
         const vk::ImageCreateInfo & image_info,
         const MemoryAllocationInfo & alloc_info) noexcept;
+    //- placed into block at offset, the block has to outlive the image
+    std::error_code create(
+        const MemoryAllocator & allocator,
+        const vk::ImageCreateInfo & image_info,
+        const MemoryBlock & block,
+        vk::DeviceSize offset) noexcept;
+    std::error_code wrap(vk::Device device, vk::Image image, const ImageDescription & desc) noexcept; //- non-owning, e.g. swapchain images
     const vk::Image & handle() const noexcept;
     ResourceLease lease() const noexcept;
     const ImageDescription & getDescription() const noexcept { return m_desc; }
@@ -4,7 +4,10 @@
 #include <memory>
 #include <expected>
 #include <type_traits>
+#include <vector>
 #include "vk_core/memory/details/Memory.h"
+#include "vk_core/memory/MemoryPool.h"
+#include "vk_core/memory/MemoryBlock.h"
 
 namespace lcf::vkc {
 
@@ -18,6 +21,10 @@ class MemoryAllocationInfo;
 
 class MemoryAllocatorCreateInfo;
 
+class MemoryPoolCreateInfo;
+
+struct MemoryHeapBudget;
+
 class MemoryAllocator
 {
     using Self = MemoryAllocator;
@@ -33,12 +40,36 @@ public:
         vk::Instance instance, vk::PhysicalDevice physical_device, vk::Device device,
         const MemoryAllocatorCreateInfo & create_info) noexcept;
     const vk::Device & getDevice() const noexcept { return m_device; }
+    bool isBufferDeviceAddressEnabled() const noexcept { return m_bda_enabled; }
+    std::expected<details::UniqueBufferMemory, std::error_code> allocateBuffer(
+        const vk::BufferCreateInfo & buffer_info,
+        const MemoryAllocationInfo & alloc_info) const noexcept;
     std::expected<details::UniqueBufferMemory, std::error_code> allocateBuffer(
         const vk::BufferCreateInfo & buffer_info,
+        const MemoryAllocationInfo & alloc_info,
+        const MemoryPool & pool) const noexcept;
+    std::expected<details::UniqueImageMemory, std::error_code> allocateImage(
+        const vk::ImageCreateInfo & image_info,
         const MemoryAllocationInfo & alloc_info) const noexcept;
+    std::expected<details::UniqueBufferMemory, std::error_code> allocateBuffer(
+        const vk::BufferCreateInfo & buffer_info,
+        const MemoryBlock & block,
+        vk::DeviceSize offset) const noexcept;
     std::expected<details::UniqueImageMemory, std::error_code> allocateImage(
         const vk::ImageCreateInfo & image_info,
+        const MemoryBlock & block,
+        vk::DeviceSize offset) const noexcept;
+    //- memory for resources placed with the block overloads above, requirements.memoryTypeBits must suit all of them
+    std::expected<MemoryBlock, std::error_code> allocateMemory(
+        const vk::MemoryRequirements & requirements,
         const MemoryAllocationInfo & alloc_info) const noexcept;
+    std::expected<MemoryPool, std::error_code> createPool(
+        const vk::BufferCreateInfo & buffer_info,
+        const MemoryAllocationInfo & alloc_info,
+        const MemoryPoolCreateInfo & pool_info) const noexcept;
+    //- budgets are cached per frame index, advance it once per frame before querying
+    void setCurrentFrameIndex(uint32_t frame_index) const noexcept;
+    std::vector<MemoryHeapBudget> getHeapBudgets() const noexcept;
 private:
     vk::Device m_device;
     std::unique_ptr<details::VMAllocator> m_allocator_up;
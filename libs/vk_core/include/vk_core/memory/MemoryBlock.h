@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <vk_mem_alloc.h>
+#include <utility>
+
+namespace lcf::vkc {
+
+//- raw VMA allocation that images and buffers are placed into at explicit offsets, which lets resources with
+//- disjoint lifetimes alias the same memory; every resource bound to it must be destroyed before the block
+class MemoryBlock
+{
+    using Self = MemoryBlock;
+public:
+    ~MemoryBlock() noexcept { this->destroy(); }
+    MemoryBlock() noexcept = default;
+    MemoryBlock(VmaAllocator allocator, VmaAllocation allocation, vk::DeviceSize size) noexcept :
+        m_allocator(allocator),
+        m_allocation(allocation),
+        m_size(size) {}
+    MemoryBlock(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    MemoryBlock(Self && other) noexcept { this->stealFrom(other); }
+    Self & operator=(Self && other) noexcept
+    {
+        if (this == &other) { return *this; }
+        this->destroy();
+        this->stealFrom(other);
+        return *this;
+    }
+    explicit operator bool() const noexcept { return m_allocation; }
+public:
+    VmaAllocation handle() const noexcept { return m_allocation; }
+    vk::DeviceSize getSize() const noexcept { return m_size; }
+private:
+    void destroy() noexcept
+    {
+        if (m_allocation) { vmaFreeMemory(m_allocator, m_allocation); }
+        m_allocation = nullptr;
+        m_size = 0;
+    }
+    void stealFrom(Self & other) noexcept
+    {
+        m_allocator = std::exchange(other.m_allocator, nullptr);
+        m_allocation = std::exchange(other.m_allocation, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+private:
+    VmaAllocator m_allocator = nullptr;
+    VmaAllocation m_allocation = nullptr;
+    vk::DeviceSize m_size = 0;
+};
+
+} // namespace lcf::vkc
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <vk_mem_alloc.h>
+#include <utility>
+
+namespace lcf::vkc {
+
+//- custom VMA pool, every buffer allocated from it must be destroyed before the pool
+class MemoryPool
+{
+    using Self = MemoryPool;
+public:
+    ~MemoryPool() noexcept { this->destroy(); }
+    MemoryPool() noexcept = default;
+    MemoryPool(VmaAllocator allocator, VmaPool pool) noexcept : m_allocator(allocator), m_pool(pool) {}
+    MemoryPool(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    MemoryPool(Self && other) noexcept { this->stealFrom(other); }
+    Self & operator=(Self && other) noexcept
+    {
+        if (this == &other) { return *this; }
+        this->destroy();
+        this->stealFrom(other);
+        return *this;
+    }
+    explicit operator bool() const noexcept { return m_pool; }
+public:
+    VmaPool handle() const noexcept { return m_pool; }
+private:
+    void destroy() noexcept
+    {
+        if (m_pool) { vmaDestroyPool(m_allocator, m_pool); }
+        m_pool = nullptr;
+    }
+    void stealFrom(Self & other) noexcept
+    {
+        m_allocator = std::exchange(other.m_allocator, nullptr);
+        m_pool = std::exchange(other.m_pool, nullptr);
+    }
+private:
+    VmaAllocator m_allocator = nullptr;
+    VmaPool m_pool = nullptr;
+};
+
+} // namespace lcf::vkc
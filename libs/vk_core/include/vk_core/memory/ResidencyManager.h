@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <array>
+#include <deque>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+#include "vk_core/memory/enums.h"
+#include "enums/enum_count.h"
+
+namespace lcf::vkc {
+
+class MemoryAllocator;
+
+//- watches the VMA heap budgets and keeps device local usage below a soft limit by evicting least recently used resources;
+//- eviction only drops the owner's handle, leases pinned by in-flight command buffers keep the memory alive until the timeline passes
+class ResidencyManager
+{
+    using Self = ResidencyManager;
+public:
+    using ResidencyId = uint64_t;
+    using EvictCallback = std::move_only_function<void()>;
+private:
+    using LruList = std::list<ResidencyId>;
+    struct HeldEviction //- evicted, but leases may still hold the memory until the frames in flight retire
+    {
+        uint64_t m_frame_index;
+        vk::DeviceSize m_size;
+    };
+    using HeldEvictionQueue = std::deque<HeldEviction>;
+    struct Entry
+    {
+        MemoryCategory m_category;
+        vk::DeviceSize m_size;
+        uint64_t m_last_used_frame;
+        EvictCallback m_evict; //- empty for resources that must stay resident
+        LruList::iterator m_lru_it;
+    };
+    using EntryMap = std::unordered_map<ResidencyId, Entry>;
+    using CategorySizeArray = std::array<vk::DeviceSize, lcf::enum_count_v<MemoryCategory>>;
+    using EvictCallbackList = std::vector<EvictCallback>;
+public:
+    ~ResidencyManager() noexcept = default;
+    ResidencyManager() noexcept = default;
+    ResidencyManager(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    ResidencyManager(Self &&) = delete;
+    Self & operator=(Self &&) = delete;
+public:
+    std::error_code create(const MemoryAllocator & allocator) noexcept;
+    //- fractions of the device local budget reported by the driver
+    Self & setSoftLimit(float fraction) noexcept;
+    Self & setHardLimit(float fraction) noexcept;
+    //- 0 means the category is only bound by the global limits
+    Self & setCategoryLimit(MemoryCategory category, vk::DeviceSize size_in_bytes) noexcept;
+    //- resources touched within this many frames are never evicted, which keeps eviction from thrashing the working set
+    Self & setMinIdleFrames(uint32_t frame_count) noexcept;
+    //- evicted memory is taken as still leased by in-flight command buffers for this many frames,
+    //- so the polled usage is not mistaken for pressure the evictions have already answered
+    Self & setMaxFramesInFlight(uint32_t frame_count) noexcept;
+    ResidencyId track(MemoryCategory category, vk::DeviceSize size_in_bytes, EvictCallback evict = {}) noexcept;
+    void untrack(ResidencyId id) noexcept;
+    void touch(ResidencyId id) noexcept;
+    //- call before allocating, evicts what it can and fails with errc::memory_budget_exceeded past the hard limit
+    std::error_code reserve(MemoryCategory category, vk::DeviceSize size_in_bytes) noexcept;
+    //- call once per frame, polls the budgets and evicts down to the soft limit; returns the number of evicted resources
+    uint32_t update(uint64_t frame_index) noexcept;
+    vk::DeviceSize getCategoryUsage(MemoryCategory category) const noexcept;
+    vk::DeviceSize getDeviceLocalUsage() const noexcept;
+    vk::DeviceSize getDeviceLocalBudget() const noexcept;
+private:
+    vk::DeviceSize estimateUsage() const noexcept;
+    //- frees at least bytes_to_free from the lru end, restricted to one category when given
+    vk::DeviceSize collectEvictions(
+        vk::DeviceSize bytes_to_free,
+        std::optional<MemoryCategory> category_opt,
+        EvictCallbackList & evictions) noexcept;
+    void pollBudgets() noexcept;
+    void retireHeldEvictions() noexcept;
+    void evict(ResidencyId id, EvictCallbackList & evictions) noexcept;
+private:
+    const MemoryAllocator * m_allocator_p = nullptr;
+    mutable std::mutex m_mutex;
+    EntryMap m_entries;
+    LruList m_lru; //- evictable entries only, least recently used first
+    ResidencyId m_next_id = 1;
+    uint64_t m_frame_index = 0;
+    uint32_t m_min_idle_frames = 2;
+    uint32_t m_max_frames_in_flight = 3;
+    float m_soft_limit = 0.85f;
+    float m_hard_limit = 0.95f;
+    CategorySizeArray m_category_usages {};
+    CategorySizeArray m_category_limits {};
+    vk::DeviceSize m_polled_usage = 0;
+    vk::DeviceSize m_polled_budget = 0;
+    vk::DeviceSize m_reserved_since_poll = 0;
+    HeldEvictionQueue m_held_evictions; //- oldest first
+    vk::DeviceSize m_held_eviction_bytes = 0;
+};
+
+} // namespace lcf::vkc
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <vk_mem_alloc.h>
+#include <deque>
+#include <expected>
+#include <span>
+#include <system_error>
+#include <vector>
+#include "resource_utils.h"
+#include "vk_core/memory/details/Memory.h"
+#include "vk_core/memory/MemoryPool.h"
+#include "vk_core/memory/enums.h"
+
+namespace lcf::vkc {
+
+class MemoryAllocator;
+
+class BufferSlice
+{
+    using Self = BufferSlice;
+    using ByteSpan = std::span<std::byte>;
+public:
+    ~BufferSlice() noexcept = default;
+    BufferSlice() noexcept = default;
+    BufferSlice(
+        vk::Buffer buffer,
+        vk::DeviceSize offset,
+        vk::DeviceSize size,
+        vk::DeviceAddress device_address,
+        ByteSpan mapped_span) noexcept :
+        m_buffer(buffer),
+        m_offset(offset),
+        m_size(size),
+        m_device_address(device_address),
+        m_mapped_span(mapped_span) {}
+    BufferSlice(const Self &) noexcept = default;
+    BufferSlice(Self &&) noexcept = default;
+    Self & operator=(const Self &) noexcept = default;
+    Self & operator=(Self &&) noexcept = default;
+public:
+    const vk::Buffer & getBuffer() const noexcept { return m_buffer; }
+    vk::DeviceSize getOffset() const noexcept { return m_offset; }
+    vk::DeviceSize getSize() const noexcept { return m_size; }
+    //- 0 unless the ring was created with eShaderDeviceAddress and buffer device address enabled
+    vk::DeviceAddress getDeviceAddress() const noexcept { return m_device_address; }
+    //- empty for device local rings
+    ByteSpan getMappedSpan() const noexcept { return m_mapped_span; }
+    vk::DescriptorBufferInfo getDescriptorInfo() const noexcept { return {m_buffer, m_offset, m_size}; }
+private:
+    vk::Buffer m_buffer;
+    vk::DeviceSize m_offset = 0;
+    vk::DeviceSize m_size = 0;
+    vk::DeviceAddress m_device_address = 0;
+    ByteSpan m_mapped_span;
+};
+
+//- suballocates transient per-frame data out of one VkBuffer that lives in its own linear VMA pool;
+//- slices are tagged with a timeline value on retire() and recycled in order once reclaim() sees it completed
+class TransientBufferRing
+{
+    using Self = TransientBufferRing;
+    struct SharedStorage //- leases share ownership of the pool with the buffer, so in-flight work keeps both alive
+    {
+        MemoryPool m_pool;
+        details::UniqueBufferMemory m_memory; //- declared after the pool so it is released first
+    };
+    using SharedStoragePointer = ResourcePtr<SharedStorage>;
+    using VirtualAllocationList = std::vector<VmaVirtualAllocation>;
+    struct RetiredAllocations
+    {
+        uint64_t m_timestamp;
+        VirtualAllocationList m_allocations;
+    };
+    using RetiredAllocationQueue = std::deque<RetiredAllocations>;
+public:
+    ~TransientBufferRing() noexcept;
+    TransientBufferRing() noexcept = default;
+    TransientBufferRing(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    TransientBufferRing(Self && other) noexcept;
+    Self & operator=(Self && other) noexcept;
+public:
+    std::error_code create(
+        const MemoryAllocator & allocator,
+        vk::DeviceSize capacity,
+        vk::BufferUsageFlags usage,
+        MemoryAccess access = MemoryAccess::eHostSequentialWrite) noexcept;
+    std::expected<BufferSlice, std::error_code> allocate(vk::DeviceSize size, vk::DeviceSize alignment = 16) noexcept;
+    //- everything allocated since the previous retire() becomes reusable once timestamp completes
+    void retire(uint64_t timestamp) noexcept;
+    void reclaim(uint64_t completed_timestamp) noexcept;
+    const vk::Buffer & getBuffer() const noexcept { return m_buffer; }
+    vk::DeviceAddress getDeviceAddress() const noexcept { return m_device_address; }
+    //- keeps the buffer and its pool alive after the ring is destroyed, hold one per submission using the slices
+    ResourceLease lease() const noexcept { return m_storage_rp.lease(); }
+    vk::DeviceSize getCapacity() const noexcept { return m_capacity; }
+private:
+    void destroy() noexcept;
+    void stealFrom(Self & other) noexcept;
+private:
+    SharedStoragePointer m_storage_rp;
+    vk::Buffer m_buffer;
+    vk::DeviceAddress m_device_address = 0;
+    VmaVirtualBlock m_virtual_block = nullptr;
+    vk::DeviceSize m_capacity = 0;
+    std::span<std::byte> m_mapped_span;
+    VirtualAllocationList m_open_allocations;
+    RetiredAllocationQueue m_retired_allocations;
+};
+
+} // namespace lcf::vkc
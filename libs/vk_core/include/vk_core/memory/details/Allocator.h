@@ -4,6 +4,7 @@
 #include <vk_mem_alloc.h>
 #include <system_error>
 #include <expected>
+#include <vector>
 #include "vk_core/memory/details/Memory.h"
 
 namespace lcf::vkc {
@@ -12,6 +13,10 @@ class MemoryAllocationInfo;
 
 class MemoryAllocatorCreateInfo;
 
+class MemoryPoolCreateInfo;
+
+struct MemoryHeapBudget;
+
 } // namespace lcf::vkc
 
 namespace lcf::vkc::details {
@@ -30,8 +35,17 @@ public:
     std::error_code create(vk::Instance instance, vk::PhysicalDevice physical_device, vk::Device device, const MemoryAllocatorCreateInfo & create_info) noexcept;
     //- Memory is no longer RAII, so it never leaves here bare: UniqueHandle closes the
     //- window between allocation and the caller's ResourceHandle taking ownership
-    std::expected<UniqueBufferMemory, std::error_code> allocateBuffer(const vk::BufferCreateInfo & buffer_info, const MemoryAllocationInfo & alloc_info) const noexcept;
+    std::expected<UniqueBufferMemory, std::error_code> allocateBuffer(const vk::BufferCreateInfo & buffer_info, const MemoryAllocationInfo & alloc_info, VmaPool pool = nullptr) const noexcept;
     std::expected<UniqueImageMemory, std::error_code> allocateImage(const vk::ImageCreateInfo & image_info, const MemoryAllocationInfo & alloc_info) const noexcept;
+    std::expected<VmaAllocation, std::error_code> allocateMemory(const vk::MemoryRequirements & requirements, const MemoryAllocationInfo & alloc_info) const noexcept;
+    //- the resource is bound at offset into allocation and does not own it, destroying it leaves the memory alone
+    std::expected<UniqueBufferMemory, std::error_code> allocateAliasingBuffer(const vk::BufferCreateInfo & buffer_info, VmaAllocation allocation, vk::DeviceSize offset) const noexcept;
+    std::expected<UniqueImageMemory, std::error_code> allocateAliasingImage(const vk::ImageCreateInfo & image_info, VmaAllocation allocation, vk::DeviceSize offset) const noexcept;
+    //- the memory type is picked for buffer_info and alloc_info, so the pool only serves buffers of compatible usage
+    std::expected<VmaPool, std::error_code> createPool(const vk::BufferCreateInfo & buffer_info, const MemoryAllocationInfo & alloc_info, const MemoryPoolCreateInfo & pool_info) const noexcept;
+    void setCurrentFrameIndex(uint32_t frame_index) const noexcept { vmaSetCurrentFrameIndex(m_allocator, frame_index); }
+    std::vector<MemoryHeapBudget> getHeapBudgets() const noexcept;
+    VmaAllocator handle() const noexcept { return m_allocator; }
 private:
     VmaAllocator m_allocator = nullptr;
 };
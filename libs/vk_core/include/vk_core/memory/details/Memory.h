@@ -7,6 +7,12 @@
 #include <utility>
 #include <type_traits>
 
+namespace lcf::vkc {
+
+class TransientBufferRing;
+
+} // namespace lcf::vkc
+
 namespace lcf::vkc::details {
 
 namespace vma {
@@ -27,6 +33,7 @@ template <typename Handle>
 requires std::is_same_v<Handle, vk::Image> or std::is_same_v<Handle, vk::Buffer>
 class Memory
 {
+    friend class lcf::vkc::TransientBufferRing; //- hands out subranges of its persistently mapped buffer
     using Self = Memory<Handle>;
     using ByteSpan = std::span<std::byte>;
     using ReadableByteSpan = std::span<const std::byte>;
@@ -18,4 +18,12 @@ enum class AllocationStrategy : uint8_t
     eMinTime,   // minimise allocation time
 };
 
+enum class MemoryCategory : uint8_t
+{
+    eTexture = 0,
+    eGeometry,
+    eBuffer,
+    eStaging,
+};
+
 } // namespace lcf::vkc
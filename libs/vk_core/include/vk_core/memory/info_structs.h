@@ -113,4 +113,58 @@ private:
     vk::DeviceSize m_preferred_large_heap_block_size = 0;
 };
 
+struct MemoryHeapBudget
+{
+    vk::DeviceSize m_usage = 0;            // bytes the whole process uses on this heap, as reported by the driver
+    vk::DeviceSize m_budget = 0;           // bytes the process may use before the OS starts demoting or failing
+    vk::DeviceSize m_allocation_bytes = 0; // bytes handed out by this allocator
+    vk::DeviceSize m_block_bytes = 0;      // bytes this allocator holds in device memory blocks
+    bool m_device_local = false;
+};
+
+class MemoryPoolCreateInfo
+{
+    using Self = MemoryPoolCreateInfo;
+public:
+    ~MemoryPoolCreateInfo() noexcept = default;
+    MemoryPoolCreateInfo() noexcept = default;
+    MemoryPoolCreateInfo(const Self &) = default;
+    MemoryPoolCreateInfo(Self &&) noexcept = default;
+    Self & operator =(const Self &) = default;
+    Self & operator =(Self &&) noexcept = default;
+public:
+    // Linear pools hand out memory bump-style and serve as stacks or ring buffers when freed in order.
+    Self & setLinear(bool linear) noexcept
+    {
+        m_linear = linear;
+        return *this;
+    }
+    // 0 keeps the allocator's default block size.
+    Self & setBlockSize(vk::DeviceSize size) noexcept
+    {
+        m_block_size = size;
+        return *this;
+    }
+    Self & setMinBlockCount(uint32_t count) noexcept
+    {
+        m_min_block_count = count;
+        return *this;
+    }
+    // 0 means unlimited; a linear pool used as a ring buffer needs exactly 1.
+    Self & setMaxBlockCount(uint32_t count) noexcept
+    {
+        m_max_block_count = count;
+        return *this;
+    }
+    bool isLinear() const noexcept { return m_linear; }
+    vk::DeviceSize getBlockSize() const noexcept { return m_block_size; }
+    uint32_t getMinBlockCount() const noexcept { return m_min_block_count; }
+    uint32_t getMaxBlockCount() const noexcept { return m_max_block_count; }
+private:
+    bool m_linear = true;
+    vk::DeviceSize m_block_size = 0;
+    uint32_t m_min_block_count = 0;
+    uint32_t m_max_block_count = 0;
+};
+
 } // namespace lcf::vkc
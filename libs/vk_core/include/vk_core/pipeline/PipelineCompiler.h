@@ -0,0 +1,167 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "vk_core/pipeline/graphics/GraphicsPipeline.h"
+#include "vk_core/pipeline/shader/ShaderObject.h"
+
+namespace lcf::vkc {
+
+class GraphicsPipelineInfo;
+
+class StaticRenderScopeInfo;
+
+class DynamicRenderScopeInfo;
+
+class ShaderProgramInfo;
+
+enum class CompileStatus
+{
+    ePending,
+    eReady,
+    eFailed,
+};
+
+namespace details {
+
+template <typename Product>
+class CompileState
+{
+    using Self = CompileState;
+public:
+    ~CompileState() noexcept = default;
+    CompileState() noexcept = default;
+    CompileState(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    CompileState(Self &&) = delete;
+    Self & operator=(Self &&) = delete;
+public:
+    void fulfill(Product && product) noexcept
+    {
+        m_product_opt.emplace(std::move(product));
+        this->publish(CompileStatus::eReady);
+    }
+    void fail(std::error_code error) noexcept
+    {
+        m_error = error;
+        this->publish(CompileStatus::eFailed);
+    }
+    void wait() const noexcept { m_status.wait(CompileStatus::ePending, std::memory_order_acquire); }
+    CompileStatus getStatus() const noexcept { return m_status.load(std::memory_order_acquire); }
+    //- only meaningful once getStatus() has left ePending
+    const Product & getProduct() const noexcept { return *m_product_opt; }
+    const std::error_code & getError() const noexcept { return m_error; }
+private:
+    void publish(CompileStatus status) noexcept
+    {
+        m_status.store(status, std::memory_order_release);
+        m_status.notify_all();
+    }
+private:
+    std::atomic<CompileStatus> m_status = CompileStatus::ePending;
+    std::optional<Product> m_product_opt;
+    std::error_code m_error;
+};
+
+} // namespace details
+
+//- future-like handle to a background build, copies share the product
+template <typename Product>
+class CompileTicket
+{
+    using Self = CompileTicket;
+    using StateSharedPointer = std::shared_ptr<const details::CompileState<Product>>;
+public:
+    ~CompileTicket() noexcept = default;
+    CompileTicket() noexcept = default;
+    explicit CompileTicket(StateSharedPointer state_sp) noexcept : m_state_sp(std::move(state_sp)) {}
+    CompileTicket(const Self &) noexcept = default;
+    CompileTicket(Self &&) noexcept = default;
+    Self & operator=(const Self &) noexcept = default;
+    Self & operator=(Self &&) noexcept = default;
+    explicit operator bool() const noexcept { return bool(m_state_sp); }
+public:
+    CompileStatus getStatus() const noexcept { return m_state_sp ? m_state_sp->getStatus() : CompileStatus::eFailed; }
+    bool isReady() const noexcept { return this->getStatus() == CompileStatus::eReady; }
+    bool isPending() const noexcept { return this->getStatus() == CompileStatus::ePending; }
+    void wait() const noexcept { if (m_state_sp) { m_state_sp->wait(); } }
+    const Product * tryGet() const noexcept { return this->isReady() ? &m_state_sp->getProduct() : nullptr; }
+    //- keeps drawing with a compatible, already built product until this one is ready
+    const Product & getOr(const Product & fallback) const noexcept { return this->isReady() ? m_state_sp->getProduct() : fallback; }
+    std::error_code getError() const noexcept
+    {
+        if (not m_state_sp) { return std::make_error_code(std::errc::invalid_argument); }
+        return m_state_sp->getStatus() == CompileStatus::eFailed ? m_state_sp->getError() : std::error_code {};
+    }
+private:
+    StateSharedPointer m_state_sp;
+};
+
+using GraphicsPipelineTicket = CompileTicket<GraphicsPipeline>;
+
+using ShaderObjectGroupTicket = CompileTicket<ShaderObjectGroup>;
+
+//- runs driver compiles on a fixed set of workers so first use of a permutation does not stall the frame;
+//- infos are shared with the workers and must stay unmodified until the ticket leaves ePending
+class PipelineCompiler
+{
+    using Self = PipelineCompiler;
+    using Task = std::move_only_function<void(bool cancelled)>;
+    using TaskQueue = std::deque<Task>;
+    using WorkerList = std::vector<std::jthread>;
+public:
+    using ConstGraphicsPipelineInfoSP = std::shared_ptr<const GraphicsPipelineInfo>;
+    using ConstStaticRenderScopeInfoSP = std::shared_ptr<const StaticRenderScopeInfo>;
+    using ConstDynamicRenderScopeInfoSP = std::shared_ptr<const DynamicRenderScopeInfo>;
+    using ConstShaderProgramInfoSP = std::shared_ptr<const ShaderProgramInfo>;
+    ~PipelineCompiler() noexcept;
+    PipelineCompiler() noexcept = default;
+    PipelineCompiler(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    PipelineCompiler(Self &&) = delete;
+    Self & operator=(Self &&) = delete;
+public:
+    //- worker_count 0 picks half the hardware threads; compile() fails with pipeline_compile_queue_full past max_pending_count
+    std::error_code create(
+        vk::Device device,
+        uint32_t worker_count = 0u,
+        uint32_t max_pending_count = 64u,
+        std::span<const std::byte> initial_cache_data = {}) noexcept;
+    std::expected<GraphicsPipelineTicket, std::error_code> compile(
+        ConstGraphicsPipelineInfoSP pipeline_info_sp,
+        ConstStaticRenderScopeInfoSP render_scope_info_sp) noexcept;
+    std::expected<GraphicsPipelineTicket, std::error_code> compile(
+        ConstGraphicsPipelineInfoSP pipeline_info_sp,
+        ConstDynamicRenderScopeInfoSP render_scope_info_sp) noexcept;
+    std::expected<ShaderObjectGroupTicket, std::error_code> compile(
+        ConstShaderProgramInfoSP program_info_sp,
+        vk::ShaderCreateFlagsEXT flags = {}) noexcept;
+    uint32_t getPendingCount() const noexcept;
+    vk::PipelineCache getPipelineCache() const noexcept { return m_pipeline_cache.get(); }
+private:
+    template <typename Product, typename Build>
+    std::expected<CompileTicket<Product>, std::error_code> submit(Build && build) noexcept;
+    void workerLoop(std::stop_token stop_token) noexcept;
+private:
+    vk::Device m_device;
+    vk::UniquePipelineCache m_pipeline_cache;
+    mutable std::mutex m_mutex;
+    std::condition_variable_any m_task_cv;
+    TaskQueue m_tasks;
+    uint32_t m_pending_count = 0u; //- queued plus running
+    uint32_t m_max_pending_count = 0u;
+    WorkerList m_workers;
+};
+
+} // namespace lcf::vkc
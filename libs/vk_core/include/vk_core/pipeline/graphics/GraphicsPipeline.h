@@ -28,11 +28,13 @@ public:
     std::error_code create(
         vk::Device device,
         const GraphicsPipelineInfo & pipeline_info,
-        const StaticRenderScopeInfo & render_scope_info) noexcept;
+        const StaticRenderScopeInfo & render_scope_info,
+        vk::PipelineCache pipeline_cache = nullptr) noexcept;
     std::error_code create(
         vk::Device device,
         const GraphicsPipelineInfo & pipeline_info,
-        const DynamicRenderScopeInfo & render_scope_info) noexcept;
+        const DynamicRenderScopeInfo & render_scope_info,
+        vk::PipelineCache pipeline_cache = nullptr) noexcept;
     void bind(CommandBufferProxy & cmd) const noexcept;
     const vk::Pipeline & handle() const noexcept { return m_pipeline.get(); }
 private:
@@ -3,8 +3,9 @@
 #include <vulkan/vulkan.hpp>
 #include <queue>
 #include <expected>
-#include <queue>
+#include <span>
 #include "vk_core/queue/LogicalQueue.h"
+#include "vk_core/queue/details/SubmitArena.h"
 #include "vk_core/queue/SubmissionToken.h"
 #include "vk_core/sync/TimelineSemaphore.h"
 #include "vk_core/command/CommandBufferAllocator.h"
@@ -29,14 +30,16 @@ public:
     Self & operator=(Self &&) = delete;
 public:
     std::error_code create(const LogicalQueue & logical_queue) noexcept;
-    std::expected<CommandBufferBatch, std::error_code> allocateCommandBufferBatch(const CommandBufferAllocateInfo & info) noexcept;
+    std::expected<CommandBufferBatch, std::error_code> allocateCommandBufferBatch(const CommandBufferAllocateInfo & info) noexcept; //- callable from recording threads, each thread gets its own pools
     std::expected<SubmissionToken, std::error_code> submit(CommandBufferBatch && batch) noexcept;
+    std::expected<SubmissionToken, std::error_code> submitMany(std::span<CommandBufferBatch> batches) noexcept; //- one vkQueueSubmit2 and one timeline signal for all batches, consumes them
     void collectGarbage() noexcept;
 private:
     LogicalQueue m_logical_queue;
     TimelineSemaphore m_timeline;
     CommandBufferAllocator m_cmd_allocator;
     LeaseBatchQueue m_lease_batch_queue;
+    details::SubmitArena m_submit_arena;
 };
 
 } // namespace lcf::vkc
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vulkan/vulkan.hpp>
+#include <span>
+#include <vector>
+
+namespace lcf::vkc::details {
+
+class SubmitArena //- scratch storage for vkQueueSubmit2 arguments, capacity survives across submissions
+{
+    using Self = SubmitArena;
+public:
+    ~SubmitArena() noexcept = default;
+    SubmitArena() = default;
+    SubmitArena(const Self &) = delete;
+    Self & operator=(const Self &) = delete;
+    SubmitArena(Self &&) noexcept = default;
+    Self & operator=(Self &&) noexcept = default;
+public:
+    void reset(size_t submit_count, size_t cmd_buffer_count, size_t signal_count) noexcept
+    {
+        //- reserved up front so spans handed out below stay valid until the next reset
+        m_submit_infos.clear();
+        m_cmd_buffer_infos.clear();
+        m_signal_infos.clear();
+        m_submit_infos.reserve(submit_count);
+        m_cmd_buffer_infos.reserve(cmd_buffer_count);
+        m_signal_infos.reserve(signal_count);
+    }
+    std::span<const vk::CommandBufferSubmitInfo> pushCommandBuffers(std::span<const vk::CommandBuffer> cmd_buffers) noexcept
+    {
+        size_t offset = m_cmd_buffer_infos.size();
+        for (vk::CommandBuffer cmd : cmd_buffers) { m_cmd_buffer_infos.emplace_back(cmd); }
+        return std::span(m_cmd_buffer_infos).subspan(offset);
+    }
+    std::span<const vk::SemaphoreSubmitInfo> pushSignalInfos(std::span<const vk::SemaphoreSubmitInfo> signal_infos) noexcept
+    {
+        size_t offset = m_signal_infos.size();
+        m_signal_infos.append_range(signal_infos);
+        return std::span(m_signal_infos).subspan(offset);
+    }
+    vk::SubmitInfo2 & pushSubmitInfo() noexcept { return m_submit_infos.emplace_back(); }
+    std::span<const vk::SubmitInfo2> getSubmitInfos() const noexcept { return m_submit_infos; }
+private:
+    std::vector<vk::SubmitInfo2> m_submit_infos;
+    std::vector<vk::CommandBufferSubmitInfo> m_cmd_buffer_infos;
+    std::vector<vk::SemaphoreSubmitInfo> m_signal_infos;
+};
+
+} // namespace lcf::vkc::details
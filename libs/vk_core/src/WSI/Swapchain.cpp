@@ -9,6 +9,24 @@
 
 namespace stdr = std::ranges;
 
+namespace {
+
+using namespace lcf::vkc;
+
+constexpr std::array k_present_wait_extensions
+{
+    vk::KHRPresentIdExtensionName,
+    vk::KHRPresentWaitExtensionName,
+};
+
+constexpr std::array k_present_wait_features
+{
+    LCF_VKC_UTILS_FEATURE_BIT(&vk::PhysicalDevicePresentIdFeaturesKHR::presentId),
+    LCF_VKC_UTILS_FEATURE_BIT(&vk::PhysicalDevicePresentWaitFeaturesKHR::presentWait),
+};
+
+} // namespace
+
 namespace lcf::vkc::entry {
 
 void register_swapchain(InstanceExtensionManifest & instance_ext_manifest, DeviceExtensionManifest & device_ext_manifest) noexcept
@@ -34,6 +52,12 @@ void register_swapchain(InstanceExtensionManifest & instance_ext_manifest, Devic
     register_timeline_semaphore(device_ext_manifest);
 }
 
+void register_present_wait(DeviceExtensionManifest & device_ext_manifest) noexcept
+{
+    device_ext_manifest.addRequiredExtensions(k_present_wait_extensions)
+        .addRequiredFeatures(k_present_wait_features);
+}
+
 } // namespace lcf::vkc::entry
 
 namespace lcf::vkc::wsi {
@@ -65,17 +89,14 @@ std::expected<vk::SemaphoreSubmitInfo, std::error_code> Swapchain::_present(
     vk::ImageSubresourceLayers src_subresource_layers) noexcept
 {
     //- 1. check pre-conditions
+    if (m_is_frame_acquired) { return std::unexpected(errc::swapchain_frame_already_acquired); }
     if (auto ec = this->acquireNextImage()) { return std::unexpected(ec); }
     //- 2. fill m_present_resources
     auto expected_cmd = this->acquireCmdBuffer();
-    auto expected_fence = this->acquireFence();
-    auto expected_present_ready_semaphore = this->acquireSemaphore();
     if (not expected_cmd) { return std::unexpected(expected_cmd.error()); }
-    if (not expected_fence) { return std::unexpected(expected_fence.error()); }
-    if (not expected_present_ready_semaphore) { return std::unexpected(expected_present_ready_semaphore.error()); }
+    if (auto ec = this->acquirePresentResources()) { return std::unexpected(ec); }
     auto & cmd = m_present_resources.m_cmd = std::move(expected_cmd.value());
-    auto & present_fence = m_present_resources.m_present_fence = std::move(expected_fence.value());
-    auto & present_ready = m_present_resources.m_present_ready = std::move(expected_present_ready_semaphore.value());
+    auto & present_ready = m_present_resources.m_present_ready;
     auto & target_available = m_present_resources.m_target_available;
     if (image_lease) {
         m_present_resources.m_leases.emplace_back(std::move(image_lease));
@@ -148,21 +169,7 @@ std::expected<vk::SemaphoreSubmitInfo, std::error_code> Swapchain::_present(
         return std::unexpected(e.code());
     }
     //- 5. present
-    vk::StructureChain<vk::PresentInfoKHR, vk::SwapchainPresentFenceInfoKHR> present_info_chain;
-    present_info_chain.get<vk::SwapchainPresentFenceInfoKHR>().setFences(present_fence.get());
-    present_info_chain.get<vk::PresentInfoKHR>()
-        .setWaitSemaphores(present_ready.get())
-        .setSwapchains(m_swapchain.get())
-        .setPImageIndices(&m_image_index);
-    vk::Result present_result = vk::Result::eSuccess;   
-    try {
-        QueueAccess queue_access {m_logical_present_queue};
-        present_result = queue_access->presentKHR(present_info_chain.get<vk::PresentInfoKHR>());
-    } catch (const vk::OutOfDateKHRError &e) {
-        //- no need to recreate, recreation will happen in acquireNextImage, keep present_result as vk::Result::eSuccess
-    } catch (const vk::SystemError &e) {
-        present_result = static_cast<vk::Result>(e.code().value());
-    }
+    vk::Result present_result = this->queuePresent();
     //- 6. recycle resources
     m_pending_resources_queue.emplace(std::exchange(m_present_resources, {}));
     this->tryRecyclePendingResources();
@@ -189,6 +196,47 @@ std::expected<vk::SemaphoreSubmitInfo, std::error_code> Swapchain::present(
     return this->_present(src_offsets, src_image, std::move(image_lease), wait_info, src_subresource_layers);
 }
 
+std::expected<SwapchainFrame, std::error_code> Swapchain::acquireFrame() noexcept
+{
+    if (m_resize_has_priority.load(std::memory_order_acquire)) { return std::unexpected(errc::present_skipped_for_resize); }
+    std::lock_guard lock(m_present_mutex);
+    if (m_is_frame_acquired) { return std::unexpected(errc::swapchain_frame_already_acquired); } //- would overwrite the outstanding frame's resources
+    if (auto snapshot = m_desired_params_snapshot.loadIfChanged()) {
+        if (auto ec = this->recreate(*snapshot)) { return std::unexpected(ec); }
+    }
+    this->limitFrameLatency();
+    if (auto ec = this->acquireNextImage()) { return std::unexpected(ec); }
+    if (auto ec = this->acquirePresentResources()) { return std::unexpected(ec); }
+    SwapchainFrame frame;
+    frame.m_image_p = &m_wrapped_images[m_image_index];
+    frame.m_image_index = m_image_index;
+    frame.m_generation = m_generation;
+    frame.m_image_available = m_present_resources.m_target_available.get();
+    frame.m_render_finished = m_present_resources.m_present_ready.get();
+    m_is_frame_acquired = true;
+    return frame;
+}
+
+std::error_code Swapchain::presentFrame(const SwapchainFrame & frame, ResourceLease lease) noexcept
+{
+    std::lock_guard lock(m_present_mutex);
+    if (not m_is_frame_acquired or frame.m_render_finished != m_present_resources.m_present_ready.get()) {
+        return std::make_error_code(std::errc::invalid_argument); //- not the outstanding frame, which stays presentable
+    }
+    if (lease) { m_present_resources.m_leases.emplace_back(std::move(lease)); }
+    if (frame.m_generation != m_generation) {
+        this->releaseAcquiredFrame();
+        return errc::swapchain_frame_out_of_date;
+    }
+    m_is_frame_acquired = false;
+    //- the caller's submission waits on image_available and signals render_finished, presentation waits on the latter only
+    vk::Result present_result = this->queuePresent();
+    m_pending_resources_queue.emplace(std::exchange(m_present_resources, {}));
+    this->tryRecyclePendingResources();
+    if (present_result == vk::Result::eSuccess or present_result == vk::Result::eSuboptimalKHR) { return {}; }
+    return present_result;
+}
+
 std::error_code Swapchain::resizeToFit() noexcept
 {
     struct AtomicSwitchFlagGuard 
@@ -276,7 +324,12 @@ std::error_code Swapchain::recreate(const DesiredParams & desired_params) noexce
     //- add old swapchain to current present resources
     m_present_resources.m_leases.emplace_back(make_resource_ptr<vk::UniqueSwapchainKHR>(std::move(m_swapchain)).lease());
     m_swapchain = std::move(new_swapchain);
-    m_swapchain_images = std::move(swapchain_images);   
+    m_swapchain_images = std::move(swapchain_images);
+    ImageDescription image_desc {vk::ImageType::e2D, m_surface_format.format, vk::SampleCountFlagBits::e1, swapchain_info.imageUsage, {m_width, m_height, 1u}};
+    m_wrapped_images.resize(m_swapchain_images.size());
+    for (size_t i = 0; i < m_swapchain_images.size(); ++i) { (void)m_wrapped_images[i].wrap(m_device, m_swapchain_images[i], image_desc); }
+    ++m_generation;
+    m_present_id = 0u; //- present ids are per swapchain
     return {};
 }
 
@@ -304,6 +357,64 @@ std::error_code Swapchain::acquireNextImage() noexcept
     return {};
 }
 
+std::error_code Swapchain::acquirePresentResources() noexcept
+{
+    auto expected_fence = this->acquireFence();
+    if (not expected_fence) { return expected_fence.error(); }
+    auto expected_present_ready_semaphore = this->acquireSemaphore();
+    if (not expected_present_ready_semaphore) {
+        m_fence_pool.emplace(std::move(expected_fence.value()));
+        return expected_present_ready_semaphore.error();
+    }
+    m_present_resources.m_present_fence = std::move(expected_fence.value());
+    m_present_resources.m_present_ready = std::move(expected_present_ready_semaphore.value());
+    return {};
+}
+
+vk::Result Swapchain::queuePresent() noexcept
+{
+    vk::StructureChain<vk::PresentInfoKHR, vk::SwapchainPresentFenceInfoKHR, vk::PresentIdKHR> present_info_chain;
+    uint64_t present_id = ++m_present_id;
+    present_info_chain.get<vk::SwapchainPresentFenceInfoKHR>().setFences(m_present_resources.m_present_fence.get());
+    present_info_chain.get<vk::PresentIdKHR>().setPresentIds(present_id);
+    if (not this->isPresentWaitActive()) { present_info_chain.unlink<vk::PresentIdKHR>(); }
+    present_info_chain.get<vk::PresentInfoKHR>()
+        .setWaitSemaphores(m_present_resources.m_present_ready.get())
+        .setSwapchains(m_swapchain.get())
+        .setPImageIndices(&m_image_index);
+    vk::Result present_result = vk::Result::eSuccess;
+    try {
+        QueueAccess queue_access {m_logical_present_queue};
+        present_result = queue_access->presentKHR(present_info_chain.get<vk::PresentInfoKHR>());
+    } catch (const vk::OutOfDateKHRError &e) {
+        //- no need to recreate, recreation will happen in acquireNextImage, keep present_result as vk::Result::eSuccess
+    } catch (const vk::SystemError &e) {
+        present_result = static_cast<vk::Result>(e.code().value());
+    }
+    return present_result;
+}
+
+void Swapchain::limitFrameLatency() noexcept
+{
+    constexpr uint64_t k_latency_wait_timeout = 1'000'000'000ull; //- 1s, a stalled present must not hang the caller forever
+    if (m_max_frame_latency == 0u) { return; }
+    if (this->isPresentWaitActive()) {
+        if (m_present_id <= m_max_frame_latency) { return; }
+        try {
+            (void)m_device.waitForPresentKHR(m_swapchain.get(), m_present_id - m_max_frame_latency, k_latency_wait_timeout);
+        } catch (const vk::SystemError &) {
+            //- out of date or surface loss resurfaces in acquireNextImage
+        }
+        return;
+    }
+    //- fallback: the present fences of swapchain_maintenance1 signal once an earlier present released its resources
+    while (m_pending_resources_queue.size() >= m_max_frame_latency) {
+        vk::Fence present_fence = m_pending_resources_queue.front().m_present_fence.get();
+        if (m_device.waitForFences(present_fence, VK_TRUE, k_latency_wait_timeout) != vk::Result::eSuccess) { break; }
+        this->tryRecyclePendingResources();
+    }
+}
+
 void Swapchain::recyclePresentResources(PresentResources & present_resources) noexcept
 {
     present_resources.m_leases.clear();
@@ -323,6 +434,22 @@ void Swapchain::recyclePresentResources(PresentResources & present_resources) no
     }
 }
 
+void Swapchain::releaseAcquiredFrame() noexcept
+{
+    //- the caller's submission may still wait on or signal the frame's semaphores and either may be left signaled,
+    //- so they are destroyed once the device drains instead of going back to the pool;
+    //- the image was acquired from the retired swapchain, which is released with the leases
+    try {
+        m_device.waitIdle();
+    } catch (const vk::SystemError &) {
+        //- device loss resurfaces on the next acquire
+    }
+    m_present_resources.m_target_available.reset();
+    m_present_resources.m_present_ready.reset();
+    this->recyclePresentResources(m_present_resources);
+    m_is_frame_acquired = false;
+}
+
 void Swapchain::tryRecyclePendingResources() noexcept
 {
     while (not m_pending_resources_queue.empty()) {
@@ -401,4 +528,15 @@ auto Swapchain::setDesiredPresentMode(const vk::PresentModeKHR &present_mode) no
     return *this;
 }
 
+auto Swapchain::enablePresentWait(const DeviceExtensionManifest & device_ext_manifest) noexcept -> Self &
+{
+    //- required extensions and features are exactly what the device was created with, physical device support alone is not enough
+    m_is_present_wait_enabled = stdr::all_of(k_present_wait_extensions, [&device_ext_manifest](const char * extension_name) {
+            return device_ext_manifest.isExtensionRequired(extension_name);
+        }) and stdr::all_of(k_present_wait_features, [&device_ext_manifest](const auto & feature_bit) {
+            return device_ext_manifest.isFeatureRequired(feature_bit);
+        });
+    return *this;
+}
+
 } // namespace lcf::vkc::wsi
\ No newline at end of file
@@ -28,6 +28,16 @@ void register_surface(InstanceExtensionManifest & manifest) noexcept
     manifest.addRequiredExtensions(k_extensions);
 }
 
+void register_headless_surface(InstanceExtensionManifest & manifest) noexcept
+{
+    static constexpr std::array k_extensions
+    {
+        vk::KHRSurfaceExtensionName,
+        vk::EXTHeadlessSurfaceExtensionName,
+    };
+    manifest.addRequiredExtensions(k_extensions);
+}
+
 } // namespace lcf::vkc::entry
 
 namespace {
@@ -122,6 +132,15 @@ vk::UniqueSurfaceKHR create_surface(vk::Instance instance, const WindowHandle &
 
 } // namespace metal
 
+namespace headless {
+
+vk::UniqueSurfaceKHR create_surface(vk::Instance instance, const WindowHandle & handle, const vk::AllocationCallbacks * allocator)
+{
+    return instance.createHeadlessSurfaceEXTUnique(vk::HeadlessSurfaceCreateInfoEXT {}, allocator);
+}
+
+} // namespace headless
+
 
 std::expected<vk::UniqueSurfaceKHR, std::error_code> create_surface(vk::Instance instance, const WindowHandle & window_handle, const vk::AllocationCallbacks * allocator) noexcept
 {
@@ -145,6 +164,7 @@ vk::UniqueSurfaceKHR create_surface_maythrow(vk::Instance instance, const Window
         if constexpr (std::same_as<Handle, xlib::WindowHandle>) { return xlib::create_surface(instance, handle, allocator); }
         if constexpr (std::same_as<Handle, wayland::WindowHandle>) { return wayland::create_surface(instance, handle, allocator); }
         if constexpr (std::same_as<Handle, metal::WindowHandle>) { return metal::create_surface(instance, handle, allocator); }
+        if constexpr (std::same_as<Handle, headless::WindowHandle>) { return headless::create_surface(instance, handle, allocator); }
         return vk::UniqueSurfaceKHR{};
     }, window_handle);
 }
@@ -1,6 +1,7 @@
 #include "vk_core/command/CommandBufferAllocator.h"
 #include "vk_core/command/info_structs.h"
 #include "vk_core/command/CommandBufferProxy.h"
+#include <algorithm>
 
 namespace lcf::vkc {
 
@@ -22,8 +23,28 @@ std::expected<std::vector<vk::CommandBuffer>, std::error_code> acquire_pool(
     return pool_map.emplace(key, std::move(pool)).first->second.allocate(count);
 }
 
+//- flags every shard created by this thread as exited when the thread ends, the shards outlive it until recycle drops them
+struct ThreadExitGuard
+{
+    ~ThreadExitGuard() noexcept
+    {
+        for (auto & flag_wp : m_exit_flags) {
+            if (auto flag_sp = flag_wp.lock()) { flag_sp->store(true, std::memory_order_release); }
+        }
+    }
+    std::vector<std::weak_ptr<std::atomic_bool>> m_exit_flags;
+};
+
+thread_local ThreadExitGuard t_thread_exit_guard;
+
 } // namespace
 
+bool CommandBufferAllocator::Shard::isIdle() const noexcept
+{
+    return std::ranges::all_of(m_resetable_pool_map, [](const auto & entry) { return entry.second.isIdle(); })
+        and std::ranges::all_of(m_rotating_pool_map, [](const auto & entry) { return entry.second.isIdle(); });
+}
+
 std::error_code CommandBufferAllocator::create(vk::Device device, uint32_t family_index, ValidationData validation_data) noexcept
 {
     m_device = device;
@@ -36,31 +57,80 @@ std::expected<CommandBufferBatch, std::error_code> CommandBufferAllocator::alloc
 {
     CommandBufferPoolKey key {info};
     uint32_t count = info.getCount();
+    auto thread_id = std::this_thread::get_id();
+    auto shard_sp = this->acquireShard(thread_id);
+    if (not shard_sp) { return std::unexpected(std::make_error_code(std::errc::not_enough_memory)); }
+    std::lock_guard lock {shard_sp->m_mutex};
     auto expected_cmd_buffers = (info.getPoolFlags() & CommandPoolFlagBits::eResetCommandBuffer)
-        ? acquire_pool(m_resetable_pool_map, m_device, m_family_index, key, count)
-        : acquire_pool(m_rotating_pool_map, m_device, m_family_index, key, count);
+        ? acquire_pool(shard_sp->m_resetable_pool_map, m_device, m_family_index, key, count)
+        : acquire_pool(shard_sp->m_rotating_pool_map, m_device, m_family_index, key, count);
     if (not expected_cmd_buffers) { return std::unexpected(expected_cmd_buffers.error()); }
-    return CommandBufferBatch {std::move(expected_cmd_buffers.value()), key, m_validation_data};
+    return CommandBufferBatch {std::move(expected_cmd_buffers.value()), key, m_validation_data, thread_id};
 }
 
 void CommandBufferAllocator::retire(uint64_t timestamp, CommandBufferBatch && batch) noexcept
 {
     if (batch.m_validation_data != m_validation_data) { return; }
+    for (auto & secondary_batch : batch.m_secondary_batches) { this->retire(timestamp, std::move(secondary_batch)); }
+    auto shard_sp = this->findShard(batch.m_shard_id);
+    if (not shard_sp) { return; }
+    std::lock_guard lock {shard_sp->m_mutex};
     if (batch.m_pool_key.m_pool_flags & CommandPoolFlagBits::eResetCommandBuffer) {
-        auto it = m_resetable_pool_map.find(batch.m_pool_key);
-        if (it == m_resetable_pool_map.end()) { return; }
+        auto it = shard_sp->m_resetable_pool_map.find(batch.m_pool_key);
+        if (it == shard_sp->m_resetable_pool_map.end()) { return; }
         it->second.retire(timestamp, std::move(batch.m_cmd_buffers));
     } else {
-        auto it = m_rotating_pool_map.find(batch.m_pool_key);
-        if (it == m_rotating_pool_map.end()) { return; }
+        auto it = shard_sp->m_rotating_pool_map.find(batch.m_pool_key);
+        if (it == shard_sp->m_rotating_pool_map.end()) { return; }
         it->second.retire(timestamp, std::move(batch.m_cmd_buffers));
     }
 }
 
 void CommandBufferAllocator::recycle(uint64_t completed_timestamp) noexcept
 {
-    for (auto & [_, pool] : m_resetable_pool_map) { pool.recycle(completed_timestamp); }
-    for (auto & [_, pool] : m_rotating_pool_map) { pool.recycle(completed_timestamp); }
+    bool has_releasable_shard = false;
+    {
+        std::shared_lock map_lock {m_shard_map_mutex};
+        for (auto & [_, shard_sp] : m_shard_map) {
+            std::lock_guard lock {shard_sp->m_mutex};
+            for (auto & [_, pool] : shard_sp->m_resetable_pool_map) { pool.recycle(completed_timestamp); }
+            for (auto & [_, pool] : shard_sp->m_rotating_pool_map) { pool.recycle(completed_timestamp); }
+            has_releasable_shard |= shard_sp->m_is_thread_exited.load(std::memory_order_acquire) and shard_sp->isIdle();
+        }
+    }
+    if (not has_releasable_shard) { return; }
+    //- the flag and idleness are checked again under the exclusive lock, acquireShard clears the flag under it when a new thread reuses the id
+    std::unique_lock map_lock {m_shard_map_mutex};
+    std::erase_if(m_shard_map, [](const auto & entry) {
+        const auto & shard_sp = entry.second;
+        std::lock_guard lock {shard_sp->m_mutex};
+        return shard_sp->m_is_thread_exited.load(std::memory_order_acquire) and shard_sp->isIdle();
+    });
+}
+
+auto CommandBufferAllocator::acquireShard(std::thread::id thread_id) noexcept -> ShardPointer
+{
+    auto shard_sp = this->findShard(thread_id);
+    if (shard_sp and not shard_sp->m_is_thread_exited.load(std::memory_order_acquire)) { return shard_sp; }
+    std::unique_lock lock {m_shard_map_mutex};
+    try {
+        auto & mapped_shard_sp = m_shard_map[thread_id];
+        if (not mapped_shard_sp) { mapped_shard_sp = std::make_shared<Shard>(); }
+        //- a fresh shard, or one left by an exited thread whose id the calling thread now reuses
+        mapped_shard_sp->m_is_thread_exited.store(false, std::memory_order_release);
+        std::erase_if(t_thread_exit_guard.m_exit_flags, [](const auto & flag_wp) { return flag_wp.expired(); });
+        t_thread_exit_guard.m_exit_flags.emplace_back(std::shared_ptr<std::atomic_bool>(mapped_shard_sp, &mapped_shard_sp->m_is_thread_exited));
+        return mapped_shard_sp;
+    } catch (const std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+auto CommandBufferAllocator::findShard(std::thread::id thread_id) const noexcept -> ShardPointer
+{
+    std::shared_lock lock {m_shard_map_mutex};
+    auto it = m_shard_map.find(thread_id);
+    return it == m_shard_map.end() ? nullptr : it->second;
 }
 
 } // namespace lcf::vkc
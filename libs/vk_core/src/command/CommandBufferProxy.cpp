@@ -0,0 +1,66 @@
+#include "vk_core/command/CommandBufferProxy.h"
+#include <array>
+#include <algorithm>
+
+namespace lcf::vkc {
+
+auto CommandBufferProxy::bindShadersIfChanged(
+    std::span<const vk::ShaderStageFlagBits> stages,
+    std::span<const vk::ShaderEXT> shaders) noexcept -> Self &
+{
+    static constexpr uint32_t k_stage_batch_size = 16u;
+    std::array<vk::ShaderStageFlagBits, k_stage_batch_size> changed_stages;
+    std::array<vk::ShaderEXT, k_stage_batch_size> changed_shaders;
+    uint32_t changed_count = 0u;
+    auto flush = [&] {
+        if (changed_count == 0u) { return; }
+        Base::bindShadersEXT(
+            vk::ArrayProxy<const vk::ShaderStageFlagBits> {changed_count, changed_stages.data()},
+            vk::ArrayProxy<const vk::ShaderEXT> {changed_count, changed_shaders.data()});
+        changed_count = 0u;
+    };
+    const size_t count = std::min(stages.size(), shaders.size());
+    for (size_t i = 0; i < count; ++i) {
+        if (not m_state_cache.updateShader(stages[i], shaders[i])) { continue; }
+        if (changed_count == k_stage_batch_size) { flush(); }
+        changed_stages[changed_count] = stages[i];
+        changed_shaders[changed_count] = shaders[i];
+        ++changed_count;
+    }
+    flush();
+    return *this;
+}
+
+auto CommandBufferProxy::bindDescriptorSetsIfChanged(
+    vk::PipelineBindPoint bind_point,
+    vk::PipelineLayout layout,
+    uint32_t first_set,
+    std::span<const vk::DescriptorSet> sets,
+    std::span<const uint32_t> dynamic_offsets) noexcept -> Self &
+{
+    if (sets.empty()) { return *this; }
+    if (m_state_cache.updateDescriptorSets(bind_point, layout, first_set, sets, dynamic_offsets)) {
+        Base::bindDescriptorSets(
+            bind_point,
+            layout,
+            first_set,
+            vk::ArrayProxy<const vk::DescriptorSet> {static_cast<uint32_t>(sets.size()), sets.data()},
+            vk::ArrayProxy<const uint32_t> {static_cast<uint32_t>(dynamic_offsets.size()), dynamic_offsets.data()});
+    }
+    return *this;
+}
+
+auto CommandBufferProxy::pushConstantsIfChanged(
+    vk::PipelineLayout layout,
+    vk::ShaderStageFlags stages,
+    uint32_t offset,
+    std::span<const std::byte> data) noexcept -> Self &
+{
+    if (data.empty()) { return *this; }
+    if (m_state_cache.updatePushConstants(layout, stages, offset, data)) {
+        Base::pushConstants(layout, stages, offset, static_cast<uint32_t>(data.size()), data.data());
+    }
+    return *this;
+}
+
+} // namespace lcf::vkc
@@ -0,0 +1,97 @@
+#include "vk_core/command/details/CommandStateCache.h"
+#include <algorithm>
+#include <ranges>
+
+namespace stdr = std::ranges;
+
+namespace lcf::vkc::details {
+
+void CommandStateCache::reset() noexcept
+{
+    this->invalidatePipelineState();
+    m_descriptor_sets.clear();
+    m_push_constant_layout = nullptr;
+    m_push_constants.clear();
+}
+
+void CommandStateCache::invalidatePipelineState() noexcept
+{
+    m_shaders.clear();
+    m_dynamic_states.clear();
+}
+
+bool CommandStateCache::updateShader(vk::ShaderStageFlagBits stage, vk::ShaderEXT shader) noexcept
+{
+    auto [it, inserted] = m_shaders.try_emplace(stage, shader);
+    if (inserted) { return true; }
+    if (it->second == shader) { return false; }
+    it->second = shader;
+    return true;
+}
+
+bool CommandStateCache::updateDescriptorSets(
+    vk::PipelineBindPoint bind_point,
+    vk::PipelineLayout layout,
+    uint32_t first_set,
+    std::span<const vk::DescriptorSet> sets,
+    std::span<const uint32_t> dynamic_offsets) noexcept
+{
+    auto & bound = m_descriptor_sets[bind_point];
+    //- a different layout may disturb any previously bound set, so nothing else is trusted afterwards
+    bool changed = bound.m_layout != layout or not dynamic_offsets.empty();
+    if (bound.m_layout != layout) {
+        bound.m_layout = layout;
+        bound.m_sets.clear();
+    }
+    const size_t end_set = first_set + sets.size();
+    if (bound.m_sets.size() < end_set) {
+        bound.m_sets.resize(end_set);
+        changed = true;
+    }
+    for (size_t i = 0; i < sets.size(); ++i) {
+        auto & slot = bound.m_sets[first_set + i];
+        changed |= slot != sets[i] or not slot;
+        slot = sets[i];
+    }
+    return changed;
+}
+
+bool CommandStateCache::updatePushConstants(
+    vk::PipelineLayout layout,
+    vk::ShaderStageFlags stages,
+    uint32_t offset,
+    std::span<const std::byte> data) noexcept
+{
+    if (m_push_constant_layout != layout) {
+        m_push_constant_layout = layout;
+        m_push_constants.clear();
+    }
+    const auto stage_mask = static_cast<VkShaderStageFlags>(stages);
+    const size_t end = offset + data.size();
+    auto & shadow = m_push_constants[stage_mask];
+    if (shadow.m_bytes.size() < end) {
+        shadow.m_bytes.resize(end);
+        shadow.m_known.resize(end, 0u);
+    }
+    auto bytes = std::span {shadow.m_bytes}.subspan(offset, data.size());
+    auto known = std::span {shadow.m_known}.subspan(offset, data.size());
+    if (stdr::all_of(known, [](uint8_t k) { return k != 0u; }) and stdr::equal(bytes, data)) { return false; }
+    stdr::copy(data, bytes.begin());
+    stdr::fill(known, uint8_t {1u});
+    for (auto && [other_mask, other_shadow] : m_push_constants) {
+        if (other_mask == stage_mask or (other_mask & stage_mask) == 0u) { continue; }
+        const size_t other_end = std::min(end, other_shadow.m_known.size());
+        for (size_t i = offset; i < other_end; ++i) { other_shadow.m_known[i] = 0u; }
+    }
+    return true;
+}
+
+bool CommandStateCache::updateDynamicStateBytes(uint64_t key) noexcept
+{
+    auto & bytes = m_dynamic_states[key];
+    if (stdr::equal(bytes, m_scratch)) { return false; }
+    bytes.assign(m_scratch.begin(), m_scratch.end());
+    return true;
+}
+
+} // namespace lcf::vkc::details
@@ -1,4 +1,5 @@
 #include "vk_core/command/details/command_pools.h"
+#include <algorithm>
 #include <ranges>
 
 namespace stdr = std::ranges;
@@ -52,22 +53,32 @@ auto ResetableCommandPool::allocate(uint32_t count) noexcept -> std::expected<Co
         m_reusable_buffers.recycle(std::move(cmd_buffers));
         return std::unexpected(e.code());
     }
+    m_allocated_count += remaining_count;
     return cmd_buffers;
 }
 
 void ResetableCommandPool::retire(uint64_t timestamp, CommandBufferList &&cmd_batch) noexcept
 {
+    if (not m_pending_entries.empty() and m_pending_entries.back().m_timestamp == timestamp) {
+        m_pending_entries.back().m_cmd_buffers.append_range(std::exchange(cmd_batch, {}));
+        return;
+    }
     m_pending_entries.emplace_back(timestamp, std::move(cmd_batch));
 }
 
 void ResetableCommandPool::recycle(uint64_t completed_timestamp) noexcept
 {
+    bool has_recycled = false;
     while (not m_pending_entries.empty()) {
         PendingEntry & entry = m_pending_entries.front();
         if (entry.m_timestamp > completed_timestamp) { break; }
-        for (vk::CommandBuffer buffer : entry.m_cmd_buffers) { buffer.reset({}); }
+        //- no per-buffer reset: the pool has eResetCommandBuffer, so vkBeginCommandBuffer resets implicitly
         m_reusable_buffers.recycle(std::move(entry.m_cmd_buffers));
         m_pending_entries.pop_front();
+        has_recycled = true;
+    }
+    if (has_recycled and m_reusable_buffers.size() == m_allocated_count) {
+        m_device.resetCommandPool(m_cmd_pool.get()); //- every buffer is idle, release their recordings in one call
     }
 }
 
@@ -89,34 +100,47 @@ auto RotatingCommandPool::allocate(uint32_t count) noexcept -> std::expected<Com
         if (auto ec = this->activateSlot()) { return std::unexpected(ec); }
     }
     CommandBufferList cmd_buffers =  m_active_slot.m_reusable_buffers.acquire(count);
-    if (static_cast<uint32_t>(cmd_buffers.size()) == count) { return cmd_buffers; }
-    uint32_t remaining_count = count - static_cast<uint32_t>(cmd_buffers.size());
-    try {
-        auto allocated = m_device.allocateCommandBuffers({m_active_slot.m_cmd_pool.get(), m_cmd_level, remaining_count});
-        cmd_buffers.append_range(std::exchange(allocated, {}));
-    } catch (const vk::SystemError & e) {
-        m_active_slot.m_reusable_buffers.recycle(std::move(cmd_buffers));
-        return std::unexpected(e.code());
+    if (static_cast<uint32_t>(cmd_buffers.size()) < count) {
+        uint32_t remaining_count = count - static_cast<uint32_t>(cmd_buffers.size());
+        try {
+            auto allocated = m_device.allocateCommandBuffers({m_active_slot.m_cmd_pool.get(), m_cmd_level, remaining_count});
+            cmd_buffers.append_range(std::exchange(allocated, {}));
+        } catch (const vk::SystemError & e) {
+            m_active_slot.m_reusable_buffers.recycle(std::move(cmd_buffers));
+            return std::unexpected(e.code());
+        }
     }
+    m_active_slot.m_outstanding_buffers.append_range(cmd_buffers);
     return cmd_buffers;
 }
 
 void RotatingCommandPool::retire(uint64_t timestamp, CommandBufferList &&cmd_batch) noexcept
 {
-    m_pending_timestamp = timestamp;
-    m_pending_cmds.recycle(std::move(cmd_batch));
+    if (cmd_batch.empty()) { return; }
+    //- a batch comes from a single allocate call, so all of its buffers live in the same slot
+    PoolSlot * slot_p = this->findOwningSlot(cmd_batch.front());
+    if (not slot_p) { return; }
+    std::erase_if(slot_p->m_outstanding_buffers, [&cmd_batch](vk::CommandBuffer cmd_buffer) {
+        return stdr::contains(cmd_batch, cmd_buffer);
+    });
+    slot_p->m_timestamp = std::max(slot_p->m_timestamp, timestamp);
+    slot_p->m_retired_buffers.recycle(std::move(cmd_batch));
 }
 
 void RotatingCommandPool::recycle(uint64_t completed_timestamp) noexcept
 {
-    if (not m_sealed_slot.isValid()) {
-        m_sealed_slot = std::move(m_active_slot);
-        m_sealed_slot.m_timestamp = m_pending_timestamp;
-        m_sealed_slot.m_reusable_buffers.recycle(std::move(m_pending_cmds));
+    //- every recycle is a frame boundary: the active slot is sealed even with buffers still recording,
+    //- those are retired into the sealed slot later and hold back its reset until then
+    if (m_active_slot.isValid() and not m_active_slot.m_retired_buffers.empty()) {
+        m_in_flight_slots.emplace_back(std::exchange(m_active_slot, {}));
     }
-    if (m_sealed_slot.isValid() and completed_timestamp >= m_sealed_slot.m_timestamp) {
-        m_device.resetCommandPool(m_sealed_slot.m_cmd_pool.get());
-        m_reusable_slots.emplace_back(std::move(m_sealed_slot));
+    for (auto it = m_in_flight_slots.begin(); it != m_in_flight_slots.end();) {
+        if (not it->isResettable(completed_timestamp)) { ++it; continue; }
+        m_device.resetCommandPool(it->m_cmd_pool.get());
+        it->m_reusable_buffers.recycle(std::move(it->m_retired_buffers));
+        it->m_timestamp = 0;
+        m_reusable_slots.emplace_back(std::move(*it));
+        it = m_in_flight_slots.erase(it);
     }
 }
 
@@ -135,5 +159,14 @@ std::error_code RotatingCommandPool::activateSlot() noexcept
     return {};
 }
 
+auto RotatingCommandPool::findOwningSlot(vk::CommandBuffer cmd_buffer) noexcept -> PoolSlot *
+{
+    if (stdr::contains(m_active_slot.m_outstanding_buffers, cmd_buffer)) { return &m_active_slot; }
+    for (auto & slot : m_in_flight_slots | stdv::reverse) {
+        if (stdr::contains(slot.m_outstanding_buffers, cmd_buffer)) { return &slot; }
+    }
+    return nullptr;
+}
+
 } // namespace lcf::vkc::details
 
@@ -42,10 +42,28 @@ public:
                 return "a required device feature is not supported";
             case errc::present_skipped_for_resize:
                 return "present skipped: yielded to a pending resize";
+            case errc::swapchain_frame_already_acquired:
+                return "a swapchain frame is already acquired and must be presented first";
+            case errc::swapchain_frame_out_of_date:
+                return "swapchain was recreated after the frame was acquired, the frame was released without presenting";
             case errc::command_buffer_batch_exhausted:
                 return "command buffer batch has no more proxies to acquire";
             case errc::command_buffer_batch_queue_mismatch:
                 return "command buffer batch was not allocated by this queue";
+            case errc::command_buffer_batch_level_mismatch:
+                return "command buffer batch has the wrong command buffer level for this operation";
+            case errc::pipeline_compile_queue_full:
+                return "pipeline compiler has too many pending builds";
+            case errc::pipeline_compile_cancelled:
+                return "pipeline build was cancelled before it started";
+            case errc::transient_buffer_ring_exhausted:
+                return "transient buffer ring has no room left until older slices are reclaimed";
+            case errc::memory_budget_exceeded:
+                return "allocation would exceed the memory budget and nothing idle is left to evict";
+            case errc::render_graph_invalid_resource:
+                return "render graph pass refers to a resource that was not declared in this graph";
+            case errc::render_graph_not_compiled:
+                return "render graph must be compiled before it is executed";
             default:
                 return "unrecognized lcf::vkc error";
         }
@@ -0,0 +1,677 @@
+#include "vk_core/graph/RenderGraph.h"
+#include "vk_core/command/CommandBufferProxy.h"
+#include "vk_core/memory/MemoryAllocator.h"
+#include "vk_core/memory/info_structs.h"
+#include "vk_core/utils/format_utils.h"
+#include "vk_core/error.h"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ranges>
+
+namespace {
+
+using namespace lcf::vkc;
+
+constexpr uint32_t k_unused = std::numeric_limits<uint32_t>::max();
+
+constexpr vk::AccessFlags2 k_write_access_mask =
+    vk::AccessFlagBits2::eShaderWrite |
+    vk::AccessFlagBits2::eShaderStorageWrite |
+    vk::AccessFlagBits2::eColorAttachmentWrite |
+    vk::AccessFlagBits2::eDepthStencilAttachmentWrite |
+    vk::AccessFlagBits2::eTransferWrite |
+    vk::AccessFlagBits2::eHostWrite |
+    vk::AccessFlagBits2::eMemoryWrite |
+    vk::AccessFlagBits2::eAccelerationStructureWriteKHR;
+
+vk::ImageUsageFlags image_usage_of(vk::AccessFlags2 access) noexcept;
+
+vk::BufferUsageFlags buffer_usage_of(vk::AccessFlags2 access) noexcept;
+
+vk::ImageAspectFlags aspect_flags_of(vk::Format format) noexcept;
+
+vk::ImageViewType view_type_of(const ImageDescription & desc) noexcept;
+
+vk::ImageSubresourceRange full_range_of(const ImageDescription & desc) noexcept
+{
+    return {aspect_flags_of(desc.getFormat()), 0u, desc.getMipLevelCount(), 0u, desc.getArrayLayerCount()};
+}
+
+constexpr vk::DeviceSize align_up(vk::DeviceSize value, vk::DeviceSize alignment) noexcept
+{
+    return alignment == 0 ? value : (value + alignment - 1) / alignment * alignment;
+}
+
+//- what the barrier builder knows about a resource at a point in the schedule
+struct ResourceState
+{
+    bool m_touched = false;
+    vk::ImageLayout m_layout = vk::ImageLayout::eUndefined;
+    vk::PipelineStageFlags2 m_write_stages;  //- stages of the last write or layout transition
+    vk::AccessFlags2 m_write_access;         //- writes not yet made available
+    vk::PipelineStageFlags2 m_read_stages;   //- stages already synchronized with the last write
+    vk::AccessFlags2 m_read_access;          //- accesses the last write is already visible to
+};
+
+} // anonymous namespace
+
+namespace lcf::vkc {
+
+auto RenderGraphPassBuilder::read(ImageId id, const ResourceAccessInfo & access) noexcept -> Self &
+{
+    m_graph.addUse(m_pass_index, std::to_underlying(id), RenderGraph::ResourceKind::eImage, access, false);
+    return *this;
+}
+
+auto RenderGraphPassBuilder::write(ImageId id, const ResourceAccessInfo & access) noexcept -> Self &
+{
+    m_graph.addUse(m_pass_index, std::to_underlying(id), RenderGraph::ResourceKind::eImage, access, true);
+    return *this;
+}
+
+auto RenderGraphPassBuilder::read(BufferId id, vk::PipelineStageFlags2 stage_flags, vk::AccessFlags2 access_flags) noexcept -> Self &
+{
+    m_graph.addUse(m_pass_index, std::to_underlying(id), RenderGraph::ResourceKind::eBuffer, {stage_flags, access_flags}, false);
+    return *this;
+}
+
+auto RenderGraphPassBuilder::write(BufferId id, vk::PipelineStageFlags2 stage_flags, vk::AccessFlags2 access_flags) noexcept -> Self &
+{
+    m_graph.addUse(m_pass_index, std::to_underlying(id), RenderGraph::ResourceKind::eBuffer, {stage_flags, access_flags}, true);
+    return *this;
+}
+
+auto RenderGraphPassBuilder::setSideEffects() noexcept -> Self &
+{
+    m_graph.m_passes[m_pass_index].m_side_effects = true;
+    m_graph.m_compiled = false;
+    return *this;
+}
+
+auto RenderGraph::importImage(
+    const Image & image,
+    vk::ImageView view,
+    const ResourceAccessInfo & initial_access,
+    std::optional<ResourceAccessInfo> final_access_opt) noexcept -> ImageId
+{
+    m_compiled = false;
+    auto & resource = m_resources.emplace_back();
+    resource.m_kind = ResourceKind::eImage;
+    resource.m_imported = true;
+    resource.m_image_desc = image.getDescription();
+    resource.m_image_range = full_range_of(resource.m_image_desc);
+    resource.m_image = image.handle();
+    resource.m_image_view = view;
+    resource.m_initial_access = initial_access;
+    resource.m_final_access_opt = final_access_opt;
+    return static_cast<ImageId>(m_resources.size() - 1);
+}
+
+auto RenderGraph::importBuffer(
+    const Buffer & buffer,
+    vk::DeviceSize size,
+    const ResourceAccessInfo & initial_access,
+    std::optional<ResourceAccessInfo> final_access_opt) noexcept -> BufferId
+{
+    m_compiled = false;
+    auto & resource = m_resources.emplace_back();
+    resource.m_kind = ResourceKind::eBuffer;
+    resource.m_imported = true;
+    resource.m_buffer_size = size;
+    resource.m_buffer = buffer.handle();
+    resource.m_initial_access = initial_access;
+    resource.m_final_access_opt = final_access_opt;
+    return static_cast<BufferId>(m_resources.size() - 1);
+}
+
+auto RenderGraph::createImage(const ImageDescription & desc) noexcept -> ImageId
+{
+    m_compiled = false;
+    auto & resource = m_resources.emplace_back();
+    resource.m_kind = ResourceKind::eImage;
+    resource.m_image_desc = desc;
+    resource.m_image_range = full_range_of(desc);
+    return static_cast<ImageId>(m_resources.size() - 1);
+}
+
+auto RenderGraph::createBuffer(vk::DeviceSize size, vk::BufferUsageFlags usage) noexcept -> BufferId
+{
+    m_compiled = false;
+    auto & resource = m_resources.emplace_back();
+    resource.m_kind = ResourceKind::eBuffer;
+    resource.m_buffer_size = size;
+    resource.m_buffer_usage = usage;
+    return static_cast<BufferId>(m_resources.size() - 1);
+}
+
+RenderGraphPassBuilder RenderGraph::addPass(std::string_view name, ExecuteCallback execute) noexcept
+{
+    m_compiled = false;
+    auto & pass = m_passes.emplace_back();
+    pass.m_name = name;
+    pass.m_execute = std::move(execute);
+    return RenderGraphPassBuilder {*this, static_cast<uint32_t>(m_passes.size() - 1)};
+}
+
+void RenderGraph::setImportedImage(ImageId id, const Image & image, vk::ImageView view) noexcept
+{
+    auto & resource = m_resources[std::to_underlying(id)];
+    if (not resource.m_imported or resource.m_kind != ResourceKind::eImage) { return; }
+    resource.m_image = image.handle();
+    resource.m_image_view = view;
+}
+
+void RenderGraph::setImportedBuffer(BufferId id, const Buffer & buffer) noexcept
+{
+    auto & resource = m_resources[std::to_underlying(id)];
+    if (not resource.m_imported or resource.m_kind != ResourceKind::eBuffer) { return; }
+    resource.m_buffer = buffer.handle();
+}
+
+std::error_code RenderGraph::compile(const MemoryAllocator & allocator) noexcept
+{
+    if (m_declaration_error) { return m_declaration_error; }
+    m_compiled = false;
+    m_compiled_passes.clear();
+    m_image_barriers.clear();
+    m_image_barrier_resources.clear();
+    m_buffer_barriers.clear();
+    m_buffer_barrier_resources.clear();
+    auto schedule = this->schedulePasses(this->cullPasses());
+    AliasPredecessorTable alias_predecessors(m_resources.size());
+    if (auto error = this->allocateTransients(allocator, schedule, alias_predecessors)) { return error; }
+    this->buildBarriers(schedule, alias_predecessors);
+    m_compiled_passes = std::move(schedule);
+    m_compiled = true;
+    return {};
+}
+
+std::error_code RenderGraph::execute(CommandBufferProxy & cmd) noexcept
+{
+    if (not m_compiled) { return make_error_code(errc::render_graph_not_compiled); }
+    if (m_transients_rp) { cmd.pinLease(m_transients_rp.lease()); }
+    for (const auto & compiled_pass : m_compiled_passes) {
+        this->recordBarriers(cmd, compiled_pass.m_barriers);
+        auto & pass = m_passes[compiled_pass.m_pass_index];
+        if (pass.m_execute) { pass.m_execute(cmd, *this); }
+    }
+    this->recordBarriers(cmd, m_final_barriers);
+    return {};
+}
+
+void RenderGraph::reset() noexcept
+{
+    m_resources.clear();
+    m_passes.clear();
+    m_declaration_error.clear();
+    m_compiled = false;
+    m_compiled_passes.clear();
+    m_image_barriers.clear();
+    m_image_barrier_resources.clear();
+    m_buffer_barriers.clear();
+    m_buffer_barrier_resources.clear();
+    m_final_barriers = {};
+    m_transients_rp = ResourcePtr<TransientResources> {};
+    m_transient_resource_bytes = 0;
+    m_transient_memory_bytes = 0;
+}
+
+void RenderGraph::addUse(uint32_t pass_index, uint32_t resource_index, ResourceKind kind, const ResourceAccessInfo & access, bool write) noexcept
+{
+    m_compiled = false;
+    if (resource_index >= m_resources.size() or m_resources[resource_index].m_kind != kind) {
+        m_declaration_error = make_error_code(errc::render_graph_invalid_resource);
+        return;
+    }
+    auto & uses = m_passes[pass_index].m_uses;
+    auto it = std::ranges::find(uses, resource_index, &ResourceUse::m_resource_index);
+    if (it == uses.end()) {
+        uses.emplace_back(resource_index, access, write);
+        return;
+    }
+    //- one use per resource and pass, a pass touching it twice gets the union and a layout both accesses accept
+    vk::ImageLayout layout = it->m_access.getImageLayout();
+    if (layout != access.getImageLayout()) { layout = vk::ImageLayout::eGeneral; }
+    it->m_access = ResourceAccessInfo {
+        it->m_access.getStageFlags() | access.getStageFlags(),
+        it->m_access.getAccessFlags() | access.getAccessFlags(),
+        layout};
+    it->m_write = it->m_write or write;
+}
+
+std::vector<bool> RenderGraph::cullPasses() const noexcept
+{
+    std::vector<bool> resource_needed(m_resources.size());
+    for (uint32_t i = 0; i < m_resources.size(); ++i) { resource_needed[i] = m_resources[i].m_imported; }
+    std::vector<bool> pass_needed(m_passes.size());
+    //- walking backwards, a pass survives if it writes something a surviving pass or the outside world consumes
+    for (uint32_t pass_index = static_cast<uint32_t>(m_passes.size()); pass_index-- > 0; ) {
+        const auto & pass = m_passes[pass_index];
+        bool needed = pass.m_side_effects or std::ranges::any_of(pass.m_uses, [&](const ResourceUse & use) {
+            return use.m_write and resource_needed[use.m_resource_index];
+        });
+        if (not needed) { continue; }
+        pass_needed[pass_index] = true;
+        for (const auto & use : pass.m_uses) { resource_needed[use.m_resource_index] = true; }
+    }
+    return pass_needed;
+}
+
+auto RenderGraph::schedulePasses(const std::vector<bool> & pass_needed) const noexcept -> CompiledPassList
+{
+    const auto pass_count = static_cast<uint32_t>(m_passes.size());
+    //- hazards in declaration order become edges: read after write, write after read and write after write
+    std::vector<ResourceIndexList> successors(pass_count);
+    std::vector<uint32_t> last_writers(m_resources.size(), k_unused);
+    std::vector<ResourceIndexList> readers_since_write(m_resources.size());
+    for (uint32_t pass_index = 0; pass_index < pass_count; ++pass_index) {
+        if (not pass_needed[pass_index]) { continue; }
+        for (const auto & use : m_passes[pass_index].m_uses) {
+            const uint32_t resource_index = use.m_resource_index;
+            uint32_t & last_writer = last_writers[resource_index];
+            auto & readers = readers_since_write[resource_index];
+            if (last_writer != k_unused and last_writer != pass_index) { successors[last_writer].emplace_back(pass_index); }
+            if (not use.m_write) {
+                readers.emplace_back(pass_index);
+                continue;
+            }
+            for (uint32_t reader : readers) {
+                if (reader != pass_index) { successors[reader].emplace_back(pass_index); }
+            }
+            readers.clear();
+            last_writer = pass_index;
+        }
+    }
+    std::vector<uint32_t> in_degrees(pass_count);
+    for (auto & pass_successors : successors) {
+        std::ranges::sort(pass_successors);
+        auto [first, last] = std::ranges::unique(pass_successors);
+        pass_successors.erase(first, last);
+        for (uint32_t successor : pass_successors) { ++in_degrees[successor]; }
+    }
+    ResourceIndexList ready;
+    for (uint32_t pass_index = 0; pass_index < pass_count; ++pass_index) {
+        if (pass_needed[pass_index] and in_degrees[pass_index] == 0) { ready.emplace_back(pass_index); }
+    }
+    //- Kahn's algorithm; among ready passes prefer one that does not wait on the pass just scheduled,
+    //- which gives each barrier a pass worth of independent work to overlap with
+    CompiledPassList schedule;
+    while (not ready.empty()) {
+        auto pick_it = ready.begin();
+        if (not schedule.empty()) {
+            const auto & previous_successors = successors[schedule.back().m_pass_index];
+            auto independent_it = std::ranges::find_if(ready, [&](uint32_t pass_index) {
+                return not std::ranges::binary_search(previous_successors, pass_index);
+            });
+            if (independent_it != ready.end()) { pick_it = independent_it; }
+        }
+        const uint32_t pass_index = *pick_it;
+        ready.erase(pick_it);
+        schedule.emplace_back(pass_index, BarrierBatch {});
+        for (uint32_t successor : successors[pass_index]) {
+            if (--in_degrees[successor] != 0) { continue; }
+            ready.insert(std::ranges::upper_bound(ready, successor), successor);
+        }
+    }
+    return schedule;
+}
+
+std::error_code RenderGraph::allocateTransients(
+    const MemoryAllocator & allocator,
+    const CompiledPassList & schedule,
+    AliasPredecessorTable & alias_predecessors) noexcept
+{
+    struct Lifetime
+    {
+        uint32_t m_first = k_unused;
+        uint32_t m_last = 0;
+        vk::AccessFlags2 m_access;
+    };
+    std::vector<Lifetime> lifetimes(m_resources.size());
+    for (uint32_t position = 0; position < schedule.size(); ++position) {
+        for (const auto & use : m_passes[schedule[position].m_pass_index].m_uses) {
+            auto & lifetime = lifetimes[use.m_resource_index];
+            lifetime.m_first = std::min(lifetime.m_first, position);
+            lifetime.m_last = position;
+            lifetime.m_access |= use.m_access.getAccessFlags();
+        }
+    }
+    struct Candidate
+    {
+        uint32_t m_resource_index;
+        vk::ImageCreateInfo m_image_info;
+        vk::BufferCreateInfo m_buffer_info;
+        vk::MemoryRequirements m_requirements;
+    };
+    std::vector<Candidate> candidates;
+    const vk::Device & device = allocator.getDevice();
+    for (uint32_t resource_index = 0; resource_index < m_resources.size(); ++resource_index) {
+        auto & resource = m_resources[resource_index];
+        const auto & lifetime = lifetimes[resource_index];
+        if (resource.m_imported or lifetime.m_first == k_unused) { continue; }
+        auto & candidate = candidates.emplace_back();
+        candidate.m_resource_index = resource_index;
+        if (resource.m_kind == ResourceKind::eImage) {
+            const auto & desc = resource.m_image_desc;
+            candidate.m_image_info.setImageType(desc.getType())
+                .setFormat(desc.getFormat())
+                .setExtent(desc.getExtent())
+                .setMipLevels(desc.getMipLevelCount())
+                .setArrayLayers(desc.getArrayLayerCount())
+                .setSamples(desc.getSampleCount())
+                .setTiling(vk::ImageTiling::eOptimal)
+                .setUsage(desc.getUsageFlags() | image_usage_of(lifetime.m_access))
+                .setSharingMode(vk::SharingMode::eExclusive)
+                .setInitialLayout(vk::ImageLayout::eUndefined);
+            candidate.m_requirements = device.getImageMemoryRequirements(
+                vk::DeviceImageMemoryRequirements {&candidate.m_image_info}).memoryRequirements;
+        } else {
+            candidate.m_buffer_info.setSize(resource.m_buffer_size)
+                .setUsage(resource.m_buffer_usage | buffer_usage_of(lifetime.m_access))
+                .setSharingMode(vk::SharingMode::eExclusive);
+            candidate.m_requirements = device.getBufferMemoryRequirements(
+                vk::DeviceBufferMemoryRequirements {&candidate.m_buffer_info}).memoryRequirements;
+        }
+    }
+    //- greedy placement, largest first: a resource takes the lowest offset in the first compatible heap that no
+    //- lifetime-overlapping resource occupies; images and buffers get separate heaps so buffer-image granularity never applies
+    struct Placement
+    {
+        uint32_t m_candidate_index;
+        vk::DeviceSize m_offset;
+        vk::DeviceSize m_size;
+    };
+    struct Heap
+    {
+        ResourceKind m_kind;
+        uint32_t m_memory_type_bits;
+        vk::DeviceSize m_alignment;
+        vk::DeviceSize m_size;
+        std::vector<Placement> m_placements;
+    };
+    std::vector<uint32_t> placement_order(candidates.size());
+    std::ranges::iota(placement_order, 0u);
+    std::ranges::stable_sort(placement_order, std::ranges::greater {}, [&](uint32_t i) { return candidates[i].m_requirements.size; });
+    auto overlaps_in_time = [&](uint32_t lhs, uint32_t rhs) {
+        const auto & a = lifetimes[candidates[lhs].m_resource_index];
+        const auto & b = lifetimes[candidates[rhs].m_resource_index];
+        return a.m_first <= b.m_last and b.m_first <= a.m_last;
+    };
+    std::vector<Heap> heaps;
+    std::vector<std::pair<uint32_t, vk::DeviceSize>> heap_offsets(candidates.size());
+    std::vector<Placement> occupied;
+    for (uint32_t candidate_index : placement_order) {
+        const auto & candidate = candidates[candidate_index];
+        const auto & requirements = candidate.m_requirements;
+        const ResourceKind kind = m_resources[candidate.m_resource_index].m_kind;
+        bool placed = false;
+        for (uint32_t heap_index = 0; heap_index < heaps.size() and not placed; ++heap_index) {
+            auto & heap = heaps[heap_index];
+            if (heap.m_kind != kind or not (heap.m_memory_type_bits & requirements.memoryTypeBits)) { continue; }
+            occupied.clear();
+            for (const auto & placement : heap.m_placements) {
+                if (overlaps_in_time(placement.m_candidate_index, candidate_index)) { occupied.emplace_back(placement); }
+            }
+            std::ranges::sort(occupied, {}, &Placement::m_offset);
+            vk::DeviceSize offset = 0;
+            for (const auto & placement : occupied) {
+                if (align_up(offset, requirements.alignment) + requirements.size <= placement.m_offset) { break; }
+                offset = std::max(offset, placement.m_offset + placement.m_size);
+            }
+            offset = align_up(offset, requirements.alignment);
+            if (offset + requirements.size > heap.m_size) { continue; }
+            heap.m_memory_type_bits &= requirements.memoryTypeBits;
+            heap.m_alignment = std::max(heap.m_alignment, requirements.alignment);
+            heap.m_placements.emplace_back(candidate_index, offset, requirements.size);
+            heap_offsets[candidate_index] = {heap_index, offset};
+            placed = true;
+        }
+        if (placed) { continue; }
+        heap_offsets[candidate_index] = {static_cast<uint32_t>(heaps.size()), 0};
+        heaps.emplace_back(kind, requirements.memoryTypeBits, requirements.alignment, requirements.size,
+            std::vector<Placement> {{candidate_index, 0, requirements.size}});
+    }
+    //- whoever used the memory before a transient has to finish before its first use overwrites it
+    for (const auto & heap : heaps) {
+        for (const auto & later : heap.m_placements) {
+            for (const auto & earlier : heap.m_placements) {
+                const bool overlaps_in_memory = earlier.m_offset < later.m_offset + later.m_size and later.m_offset < earlier.m_offset + earlier.m_size;
+                const uint32_t earlier_resource = candidates[earlier.m_candidate_index].m_resource_index;
+                const uint32_t later_resource = candidates[later.m_candidate_index].m_resource_index;
+                if (not overlaps_in_memory or lifetimes[earlier_resource].m_last >= lifetimes[later_resource].m_first) { continue; }
+                alias_predecessors[later_resource].emplace_back(earlier_resource);
+            }
+        }
+    }
+    auto transients_p = std::make_unique<TransientResources>();
+    m_transient_resource_bytes = 0;
+    m_transient_memory_bytes = 0;
+    MemoryAllocationInfo alloc_info;
+    alloc_info.setAccess(MemoryAccess::eDeviceLocal);
+    for (const auto & heap : heaps) {
+        vk::MemoryRequirements requirements {heap.m_size, heap.m_alignment, heap.m_memory_type_bits};
+        auto expected_block = allocator.allocateMemory(requirements, alloc_info);
+        if (not expected_block) { return expected_block.error(); }
+        transients_p->m_memory_blocks.emplace_back(std::move(expected_block.value()));
+        m_transient_memory_bytes += heap.m_size;
+    }
+    for (uint32_t candidate_index = 0; candidate_index < candidates.size(); ++candidate_index) {
+        const auto & candidate = candidates[candidate_index];
+        auto & resource = m_resources[candidate.m_resource_index];
+        const auto & [heap_index, offset] = heap_offsets[candidate_index];
+        const auto & block = transients_p->m_memory_blocks[heap_index];
+        m_transient_resource_bytes += candidate.m_requirements.size;
+        if (resource.m_kind == ResourceKind::eImage) {
+            Image image;
+            if (auto error = image.create(allocator, candidate.m_image_info, block, offset)) { return error; }
+            auto expected_view = image.createView(resource.m_image_range, view_type_of(resource.m_image_desc));
+            if (not expected_view) { return expected_view.error(); }
+            resource.m_image = image.handle();
+            resource.m_image_view = expected_view.value().get();
+            transients_p->m_images.emplace_back(std::move(image));
+            transients_p->m_image_views.emplace_back(std::move(expected_view.value()));
+        } else {
+            auto expected_memory = allocator.allocateBuffer(candidate.m_buffer_info, block, offset);
+            if (not expected_memory) { return expected_memory.error(); }
+            Buffer buffer {utils::ResourceHandle<details::Memory<vk::Buffer>>(std::move(expected_memory.value()))};
+            resource.m_buffer = buffer.handle();
+            transients_p->m_buffers.emplace_back(std::move(buffer));
+        }
+    }
+    m_transients_rp = ResourcePtr<TransientResources>(std::move(transients_p));
+    return {};
+}
+
+void RenderGraph::buildBarriers(CompiledPassList & schedule, const AliasPredecessorTable & alias_predecessors) noexcept
+{
+    std::vector<ResourceState> states(m_resources.size());
+    for (uint32_t resource_index = 0; resource_index < m_resources.size(); ++resource_index) {
+        const auto & resource = m_resources[resource_index];
+        if (not resource.m_imported) { continue; }
+        auto & state = states[resource_index];
+        state.m_touched = true;
+        state.m_layout = resource.m_initial_access.getImageLayout();
+        state.m_write_stages = resource.m_initial_access.getStageFlags();
+        state.m_write_access = resource.m_initial_access.getAccessFlags() & k_write_access_mask;
+    }
+    auto emit = [this](uint32_t resource_index, vk::PipelineStageFlags2 src_stages, vk::AccessFlags2 src_access,
+        vk::ImageLayout old_layout, const ResourceAccessInfo & dst) {
+        const auto & resource = m_resources[resource_index];
+        if (resource.m_kind == ResourceKind::eImage) {
+            m_image_barriers.emplace_back()
+                .setSrcStageMask(src_stages)
+                .setSrcAccessMask(src_access)
+                .setDstStageMask(dst.getStageFlags())
+                .setDstAccessMask(dst.getAccessFlags())
+                .setOldLayout(old_layout)
+                .setNewLayout(dst.getImageLayout())
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setSubresourceRange(resource.m_image_range);
+            m_image_barrier_resources.emplace_back(resource_index);
+        } else {
+            m_buffer_barriers.emplace_back()
+                .setSrcStageMask(src_stages)
+                .setSrcAccessMask(src_access)
+                .setDstStageMask(dst.getStageFlags())
+                .setDstAccessMask(dst.getAccessFlags())
+                .setSrcQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setDstQueueFamilyIndex(vk::QueueFamilyIgnored)
+                .setOffset(0)
+                .setSize(vk::WholeSize);
+            m_buffer_barrier_resources.emplace_back(resource_index);
+        }
+    };
+    auto begin_batch = [this]() {
+        return BarrierBatch {
+            static_cast<uint32_t>(m_image_barriers.size()), 0u,
+            static_cast<uint32_t>(m_buffer_barriers.size()), 0u};
+    };
+    auto end_batch = [this](BarrierBatch & batch) {
+        batch.m_image_barrier_count = static_cast<uint32_t>(m_image_barriers.size()) - batch.m_first_image_barrier;
+        batch.m_buffer_barrier_count = static_cast<uint32_t>(m_buffer_barriers.size()) - batch.m_first_buffer_barrier;
+    };
+    for (auto & compiled_pass : schedule) {
+        compiled_pass.m_barriers = begin_batch();
+        for (const auto & use : m_passes[compiled_pass.m_pass_index].m_uses) {
+            const auto & resource = m_resources[use.m_resource_index];
+            const bool is_image = resource.m_kind == ResourceKind::eImage;
+            const auto & dst = use.m_access;
+            auto & state = states[use.m_resource_index];
+            vk::PipelineStageFlags2 src_stages;
+            vk::AccessFlags2 src_access;
+            bool transitions = false;
+            bool needs_barrier = false;
+            if (not state.m_touched) {
+                //- first use of a transient: contents are undefined, but its memory may still be in use by the previous occupant
+                for (uint32_t predecessor : alias_predecessors[use.m_resource_index]) {
+                    const auto & predecessor_state = states[predecessor];
+                    src_stages |= predecessor_state.m_write_stages | predecessor_state.m_read_stages;
+                    src_access |= predecessor_state.m_write_access;
+                }
+                transitions = is_image;
+                needs_barrier = is_image or src_stages;
+            } else {
+                transitions = is_image and state.m_layout != dst.getImageLayout();
+                if (use.m_write or transitions) {
+                    src_stages = state.m_write_stages | state.m_read_stages;
+                    src_access = state.m_write_access;
+                    needs_barrier = transitions or src_stages;
+                } else {
+                    const bool covered = not (dst.getStageFlags() & ~state.m_read_stages) and not (dst.getAccessFlags() & ~state.m_read_access);
+                    src_stages = state.m_write_stages;
+                    src_access = state.m_write_access;
+                    needs_barrier = not covered and src_stages;
+                }
+            }
+            if (needs_barrier) {
+                const vk::ImageLayout old_layout = state.m_touched ? state.m_layout : vk::ImageLayout::eUndefined;
+                emit(use.m_resource_index, src_stages, src_access, old_layout, dst);
+            }
+            if (use.m_write or transitions or not state.m_touched) {
+                //- a layout transition is a write as far as later accesses are concerned
+                state.m_write_stages = dst.getStageFlags();
+                state.m_write_access = use.m_write ? dst.getAccessFlags() & k_write_access_mask : vk::AccessFlags2 {};
+                state.m_read_stages = use.m_write ? vk::PipelineStageFlags2 {} : dst.getStageFlags();
+                state.m_read_access = use.m_write ? vk::AccessFlags2 {} : dst.getAccessFlags();
+            } else {
+                state.m_read_stages |= dst.getStageFlags();
+                state.m_read_access |= dst.getAccessFlags();
+            }
+            state.m_touched = true;
+            if (is_image) { state.m_layout = dst.getImageLayout(); }
+        }
+        end_batch(compiled_pass.m_barriers);
+    }
+    m_final_barriers = begin_batch();
+    for (uint32_t resource_index = 0; resource_index < m_resources.size(); ++resource_index) {
+        const auto & resource = m_resources[resource_index];
+        if (not resource.m_final_access_opt) { continue; }
+        const auto & dst = *resource.m_final_access_opt;
+        const auto & state = states[resource_index];
+        const bool transitions = resource.m_kind == ResourceKind::eImage and state.m_layout != dst.getImageLayout();
+        const vk::PipelineStageFlags2 src_stages = state.m_write_stages | state.m_read_stages;
+        if (not transitions and not (src_stages and dst.getStageFlags())) { continue; }
+        emit(resource_index, src_stages, state.m_write_access, state.m_layout, dst);
+    }
+    end_batch(m_final_barriers);
+}
+
+void RenderGraph::recordBarriers(CommandBufferProxy & cmd, const BarrierBatch & batch) noexcept
+{
+    if (batch.m_image_barrier_count == 0 and batch.m_buffer_barrier_count == 0) { return; }
+    //- handles are patched on every execute so imported resources can be rebound between frames
+    for (uint32_t i = batch.m_first_image_barrier; i < batch.m_first_image_barrier + batch.m_image_barrier_count; ++i) {
+        m_image_barriers[i].setImage(m_resources[m_image_barrier_resources[i]].m_image);
+    }
+    for (uint32_t i = batch.m_first_buffer_barrier; i < batch.m_first_buffer_barrier + batch.m_buffer_barrier_count; ++i) {
+        m_buffer_barriers[i].setBuffer(m_resources[m_buffer_barrier_resources[i]].m_buffer);
+    }
+    vk::DependencyInfo dependency_info;
+    dependency_info.setImageMemoryBarrierCount(batch.m_image_barrier_count)
+        .setPImageMemoryBarriers(m_image_barriers.data() + batch.m_first_image_barrier)
+        .setBufferMemoryBarrierCount(batch.m_buffer_barrier_count)
+        .setPBufferMemoryBarriers(m_buffer_barriers.data() + batch.m_first_buffer_barrier);
+    cmd.pipelineBarrier2(dependency_info);
+}
+
+} // namespace lcf::vkc
+
+namespace {
+
+vk::ImageUsageFlags image_usage_of(vk::AccessFlags2 access) noexcept
+{
+    vk::ImageUsageFlags usage;
+    if (access & (vk::AccessFlagBits2::eColorAttachmentRead | vk::AccessFlagBits2::eColorAttachmentWrite)) {
+        usage |= vk::ImageUsageFlagBits::eColorAttachment;
+    }
+    if (access & (vk::AccessFlagBits2::eDepthStencilAttachmentRead | vk::AccessFlagBits2::eDepthStencilAttachmentWrite)) {
+        usage |= vk::ImageUsageFlagBits::eDepthStencilAttachment;
+    }
+    if (access & vk::AccessFlagBits2::eInputAttachmentRead) { usage |= vk::ImageUsageFlagBits::eInputAttachment; }
+    if (access & (vk::AccessFlagBits2::eShaderSampledRead | vk::AccessFlagBits2::eShaderRead)) { usage |= vk::ImageUsageFlagBits::eSampled; }
+    if (access & (vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite | vk::AccessFlagBits2::eShaderWrite)) {
+        usage |= vk::ImageUsageFlagBits::eStorage;
+    }
+    if (access & vk::AccessFlagBits2::eTransferRead) { usage |= vk::ImageUsageFlagBits::eTransferSrc; }
+    if (access & vk::AccessFlagBits2::eTransferWrite) { usage |= vk::ImageUsageFlagBits::eTransferDst; }
+    return usage;
+}
+
+vk::BufferUsageFlags buffer_usage_of(vk::AccessFlags2 access) noexcept
+{
+    vk::BufferUsageFlags usage;
+    if (access & vk::AccessFlagBits2::eIndirectCommandRead) { usage |= vk::BufferUsageFlagBits::eIndirectBuffer; }
+    if (access & vk::AccessFlagBits2::eIndexRead) { usage |= vk::BufferUsageFlagBits::eIndexBuffer; }
+    if (access & vk::AccessFlagBits2::eVertexAttributeRead) { usage |= vk::BufferUsageFlagBits::eVertexBuffer; }
+    if (access & vk::AccessFlagBits2::eUniformRead) { usage |= vk::BufferUsageFlagBits::eUniformBuffer; }
+    if (access & (vk::AccessFlagBits2::eShaderStorageRead | vk::AccessFlagBits2::eShaderStorageWrite |
+        vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite)) {
+        usage |= vk::BufferUsageFlagBits::eStorageBuffer;
+    }
+    if (access & vk::AccessFlagBits2::eTransferRead) { usage |= vk::BufferUsageFlagBits::eTransferSrc; }
+    if (access & vk::AccessFlagBits2::eTransferWrite) { usage |= vk::BufferUsageFlagBits::eTransferDst; }
+    return usage;
+}
+
+vk::ImageAspectFlags aspect_flags_of(vk::Format format) noexcept
+{
+    vk::ImageAspectFlags aspect;
+    if (utils::is_depth_format(format)) { aspect |= vk::ImageAspectFlagBits::eDepth; }
+    if (utils::is_stencil_format(format)) { aspect |= vk::ImageAspectFlagBits::eStencil; }
+    return aspect ? aspect : vk::ImageAspectFlagBits::eColor;
+}
+
+vk::ImageViewType view_type_of(const ImageDescription & desc) noexcept
+{
+    const bool is_array = desc.getArrayLayerCount() > 1u;
+    switch (desc.getType()) {
+        case vk::ImageType::e1D: return is_array ? vk::ImageViewType::e1DArray : vk::ImageViewType::e1D;
+        case vk::ImageType::e3D: return vk::ImageViewType::e3D;
+        default: return is_array ? vk::ImageViewType::e2DArray : vk::ImageViewType::e2D;
+    }
+}
+
+} // anonymous namespace
@@ -17,6 +17,29 @@ std::error_code Image::create(
     return {};
 }
 
+std::error_code Image::create(
+    const MemoryAllocator & allocator,
+    const vk::ImageCreateInfo & image_info,
+    const MemoryBlock & block,
+    vk::DeviceSize offset) noexcept
+{
+    auto expected_memory = allocator.allocateImage(image_info, block, offset);
+    if (not expected_memory) { return expected_memory.error(); }
+    m_memory_rh = std::move(expected_memory.value());
+    m_device = allocator.getDevice();
+    m_desc = image_info;
+    return {};
+}
+
+std::error_code Image::wrap(vk::Device device, vk::Image image, const ImageDescription & desc) noexcept
+{
+    //- without an allocator the memory handle's destroy is a no-op, the image stays owned by its creator
+    m_memory_rh = details::UniqueImageMemory {details::Memory<vk::Image> {nullptr, nullptr, image}};
+    m_device = device;
+    m_desc = desc;
+    return {};
+}
+
 Image::operator vk::Image() const noexcept
 {
     return m_memory_rh->handle();
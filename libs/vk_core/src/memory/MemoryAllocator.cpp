@@ -28,10 +28,56 @@ std::expected<details::UniqueBufferMemory, std::error_code> MemoryAllocator::all
     return m_allocator_up->allocateBuffer(buffer_info, alloc_info);
 }
 
+std::expected<details::UniqueBufferMemory, std::error_code> MemoryAllocator::allocateBuffer(
+    const vk::BufferCreateInfo & buffer_info, const MemoryAllocationInfo & alloc_info, const MemoryPool & pool) const noexcept
+{
+    return m_allocator_up->allocateBuffer(buffer_info, alloc_info, pool.handle());
+}
+
 std::expected<details::UniqueImageMemory, std::error_code> MemoryAllocator::allocateImage(
     const vk::ImageCreateInfo & image_info, const MemoryAllocationInfo & alloc_info) const noexcept
 {
     return m_allocator_up->allocateImage(image_info, alloc_info);
 }
 
+std::expected<details::UniqueBufferMemory, std::error_code> MemoryAllocator::allocateBuffer(
+    const vk::BufferCreateInfo & buffer_info, const MemoryBlock & block, vk::DeviceSize offset) const noexcept
+{
+    return m_allocator_up->allocateAliasingBuffer(buffer_info, block.handle(), offset);
+}
+
+std::expected<details::UniqueImageMemory, std::error_code> MemoryAllocator::allocateImage(
+    const vk::ImageCreateInfo & image_info, const MemoryBlock & block, vk::DeviceSize offset) const noexcept
+{
+    return m_allocator_up->allocateAliasingImage(image_info, block.handle(), offset);
+}
+
+std::expected<MemoryBlock, std::error_code> MemoryAllocator::allocateMemory(
+    const vk::MemoryRequirements & requirements, const MemoryAllocationInfo & alloc_info) const noexcept
+{
+    auto expected_allocation = m_allocator_up->allocateMemory(requirements, alloc_info);
+    if (not expected_allocation) { return std::unexpected(expected_allocation.error()); }
+    return MemoryBlock {m_allocator_up->handle(), expected_allocation.value(), requirements.size};
+}
+
+std::expected<MemoryPool, std::error_code> MemoryAllocator::createPool(
+    const vk::BufferCreateInfo & buffer_info,
+    const MemoryAllocationInfo & alloc_info,
+    const MemoryPoolCreateInfo & pool_info) const noexcept
+{
+    auto expected_pool = m_allocator_up->createPool(buffer_info, alloc_info, pool_info);
+    if (not expected_pool) { return std::unexpected(expected_pool.error()); }
+    return MemoryPool {m_allocator_up->handle(), expected_pool.value()};
+}
+
+void MemoryAllocator::setCurrentFrameIndex(uint32_t frame_index) const noexcept
+{
+    m_allocator_up->setCurrentFrameIndex(frame_index);
+}
+
+std::vector<MemoryHeapBudget> MemoryAllocator::getHeapBudgets() const noexcept
+{
+    return m_allocator_up->getHeapBudgets();
+}
+
 }
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "vk_core/memory/ResidencyManager.h"
+#include "vk_core/memory/MemoryAllocator.h"
+#include "vk_core/memory/info_structs.h"
+#include "vk_core/error.h"
+#include <algorithm>
+
+namespace lcf::vkc {
+
+std::error_code ResidencyManager::create(const MemoryAllocator & allocator) noexcept
+{
+    std::lock_guard lock {m_mutex};
+    m_allocator_p = &allocator;
+    this->pollBudgets();
+    return {};
+}
+
+auto ResidencyManager::setSoftLimit(float fraction) noexcept -> Self &
+{
+    std::lock_guard lock {m_mutex};
+    m_soft_limit = std::clamp(fraction, 0.0f, 1.0f);
+    return *this;
+}
+
+auto ResidencyManager::setHardLimit(float fraction) noexcept -> Self &
+{
+    std::lock_guard lock {m_mutex};
+    m_hard_limit = std::clamp(fraction, 0.0f, 1.0f);
+    return *this;
+}
+
+auto ResidencyManager::setCategoryLimit(MemoryCategory category, vk::DeviceSize size_in_bytes) noexcept -> Self &
+{
+    std::lock_guard lock {m_mutex};
+    m_category_limits[static_cast<size_t>(category)] = size_in_bytes;
+    return *this;
+}
+
+auto ResidencyManager::setMinIdleFrames(uint32_t frame_count) noexcept -> Self &
+{
+    std::lock_guard lock {m_mutex};
+    m_min_idle_frames = frame_count;
+    return *this;
+}
+
+auto ResidencyManager::setMaxFramesInFlight(uint32_t frame_count) noexcept -> Self &
+{
+    std::lock_guard lock {m_mutex};
+    m_max_frames_in_flight = frame_count;
+    return *this;
+}
+
+auto ResidencyManager::track(MemoryCategory category, vk::DeviceSize size_in_bytes, EvictCallback evict) noexcept -> ResidencyId
+{
+    std::lock_guard lock {m_mutex};
+    const ResidencyId id = m_next_id++;
+    LruList::iterator lru_it = m_lru.end();
+    if (evict) { lru_it = m_lru.insert(m_lru.end(), id); }
+    m_entries.try_emplace(id, category, size_in_bytes, m_frame_index, std::move(evict), lru_it);
+    m_category_usages[static_cast<size_t>(category)] += size_in_bytes;
+    m_reserved_since_poll -= std::min(m_reserved_since_poll, size_in_bytes); //- the reservation has turned into a tracked allocation
+    return id;
+}
+
+void ResidencyManager::untrack(ResidencyId id) noexcept
+{
+    std::lock_guard lock {m_mutex};
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) { return; }
+    auto & entry = it->second;
+    if (entry.m_lru_it != m_lru.end()) { m_lru.erase(entry.m_lru_it); }
+    m_category_usages[static_cast<size_t>(entry.m_category)] -= entry.m_size;
+    m_entries.erase(it);
+}
+
+void ResidencyManager::touch(ResidencyId id) noexcept
+{
+    std::lock_guard lock {m_mutex};
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) { return; }
+    auto & entry = it->second;
+    entry.m_last_used_frame = m_frame_index;
+    if (entry.m_lru_it != m_lru.end()) { m_lru.splice(m_lru.end(), m_lru, entry.m_lru_it); }
+}
+
+std::error_code ResidencyManager::reserve(MemoryCategory category, vk::DeviceSize size_in_bytes) noexcept
+{
+    EvictCallbackList evictions;
+    std::error_code error;
+    {
+        std::lock_guard lock {m_mutex};
+        const auto category_index = static_cast<size_t>(category);
+        const vk::DeviceSize category_limit = m_category_limits[category_index];
+        if (category_limit != 0) {
+            const vk::DeviceSize category_usage = m_category_usages[category_index] + size_in_bytes;
+            if (category_usage > category_limit) {
+                const vk::DeviceSize freed = this->collectEvictions(category_usage - category_limit, category, evictions);
+                if (freed < category_usage - category_limit) { error = make_error_code(errc::memory_budget_exceeded); }
+            }
+        }
+        const auto hard_limit = static_cast<vk::DeviceSize>(static_cast<double>(m_polled_budget) * m_hard_limit);
+        const vk::DeviceSize usage = this->estimateUsage() + size_in_bytes;
+        if (not error and m_polled_budget != 0 and usage > hard_limit) {
+            const vk::DeviceSize freed = this->collectEvictions(usage - hard_limit, std::nullopt, evictions);
+            if (freed < usage - hard_limit) { error = make_error_code(errc::memory_budget_exceeded); }
+        }
+        if (not error) { m_reserved_since_poll += size_in_bytes; }
+    }
+    for (auto & evict : evictions) { evict(); }
+    return error;
+}
+
+uint32_t ResidencyManager::update(uint64_t frame_index) noexcept
+{
+    EvictCallbackList evictions;
+    {
+        std::lock_guard lock {m_mutex};
+        m_frame_index = frame_index;
+        if (m_allocator_p) { m_allocator_p->setCurrentFrameIndex(static_cast<uint32_t>(frame_index)); }
+        this->retireHeldEvictions();
+        this->pollBudgets();
+        const auto soft_limit = static_cast<vk::DeviceSize>(static_cast<double>(m_polled_budget) * m_soft_limit);
+        const vk::DeviceSize usage = this->estimateUsage();
+        if (m_polled_budget != 0 and usage > soft_limit) {
+            this->collectEvictions(usage - soft_limit, std::nullopt, evictions);
+        }
+        for (size_t i = 0; i < m_category_limits.size(); ++i) {
+            const vk::DeviceSize limit = m_category_limits[i];
+            if (limit == 0 or m_category_usages[i] <= limit) { continue; }
+            this->collectEvictions(m_category_usages[i] - limit, static_cast<MemoryCategory>(i), evictions);
+        }
+    }
+    for (auto & evict : evictions) { evict(); }
+    return static_cast<uint32_t>(evictions.size());
+}
+
+vk::DeviceSize ResidencyManager::getCategoryUsage(MemoryCategory category) const noexcept
+{
+    std::lock_guard lock {m_mutex};
+    return m_category_usages[static_cast<size_t>(category)];
+}
+
+vk::DeviceSize ResidencyManager::getDeviceLocalUsage() const noexcept
+{
+    std::lock_guard lock {m_mutex};
+    return this->estimateUsage();
+}
+
+vk::DeviceSize ResidencyManager::getDeviceLocalBudget() const noexcept
+{
+    std::lock_guard lock {m_mutex};
+    return m_polled_budget;
+}
+
+vk::DeviceSize ResidencyManager::estimateUsage() const noexcept
+{
+    //- budgets are only refreshed once per frame, so account for what happened since;
+    //- evicted memory still shows up in the polled usage while leases hold it, it is already on its way out
+    const vk::DeviceSize usage = m_polled_usage + m_reserved_since_poll;
+    return usage - std::min(usage, m_held_eviction_bytes);
+}
+
+vk::DeviceSize ResidencyManager::collectEvictions(
+    vk::DeviceSize bytes_to_free,
+    std::optional<MemoryCategory> category_opt,
+    EvictCallbackList & evictions) noexcept
+{
+    vk::DeviceSize freed = 0;
+    auto lru_it = m_lru.begin();
+    while (freed < bytes_to_free and lru_it != m_lru.end()) {
+        const ResidencyId id = *lru_it;
+        const auto & entry = m_entries.at(id);
+        //- the list is ordered by last use, everything after this entry is younger still
+        if (entry.m_last_used_frame + m_min_idle_frames > m_frame_index) { break; }
+        ++lru_it;
+        if (category_opt and entry.m_category != *category_opt) { continue; }
+        freed += entry.m_size;
+        this->evict(id, evictions);
+    }
+    return freed;
+}
+
+void ResidencyManager::pollBudgets() noexcept
+{
+    m_polled_usage = 0;
+    m_polled_budget = 0;
+    m_reserved_since_poll = 0;
+    if (not m_allocator_p) { return; }
+    for (const auto & heap_budget : m_allocator_p->getHeapBudgets()) {
+        if (not heap_budget.m_device_local) { continue; }
+        m_polled_usage += heap_budget.m_usage;
+        m_polled_budget += heap_budget.m_budget;
+    }
+}
+
+void ResidencyManager::retireHeldEvictions() noexcept
+{
+    //- past the frames in flight the leases are gone and the polled usage no longer contains the memory
+    while (not m_held_evictions.empty() and m_held_evictions.front().m_frame_index + m_max_frames_in_flight <= m_frame_index) {
+        m_held_eviction_bytes -= m_held_evictions.front().m_size;
+        m_held_evictions.pop_front();
+    }
+}
+
+void ResidencyManager::evict(ResidencyId id, EvictCallbackList & evictions) noexcept
+{
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) { return; }
+    auto & entry = it->second;
+    if (entry.m_lru_it != m_lru.end()) { m_lru.erase(entry.m_lru_it); }
+    m_category_usages[static_cast<size_t>(entry.m_category)] -= entry.m_size;
+    m_held_evictions.emplace_back(m_frame_index, entry.m_size);
+    m_held_eviction_bytes += entry.m_size;
+    evictions.emplace_back(std::move(entry.m_evict));
+    m_entries.erase(it);
+}
+
+} // namespace lcf::vkc
@@ -0,0 +1,139 @@
+#include "vk_core/memory/TransientBufferRing.h"
+#include "vk_core/memory/MemoryAllocator.h"
+#include "vk_core/memory/info_structs.h"
+#include "vk_core/error.h"
+#include <algorithm>
+#include <utility>
+
+namespace lcf::vkc {
+
+TransientBufferRing::~TransientBufferRing() noexcept
+{
+    this->destroy();
+}
+
+TransientBufferRing::TransientBufferRing(Self && other) noexcept
+{
+    this->stealFrom(other);
+}
+
+auto TransientBufferRing::operator=(Self && other) noexcept -> Self &
+{
+    if (this == &other) { return *this; }
+    this->destroy();
+    this->stealFrom(other);
+    return *this;
+}
+
+std::error_code TransientBufferRing::create(
+    const MemoryAllocator & allocator,
+    vk::DeviceSize capacity,
+    vk::BufferUsageFlags usage,
+    MemoryAccess access) noexcept
+{
+    if (capacity == 0) { return std::make_error_code(std::errc::invalid_argument); }
+    this->destroy();
+    const bool bda_enabled = allocator.isBufferDeviceAddressEnabled() and (usage & vk::BufferUsageFlagBits::eShaderDeviceAddress);
+    if (not allocator.isBufferDeviceAddressEnabled()) { usage &= ~vk::BufferUsageFlagBits::eShaderDeviceAddress; }
+    vk::BufferCreateInfo buffer_info;
+    buffer_info.setSize(capacity)
+        .setUsage(usage)
+        .setSharingMode(vk::SharingMode::eExclusive);
+    MemoryAllocationInfo alloc_info;
+    alloc_info.setAccess(access);
+    //- the single block must hold the buffer as the driver sizes it, which can exceed capacity
+    const auto requirements = allocator.getDevice().getBufferMemoryRequirements(vk::DeviceBufferMemoryRequirements {&buffer_info}).memoryRequirements;
+    const vk::DeviceSize alignment = std::max<vk::DeviceSize>(requirements.alignment, 1);
+    MemoryPoolCreateInfo pool_info;
+    pool_info.setLinear(true)
+        .setBlockSize((requirements.size + alignment - 1) / alignment * alignment)
+        .setMinBlockCount(1)
+        .setMaxBlockCount(1);
+    auto expected_pool = allocator.createPool(buffer_info, alloc_info, pool_info);
+    if (not expected_pool) { return expected_pool.error(); }
+    auto expected_memory = allocator.allocateBuffer(buffer_info, alloc_info, expected_pool.value());
+    if (not expected_memory) { return expected_memory.error(); }
+    VmaVirtualBlockCreateInfo virtual_block_info {};
+    virtual_block_info.size = capacity;
+    virtual_block_info.flags = VMA_VIRTUAL_BLOCK_CREATE_LINEAR_ALGORITHM_BIT;
+    VmaVirtualBlock virtual_block = nullptr;
+    if (VkResult result = vmaCreateVirtualBlock(&virtual_block_info, &virtual_block); result != VK_SUCCESS) {
+        return vk::make_error_code(static_cast<vk::Result>(result));
+    }
+    auto mapped_span = expected_memory.value()->getMappedMemorySpan();
+    m_buffer = expected_memory.value()->handle();
+    m_device_address = bda_enabled ? allocator.getDevice().getBufferAddress(vk::BufferDeviceAddressInfo {m_buffer}) : 0;
+    m_storage_rp = make_resource_ptr<SharedStorage>(std::move(expected_pool.value()), std::move(expected_memory.value()));
+    m_virtual_block = virtual_block;
+    m_capacity = capacity;
+    m_mapped_span = mapped_span.first(std::min<size_t>(mapped_span.size(), capacity));
+    return {};
+}
+
+std::expected<BufferSlice, std::error_code> TransientBufferRing::allocate(vk::DeviceSize size, vk::DeviceSize alignment) noexcept
+{
+    if (not m_virtual_block or size == 0) { return std::unexpected(std::make_error_code(std::errc::invalid_argument)); }
+    VmaVirtualAllocationCreateInfo allocation_info {};
+    allocation_info.size = size;
+    allocation_info.alignment = alignment;
+    VmaVirtualAllocation allocation = nullptr;
+    vk::DeviceSize offset = 0;
+    if (vmaVirtualAllocate(m_virtual_block, &allocation_info, &allocation, &offset) != VK_SUCCESS) {
+        return std::unexpected(make_error_code(errc::transient_buffer_ring_exhausted));
+    }
+    m_open_allocations.emplace_back(allocation);
+    const vk::DeviceAddress device_address = m_device_address ? m_device_address + offset : 0;
+    auto mapped_span = m_mapped_span.empty() ? std::span<std::byte> {} : m_mapped_span.subspan(offset, size);
+    return BufferSlice {m_buffer, offset, size, device_address, mapped_span};
+}
+
+void TransientBufferRing::retire(uint64_t timestamp) noexcept
+{
+    if (m_open_allocations.empty()) { return; }
+    if (not m_retired_allocations.empty() and m_retired_allocations.back().m_timestamp == timestamp) {
+        m_retired_allocations.back().m_allocations.append_range(std::exchange(m_open_allocations, {}));
+        return;
+    }
+    m_retired_allocations.emplace_back(timestamp, std::exchange(m_open_allocations, {}));
+}
+
+void TransientBufferRing::reclaim(uint64_t completed_timestamp) noexcept
+{
+    //- freed oldest first, which lets the linear block wrap around like a ring buffer
+    while (not m_retired_allocations.empty() and m_retired_allocations.front().m_timestamp <= completed_timestamp) {
+        for (auto allocation : m_retired_allocations.front().m_allocations) {
+            vmaVirtualFree(m_virtual_block, allocation);
+        }
+        m_retired_allocations.pop_front();
+    }
+}
+
+void TransientBufferRing::destroy() noexcept
+{
+    if (m_virtual_block) {
+        vmaClearVirtualBlock(m_virtual_block);
+        vmaDestroyVirtualBlock(m_virtual_block);
+        m_virtual_block = nullptr;
+    }
+    m_open_allocations.clear();
+    m_retired_allocations.clear();
+    m_mapped_span = {};
+    m_capacity = 0;
+    m_device_address = 0;
+    m_buffer = nullptr;
+    m_storage_rp = SharedStoragePointer {}; //- outstanding leases keep the buffer and pool until their work completes
+}
+
+void TransientBufferRing::stealFrom(Self & other) noexcept
+{
+    m_storage_rp = std::move(other.m_storage_rp);
+    m_buffer = std::exchange(other.m_buffer, nullptr);
+    m_device_address = std::exchange(other.m_device_address, 0);
+    m_virtual_block = std::exchange(other.m_virtual_block, nullptr);
+    m_capacity = std::exchange(other.m_capacity, 0);
+    m_mapped_span = std::exchange(other.m_mapped_span, {});
+    m_open_allocations = std::move(other.m_open_allocations);
+    m_retired_allocations = std::move(other.m_retired_allocations);
+}
+
+} // namespace lcf::vkc
@@ -57,9 +57,10 @@ std::error_code VMAllocator::create(vk::Instance instance, vk::PhysicalDevice ph
     return {};
 }
 
-std::expected<UniqueBufferMemory, std::error_code> VMAllocator::allocateBuffer(const vk::BufferCreateInfo & buffer_info, const MemoryAllocationInfo & alloc_info) const noexcept
+std::expected<UniqueBufferMemory, std::error_code> VMAllocator::allocateBuffer(const vk::BufferCreateInfo & buffer_info, const MemoryAllocationInfo & alloc_info, VmaPool pool) const noexcept
 {
     VmaAllocationCreateInfo create_info = to_vma_allocation_create_info(alloc_info);
+    create_info.pool = pool;
     VkBuffer buffer = nullptr;
     VmaAllocation allocation = nullptr;
     VkResult result = vmaCreateBuffer(
@@ -89,6 +90,87 @@ std::expected<UniqueImageMemory, std::error_code> VMAllocator::allocateImage(con
     return UniqueImageMemory(Memory<vk::Image>(m_allocator, allocation, image));
 }
 
+std::expected<VmaAllocation, std::error_code> VMAllocator::allocateMemory(const vk::MemoryRequirements & requirements, const MemoryAllocationInfo & alloc_info) const noexcept
+{
+    VmaAllocationCreateInfo create_info = to_vma_allocation_create_info(alloc_info);
+    VmaAllocation allocation = nullptr;
+    VkResult result = vmaAllocateMemory(
+        m_allocator,
+        reinterpret_cast<const VkMemoryRequirements *>(&requirements),
+        &create_info,
+        &allocation,
+        nullptr);
+    if (result != VK_SUCCESS) { return std::unexpected(vk::make_error_code(static_cast<vk::Result>(result))); }
+    return allocation;
+}
+
+std::expected<UniqueBufferMemory, std::error_code> VMAllocator::allocateAliasingBuffer(const vk::BufferCreateInfo & buffer_info, VmaAllocation allocation, vk::DeviceSize offset) const noexcept
+{
+    VkBuffer buffer = nullptr;
+    VkResult result = vmaCreateAliasingBuffer2(
+        m_allocator,
+        allocation,
+        offset,
+        reinterpret_cast<const VkBufferCreateInfo *>(&buffer_info),
+        &buffer);
+    if (result != VK_SUCCESS) { return std::unexpected(vk::make_error_code(static_cast<vk::Result>(result))); }
+    //- no allocation recorded, so destroy() only releases the buffer
+    return UniqueBufferMemory(Memory<vk::Buffer>(m_allocator, nullptr, buffer));
+}
+
+std::expected<UniqueImageMemory, std::error_code> VMAllocator::allocateAliasingImage(const vk::ImageCreateInfo & image_info, VmaAllocation allocation, vk::DeviceSize offset) const noexcept
+{
+    VkImage image = nullptr;
+    VkResult result = vmaCreateAliasingImage2(
+        m_allocator,
+        allocation,
+        offset,
+        reinterpret_cast<const VkImageCreateInfo *>(&image_info),
+        &image);
+    if (result != VK_SUCCESS) { return std::unexpected(vk::make_error_code(static_cast<vk::Result>(result))); }
+    return UniqueImageMemory(Memory<vk::Image>(m_allocator, nullptr, image));
+}
+
+std::expected<VmaPool, std::error_code> VMAllocator::createPool(const vk::BufferCreateInfo & buffer_info, const MemoryAllocationInfo & alloc_info, const MemoryPoolCreateInfo & pool_info) const noexcept
+{
+    VmaAllocationCreateInfo create_info = to_vma_allocation_create_info(alloc_info);
+    uint32_t memory_type_index = 0;
+    VkResult result = vmaFindMemoryTypeIndexForBufferInfo(
+        m_allocator,
+        reinterpret_cast<const VkBufferCreateInfo *>(&buffer_info),
+        &create_info,
+        &memory_type_index);
+    if (result != VK_SUCCESS) { return std::unexpected(vk::make_error_code(static_cast<vk::Result>(result))); }
+    VmaPoolCreateInfo vma_pool_info {};
+    vma_pool_info.memoryTypeIndex = memory_type_index;
+    if (pool_info.isLinear()) { vma_pool_info.flags |= VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT; }
+    vma_pool_info.blockSize = pool_info.getBlockSize();
+    vma_pool_info.minBlockCount = pool_info.getMinBlockCount();
+    vma_pool_info.maxBlockCount = pool_info.getMaxBlockCount();
+    vma_pool_info.priority = alloc_info.getPriority();
+    VmaPool pool = nullptr;
+    result = vmaCreatePool(m_allocator, &vma_pool_info, &pool);
+    if (result != VK_SUCCESS) { return std::unexpected(vk::make_error_code(static_cast<vk::Result>(result))); }
+    return pool;
+}
+
+std::vector<MemoryHeapBudget> VMAllocator::getHeapBudgets() const noexcept
+{
+    const VkPhysicalDeviceMemoryProperties * memory_properties_p = nullptr;
+    vmaGetMemoryProperties(m_allocator, &memory_properties_p);
+    std::vector<VmaBudget> vma_budgets(memory_properties_p->memoryHeapCount);
+    vmaGetHeapBudgets(m_allocator, vma_budgets.data());
+    std::vector<MemoryHeapBudget> budgets(vma_budgets.size());
+    for (uint32_t i = 0; i < vma_budgets.size(); ++i) {
+        budgets[i].m_usage = vma_budgets[i].usage;
+        budgets[i].m_budget = vma_budgets[i].budget;
+        budgets[i].m_allocation_bytes = vma_budgets[i].statistics.allocationBytes;
+        budgets[i].m_block_bytes = vma_budgets[i].statistics.blockBytes;
+        budgets[i].m_device_local = memory_properties_p->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT;
+    }
+    return budgets;
+}
+
 } // namespace lcf::vkc::details
 
 namespace {
@@ -0,0 +1,130 @@
+#include "vk_core/pipeline/PipelineCompiler.h"
+#include "vk_core/pipeline/graphics/StaticRender.h"
+#include "vk_core/pipeline/graphics/DynamicRender.h"
+#include "vk_core/pipeline/graphics/info_structs.h"
+#include "vk_core/pipeline/shader/info_structs.h"
+#include "vk_core/error.h"
+#include <algorithm>
+
+namespace lcf::vkc {
+
+PipelineCompiler::~PipelineCompiler() noexcept
+{
+    for (auto & worker : m_workers) { worker.request_stop(); }
+    m_workers.clear(); //- joins, builds already running are finished
+    for (auto & task : m_tasks) { task(true); }
+}
+
+std::error_code PipelineCompiler::create(
+    vk::Device device,
+    uint32_t worker_count,
+    uint32_t max_pending_count,
+    std::span<const std::byte> initial_cache_data) noexcept
+{
+    if (not device or max_pending_count == 0u) { return std::make_error_code(std::errc::invalid_argument); }
+    if (not m_workers.empty()) { return std::make_error_code(std::errc::operation_in_progress); }
+    vk::PipelineCacheCreateInfo pipeline_cache_info;
+    pipeline_cache_info.setInitialDataSize(initial_cache_data.size())
+        .setPInitialData(initial_cache_data.data());
+    try {
+        m_pipeline_cache = device.createPipelineCacheUnique(pipeline_cache_info);
+    } catch (const vk::SystemError & e) {
+        return e.code();
+    }
+    m_device = device;
+    m_max_pending_count = max_pending_count;
+    if (worker_count == 0u) { worker_count = std::max(1u, std::thread::hardware_concurrency() / 2u); }
+    try {
+        m_workers.reserve(worker_count);
+        for (uint32_t i = 0; i < worker_count; ++i) {
+            m_workers.emplace_back([this](std::stop_token stop_token) { this->workerLoop(stop_token); });
+        }
+    } catch (const std::system_error & e) {
+        if (m_workers.empty()) { return e.code(); }
+    }
+    return {};
+}
+
+auto PipelineCompiler::compile(
+    ConstGraphicsPipelineInfoSP pipeline_info_sp,
+    ConstStaticRenderScopeInfoSP render_scope_info_sp) noexcept -> std::expected<GraphicsPipelineTicket, std::error_code>
+{
+    if (not pipeline_info_sp or not render_scope_info_sp) { return std::unexpected(std::make_error_code(std::errc::invalid_argument)); }
+    return this->submit<GraphicsPipeline>([this, pipeline_info_sp, render_scope_info_sp](GraphicsPipeline & pipeline) {
+        return pipeline.create(m_device, *pipeline_info_sp, *render_scope_info_sp, m_pipeline_cache.get());
+    });
+}
+
+auto PipelineCompiler::compile(
+    ConstGraphicsPipelineInfoSP pipeline_info_sp,
+    ConstDynamicRenderScopeInfoSP render_scope_info_sp) noexcept -> std::expected<GraphicsPipelineTicket, std::error_code>
+{
+    if (not pipeline_info_sp or not render_scope_info_sp) { return std::unexpected(std::make_error_code(std::errc::invalid_argument)); }
+    return this->submit<GraphicsPipeline>([this, pipeline_info_sp, render_scope_info_sp](GraphicsPipeline & pipeline) {
+        return pipeline.create(m_device, *pipeline_info_sp, *render_scope_info_sp, m_pipeline_cache.get());
+    });
+}
+
+auto PipelineCompiler::compile(
+    ConstShaderProgramInfoSP program_info_sp,
+    vk::ShaderCreateFlagsEXT flags) noexcept -> std::expected<ShaderObjectGroupTicket, std::error_code>
+{
+    if (not program_info_sp) { return std::unexpected(std::make_error_code(std::errc::invalid_argument)); }
+    return this->submit<ShaderObjectGroup>([this, program_info_sp, flags](ShaderObjectGroup & group) {
+        return group.create(m_device, *program_info_sp, flags);
+    });
+}
+
+uint32_t PipelineCompiler::getPendingCount() const noexcept
+{
+    std::lock_guard lock {m_mutex};
+    return m_pending_count;
+}
+
+template <typename Product, typename Build>
+auto PipelineCompiler::submit(Build && build) noexcept -> std::expected<CompileTicket<Product>, std::error_code>
+{
+    if (m_workers.empty()) { return std::unexpected(std::make_error_code(std::errc::operation_not_permitted)); }
+    std::shared_ptr<details::CompileState<Product>> state_sp;
+    try {
+        state_sp = std::make_shared<details::CompileState<Product>>();
+        std::lock_guard lock {m_mutex};
+        if (m_pending_count >= m_max_pending_count) { return std::unexpected(make_error_code(errc::pipeline_compile_queue_full)); }
+        m_tasks.emplace_back([state_sp, build = std::forward<Build>(build)](bool cancelled) mutable {
+            if (cancelled) {
+                state_sp->fail(make_error_code(errc::pipeline_compile_cancelled));
+                return;
+            }
+            Product product;
+            if (auto error = build(product)) {
+                state_sp->fail(error);
+            } else {
+                state_sp->fulfill(std::move(product));
+            }
+        });
+        ++m_pending_count;
+    } catch (const std::bad_alloc &) {
+        return std::unexpected(std::make_error_code(std::errc::not_enough_memory));
+    }
+    m_task_cv.notify_one();
+    return CompileTicket<Product> {std::move(state_sp)};
+}
+
+void PipelineCompiler::workerLoop(std::stop_token stop_token) noexcept
+{
+    while (true) {
+        Task task;
+        {
+            std::unique_lock lock {m_mutex};
+            m_task_cv.wait(lock, stop_token, [this] { return not m_tasks.empty(); });
+            if (stop_token.stop_requested()) { return; } //- leftovers are cancelled by the destructor
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task(false);
+        std::lock_guard lock {m_mutex};
+        --m_pending_count;
+    }
+}
+
+} // namespace lcf::vkc
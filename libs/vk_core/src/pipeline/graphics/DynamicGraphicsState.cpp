@@ -1,6 +1,7 @@
 #include "vk_core/pipeline/graphics/DynamicGraphicsState.h"
 #include "vk_core/pipeline/graphics/info_structs.h"
 #include "vk_core/command/CommandBufferProxy.h"
+#include <array>
 #include <vector>
 
 namespace lcf::vkc {
@@ -10,98 +11,169 @@ void bind_dynamic_graphics_state(
     const GraphicsPipelineInfo & info,
     const ShaderObjectBindingState & shader_object_binding_states) noexcept
 {
+    using enum vk::DynamicState;
+    static constexpr uint32_t k_front = static_cast<uint32_t>(vk::StencilFaceFlagBits::eFront);
+    static constexpr uint32_t k_back = static_cast<uint32_t>(vk::StencilFaceFlagBits::eBack);
+
     const auto & vertex_input = info.getVertexInputInfo();
-    std::vector<vk::VertexInputBindingDescription2EXT> bindings;
-    bindings.reserve(vertex_input.getBindings().size());
+    thread_local std::vector<vk::VertexInputBindingDescription2EXT> bindings;
+    thread_local std::vector<vk::VertexInputAttributeDescription2EXT> attributes;
+    bindings.clear();
     for (const auto & binding : vertex_input.getBindings()) {
         bindings.emplace_back(static_cast<const vk::VertexInputBindingDescription2EXT &>(binding));
     }
-    std::vector<vk::VertexInputAttributeDescription2EXT> attributes;
-    attributes.reserve(vertex_input.getAttributes().size());
+    attributes.clear();
     for (const auto & attribute : vertex_input.getAttributes()) {
         attributes.emplace_back(static_cast<const vk::VertexInputAttributeDescription2EXT &>(attribute));
     }
-    cmd.setVertexInputEXT(bindings, attributes);
+    if (cmd.isDynamicStateChanged(eVertexInputEXT, bindings, attributes)) {
+        cmd.setVertexInputEXT(bindings, attributes);
+    }
 
     const auto & input_assembly = info.getInputAssemblyStateInfo();
-    cmd.setPrimitiveTopologyEXT(input_assembly.getTopology());
-    cmd.setPrimitiveRestartEnableEXT(input_assembly.isPrimitiveRestartEnabled());
+    const auto topology = input_assembly.getTopology();
+    if (cmd.isDynamicStateChanged(ePrimitiveTopology, topology)) {
+        cmd.setPrimitiveTopologyEXT(topology);
+    }
+    const vk::Bool32 primitive_restart_enabled = input_assembly.isPrimitiveRestartEnabled();
+    if (cmd.isDynamicStateChanged(ePrimitiveRestartEnable, primitive_restart_enabled)) {
+        cmd.setPrimitiveRestartEnableEXT(primitive_restart_enabled);
+    }
 
-    if (input_assembly.getTopology() == vk::PrimitiveTopology::ePatchList) {
-        const auto & tessellation = info.getTessellationStateInfo();
-        cmd.setPatchControlPointsEXT(tessellation.getPatchControlPoints());
+    if (topology == vk::PrimitiveTopology::ePatchList) {
+        const auto control_points = info.getTessellationStateInfo().getPatchControlPoints();
+        if (cmd.isDynamicStateChanged(ePatchControlPointsEXT, control_points)) {
+            cmd.setPatchControlPointsEXT(control_points);
+        }
     }
 
     const auto & viewport = info.getViewportStateInfo();
-    if (not viewport.getViewports().empty()) {
+    if (not viewport.getViewports().empty() and cmd.isDynamicStateChanged(eViewportWithCount, viewport.getViewports())) {
         cmd.setViewportWithCountEXT(viewport.getViewports());
     }
-    if (not viewport.getScissors().empty()) {
+    if (not viewport.getScissors().empty() and cmd.isDynamicStateChanged(eScissorWithCount, viewport.getScissors())) {
         cmd.setScissorWithCountEXT(viewport.getScissors());
     }
 
     const auto & rasterization = info.getRasterizationStateInfo();
-    cmd.setDepthClampEnableEXT(rasterization.isDepthClampEnabled());
-    cmd.setRasterizerDiscardEnableEXT(rasterization.isRasterizerDiscardEnabled());
-    cmd.setPolygonModeEXT(rasterization.getPolygonMode());
-    cmd.setCullModeEXT(rasterization.getCullMode());
-    cmd.setFrontFaceEXT(rasterization.getFrontFace());
-    cmd.setDepthBiasEnableEXT(rasterization.isDepthBiasEnabled());
-    cmd.setDepthBias(
+    const vk::Bool32 depth_clamp_enabled = rasterization.isDepthClampEnabled();
+    if (cmd.isDynamicStateChanged(eDepthClampEnableEXT, depth_clamp_enabled)) {
+        cmd.setDepthClampEnableEXT(depth_clamp_enabled);
+    }
+    const vk::Bool32 rasterizer_discard_enabled = rasterization.isRasterizerDiscardEnabled();
+    if (cmd.isDynamicStateChanged(eRasterizerDiscardEnable, rasterizer_discard_enabled)) {
+        cmd.setRasterizerDiscardEnableEXT(rasterizer_discard_enabled);
+    }
+    const auto polygon_mode = rasterization.getPolygonMode();
+    if (cmd.isDynamicStateChanged(ePolygonModeEXT, polygon_mode)) {
+        cmd.setPolygonModeEXT(polygon_mode);
+    }
+    const auto cull_mode = rasterization.getCullMode();
+    if (cmd.isDynamicStateChanged(eCullMode, cull_mode)) {
+        cmd.setCullModeEXT(cull_mode);
+    }
+    const auto front_face = rasterization.getFrontFace();
+    if (cmd.isDynamicStateChanged(eFrontFace, front_face)) {
+        cmd.setFrontFaceEXT(front_face);
+    }
+    const vk::Bool32 depth_bias_enabled = rasterization.isDepthBiasEnabled();
+    if (cmd.isDynamicStateChanged(eDepthBiasEnable, depth_bias_enabled)) {
+        cmd.setDepthBiasEnableEXT(depth_bias_enabled);
+    }
+    const std::array depth_bias {
         rasterization.getDepthBiasConstantFactor(),
         rasterization.getDepthBiasClamp(),
-        rasterization.getDepthBiasSlopeFactor());
-    cmd.setLineWidth(rasterization.getLineWidth());
+        rasterization.getDepthBiasSlopeFactor(),
+    };
+    if (cmd.isDynamicStateChanged(eDepthBias, depth_bias)) {
+        cmd.setDepthBias(depth_bias[0], depth_bias[1], depth_bias[2]);
+    }
+    const auto line_width = rasterization.getLineWidth();
+    if (cmd.isDynamicStateChanged(eLineWidth, line_width)) {
+        cmd.setLineWidth(line_width);
+    }
 
     const auto & multisample = info.getMultisampleStateInfo();
     const auto samples = multisample.getRasterizationSamples();
-    cmd.setRasterizationSamplesEXT(samples);
-    if (multisample.getSampleMask().empty()) {
-        const auto sample_count = static_cast<uint32_t>(samples);
-        std::vector<vk::SampleMask> sample_mask((sample_count + 31u) / 32u, ~vk::SampleMask {0});
-        cmd.setSampleMaskEXT(samples, sample_mask);
-    } else {
-        cmd.setSampleMaskEXT(samples, multisample.getSampleMask());
-    }
-    cmd.setAlphaToCoverageEnableEXT(multisample.isAlphaToCoverageEnabled());
-    cmd.setAlphaToOneEnableEXT(multisample.isAlphaToOneEnabled());
+    if (cmd.isDynamicStateChanged(eRasterizationSamplesEXT, samples)) {
+        cmd.setRasterizationSamplesEXT(samples);
+    }
+    if (cmd.isDynamicStateChanged(eSampleMaskEXT, samples, multisample.getSampleMask())) {
+        if (multisample.getSampleMask().empty()) {
+            const auto sample_count = static_cast<uint32_t>(samples);
+            std::vector<vk::SampleMask> sample_mask((sample_count + 31u) / 32u, ~vk::SampleMask {0});
+            cmd.setSampleMaskEXT(samples, sample_mask);
+        } else {
+            cmd.setSampleMaskEXT(samples, multisample.getSampleMask());
+        }
+    }
+    const vk::Bool32 alpha_to_coverage_enabled = multisample.isAlphaToCoverageEnabled();
+    if (cmd.isDynamicStateChanged(eAlphaToCoverageEnableEXT, alpha_to_coverage_enabled)) {
+        cmd.setAlphaToCoverageEnableEXT(alpha_to_coverage_enabled);
+    }
+    const vk::Bool32 alpha_to_one_enabled = multisample.isAlphaToOneEnabled();
+    if (cmd.isDynamicStateChanged(eAlphaToOneEnableEXT, alpha_to_one_enabled)) {
+        cmd.setAlphaToOneEnableEXT(alpha_to_one_enabled);
+    }
 
     const auto & depth_stencil = info.getDepthStencilStateInfo();
-    cmd.setDepthTestEnableEXT(depth_stencil.isDepthTestEnabled());
-    cmd.setDepthWriteEnableEXT(depth_stencil.isDepthWriteEnabled());
-    cmd.setDepthCompareOpEXT(depth_stencil.getDepthCompareOp());
-    cmd.setDepthBoundsTestEnableEXT(depth_stencil.isDepthBoundsTestEnabled());
-    cmd.setDepthBounds(depth_stencil.getMinDepthBounds(), depth_stencil.getMaxDepthBounds());
-    cmd.setStencilTestEnableEXT(depth_stencil.isStencilTestEnabled());
+    const vk::Bool32 depth_test_enabled = depth_stencil.isDepthTestEnabled();
+    if (cmd.isDynamicStateChanged(eDepthTestEnable, depth_test_enabled)) {
+        cmd.setDepthTestEnableEXT(depth_test_enabled);
+    }
+    const vk::Bool32 depth_write_enabled = depth_stencil.isDepthWriteEnabled();
+    if (cmd.isDynamicStateChanged(eDepthWriteEnable, depth_write_enabled)) {
+        cmd.setDepthWriteEnableEXT(depth_write_enabled);
+    }
+    const auto depth_compare_op = depth_stencil.getDepthCompareOp();
+    if (cmd.isDynamicStateChanged(eDepthCompareOp, depth_compare_op)) {
+        cmd.setDepthCompareOpEXT(depth_compare_op);
+    }
+    const vk::Bool32 depth_bounds_test_enabled = depth_stencil.isDepthBoundsTestEnabled();
+    if (cmd.isDynamicStateChanged(eDepthBoundsTestEnable, depth_bounds_test_enabled)) {
+        cmd.setDepthBoundsTestEnableEXT(depth_bounds_test_enabled);
+    }
+    const std::array depth_bounds { depth_stencil.getMinDepthBounds(), depth_stencil.getMaxDepthBounds() };
+    if (cmd.isDynamicStateChanged(eDepthBounds, depth_bounds)) {
+        cmd.setDepthBounds(depth_bounds[0], depth_bounds[1]);
+    }
+    const vk::Bool32 stencil_test_enabled = depth_stencil.isStencilTestEnabled();
+    if (cmd.isDynamicStateChanged(eStencilTestEnable, stencil_test_enabled)) {
+        cmd.setStencilTestEnableEXT(stencil_test_enabled);
+    }
 
-    const auto & front_stencil = depth_stencil.getFrontStencilState();
-    const auto & back_stencil = depth_stencil.getBackStencilState();
-    cmd.setStencilOpEXT(
-        vk::StencilFaceFlagBits::eFront,
-        front_stencil.failOp,
-        front_stencil.passOp,
-        front_stencil.depthFailOp,
-        front_stencil.compareOp);
-    cmd.setStencilOpEXT(
-        vk::StencilFaceFlagBits::eBack,
-        back_stencil.failOp,
-        back_stencil.passOp,
-        back_stencil.depthFailOp,
-        back_stencil.compareOp);
-    cmd.setStencilCompareMask(vk::StencilFaceFlagBits::eFront, front_stencil.compareMask);
-    cmd.setStencilCompareMask(vk::StencilFaceFlagBits::eBack, back_stencil.compareMask);
-    cmd.setStencilWriteMask(vk::StencilFaceFlagBits::eFront, front_stencil.writeMask);
-    cmd.setStencilWriteMask(vk::StencilFaceFlagBits::eBack, back_stencil.writeMask);
-    cmd.setStencilReference(vk::StencilFaceFlagBits::eFront, front_stencil.reference);
-    cmd.setStencilReference(vk::StencilFaceFlagBits::eBack, back_stencil.reference);
+    auto set_stencil_face = [&cmd](vk::StencilFaceFlagBits face, uint32_t face_key, const vk::StencilOpState & stencil) {
+        if (cmd.isDynamicStateChanged({eStencilOp, face_key}, stencil.failOp, stencil.passOp, stencil.depthFailOp, stencil.compareOp)) {
+            cmd.setStencilOpEXT(face, stencil.failOp, stencil.passOp, stencil.depthFailOp, stencil.compareOp);
+        }
+        if (cmd.isDynamicStateChanged({eStencilCompareMask, face_key}, stencil.compareMask)) {
+            cmd.setStencilCompareMask(face, stencil.compareMask);
+        }
+        if (cmd.isDynamicStateChanged({eStencilWriteMask, face_key}, stencil.writeMask)) {
+            cmd.setStencilWriteMask(face, stencil.writeMask);
+        }
+        if (cmd.isDynamicStateChanged({eStencilReference, face_key}, stencil.reference)) {
+            cmd.setStencilReference(face, stencil.reference);
+        }
+    };
+    set_stencil_face(vk::StencilFaceFlagBits::eFront, k_front, depth_stencil.getFrontStencilState());
+    set_stencil_face(vk::StencilFaceFlagBits::eBack, k_back, depth_stencil.getBackStencilState());
 
     const auto & color_blend = info.getColorBlendStateInfo();
-    cmd.setLogicOpEnableEXT(color_blend.isLogicOpEnabled());
-    cmd.setLogicOpEXT(color_blend.getLogicOp());
-    cmd.setBlendConstants(color_blend.getBlendConstants().data());
+    const vk::Bool32 logic_op_enabled = color_blend.isLogicOpEnabled();
+    if (cmd.isDynamicStateChanged(eLogicOpEnableEXT, logic_op_enabled)) {
+        cmd.setLogicOpEnableEXT(logic_op_enabled);
+    }
+    const auto logic_op = color_blend.getLogicOp();
+    if (cmd.isDynamicStateChanged(eLogicOpEXT, logic_op)) {
+        cmd.setLogicOpEXT(logic_op);
+    }
+    if (cmd.isDynamicStateChanged(eBlendConstants, color_blend.getBlendConstants())) {
+        cmd.setBlendConstants(color_blend.getBlendConstants().data());
+    }
 
     const auto & attachments = color_blend.getColorBlendAttachmentStates();
-    if (not attachments.empty()) {
+    if (not attachments.empty() and cmd.isDynamicStateChanged(eColorBlendEquationEXT, attachments)) {
         std::vector<vk::Bool32> blend_enables;
         std::vector<vk::ColorBlendEquationEXT> blend_equations;
         std::vector<vk::ColorComponentFlags> write_masks;
@@ -13,7 +13,8 @@ namespace lcf::vkc {
 std::error_code GraphicsPipeline::create(
     vk::Device device,
     const GraphicsPipelineInfo & pipeline_info,
-    const StaticRenderScopeInfo & render_scope_info) noexcept
+    const StaticRenderScopeInfo & render_scope_info,
+    vk::PipelineCache pipeline_cache) noexcept
 {
     const ShaderProgramInfo & shader_program_info = pipeline_info.getShaderProgramInfo();
     auto shader_stage_infos_view = shader_program_info.viewStageInfos();
@@ -63,7 +64,7 @@ std::error_code GraphicsPipeline::create(
         .setRenderPass(render_scope_info.getRenderPass())
         .setSubpass(render_scope_info.getSubpassIndex());
     try {
-        auto [result, pipeline] = device.createGraphicsPipelineUnique(nullptr, pipeline_create_info);
+        auto [result, pipeline] = device.createGraphicsPipelineUnique(pipeline_cache, pipeline_create_info);
         if (result != vk::Result::eSuccess) { return result; }
         m_pipeline = std::move(pipeline);
     } catch (const vk::SystemError & e) {
@@ -75,7 +76,8 @@ std::error_code GraphicsPipeline::create(
 std::error_code GraphicsPipeline::create(
     vk::Device device,
     const GraphicsPipelineInfo & pipeline_info,
-    const DynamicRenderScopeInfo & render_scope_info) noexcept
+    const DynamicRenderScopeInfo & render_scope_info,
+    vk::PipelineCache pipeline_cache) noexcept
 {
     const ShaderProgramInfo & shader_program_info = pipeline_info.getShaderProgramInfo();
     auto shader_stage_infos_view = shader_program_info.viewStageInfos();
@@ -129,7 +131,7 @@ std::error_code GraphicsPipeline::create(
         .setPDynamicState(&static_cast<const vk::PipelineDynamicStateCreateInfo &>(pipeline_info.getDynamicStateInfo()))
         .setLayout(m_pipeline_layout.get());
     try {
-        auto [result, pipeline] = device.createGraphicsPipelineUnique(nullptr, pipeline_create_info);
+        auto [result, pipeline] = device.createGraphicsPipelineUnique(pipeline_cache, pipeline_create_info);
         if (result != vk::Result::eSuccess) { return result; }
         m_pipeline = std::move(pipeline);
     } catch (const vk::SystemError & e) {
@@ -141,6 +143,7 @@ std::error_code GraphicsPipeline::create(
 void GraphicsPipeline::bind(CommandBufferProxy & cmd) const noexcept
 {
     cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, this->handle());
+    cmd.invalidatePipelineState();
 }
 
 } // namespace lcf::vkc
@@ -141,7 +141,7 @@ auto ShaderObjectBindingState::merge(const ShaderObjectGroup & group) noexcept -
 void ShaderObjectBindingState::bind(CommandBufferProxy & cmd) const noexcept
 {
     if (m_handles.empty()) { return; }
-    cmd.bindShadersEXT(m_handles.keys(), m_handles.values());
+    cmd.bindShadersIfChanged(m_handles.keys(), m_handles.values());
     cmd.pinLeases(m_leases.values());
 }
 
@@ -39,29 +39,48 @@ std::expected<CommandBufferBatch, std::error_code> Queue::allocateCommandBufferB
 
 std::expected<SubmissionToken, std::error_code> Queue::submit(CommandBufferBatch && batch) noexcept
 {
-    if (batch.getValidationData() != this) { return std::unexpected(make_error_code(errc::command_buffer_batch_queue_mismatch)); }
+    return this->submitMany(std::span(&batch, 1));
+}
+
+std::expected<SubmissionToken, std::error_code> Queue::submitMany(std::span<CommandBufferBatch> batches) noexcept
+{
+    if (batches.empty()) { return std::unexpected(std::make_error_code(std::errc::invalid_argument)); }
+    size_t cmd_buffer_count = 0u, signal_count = 1u;
+    for (const auto & batch : batches) {
+        if (batch.getValidationData() != this) { return std::unexpected(make_error_code(errc::command_buffer_batch_queue_mismatch)); }
+        if (batch.isSecondary()) { return std::unexpected(make_error_code(errc::command_buffer_batch_level_mismatch)); }
+        cmd_buffer_count += batch.getCommandBuffers().size();
+        signal_count += batch.getSignalInfos().size();
+    }
     SubmissionToken timeline_signal = m_timeline.advanceTarget().generateSubmitInfo();
-    auto cmd_submit_infos = batch.getCommandBuffers() |
-        stdv::transform([](vk::CommandBuffer cmd) { return vk::CommandBufferSubmitInfo {cmd}; }) |
-        stdr::to<std::vector>();
-    std::span<const SubmissionToken> wait_infos = batch.getWaitInfos();
-    auto signal_infos = batch.getSignalInfos() | stdr::to<std::vector>();
-    signal_infos.emplace_back(timeline_signal);
+    m_submit_arena.reset(batches.size(), cmd_buffer_count, signal_count);
+    for (const auto & batch : batches) {
+        auto wait_infos = batch.getWaitInfos();
+        auto cmd_buffer_infos = m_submit_arena.pushCommandBuffers(batch.getCommandBuffers());
+        auto signal_infos = m_submit_arena.pushSignalInfos(batch.getSignalInfos());
+        if (&batch == &batches.back()) {
+            //- only the last submit signals the timeline, its first synchronization scope covers the earlier batches
+            m_submit_arena.pushSignalInfos(std::span(&timeline_signal, 1));
+            signal_infos = {signal_infos.data(), signal_infos.size() + 1};
+        }
+        m_submit_arena.pushSubmitInfo()
+            .setWaitSemaphoreInfos(wait_infos)
+            .setCommandBufferInfos(cmd_buffer_infos)
+            .setSignalSemaphoreInfos(signal_infos);
+    }
 
-    vk::SubmitInfo2 submit_info;
-    submit_info.setWaitSemaphoreInfos(wait_infos)
-        .setCommandBufferInfos(cmd_submit_infos)
-        .setSignalSemaphoreInfos(signal_infos);
     uint64_t target_timestamp = m_timeline.getTargetTimestamp();
     try {
         QueueAccess queue_access {m_logical_queue};
-        queue_access->submit2(submit_info);
+        queue_access->submit2(m_submit_arena.getSubmitInfos());
     } catch (const vk::SystemError & e) {
-        m_cmd_allocator.retire(target_timestamp, std::move(batch));
+        for (auto & batch : batches) { m_cmd_allocator.retire(target_timestamp, std::move(batch)); }
         return std::unexpected(e.code());
     }
-    m_lease_batch_queue.emplace(target_timestamp, batch.takeLeases());
-    m_cmd_allocator.retire(target_timestamp, std::move(batch));
+    auto leases = batches.front().takeLeases();
+    for (auto & batch : batches.subspan(1)) { leases.append_range(batch.takeLeases()); }
+    m_lease_batch_queue.emplace(target_timestamp, std::move(leases));
+    for (auto & batch : batches) { m_cmd_allocator.retire(target_timestamp, std::move(batch)); }
     return timeline_signal;
 }
 
@@ -0,0 +1,149 @@
+// Vertex cache, overdraw and meshlet passes on a shuffled grid: ACMR drops, triangles survive, limits hold.
+
+#include "render_assets/GeometryOptimization.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+namespace {
+
+    using Triangle = std::array<uint32_t, 3>;
+
+    struct Mesh
+    {
+        std::vector<uint32_t> indices;
+        std::vector<float> positions;
+        uint32_t vertex_count = 0;
+    };
+
+    //- a bumpy height field split into triangles, shuffled so the input order has no locality left
+    Mesh make_shuffled_grid(uint32_t quads_per_side, uint32_t seed)
+    {
+        Mesh mesh;
+        const uint32_t side = quads_per_side + 1;
+        mesh.vertex_count = side * side;
+        for (uint32_t y = 0; y < side; ++y) {
+            for (uint32_t x = 0; x < side; ++x) {
+                mesh.positions.insert(mesh.positions.end(), {float(x), float(y), float((x * 7 + y * 3) % 5) * 0.25f});
+            }
+        }
+        std::vector<Triangle> triangles;
+        for (uint32_t y = 0; y < quads_per_side; ++y) {
+            for (uint32_t x = 0; x < quads_per_side; ++x) {
+                uint32_t v = y * side + x;
+                triangles.push_back({v, v + 1, v + side});
+                triangles.push_back({v + 1, v + side + 1, v + side});
+            }
+        }
+        std::mt19937 rng {seed};
+        std::ranges::shuffle(triangles, rng);
+        for (const auto & triangle : triangles) { mesh.indices.insert(mesh.indices.end(), triangle.begin(), triangle.end()); }
+        return mesh;
+    }
+
+    //- rotated so the smallest index leads, which keeps the winding, then sorted
+    std::vector<Triangle> canonical_triangles(std::span<const uint32_t> indices)
+    {
+        std::vector<Triangle> triangles;
+        for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+            Triangle triangle {indices[t], indices[t + 1], indices[t + 2]};
+            std::ranges::rotate(triangle, std::ranges::min_element(triangle));
+            triangles.push_back(triangle);
+        }
+        std::ranges::sort(triangles);
+        return triangles;
+    }
+
+    TEST(VertexCache, AcmrDropsAndTrianglesArePreserved)
+    {
+        auto mesh = make_shuffled_grid(48, 3);
+        const auto input_triangles = canonical_triangles(mesh.indices);
+        float input_acmr = lcf::compute_acmr(mesh.indices, mesh.vertex_count);
+        lcf::optimize_vertex_cache(mesh.indices, mesh.vertex_count);
+        float optimized_acmr = lcf::compute_acmr(mesh.indices, mesh.vertex_count);
+        EXPECT_LT(optimized_acmr, input_acmr * 0.5f) << "input " << input_acmr << " optimized " << optimized_acmr;
+        EXPECT_LT(optimized_acmr, 1.0f);
+        EXPECT_EQ(canonical_triangles(mesh.indices), input_triangles);
+    }
+
+    TEST(Overdraw, KeepsTrianglesAndStaysNearTheCacheOptimizedAcmr)
+    {
+        auto mesh = make_shuffled_grid(48, 5);
+        const auto input_triangles = canonical_triangles(mesh.indices);
+        lcf::optimize_vertex_cache(mesh.indices, mesh.vertex_count);
+        float cache_acmr = lcf::compute_acmr(mesh.indices, mesh.vertex_count);
+        constexpr float threshold = 1.05f;
+        lcf::optimize_overdraw(mesh.indices, mesh.positions, mesh.vertex_count, threshold);
+        EXPECT_EQ(canonical_triangles(mesh.indices), input_triangles);
+        //- clusters are cut on cache restarts or within the threshold, so reordering them costs little
+        EXPECT_LE(lcf::compute_acmr(mesh.indices, mesh.vertex_count), cache_acmr * threshold + 0.05f);
+    }
+
+    TEST(VertexFetchRemap, IsAPermutationInFirstUseOrder)
+    {
+        auto mesh = make_shuffled_grid(16, 7);
+        mesh.vertex_count += 5; //- unreferenced vertices go to the end
+        auto remap = lcf::generate_vertex_fetch_remap(mesh.indices, mesh.vertex_count);
+        ASSERT_EQ(remap.size(), mesh.vertex_count);
+        auto sorted_remap = remap;
+        std::ranges::sort(sorted_remap);
+        std::vector<uint32_t> identity(mesh.vertex_count);
+        std::iota(identity.begin(), identity.end(), 0u);
+        EXPECT_EQ(sorted_remap, identity);
+        EXPECT_EQ(remap[mesh.indices[0]], 0u);
+        for (uint32_t v = mesh.vertex_count - 5; v < mesh.vertex_count; ++v) { EXPECT_GE(remap[v], mesh.vertex_count - 5); }
+    }
+
+    TEST(Meshlets, RespectLimitsAndCoverEveryTriangle)
+    {
+        auto mesh = make_shuffled_grid(40, 9);
+        lcf::optimize_vertex_cache(mesh.indices, mesh.vertex_count);
+        for (auto [max_vertices, max_triangles] : {std::pair {lcf::c_meshlet_max_vertices, lcf::c_meshlet_max_triangles}, std::pair {16u, 10u}}) {
+            auto data = lcf::build_meshlets(mesh.indices, mesh.positions, max_vertices, max_triangles);
+            ASSERT_EQ(data.m_bounds.size(), data.m_meshlets.size());
+            std::vector<uint32_t> rebuilt_indices;
+            for (const auto & meshlet : data.m_meshlets) {
+                EXPECT_GT(meshlet.m_triangle_count, 0u);
+                EXPECT_LE(meshlet.m_vertex_count, max_vertices);
+                EXPECT_LE(meshlet.m_triangle_count, max_triangles);
+                EXPECT_EQ(meshlet.m_triangle_offset % 4, 0u);
+                ASSERT_LE(meshlet.m_vertex_offset + meshlet.m_vertex_count, data.m_vertex_indices.size());
+                ASSERT_LE(meshlet.m_triangle_offset + meshlet.m_triangle_count * 3, data.m_triangle_indices.size());
+                for (uint32_t i = 0; i < meshlet.m_triangle_count * 3; ++i) {
+                    uint8_t local_index = data.m_triangle_indices[meshlet.m_triangle_offset + i];
+                    ASSERT_LT(local_index, meshlet.m_vertex_count);
+                    rebuilt_indices.push_back(data.m_vertex_indices[meshlet.m_vertex_offset + local_index]);
+                }
+            }
+            EXPECT_EQ(canonical_triangles(rebuilt_indices), canonical_triangles(mesh.indices)) << "limits " << max_vertices << " " << max_triangles;
+        }
+    }
+
+    TEST(OutOfRangeIndices, PassesLeaveIndicesAloneAndMeshletsSkipThem)
+    {
+        auto mesh = make_shuffled_grid(8, 11);
+        const uint32_t out_of_range = mesh.vertex_count + 100;
+        mesh.indices.insert(mesh.indices.end(), {0, 1, out_of_range});
+        const auto input_indices = mesh.indices;
+
+        lcf::optimize_vertex_cache(mesh.indices, mesh.vertex_count);
+        EXPECT_EQ(mesh.indices, input_indices);
+        lcf::optimize_overdraw(mesh.indices, mesh.positions, mesh.vertex_count);
+        EXPECT_EQ(mesh.indices, input_indices);
+
+        auto remap = lcf::generate_vertex_fetch_remap(mesh.indices, mesh.vertex_count);
+        EXPECT_EQ(remap.size(), mesh.vertex_count);
+        EXPECT_GT(lcf::compute_acmr(mesh.indices, mesh.vertex_count), 0.0f);
+
+        auto data = lcf::build_meshlets(mesh.indices, mesh.positions);
+        uint32_t triangle_count = 0;
+        for (const auto & meshlet : data.m_meshlets) { triangle_count += meshlet.m_triangle_count; }
+        EXPECT_EQ(triangle_count, mesh.indices.size() / 3 - 1);
+        EXPECT_TRUE(std::ranges::none_of(data.m_vertex_indices, [&mesh](uint32_t v) { return v >= mesh.vertex_count; }));
+    }
+}
@@ -0,0 +1,141 @@
+// Octahedral unit vector encoding against an angular error bound, and the compact index codec round trip.
+
+#include "render_assets/VertexEncoding.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+namespace {
+
+    //- two snorm16 components put octahedral samples about 3e-5 apart, the worst case sits near the folded edges
+    constexpr float k_max_octahedral_error_degrees = 0.01f;
+
+    //- atan2 of the cross and dot products, acos of a float dot product cannot resolve angles this small
+    float angle_degrees(const std::array<float, 3> & a, const std::array<float, 3> & b)
+    {
+        double cross[3] = {
+            double(a[1]) * b[2] - double(a[2]) * b[1],
+            double(a[2]) * b[0] - double(a[0]) * b[2],
+            double(a[0]) * b[1] - double(a[1]) * b[0],
+        };
+        double dot = double(a[0]) * b[0] + double(a[1]) * b[1] + double(a[2]) * b[2];
+        double angle = std::atan2(std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]), dot);
+        return static_cast<float>(angle * 180.0 / std::numbers::pi);
+    }
+
+    std::array<float, 3> normalized(float x, float y, float z)
+    {
+        float inverse_length = 1.0f / std::sqrt(x * x + y * y + z * z);
+        return {x * inverse_length, y * inverse_length, z * inverse_length};
+    }
+
+    TEST(OctahedralEncoding, AxesAndDiagonalsRoundTrip)
+    {
+        const std::array<std::array<float, 3>, 14> directions {{
+            {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+            {1, 1, 1}, {-1, 1, 1}, {1, -1, 1}, {-1, -1, 1}, {1, 1, -1}, {-1, 1, -1}, {1, -1, -1}, {-1, -1, -1},
+        }};
+        for (const auto & direction : directions) {
+            auto expected = normalized(direction[0], direction[1], direction[2]);
+            auto decoded = lcf::decode_octahedral(lcf::encode_octahedral(expected[0], expected[1], expected[2]));
+            EXPECT_LE(angle_degrees(decoded, expected), k_max_octahedral_error_degrees)
+                << "direction " << direction[0] << " " << direction[1] << " " << direction[2];
+        }
+    }
+
+    TEST(OctahedralEncoding, RandomDirectionsStayWithinErrorBound)
+    {
+        std::mt19937 rng {7};
+        std::normal_distribution<float> distribution;
+        float max_error = 0.0f;
+        for (uint32_t i = 0; i < 200000; ++i) {
+            float x = distribution(rng), y = distribution(rng), z = distribution(rng);
+            if (x * x + y * y + z * z < 1e-6f) { continue; }
+            auto expected = normalized(x, y, z);
+            auto decoded = lcf::decode_octahedral(lcf::encode_octahedral(x, y, z));
+            max_error = std::max(max_error, angle_degrees(decoded, expected));
+        }
+        EXPECT_LE(max_error, k_max_octahedral_error_degrees);
+    }
+
+    TEST(OctahedralEncoding, DecodesToUnitLength)
+    {
+        for (uint32_t bits : {0u, 0x7FFF7FFFu, 0x80018001u, 0x12345678u, 0xFFFFFFFFu}) {
+            auto decoded = lcf::decode_octahedral(bits);
+            float length = std::sqrt(decoded[0] * decoded[0] + decoded[1] * decoded[1] + decoded[2] * decoded[2]);
+            EXPECT_NEAR(length, 1.0f, 1e-5f) << "bits " << bits;
+        }
+    }
+
+    void expect_index_round_trip(const std::vector<uint32_t> & indices)
+    {
+        auto encoded = lcf::encode_index_buffer(indices);
+        auto decoded = lcf::decode_index_buffer(encoded, indices.size());
+        ASSERT_TRUE(decoded.has_value()) << decoded.error().message();
+        EXPECT_EQ(*decoded, indices);
+    }
+
+    TEST(IndexCodec, EmptyRoundTrips)
+    {
+        expect_index_round_trip({});
+    }
+
+    TEST(IndexCodec, StripOrderedIndicesCostAboutAByteEach)
+    {
+        std::vector<uint32_t> indices;
+        for (uint32_t i = 0; i + 2 < 3000; ++i) { indices.insert(indices.end(), {i, i + 1, i + 2}); }
+        expect_index_round_trip(indices);
+        EXPECT_LT(lcf::encode_index_buffer(indices).size(), indices.size() * 2);
+    }
+
+    TEST(IndexCodec, RandomIndicesRoundTrip)
+    {
+        std::mt19937 rng {11};
+        std::uniform_int_distribution<uint32_t> distribution;
+        std::vector<uint32_t> indices(30000);
+        for (auto & index : indices) { index = distribution(rng); }
+        expect_index_round_trip(indices);
+    }
+
+    TEST(IndexCodec, ExtremeJumpsRoundTrip)
+    {
+        constexpr uint32_t max_index = std::numeric_limits<uint32_t>::max();
+        expect_index_round_trip({0, max_index, 0, 0x80000000u, 0, 0x7FFFFFFFu, 0x80000000u, 1, max_index - 1, 2});
+    }
+
+    TEST(IndexCodec, RejectsTruncatedAndMalformedStreams)
+    {
+        std::vector<uint32_t> indices {0, 1, 2, 2, 1, 3, 100000, 4, 5};
+        auto encoded = lcf::encode_index_buffer(indices);
+        EXPECT_FALSE(lcf::decode_index_buffer(std::span(encoded).first(encoded.size() - 1), indices.size()).has_value());
+        EXPECT_FALSE(lcf::decode_index_buffer({}, 0).has_value());
+
+        auto wrong_version = encoded;
+        wrong_version[0] ^= 0xFF;
+        EXPECT_FALSE(lcf::decode_index_buffer(wrong_version, indices.size()).has_value());
+
+        const std::vector<uint8_t> unterminated_varint {encoded[0], 0x80, 0x80, 0x80, 0x80, 0x80};
+        EXPECT_FALSE(lcf::decode_index_buffer(unterminated_varint, 1).has_value());
+
+        const std::vector<uint8_t> oversized_varint {encoded[0], 0xFF, 0xFF, 0xFF, 0xFF, 0x7F};
+        EXPECT_FALSE(lcf::decode_index_buffer(oversized_varint, 1).has_value());
+    }
+
+    TEST(IndexCodec, RejectsCountsTheStreamCannotHold)
+    {
+        const std::vector<uint32_t> indices {0, 1, 2};
+        auto encoded = lcf::encode_index_buffer(indices);
+        auto decoded = lcf::decode_index_buffer(encoded, std::numeric_limits<size_t>::max());
+        ASSERT_FALSE(decoded.has_value());
+        EXPECT_EQ(decoded.error(), std::errc::illegal_byte_sequence);
+        EXPECT_FALSE(lcf::decode_index_buffer(encoded, encoded.size()).has_value());
+        EXPECT_TRUE(lcf::decode_index_buffer(encoded, indices.size()).has_value());
+    }
+}
@@ -0,0 +1,110 @@
+// Batch float <-> half conversion benchmarks (google-benchmark).
+//
+// Standalone executable (NOT registered with CTest). Run manually:
+//   .\utilities_float16_bench.exe                 (Windows)
+//   ./utilities_float16_bench                      (Linux)
+//
+// Compares the runtime dispatched path against the scalar fallback and the
+// element-wise half_float::half conversion the engine used before.
+
+#include "float16_convert.h"
+#include <log.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+    constexpr int N_texture = 1024 * 1024 * 4; //- one 1k rgba layer
+    constexpr int N_vertices = 65'536 * 3;
+
+    std::vector<float> make_floats(int n)
+    {
+        std::vector<float> values(static_cast<std::size_t>(n));
+        for (int i = 0; i < n; ++i) { values[i] = static_cast<float>(i % 4096) / 64.0f - 16.0f; }
+        return values;
+    }
+
+    // ============================================================
+    // F.1  float -> half
+    // ============================================================
+    static void BM_F32ToF16_Element(benchmark::State & state)
+    {
+        const auto src = make_floats(static_cast<int>(state.range(0)));
+        std::vector<lcf::float16_t> dst(src.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < src.size(); ++i) { dst[i] = static_cast<lcf::float16_t>(src[i]); }
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    static void BM_F32ToF16_Path(benchmark::State & state, lcf::details::Float16ConvertPath path)
+    {
+        const auto src = make_floats(static_cast<int>(state.range(0)));
+        std::vector<uint16_t> dst(src.size());
+        for (auto _ : state) {
+            lcf::details::convert_f32_to_f16(src.data(), dst.data(), src.size(), path);
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK(BM_F32ToF16_Element)->Arg(N_texture)->Arg(N_vertices)->Name("F32ToF16/half_element");
+    BENCHMARK_CAPTURE(BM_F32ToF16_Path, scalar, lcf::details::Float16ConvertPath::eScalar)->Arg(N_texture)->Arg(N_vertices)->Name("F32ToF16/scalar");
+    BENCHMARK_CAPTURE(BM_F32ToF16_Path, dispatched, lcf::details::get_float16_convert_path())->Arg(N_texture)->Arg(N_vertices)->Name("F32ToF16/dispatched");
+
+    // ============================================================
+    // F.2  half -> float
+    // ============================================================
+    static void BM_F16ToF32_Element(benchmark::State & state)
+    {
+        const auto floats = make_floats(static_cast<int>(state.range(0)));
+        std::vector<lcf::float16_t> src(floats.size());
+        lcf::convert_f32_to_f16(floats, src);
+        std::vector<float> dst(src.size());
+        for (auto _ : state) {
+            for (std::size_t i = 0; i < src.size(); ++i) { dst[i] = static_cast<float>(src[i]); }
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    static void BM_F16ToF32_Path(benchmark::State & state, lcf::details::Float16ConvertPath path)
+    {
+        const auto floats = make_floats(static_cast<int>(state.range(0)));
+        std::vector<uint16_t> src(floats.size());
+        lcf::details::convert_f32_to_f16_scalar(floats.data(), src.data(), src.size());
+        std::vector<float> dst(src.size());
+        for (auto _ : state) {
+            lcf::details::convert_f16_to_f32(src.data(), dst.data(), src.size(), path);
+            benchmark::DoNotOptimize(dst.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    BENCHMARK(BM_F16ToF32_Element)->Arg(N_texture)->Arg(N_vertices)->Name("F16ToF32/half_element");
+    BENCHMARK_CAPTURE(BM_F16ToF32_Path, scalar, lcf::details::Float16ConvertPath::eScalar)->Arg(N_texture)->Arg(N_vertices)->Name("F16ToF32/scalar");
+    BENCHMARK_CAPTURE(BM_F16ToF32_Path, dispatched, lcf::details::get_float16_convert_path())->Arg(N_texture)->Arg(N_vertices)->Name("F16ToF32/dispatched");
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+    lcf::Logger::init();
+    lcf_log_info("float16 batch conversion benchmark, dispatched path = {}", static_cast<int>(lcf::details::get_float16_convert_path()));
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) { return 1; }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    lcf_log_info("Benchmark suite finished");
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Batch float <-> half conversion: scalar reference values and bit-exact agreement of every simd path.
+
+#include "float16_convert.h"
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+    using lcf::details::Float16ConvertPath;
+
+    std::vector<Float16ConvertPath> supported_paths()
+    {
+        std::vector<Float16ConvertPath> paths {Float16ConvertPath::eScalar};
+        const Float16ConvertPath best = lcf::details::get_float16_convert_path();
+        if (best == Float16ConvertPath::eF16C or best == Float16ConvertPath::eAVX512) { paths.push_back(Float16ConvertPath::eF16C); }
+        if (best == Float16ConvertPath::eAVX512) { paths.push_back(Float16ConvertPath::eAVX512); }
+        return paths;
+    }
+
+    uint16_t to_half_bits(float value)
+    {
+        return lcf::details::float_to_half_bits(value);
+    }
+
+    TEST(Float16Scalar, ExactValues)
+    {
+        EXPECT_EQ(to_half_bits(0.0f), 0x0000);
+        EXPECT_EQ(to_half_bits(-0.0f), 0x8000);
+        EXPECT_EQ(to_half_bits(1.0f), 0x3C00);
+        EXPECT_EQ(to_half_bits(-2.0f), 0xC000);
+        EXPECT_EQ(to_half_bits(65504.0f), 0x7BFF);
+        EXPECT_EQ(to_half_bits(0x1p-14f), 0x0400); //- smallest normal
+        EXPECT_EQ(to_half_bits(0x1p-24f), 0x0001); //- smallest subnormal
+    }
+
+    TEST(Float16Scalar, RoundsToNearestEven)
+    {
+        EXPECT_EQ(to_half_bits(1.0f + 0x1p-11f), 0x3C00); //- tie, stays on the even mantissa
+        EXPECT_EQ(to_half_bits(1.0f + 0x1p-10f + 0x1p-11f), 0x3C02); //- tie, rounds up to the even mantissa
+        EXPECT_EQ(to_half_bits(1.0f + 0x1p-11f + 0x1p-20f), 0x3C01); //- above the tie
+        EXPECT_EQ(to_half_bits(0x1p-25f), 0x0000); //- tie between zero and the smallest subnormal
+        EXPECT_EQ(to_half_bits(0x1.8p-24f), 0x0002); //- tie between subnormals 1 and 2
+        EXPECT_EQ(to_half_bits(0x1.ffcp-15f), 0x0400); //- subnormal rounding carries into the smallest normal
+    }
+
+    TEST(Float16Scalar, OverflowAndSpecials)
+    {
+        EXPECT_EQ(to_half_bits(65519.0f), 0x7BFF);
+        EXPECT_EQ(to_half_bits(65520.0f), 0x7C00);
+        EXPECT_EQ(to_half_bits(std::numeric_limits<float>::infinity()), 0x7C00);
+        EXPECT_EQ(to_half_bits(-std::numeric_limits<float>::infinity()), 0xFC00);
+        EXPECT_EQ(to_half_bits(std::numeric_limits<float>::quiet_NaN()) & 0x7E00, 0x7E00);
+        EXPECT_EQ(to_half_bits(std::numeric_limits<float>::signaling_NaN()) & 0x7E00, 0x7E00); //- quieted
+    }
+
+    TEST(Float16Scalar, EveryHalfRoundTrips)
+    {
+        for (uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+            const float value = lcf::details::half_bits_to_float(static_cast<uint16_t>(bits));
+            const bool is_signaling_nan = (bits & 0x7C00) == 0x7C00 and (bits & 0x3FF) and not (bits & 0x200);
+            const uint16_t expected = static_cast<uint16_t>(is_signaling_nan ? bits | 0x200 : bits);
+            ASSERT_EQ(to_half_bits(value), expected) << "bits " << bits;
+        }
+    }
+
+    TEST(Float16Convert, EveryHalfWidensIdenticallyOnAllPaths)
+    {
+        std::vector<uint16_t> halves(0x10000);
+        for (uint32_t i = 0; i < halves.size(); ++i) { halves[i] = static_cast<uint16_t>(i); }
+        std::vector<float> expected(halves.size());
+        lcf::details::convert_f16_to_f32_scalar(halves.data(), expected.data(), halves.size());
+        for (auto path : supported_paths()) {
+            std::vector<float> result(halves.size());
+            lcf::details::convert_f16_to_f32(halves.data(), result.data(), halves.size(), path);
+            for (size_t i = 0; i < halves.size(); ++i) {
+                ASSERT_EQ(std::bit_cast<uint32_t>(result[i]), std::bit_cast<uint32_t>(expected[i])) << "path " << int(path) << " bits " << i;
+            }
+        }
+    }
+
+    TEST(Float16Convert, NarrowsIdenticallyOnAllPaths)
+    {
+        //- a strided sweep over every float bit pattern plus an odd count so the scalar tails run too
+        std::vector<float> values;
+        for (uint64_t bits = 0; bits <= 0xFFFFFFFFull; bits += 4093) { values.push_back(std::bit_cast<float>(static_cast<uint32_t>(bits))); }
+        values.push_back(0x1p-25f);
+        values.push_back(65520.0f);
+        std::vector<uint16_t> expected(values.size());
+        lcf::details::convert_f32_to_f16_scalar(values.data(), expected.data(), values.size());
+        for (auto path : supported_paths()) {
+            std::vector<uint16_t> result(values.size());
+            lcf::details::convert_f32_to_f16(values.data(), result.data(), values.size(), path);
+            for (size_t i = 0; i < values.size(); ++i) {
+                ASSERT_EQ(result[i], expected[i]) << "path " << int(path) << " float bits " << std::bit_cast<uint32_t>(values[i]);
+            }
+        }
+    }
+
+    TEST(Float16Convert, SpanOverloadsStopAtTheShorterSpan)
+    {
+        std::vector<float> src {1.0f, 2.0f, 3.0f};
+        std::vector<lcf::float16_t> dst(2);
+        lcf::convert_f32_to_f16(src, dst);
+        std::vector<float> back(4, -1.0f);
+        lcf::convert_f16_to_f32(dst, back);
+        EXPECT_EQ(back[0], 1.0f);
+        EXPECT_EQ(back[1], 2.0f);
+        EXPECT_EQ(back[2], -1.0f);
+    }
+
+} // namespace
@@ -0,0 +1,147 @@
+// Direct frame path on a headless surface: one outstanding frame at a time, frames from a retired swapchain are released.
+
+#include "vk_core/manifest/InstanceExtensionManifest.h"
+#include "vk_core/manifest/DeviceExtensionManifest.h"
+#include "vk_core/context/entry.h"
+#include "vk_core/context/info_structs.h"
+#include "vk_core/context/InstanceContext.h"
+#include "vk_core/context/DeviceContext.h"
+#include "vk_core/WSI/entry.h"
+#include "vk_core/WSI/create_surface.h"
+#include "vk_core/WSI/Swapchain.h"
+#include "vk_core/queue/QueueAccess.h"
+#include "vk_core/error.h"
+#include <gtest/gtest.h>
+
+#include <array>
+
+namespace {
+
+    namespace vkc = lcf::vkc;
+
+    //- skips instead of failing when the machine has no driver exposing VK_EXT_headless_surface
+    class SwapchainFrame : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            vkc::InstanceExtensionManifest inst_ext_manifest;
+            vkc::DeviceExtensionManifest device_ext_manifest;
+            vkc::entry::register_context(inst_ext_manifest, device_ext_manifest);
+            vkc::entry::register_headless_surface(inst_ext_manifest);
+            vkc::entry::register_swapchain(inst_ext_manifest, device_ext_manifest);
+
+            vk::ApplicationInfo app_info;
+            app_info.setPApplicationName("vk_core_swapchain_tests")
+                .setApiVersion(vk::HeaderVersionComplete);
+            vkc::InstanceContextCreateInfo instance_info;
+            instance_info.setApplicationInfo(app_info)
+                .setRequiredInstanceExtensionManifest(inst_ext_manifest);
+            if (auto ec = m_instance_context.create(instance_info)) { GTEST_SKIP() << "no instance: " << ec.message(); }
+            auto expected_surface = vkc::wsi::create_surface(m_instance_context.getInstance(), vkc::wsi::headless::WindowHandle {});
+            if (not expected_surface) { GTEST_SKIP() << "no headless surface: " << expected_surface.error().message(); }
+
+            vkc::bs::PhysicalDeviceSelectInfo physical_device_select_info;
+            physical_device_select_info.setRequiredDeviceExtensionManifest(device_ext_manifest);
+            vkc::DeviceContextCreateInfo device_context_info;
+            device_context_info.setRequiredDeviceExtensionManifest(device_ext_manifest)
+                .setPhysicalDeviceSelectInfo(physical_device_select_info);
+            vkc::QueueKey queue_key = device_context_info.addQueueRequest({
+                vk::QueueFlagBits::eGraphics,
+                {},
+                vkc::QueueSubmissionThreadTag {0},
+                1.0f,
+                expected_surface->get()
+            });
+            if (auto ec = m_device_context.create(m_instance_context.getInstance(), device_context_info)) { GTEST_SKIP() << "no device: " << ec.message(); }
+            m_queue = m_device_context.getLogicalQueue(queue_key);
+            if (auto ec = m_swapchain.create(std::move(expected_surface.value()), m_device_context.getPhysicalDevice(), m_queue)) {
+                GTEST_SKIP() << "no swapchain: " << ec.message();
+            }
+            vk::Device device = m_device_context.getDevice();
+            m_cmd_pool = device.createCommandPoolUnique({vk::CommandPoolCreateFlagBits::eResetCommandBuffer, m_queue.getFamilyIndex()});
+            m_cmd = std::move(device.allocateCommandBuffersUnique({m_cmd_pool.get(), vk::CommandBufferLevel::ePrimary, 1u}).front());
+        }
+
+        void TearDown() override
+        {
+            if (m_device_context.getDevice()) { m_device_context.getDevice().waitIdle(); }
+        }
+
+        //- stands in for rendering: moves the image to present layout between the frame's two semaphores
+        void submitFrame(const vkc::wsi::SwapchainFrame & frame)
+        {
+            vk::Device device = m_device_context.getDevice();
+            device.waitIdle(); //- m_cmd is reused across frames
+            m_cmd->begin(vk::CommandBufferBeginInfo {vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+            vk::ImageMemoryBarrier2 barrier;
+            barrier.setSrcStageMask(vk::PipelineStageFlagBits2::eColorAttachmentOutput)
+                .setDstStageMask(vk::PipelineStageFlagBits2::eColorAttachmentOutput)
+                .setOldLayout(vk::ImageLayout::eUndefined)
+                .setNewLayout(vk::ImageLayout::ePresentSrcKHR)
+                .setImage(frame.getImage().handle())
+                .setSubresourceRange({vk::ImageAspectFlagBits::eColor, 0u, 1u, 0u, 1u});
+            m_cmd->pipelineBarrier2(vk::DependencyInfo {}.setImageMemoryBarriers(barrier));
+            m_cmd->end();
+            vk::SemaphoreSubmitInfo wait_info = frame.getAcquireWaitInfo();
+            vk::SemaphoreSubmitInfo signal_info = frame.getPresentSignalInfo();
+            vk::CommandBufferSubmitInfo cmd_submit_info {m_cmd.get()};
+            vk::SubmitInfo2 submit;
+            submit.setWaitSemaphoreInfos(wait_info)
+                .setCommandBufferInfos(cmd_submit_info)
+                .setSignalSemaphoreInfos(signal_info);
+            vkc::QueueAccess queue_access {m_queue};
+            queue_access->submit2(submit);
+        }
+
+        vkc::InstanceContext m_instance_context;
+        vkc::DeviceContext m_device_context;
+        vkc::LogicalQueue m_queue;
+        vkc::wsi::Swapchain m_swapchain;
+        vk::UniqueCommandPool m_cmd_pool;
+        vk::UniqueCommandBuffer m_cmd;
+    };
+
+    TEST_F(SwapchainFrame, SecondAcquireIsRejectedUntilTheFrameIsPresented)
+    {
+        auto expected_frame = m_swapchain.acquireFrame();
+        ASSERT_TRUE(expected_frame.has_value()) << expected_frame.error().message();
+
+        auto expected_second_frame = m_swapchain.acquireFrame();
+        ASSERT_FALSE(expected_second_frame.has_value());
+        EXPECT_EQ(expected_second_frame.error(), vkc::errc::swapchain_frame_already_acquired);
+        auto expected_blit = m_swapchain.present({}, vk::Image {});
+        ASSERT_FALSE(expected_blit.has_value());
+        EXPECT_EQ(expected_blit.error(), vkc::errc::swapchain_frame_already_acquired);
+
+        submitFrame(*expected_frame);
+        EXPECT_FALSE(m_swapchain.presentFrame(*expected_frame));
+        EXPECT_EQ(m_swapchain.presentFrame(*expected_frame), std::errc::invalid_argument); //- already handed back
+
+        auto expected_next_frame = m_swapchain.acquireFrame();
+        ASSERT_TRUE(expected_next_frame.has_value()) << expected_next_frame.error().message();
+        submitFrame(*expected_next_frame);
+        EXPECT_FALSE(m_swapchain.presentFrame(*expected_next_frame));
+    }
+
+    TEST_F(SwapchainFrame, FrameFromRetiredSwapchainIsReleasedAsOutOfDate)
+    {
+        auto expected_frame = m_swapchain.acquireFrame();
+        ASSERT_TRUE(expected_frame.has_value()) << expected_frame.error().message();
+        submitFrame(*expected_frame);
+
+        //- the blit path still applies the new params before refusing, which retires the frame's swapchain
+        m_swapchain.setDesiredSwapchainImageCount(3u);
+        auto expected_blit = m_swapchain.present({}, vk::Image {});
+        ASSERT_FALSE(expected_blit.has_value());
+        EXPECT_EQ(expected_blit.error(), vkc::errc::swapchain_frame_already_acquired);
+
+        EXPECT_EQ(m_swapchain.presentFrame(*expected_frame), vkc::errc::swapchain_frame_out_of_date);
+
+        auto expected_next_frame = m_swapchain.acquireFrame();
+        ASSERT_TRUE(expected_next_frame.has_value()) << expected_next_frame.error().message();
+        EXPECT_NE(expected_next_frame->getGeneration(), expected_frame->getGeneration());
+        submitFrame(*expected_next_frame);
+        EXPECT_FALSE(m_swapchain.presentFrame(*expected_next_frame));
+    }
+}
@@ -55,10 +55,23 @@ namespace lcf::impl {
         {
             using ValueType = std::ranges::range_value_t<Range>;
             if (m_layout.getFieldAlignedSize(field_index) < size_of_v<ValueType>) { return *this; }
+            if (start_data_index >= this->getSize()) { return *this; }
             auto dst_it = this->view<ValueType>(field_index).begin() + start_data_index;
-            std::ranges::copy(data | std::views::take(this->getSize() - start_data_index), dst_it);
+            if constexpr (std::ranges::contiguous_range<Range> and std::ranges::sized_range<Range> and std::is_trivially_copyable_v<ValueType>) {
+                size_t count = std::min<size_t>(std::ranges::size(data), this->getSize() - start_data_index);
+                scatter_field(std::ranges::data(data), sizeof(ValueType), dst_it.getData(), dst_it.getStrideInBytes(), count);
+            } else {
+                std::ranges::copy(data | std::views::take(this->getSize() - start_data_index), dst_it);
+            }
             return *this;
         }
+        //- fields[i] packs field i of every structure, see interleave_fields
+        Self & interleave(std::span<const std::span<const std::byte>> fields) noexcept
+        {
+            interleave_fields(m_layout, fields, std::span<std::byte>(m_data));
+            return *this;
+        }
+        void deinterleave(std::span<const std::span<std::byte>> fields) const noexcept { deinterleave_fields(m_layout, this->getDataSpan(), fields); }
     private:
         StructureLayout m_layout;
         std::vector<std::byte> m_data;
@@ -27,10 +27,25 @@ namespace lcf::impl {
         template <std::ranges::range Range>
         Self & setData(size_t field_index, Range && data, size_t start_data_index = 0) noexcept
         {
-            auto dst_it = this->view<std::ranges::range_value_t<Range>>(field_index).begin() + start_data_index;
-            std::ranges::copy(data | std::views::take(this->getSize() - start_data_index), dst_it);
+            using ValueType = std::ranges::range_value_t<Range>;
+            if (start_data_index >= this->getSize()) { return *this; }
+            auto dst_it = this->view<ValueType>(field_index).begin() + start_data_index;
+            if constexpr (std::ranges::contiguous_range<Range> and std::ranges::sized_range<Range> and std::is_trivially_copyable_v<ValueType>) {
+                size_t count = std::min<size_t>(std::ranges::size(data), this->getSize() - start_data_index);
+                scatter_field(std::ranges::data(data), sizeof(ValueType), dst_it.getData(), dst_it.getStrideInBytes(), count);
+            } else {
+                std::ranges::copy(data | std::views::take(this->getSize() - start_data_index), dst_it);
+            }
             return *this;
         }
+        //- fields[i] packs field i of every structure, see interleave_fields
+        Self & interleave(std::span<const std::span<const std::byte>> fields) noexcept
+        {
+            interleave_fields(m_layout, fields, m_data);
+            return *this;
+        }
+        void deinterleave(std::span<const std::span<std::byte>> fields) const noexcept { deinterleave_fields(m_layout, m_data, fields); }
+        size_t getSize() const noexcept { return m_data.size() / m_layout.getStructualSize(); }
     private:
         StructureLayout m_layout;
         std::span<std::byte> m_data;
@@ -50,6 +65,8 @@ namespace lcf::impl {
         auto view(size_t field_index) noexcept { return extract_field_range<StructureLayout ,T, true>(m_layout, field_index, m_data); }
         template <typename T>
         auto view(size_t field_index) const noexcept { return extract_field_range<StructureLayout, T, true>(m_layout, field_index, m_data); }
+        void deinterleave(std::span<const std::span<std::byte>> fields) const noexcept { deinterleave_fields(m_layout, m_data, fields); }
+        size_t getSize() const noexcept { return m_data.size() / m_layout.getStructualSize(); }
     private:
         StructureLayout m_layout;
         std::span<const std::byte> m_data;
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "strided_copy.h"
 #include <iterator>
+#include <span>
+#include <type_traits>
 
 namespace lcf::impl {
     template <typename T>
@@ -40,6 +43,8 @@ namespace lcf::impl {
         bool operator==(const Self &other) const { return m_data == other.m_data; }
         auto operator<=>(const Self &other) const { return m_data <=> other.m_data; }
         friend Self operator+(difference_type n, const Self& iter) { return iter + n; }
+        BytePtr getData() const noexcept { return m_data; }
+        size_t getStrideInBytes() const noexcept { return m_stride; }
     private:
         BytePtr m_data = nullptr;
         size_t m_stride = 0;
@@ -52,4 +57,19 @@ namespace lcf {
 
     template <typename T>
     using ConstStrideIterator = impl::StrideIteratorImpl<const T>;
+
+    //- bulk copies for trivially copyable elements, see strided_copy.h
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    void scatter_field(std::span<const T> src, StrideIterator<T> dst) noexcept
+    {
+        scatter_field(src.data(), sizeof(T), dst.getData(), dst.getStrideInBytes(), src.size());
+    }
+
+    template <typename T>
+    requires std::is_trivially_copyable_v<T>
+    void gather_field(ConstStrideIterator<T> src, std::span<T> dst) noexcept
+    {
+        gather_field(src.getData(), src.getStrideInBytes(), sizeof(T), dst.data(), dst.size());
+    }
 }
\ No newline at end of file
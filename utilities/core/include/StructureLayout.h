@@ -5,6 +5,9 @@
 #include "align.h"
 #include <vector>
 #include <ranges>
+#include <algorithm>
+#include <span>
+#include <array>
 #include <bit>
 
 namespace lcf {
@@ -91,4 +94,68 @@ namespace lcf {
         if (data_index >= bytes.size() / layout.getStructualSize()) { return; }
         *extract_field_at<StructureLayout, T, false>(layout, field_index, data_index, bytes) = data;
     }
-}
+
+    inline constexpr size_t k_interleave_chunk_size = 256; //- structures per pass, keeps the interleaved side in cache
+
+    //- whole structure aos <-> soa. fields[i] packs field i of every structure, its element size is fields[i].size()
+    //- divided by the structure count, capped at the aligned field size; empty spans skip the field
+    template <structure_layout_c StructureLayout>
+    void deinterleave_fields(const StructureLayout & layout, std::span<const std::byte> src, std::span<const std::span<std::byte>> fields) noexcept
+    {
+        const size_t stride = layout.getStructualSize();
+        const size_t count = src.size() / stride;
+        const size_t field_count = std::min(fields.size(), layout.getFieldCount());
+        if (count == 0) { return; }
+        auto get_element_size = [&](size_t field_index) { return std::min(fields[field_index].size() / count, layout.getFieldAlignedSize(field_index)); };
+#if defined(LCF_STRIDED_COPY_SSE2)
+        if (stride == 16 and field_count == 4 and layout.getFieldCount() == 4) {
+            std::array<std::byte *, 4> dst_p_array {};
+            bool is_4x4 = true;
+            for (size_t i = 0; i < 4; ++i) {
+                is_4x4 = is_4x4 and get_element_size(i) == 4 and layout.getFieldOffset(i) == i * 4;
+                dst_p_array[i] = fields[i].data();
+            }
+            if (is_4x4) { return details::deinterleave_4x4_sse2(src.data(), dst_p_array.data(), count); }
+        }
+#endif
+        for (size_t chunk_begin = 0; chunk_begin < count; chunk_begin += k_interleave_chunk_size) {
+            const size_t chunk_count = std::min(k_interleave_chunk_size, count - chunk_begin);
+            for (size_t field_index = 0; field_index < field_count; ++field_index) {
+                const size_t element_size = get_element_size(field_index);
+                if (element_size == 0) { continue; }
+                gather_field(src.data() + chunk_begin * stride + layout.getFieldOffset(field_index), stride, element_size,
+                    fields[field_index].data() + chunk_begin * element_size, chunk_count);
+            }
+        }
+    }
+
+    template <structure_layout_c StructureLayout>
+    void interleave_fields(const StructureLayout & layout, std::span<const std::span<const std::byte>> fields, std::span<std::byte> dst) noexcept
+    {
+        const size_t stride = layout.getStructualSize();
+        const size_t count = dst.size() / stride;
+        const size_t field_count = std::min(fields.size(), layout.getFieldCount());
+        if (count == 0) { return; }
+        auto get_element_size = [&](size_t field_index) { return std::min(fields[field_index].size() / count, layout.getFieldAlignedSize(field_index)); };
+#if defined(LCF_STRIDED_COPY_SSE2)
+        if (stride == 16 and field_count == 4 and layout.getFieldCount() == 4) {
+            std::array<const std::byte *, 4> src_p_array {};
+            bool is_4x4 = true;
+            for (size_t i = 0; i < 4; ++i) {
+                is_4x4 = is_4x4 and get_element_size(i) == 4 and layout.getFieldOffset(i) == i * 4;
+                src_p_array[i] = fields[i].data();
+            }
+            if (is_4x4) { return details::interleave_4x4_sse2(src_p_array.data(), dst.data(), count); }
+        }
+#endif
+        for (size_t chunk_begin = 0; chunk_begin < count; chunk_begin += k_interleave_chunk_size) {
+            const size_t chunk_count = std::min(k_interleave_chunk_size, count - chunk_begin);
+            for (size_t field_index = 0; field_index < field_count; ++field_index) {
+                const size_t element_size = get_element_size(field_index);
+                if (element_size == 0) { continue; }
+                scatter_field(fields[field_index].data() + chunk_begin * element_size, element_size,
+                    dst.data() + chunk_begin * stride + layout.getFieldOffset(field_index), stride, chunk_count);
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "float16.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define LCF_FLOAT16_X86
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+#endif
+
+namespace lcf::details {
+    static_assert(sizeof(float16_t) == sizeof(uint16_t));
+
+    enum class Float16ConvertPath : uint8_t
+    {
+        eScalar,
+        eF16C, //- 8 lanes
+        eAVX512, //- 16 lanes
+    };
+
+    inline uint16_t float_to_half_bits(float value) noexcept
+    {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        const auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+        const uint32_t magnitude = bits & 0x7FFFFFFF;
+        if (magnitude >= 0x7F800000) { //- inf stays inf, nan is quieted and keeps its upper payload bits
+            const uint32_t payload = magnitude > 0x7F800000 ? (0x200 | ((magnitude >> 13) & 0x3FF)) : 0;
+            return static_cast<uint16_t>(sign | 0x7C00 | payload);
+        }
+        if (magnitude >= 0x477FF000) { return static_cast<uint16_t>(sign | 0x7C00); } //- 65520 and up round to inf
+        if (magnitude < 0x38800000) { //- below the smallest normal half, the result is subnormal or zero
+            if (magnitude < 0x33000000) { return sign; } //- at most half of the smallest subnormal
+            const uint32_t shift = 126 - (magnitude >> 23);
+            const uint32_t mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+            uint32_t result = mantissa >> shift;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1);
+            const uint32_t halfway = 1u << (shift - 1);
+            if (remainder > halfway or (remainder == halfway and (result & 1))) { ++result; }
+            return static_cast<uint16_t>(sign | result);
+        }
+        uint32_t result = (magnitude - 0x38000000) >> 13; //- rebias the exponent from 127 to 15
+        const uint32_t remainder = magnitude & 0x1FFF;
+        if (remainder > 0x1000 or (remainder == 0x1000 and (result & 1))) { ++result; } //- a carry moves into the exponent
+        return static_cast<uint16_t>(sign | result);
+    }
+
+    inline float half_bits_to_float(uint16_t bits) noexcept
+    {
+        const uint32_t sign = static_cast<uint32_t>(bits & 0x8000) << 16;
+        const uint32_t exponent = (bits >> 10) & 0x1F;
+        const uint32_t mantissa = bits & 0x3FF;
+        if (exponent == 0x1F) {
+            const uint32_t quiet_bit = mantissa ? 0x400000 : 0;
+            return std::bit_cast<float>(sign | 0x7F800000 | quiet_bit | (mantissa << 13));
+        }
+        if (exponent == 0) { //- zero or subnormal, exact in float
+            const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+            return sign ? -magnitude : magnitude;
+        }
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+
+    inline void convert_f32_to_f16_scalar(const float * src_p, uint16_t * dst_p, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i) { dst_p[i] = float_to_half_bits(src_p[i]); }
+    }
+
+    inline void convert_f16_to_f32_scalar(const uint16_t * src_p, float * dst_p, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i) { dst_p[i] = half_bits_to_float(src_p[i]); }
+    }
+
+#if defined(LCF_FLOAT16_X86)
+#if defined(__GNUC__) || defined(__clang__)
+#define LCF_FLOAT16_TARGET_F16C __attribute__((target("avx,f16c")))
+#define LCF_FLOAT16_TARGET_AVX512 __attribute__((target("avx512f")))
+#else
+#define LCF_FLOAT16_TARGET_F16C
+#define LCF_FLOAT16_TARGET_AVX512
+#endif
+
+    LCF_FLOAT16_TARGET_F16C inline void convert_f32_to_f16_f16c(const float * src_p, uint16_t * dst_p, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i half_v = _mm256_cvtps_ph(_mm256_loadu_ps(src_p + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p + i), half_v);
+        }
+        convert_f32_to_f16_scalar(src_p + i, dst_p + i, count - i);
+    }
+
+    LCF_FLOAT16_TARGET_F16C inline void convert_f16_to_f32_f16c(const uint16_t * src_p, float * dst_p, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m128i half_v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p + i));
+            _mm256_storeu_ps(dst_p + i, _mm256_cvtph_ps(half_v));
+        }
+        convert_f16_to_f32_scalar(src_p + i, dst_p + i, count - i);
+    }
+
+    LCF_FLOAT16_TARGET_AVX512 inline void convert_f32_to_f16_avx512(const float * src_p, uint16_t * dst_p, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m256i half_v = _mm512_maskz_cvtps_ph(0xFFFF, _mm512_loadu_ps(src_p + i), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst_p + i), half_v);
+        }
+        convert_f32_to_f16_scalar(src_p + i, dst_p + i, count - i);
+    }
+
+    LCF_FLOAT16_TARGET_AVX512 inline void convert_f16_to_f32_avx512(const uint16_t * src_p, float * dst_p, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m256i half_v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src_p + i));
+            _mm512_storeu_ps(dst_p + i, _mm512_maskz_cvtph_ps(0xFFFF, half_v));
+        }
+        convert_f16_to_f32_scalar(src_p + i, dst_p + i, count - i);
+    }
+
+    inline Float16ConvertPath detect_float16_convert_path() noexcept
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+        int info[4] = {};
+        __cpuid(info, 1);
+        const bool os_saves_avx = (info[2] & (1 << 27)) and (_xgetbv(0) & 0x6) == 0x6;
+        const bool has_f16c = os_saves_avx and (info[2] & (1 << 28)) and (info[2] & (1 << 29));
+        if (not has_f16c) { return Float16ConvertPath::eScalar; }
+        __cpuidex(info, 7, 0);
+        const bool os_saves_avx512 = (_xgetbv(0) & 0xE6) == 0xE6;
+        return os_saves_avx512 and (info[1] & (1 << 16)) ? Float16ConvertPath::eAVX512 : Float16ConvertPath::eF16C;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) { return Float16ConvertPath::eAVX512; }
+        if (__builtin_cpu_supports("avx") and __builtin_cpu_supports("f16c")) { return Float16ConvertPath::eF16C; }
+        return Float16ConvertPath::eScalar;
+#endif
+    }
+#else
+    inline Float16ConvertPath detect_float16_convert_path() noexcept
+    {
+        return Float16ConvertPath::eScalar;
+    }
+#endif
+
+    inline Float16ConvertPath get_float16_convert_path() noexcept
+    {
+        static const Float16ConvertPath s_path = detect_float16_convert_path();
+        return s_path;
+    }
+
+    inline void convert_f32_to_f16(const float * src_p, uint16_t * dst_p, size_t count, Float16ConvertPath path) noexcept
+    {
+        switch (path) {
+#if defined(LCF_FLOAT16_X86)
+            case Float16ConvertPath::eAVX512: { convert_f32_to_f16_avx512(src_p, dst_p, count); } break;
+            case Float16ConvertPath::eF16C: { convert_f32_to_f16_f16c(src_p, dst_p, count); } break;
+#endif
+            default: { convert_f32_to_f16_scalar(src_p, dst_p, count); } break;
+        }
+    }
+
+    inline void convert_f16_to_f32(const uint16_t * src_p, float * dst_p, size_t count, Float16ConvertPath path) noexcept
+    {
+        switch (path) {
+#if defined(LCF_FLOAT16_X86)
+            case Float16ConvertPath::eAVX512: { convert_f16_to_f32_avx512(src_p, dst_p, count); } break;
+            case Float16ConvertPath::eF16C: { convert_f16_to_f32_f16c(src_p, dst_p, count); } break;
+#endif
+            default: { convert_f16_to_f32_scalar(src_p, dst_p, count); } break;
+        }
+    }
+}
+
+//- batch float <-> half conversion with round to nearest even. The simd path is picked once at runtime, so the
+//- binary does not need to be compiled for f16c; every path produces the same bits as the scalar one
+namespace lcf {
+    //- converts min(src.size(), dst.size()) elements
+    inline void convert_f32_to_f16(std::span<const float> src, std::span<float16_t> dst) noexcept
+    {
+        const size_t count = std::min(src.size(), dst.size());
+        details::convert_f32_to_f16(src.data(), reinterpret_cast<uint16_t *>(dst.data()), count, details::get_float16_convert_path());
+    }
+
+    inline void convert_f16_to_f32(std::span<const float16_t> src, std::span<float> dst) noexcept
+    {
+        const size_t count = std::min(src.size(), dst.size());
+        details::convert_f16_to_f32(reinterpret_cast<const uint16_t *>(src.data()), dst.data(), count, details::get_float16_convert_path());
+    }
+}
@@ -85,6 +85,9 @@ namespace lcf {
             return *this;
         }
         operator bool() const noexcept { return m_control_block_p; }
+        // Leases on the same resource share a control block, which makes it a
+        // cheap identity for deduplicating pins.
+        const void * identity() const noexcept { return m_control_block_p; }
     private:
         void tryDestroy() noexcept
         {
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LCF_STRIDED_COPY_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace lcf::details {
+    //- fixed size copies become single moves, four elements per iteration keep the loads independent
+    template <size_t element_size>
+    inline void scatter_elements(const std::byte * src_p, std::byte * dst_p, size_t dst_stride, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, src_p += element_size * 4, dst_p += dst_stride * 4) {
+            std::memcpy(dst_p, src_p, element_size);
+            std::memcpy(dst_p + dst_stride, src_p + element_size, element_size);
+            std::memcpy(dst_p + dst_stride * 2, src_p + element_size * 2, element_size);
+            std::memcpy(dst_p + dst_stride * 3, src_p + element_size * 3, element_size);
+        }
+        for (; i < count; ++i, src_p += element_size, dst_p += dst_stride) { std::memcpy(dst_p, src_p, element_size); }
+    }
+
+    template <size_t element_size>
+    inline void gather_elements(const std::byte * src_p, size_t src_stride, std::byte * dst_p, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, src_p += src_stride * 4, dst_p += element_size * 4) {
+            std::memcpy(dst_p, src_p, element_size);
+            std::memcpy(dst_p + element_size, src_p + src_stride, element_size);
+            std::memcpy(dst_p + element_size * 2, src_p + src_stride * 2, element_size);
+            std::memcpy(dst_p + element_size * 3, src_p + src_stride * 3, element_size);
+        }
+        for (; i < count; ++i, src_p += src_stride, dst_p += element_size) { std::memcpy(dst_p, src_p, element_size); }
+    }
+
+    inline void scatter_elements(const std::byte * src_p, size_t element_size, std::byte * dst_p, size_t dst_stride, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i, src_p += element_size, dst_p += dst_stride) { std::memcpy(dst_p, src_p, element_size); }
+    }
+
+    inline void gather_elements(const std::byte * src_p, size_t src_stride, size_t element_size, std::byte * dst_p, size_t count) noexcept
+    {
+        for (size_t i = 0; i < count; ++i, src_p += src_stride, dst_p += element_size) { std::memcpy(dst_p, src_p, element_size); }
+    }
+
+#if defined(LCF_STRIDED_COPY_SSE2)
+    //- vec3 fields: every element is moved as 16 bytes, the 4 spare bytes read from the next structure and written
+    //- where the next element lands. The last element is left to the caller since both would run past the buffers
+    inline size_t gather_elements_12_sse2(const std::byte * src_p, size_t src_stride, std::byte * dst_p, size_t count) noexcept
+    {
+        if (src_stride < 16 or count < 2) { return 0; }
+        size_t i = 0;
+        for (; i + 1 < count; ++i, src_p += src_stride, dst_p += 12) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_p), _mm_loadu_si128(reinterpret_cast<const __m128i *>(src_p)));
+        }
+        return i;
+    }
+
+    //- four 4 byte fields of a 16 byte structure, e.g. per instance floats, transposed four structures at a time
+    inline void deinterleave_4x4_sse2(const std::byte * src_p, std::byte * const * dst_p_array, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, src_p += 64) {
+            __m128 row0_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p));
+            __m128 row1_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p + 16));
+            __m128 row2_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p + 32));
+            __m128 row3_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p + 48));
+            _MM_TRANSPOSE4_PS(row0_v, row1_v, row2_v, row3_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p_array[0] + i * 4), row0_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p_array[1] + i * 4), row1_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p_array[2] + i * 4), row2_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p_array[3] + i * 4), row3_v);
+        }
+        for (size_t field = 0; field < 4; ++field) { gather_elements<4>(src_p + field * 4, 16, dst_p_array[field] + i * 4, count - i); }
+    }
+
+    inline void interleave_4x4_sse2(const std::byte * const * src_p_array, std::byte * dst_p, size_t count) noexcept
+    {
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, dst_p += 64) {
+            __m128 row0_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p_array[0] + i * 4));
+            __m128 row1_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p_array[1] + i * 4));
+            __m128 row2_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p_array[2] + i * 4));
+            __m128 row3_v = _mm_loadu_ps(reinterpret_cast<const float *>(src_p_array[3] + i * 4));
+            _MM_TRANSPOSE4_PS(row0_v, row1_v, row2_v, row3_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p), row0_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p + 16), row1_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p + 32), row2_v);
+            _mm_storeu_ps(reinterpret_cast<float *>(dst_p + 48), row3_v);
+        }
+        for (size_t field = 0; field < 4; ++field) { scatter_elements<4>(src_p_array[field] + i * 4, dst_p + field * 4, 16, count - i); }
+    }
+#endif
+}
+
+//- bulk copies between a packed array and one field of interleaved structures, e.g. a vertex attribute or an instance
+//- member. The element size picks a fixed size kernel, so the copies vectorize instead of going through a runtime
+//- sized assignment per element. Ranges must not overlap
+namespace lcf {
+    inline void scatter_field(const void * src_p, size_t element_size, void * dst_p, size_t dst_stride, size_t count) noexcept
+    {
+        auto src_byte_p = static_cast<const std::byte *>(src_p);
+        auto dst_byte_p = static_cast<std::byte *>(dst_p);
+        if (count == 0 or element_size == 0) { return; }
+        if (dst_stride == element_size) {
+            std::memcpy(dst_byte_p, src_byte_p, element_size * count);
+            return;
+        }
+        switch (element_size) {
+            case 1: { details::scatter_elements<1>(src_byte_p, dst_byte_p, dst_stride, count); } break;
+            case 2: { details::scatter_elements<2>(src_byte_p, dst_byte_p, dst_stride, count); } break;
+            case 4: { details::scatter_elements<4>(src_byte_p, dst_byte_p, dst_stride, count); } break;
+            case 8: { details::scatter_elements<8>(src_byte_p, dst_byte_p, dst_stride, count); } break;
+            case 12: { details::scatter_elements<12>(src_byte_p, dst_byte_p, dst_stride, count); } break;
+            case 16: { details::scatter_elements<16>(src_byte_p, dst_byte_p, dst_stride, count); } break;
+            default: { details::scatter_elements(src_byte_p, element_size, dst_byte_p, dst_stride, count); } break;
+        }
+    }
+
+    inline void gather_field(const void * src_p, size_t src_stride, size_t element_size, void * dst_p, size_t count) noexcept
+    {
+        auto src_byte_p = static_cast<const std::byte *>(src_p);
+        auto dst_byte_p = static_cast<std::byte *>(dst_p);
+        if (count == 0 or element_size == 0) { return; }
+        if (src_stride == element_size) {
+            std::memcpy(dst_byte_p, src_byte_p, element_size * count);
+            return;
+        }
+        switch (element_size) {
+            case 1: { details::gather_elements<1>(src_byte_p, src_stride, dst_byte_p, count); } break;
+            case 2: { details::gather_elements<2>(src_byte_p, src_stride, dst_byte_p, count); } break;
+            case 4: { details::gather_elements<4>(src_byte_p, src_stride, dst_byte_p, count); } break;
+            case 8: { details::gather_elements<8>(src_byte_p, src_stride, dst_byte_p, count); } break;
+            case 12: {
+                size_t done = 0;
+#if defined(LCF_STRIDED_COPY_SSE2)
+                done = details::gather_elements_12_sse2(src_byte_p, src_stride, dst_byte_p, count);
+#endif
+                details::gather_elements<12>(src_byte_p + done * src_stride, src_stride, dst_byte_p + done * 12, count - done);
+            } break;
+            case 16: { details::gather_elements<16>(src_byte_p, src_stride, dst_byte_p, count); } break;
+            default: { details::gather_elements(src_byte_p, src_stride, element_size, dst_byte_p, count); } break;
+        }
+    }
+}